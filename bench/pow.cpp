@@ -0,0 +1,79 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include "smath/smath.hpp"
+
+/**
+ * Compares smath::pow over ranges of floats, for every accuracy, with a loop
+ * calling std::pow, which is what the range functions replace.
+ *
+ * Exits with 1 when a tier is slower than the loop, so `make bench` followed
+ * by `bin/bench_pow` catches a kernel that no longer pays off.
+ *
+ * Usage: bench_pow [number of values in millions, default 4]
+ */
+
+using clock_type = std::chrono::steady_clock;
+
+/**
+ * @returns The fastest of `repeats` runs of `func`, in seconds.
+ */
+template<class F>
+double best_of(int repeats, F func) {
+	double best{ 1e30 };
+	for (int r = 0; r < repeats; ++r) {
+		const clock_type::time_point start{ clock_type::now() };
+		func();
+		const std::chrono::duration<double> elapsed{ clock_type::now() - start };
+		best = std::min(best, elapsed.count());
+	}
+	return best;
+}
+
+int main(int argc, char **argv) {
+	const std::size_t n{ (argc > 1 ? static_cast<std::size_t>(std::atol(argv[1])) : 4) * 1000000 };
+	const int repeats{ 5 };
+
+	// bases over several decades and exponents of tone mapping and falloffs
+	std::vector<float> base(n), exponent(n), out(n), expected(n);
+	for (std::size_t i = 0; i < n; ++i) {
+		base[i] = 0.01f + static_cast<float>(i % 10007) * 0.01f;
+		exponent[i] = -4.f + static_cast<float>(i % 811) * 0.01f;
+	}
+
+	const double t_std{ best_of(repeats, [&]() {
+		for (std::size_t i = 0; i < n; ++i) {
+			expected[i] = std::pow(base[i], exponent[i]);
+		}
+	}) };
+
+	std::cout.precision(2);
+	std::cout << std::fixed << "std::pow loop\t" << t_std * 1e3 << " ms\n";
+
+	const smath::accuracy tiers[3]{ smath::accuracy::fast, smath::accuracy::balanced, smath::accuracy::precise };
+	const char *names[3]{ "fast", "balanced", "precise" };
+	int status{ 0 };
+	for (int t = 0; t < 3; ++t) {
+		const double t_span{ best_of(repeats, [&]() {
+			smath::pow(base, exponent, out, tiers[t]);
+		}) };
+		std::cout << "pow " << names[t] << "\t" << t_span * 1e3 << " ms\t" << t_std / t_span << "x\n";
+
+		if (t_span > t_std) {
+			std::cerr << "pow " << names[t] << " is slower than std::pow\n";
+			status = 1;
+		}
+		const float tolerance{ t == 0 ? 1e-3f : 1e-6f };
+		if (std::fabs(out[n / 2] - expected[n / 2]) > tolerance * expected[n / 2]) {
+			std::cerr << "wrong result\n";
+			return 1;
+		}
+	}
+
+	return status;
+}
@@ -0,0 +1,81 @@
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#define SMATH_FORCE_INTRINSICS
+#include "smath/smath.hpp"
+
+/**
+ * Compares writing `out[i] = a[i] + b[i]` over arrays of smath::vec4 with
+ * the vector operators, the batch kernels with regular stores and the batch
+ * kernels with streaming stores.
+ *
+ * Streaming should lose while the three arrays fit in the cache and win once
+ * they are several times larger than the last-level cache.
+ *
+ * Usage: bench_streaming [largest array size in MiB, default 256]
+ */
+
+using clock_type = std::chrono::steady_clock;
+
+/**
+ * @returns The fastest of `repeats` runs of `func`, in seconds.
+ */
+template<class F>
+double best_of(int repeats, F func) {
+	double best{ 1e30 };
+	for (int r = 0; r < repeats; ++r) {
+		const clock_type::time_point start{ clock_type::now() };
+		func();
+		const std::chrono::duration<double> elapsed{ clock_type::now() - start };
+		best = std::min(best, elapsed.count());
+	}
+	return best;
+}
+
+int main(int argc, char **argv) {
+	const std::size_t max_mib{ argc > 1 ? static_cast<std::size_t>(std::atol(argv[1])) : 256 };
+
+	std::cout << "array MiB    vec4 GB/s   regular GB/s   streaming GB/s\n";
+
+	for (std::size_t kib = 64; kib <= max_mib * 1024; kib *= 4) {
+		const std::size_t n{ kib * 1024 / sizeof(smath::vec4) };
+		std::vector<smath::vec4> a(n, smath::vec4{ 1.f, 2.f, 3.f, 4.f });
+		std::vector<smath::vec4> b(n, smath::vec4{ 0.5f });
+		std::vector<smath::vec4> out(n);
+
+		// keep the total work roughly constant across sizes
+		const int repeats{ static_cast<int>(std::max<std::size_t>(3, (256 * 1024) / kib)) };
+
+		const double t_vec{ best_of(repeats, [&]() {
+			for (std::size_t i = 0; i < n; ++i) {
+				out[i] = a[i] + b[i];
+			}
+		}) };
+		const double t_regular{ best_of(repeats, [&]() {
+			smath::batch::add(a.data(), b.data(), out.data(), n);
+		}) };
+		const double t_stream{ best_of(repeats, [&]() {
+			smath::batch::add(a.data(), b.data(), out.data(), n, smath::batch::store_mode::streaming);
+		}) };
+
+		// two arrays read and one written
+		const double gb{ 3.0 * static_cast<double>(n * sizeof(smath::vec4)) / 1e9 };
+		std::cout.precision(2);
+		std::cout << std::fixed
+			<< static_cast<double>(kib) / 1024.0 << "\t\t"
+			<< gb / t_vec << "\t\t"
+			<< gb / t_regular << "\t\t"
+			<< gb / t_stream << "\n";
+
+		if (out[n - 1].w != 4.5f) {
+			std::cerr << "wrong result\n";
+			return 1;
+		}
+	}
+
+	return 0;
+}
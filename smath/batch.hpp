@@ -0,0 +1,428 @@
+#pragma once
+
+#ifndef BATCH_H
+#define BATCH_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "detail/setup.hpp"
+#include "detail/cpu.hpp"
+
+#include "vec.hpp"
+
+#if SMATH_HAS_CPU_DISPATCH
+#	if SMATH_COMPILER & SMATH_COMPILER_VC
+#		include <intrin.h>
+#	else
+#		include <immintrin.h>
+#	endif
+#endif
+
+namespace smath {
+
+	namespace batch {
+
+		/**
+		 * How the array functions write their output.
+		 *
+		 * `streaming` uses non-temporal stores and prefetches the inputs, which
+		 * pays off when the arrays are much larger than the last-level cache and
+		 * the output is not read again soon. Smaller arrays are faster with the
+		 * `regular` stores, which leave the output in the cache.
+		 */
+		enum class store_mode {
+			regular,
+			streaming
+		};
+
+		namespace detail {
+
+			template<class T>
+			using binary_kernel = void (*)(const T *, const T *, T *, std::size_t);
+
+			// -- Operations --
+
+			// Each operation provides an overload for the scalar type and for every
+			// register type, so one kernel per instruction set covers all of them.
+
+			struct op_add {
+				template<class T>
+				static T call(T a, T b) {
+					return a + b;
+				}
+
+#if SMATH_HAS_CPU_DISPATCH
+				SMATH_TARGET("sse2") static __m128 call(__m128 a, __m128 b) { return _mm_add_ps(a, b); }
+				SMATH_TARGET("sse2") static __m128d call(__m128d a, __m128d b) { return _mm_add_pd(a, b); }
+				SMATH_TARGET("avx") static __m256 call(__m256 a, __m256 b) { return _mm256_add_ps(a, b); }
+				SMATH_TARGET("avx") static __m256d call(__m256d a, __m256d b) { return _mm256_add_pd(a, b); }
+				SMATH_TARGET("avx512f") static __m512 call(__m512 a, __m512 b) { return _mm512_add_ps(a, b); }
+				SMATH_TARGET("avx512f") static __m512d call(__m512d a, __m512d b) { return _mm512_add_pd(a, b); }
+#endif
+			};
+
+			struct op_sub {
+				template<class T>
+				static T call(T a, T b) {
+					return a - b;
+				}
+
+#if SMATH_HAS_CPU_DISPATCH
+				SMATH_TARGET("sse2") static __m128 call(__m128 a, __m128 b) { return _mm_sub_ps(a, b); }
+				SMATH_TARGET("sse2") static __m128d call(__m128d a, __m128d b) { return _mm_sub_pd(a, b); }
+				SMATH_TARGET("avx") static __m256 call(__m256 a, __m256 b) { return _mm256_sub_ps(a, b); }
+				SMATH_TARGET("avx") static __m256d call(__m256d a, __m256d b) { return _mm256_sub_pd(a, b); }
+				SMATH_TARGET("avx512f") static __m512 call(__m512 a, __m512 b) { return _mm512_sub_ps(a, b); }
+				SMATH_TARGET("avx512f") static __m512d call(__m512d a, __m512d b) { return _mm512_sub_pd(a, b); }
+#endif
+			};
+
+			struct op_mul {
+				template<class T>
+				static T call(T a, T b) {
+					return a * b;
+				}
+
+#if SMATH_HAS_CPU_DISPATCH
+				SMATH_TARGET("sse2") static __m128 call(__m128 a, __m128 b) { return _mm_mul_ps(a, b); }
+				SMATH_TARGET("sse2") static __m128d call(__m128d a, __m128d b) { return _mm_mul_pd(a, b); }
+				SMATH_TARGET("avx") static __m256 call(__m256 a, __m256 b) { return _mm256_mul_ps(a, b); }
+				SMATH_TARGET("avx") static __m256d call(__m256d a, __m256d b) { return _mm256_mul_pd(a, b); }
+				SMATH_TARGET("avx512f") static __m512 call(__m512 a, __m512 b) { return _mm512_mul_ps(a, b); }
+				SMATH_TARGET("avx512f") static __m512d call(__m512d a, __m512d b) { return _mm512_mul_pd(a, b); }
+#endif
+			};
+
+			struct op_div {
+				template<class T>
+				static T call(T a, T b) {
+					return a / b;
+				}
+
+#if SMATH_HAS_CPU_DISPATCH
+				SMATH_TARGET("sse2") static __m128 call(__m128 a, __m128 b) { return _mm_div_ps(a, b); }
+				SMATH_TARGET("sse2") static __m128d call(__m128d a, __m128d b) { return _mm_div_pd(a, b); }
+				SMATH_TARGET("avx") static __m256 call(__m256 a, __m256 b) { return _mm256_div_ps(a, b); }
+				SMATH_TARGET("avx") static __m256d call(__m256d a, __m256d b) { return _mm256_div_pd(a, b); }
+				SMATH_TARGET("avx512f") static __m512 call(__m512 a, __m512 b) { return _mm512_div_ps(a, b); }
+				SMATH_TARGET("avx512f") static __m512d call(__m512d a, __m512d b) { return _mm512_div_pd(a, b); }
+#endif
+			};
+
+			// -- Kernels --
+
+			// With `Stream` set, the kernels write the output with non-temporal
+			// stores, which bypass the cache and skip the read-for-ownership of
+			// the output lines, and prefetch the inputs ahead of the loads. The
+			// stores must be aligned to the register, so the elements before the
+			// first aligned address are handled by the scalar kernel.
+
+			/**
+			 * @brief Distance in bytes that the streaming kernels prefetch ahead of
+			 * the current input position.
+			 */
+			static const std::size_t prefetch_distance{ 1024 };
+
+			template<class Op, class T>
+			void kernel_scalar(const T *a, const T *b, T *out, std::size_t n) {
+				for (std::size_t i = 0; i < n; ++i) {
+					out[i] = Op::call(a[i], b[i]);
+				}
+			}
+
+			/**
+			 * @returns The number of elements before `out` is aligned to `align`
+			 * bytes, limited to `n`.
+			 */
+			template<class T>
+			SMATH_INLINE std::size_t stream_head(const T *out, std::size_t align, std::size_t n) {
+				const std::size_t misalign{ reinterpret_cast<std::uintptr_t>(out) % align };
+				const std::size_t head{ misalign == 0 ? 0 : (align - misalign) / sizeof(T) };
+				return head < n ? head : n;
+			}
+
+#if SMATH_HAS_CPU_DISPATCH
+			template<class T>
+			SMATH_INLINE void prefetch(const T *a, const T *b) {
+				_mm_prefetch(reinterpret_cast<const char *>(a) + prefetch_distance, _MM_HINT_T0);
+				_mm_prefetch(reinterpret_cast<const char *>(b) + prefetch_distance, _MM_HINT_T0);
+			}
+
+			template<class Op, bool Stream>
+			SMATH_TARGET("sse2") void kernel_sse2(const float *a, const float *b, float *out, std::size_t n) {
+				std::size_t i{ Stream ? stream_head(out, 16, n) : 0 };
+				kernel_scalar<Op>(a, b, out, i);
+				for (; i + 4 <= n; i += 4) {
+					const __m128 r{ Op::call(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)) };
+					if (Stream) {
+						prefetch(a + i, b + i);
+						_mm_stream_ps(out + i, r);
+					} else {
+						_mm_storeu_ps(out + i, r);
+					}
+				}
+				kernel_scalar<Op>(a + i, b + i, out + i, n - i);
+				if (Stream) {
+					_mm_sfence();
+				}
+			}
+
+			template<class Op, bool Stream>
+			SMATH_TARGET("sse2") void kernel_sse2(const double *a, const double *b, double *out, std::size_t n) {
+				std::size_t i{ Stream ? stream_head(out, 16, n) : 0 };
+				kernel_scalar<Op>(a, b, out, i);
+				for (; i + 2 <= n; i += 2) {
+					const __m128d r{ Op::call(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i)) };
+					if (Stream) {
+						prefetch(a + i, b + i);
+						_mm_stream_pd(out + i, r);
+					} else {
+						_mm_storeu_pd(out + i, r);
+					}
+				}
+				kernel_scalar<Op>(a + i, b + i, out + i, n - i);
+				if (Stream) {
+					_mm_sfence();
+				}
+			}
+
+			template<class Op, bool Stream>
+			SMATH_TARGET("avx2") void kernel_avx2(const float *a, const float *b, float *out, std::size_t n) {
+				std::size_t i{ Stream ? stream_head(out, 32, n) : 0 };
+				kernel_scalar<Op>(a, b, out, i);
+				for (; i + 8 <= n; i += 8) {
+					const __m256 r{ Op::call(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i)) };
+					if (Stream) {
+						prefetch(a + i, b + i);
+						_mm256_stream_ps(out + i, r);
+					} else {
+						_mm256_storeu_ps(out + i, r);
+					}
+				}
+				kernel_scalar<Op>(a + i, b + i, out + i, n - i);
+				if (Stream) {
+					_mm_sfence();
+				}
+			}
+
+			template<class Op, bool Stream>
+			SMATH_TARGET("avx2") void kernel_avx2(const double *a, const double *b, double *out, std::size_t n) {
+				std::size_t i{ Stream ? stream_head(out, 32, n) : 0 };
+				kernel_scalar<Op>(a, b, out, i);
+				for (; i + 4 <= n; i += 4) {
+					const __m256d r{ Op::call(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i)) };
+					if (Stream) {
+						prefetch(a + i, b + i);
+						_mm256_stream_pd(out + i, r);
+					} else {
+						_mm256_storeu_pd(out + i, r);
+					}
+				}
+				kernel_scalar<Op>(a + i, b + i, out + i, n - i);
+				if (Stream) {
+					_mm_sfence();
+				}
+			}
+
+			template<class Op, bool Stream>
+			SMATH_TARGET("avx512f") void kernel_avx512(const float *a, const float *b, float *out, std::size_t n) {
+				std::size_t i{ Stream ? stream_head(out, 64, n) : 0 };
+				kernel_scalar<Op>(a, b, out, i);
+				for (; i + 16 <= n; i += 16) {
+					const __m512 r{ Op::call(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i)) };
+					if (Stream) {
+						prefetch(a + i, b + i);
+						_mm512_stream_ps(out + i, r);
+					} else {
+						_mm512_storeu_ps(out + i, r);
+					}
+				}
+				kernel_scalar<Op>(a + i, b + i, out + i, n - i);
+				if (Stream) {
+					_mm_sfence();
+				}
+			}
+
+			template<class Op, bool Stream>
+			SMATH_TARGET("avx512f") void kernel_avx512(const double *a, const double *b, double *out, std::size_t n) {
+				std::size_t i{ Stream ? stream_head(out, 64, n) : 0 };
+				kernel_scalar<Op>(a, b, out, i);
+				for (; i + 8 <= n; i += 8) {
+					const __m512d r{ Op::call(_mm512_loadu_pd(a + i), _mm512_loadu_pd(b + i)) };
+					if (Stream) {
+						prefetch(a + i, b + i);
+						_mm512_stream_pd(out + i, r);
+					} else {
+						_mm512_storeu_pd(out + i, r);
+					}
+				}
+				kernel_scalar<Op>(a + i, b + i, out + i, n - i);
+				if (Stream) {
+					_mm_sfence();
+				}
+			}
+#endif
+
+			// -- Dispatch --
+
+			/**
+			 * @brief Picks the kernel for the widest instruction set supported by
+			 * the host CPU.
+			 */
+			template<class Op, class T, bool Stream>
+			binary_kernel<T> resolve_kernel() {
+#if SMATH_HAS_CPU_DISPATCH
+				const cpu_info &cpu{ cpu_features() };
+				if (cpu.avx512f) {
+					return &kernel_avx512<Op, Stream>;
+				}
+				if (cpu.avx2) {
+					return &kernel_avx2<Op, Stream>;
+				}
+				if (cpu.sse2) {
+					return &kernel_sse2<Op, Stream>;
+				}
+#endif
+				return &kernel_scalar<Op, T>;
+			}
+
+			/**
+			 * @brief Resolves the kernel on the first call and reuses the cached
+			 * function pointer afterwards.
+			 */
+			template<class Op, class T>
+			SMATH_INLINE void dispatch(const T *a, const T *b, T *out, std::size_t n, store_mode mode) {
+				static const binary_kernel<T> regular{ resolve_kernel<Op, T, false>() };
+				static const binary_kernel<T> streaming{ resolve_kernel<Op, T, true>() };
+				(mode == store_mode::streaming ? streaming : regular)(a, b, out, n);
+			}
+
+			/**
+			 * @brief Views an array of vectors as the array of their components.
+			 */
+			template<length_t L, class T>
+			SMATH_INLINE const T* components(const vec<L, T> *v) {
+				SMATH_STATIC_ASSERT(sizeof(vec<L, T>) == sizeof(T) * static_cast<std::size_t>(L), "vector components must be tightly packed");
+				return reinterpret_cast<const T *>(v);
+			}
+
+			template<length_t L, class T>
+			SMATH_INLINE T* components(vec<L, T> *v) {
+				SMATH_STATIC_ASSERT(sizeof(vec<L, T>) == sizeof(T) * static_cast<std::size_t>(L), "vector components must be tightly packed");
+				return reinterpret_cast<T *>(v);
+			}
+
+		} // namespace detail
+
+		/**
+		 * @brief Adds two arrays element-wise, `out[i] = a[i] + b[i]`, using the
+		 * widest instruction set supported by the host CPU.
+		 */
+		SMATH_INLINE void add(const float *a, const float *b, float *out, std::size_t n, store_mode mode = store_mode::regular) {
+			detail::dispatch<detail::op_add>(a, b, out, n, mode);
+		}
+
+		/**
+		 * @brief Adds two arrays element-wise, `out[i] = a[i] + b[i]`, using the
+		 * widest instruction set supported by the host CPU.
+		 */
+		SMATH_INLINE void add(const double *a, const double *b, double *out, std::size_t n, store_mode mode = store_mode::regular) {
+			detail::dispatch<detail::op_add>(a, b, out, n, mode);
+		}
+
+		/**
+		 * @brief Subtracts two arrays element-wise, `out[i] = a[i] - b[i]`, using
+		 * the widest instruction set supported by the host CPU.
+		 */
+		SMATH_INLINE void sub(const float *a, const float *b, float *out, std::size_t n, store_mode mode = store_mode::regular) {
+			detail::dispatch<detail::op_sub>(a, b, out, n, mode);
+		}
+
+		/**
+		 * @brief Subtracts two arrays element-wise, `out[i] = a[i] - b[i]`, using
+		 * the widest instruction set supported by the host CPU.
+		 */
+		SMATH_INLINE void sub(const double *a, const double *b, double *out, std::size_t n, store_mode mode = store_mode::regular) {
+			detail::dispatch<detail::op_sub>(a, b, out, n, mode);
+		}
+
+		/**
+		 * @brief Multiplies two arrays element-wise, `out[i] = a[i] * b[i]`, using
+		 * the widest instruction set supported by the host CPU.
+		 */
+		SMATH_INLINE void mul(const float *a, const float *b, float *out, std::size_t n, store_mode mode = store_mode::regular) {
+			detail::dispatch<detail::op_mul>(a, b, out, n, mode);
+		}
+
+		/**
+		 * @brief Multiplies two arrays element-wise, `out[i] = a[i] * b[i]`, using
+		 * the widest instruction set supported by the host CPU.
+		 */
+		SMATH_INLINE void mul(const double *a, const double *b, double *out, std::size_t n, store_mode mode = store_mode::regular) {
+			detail::dispatch<detail::op_mul>(a, b, out, n, mode);
+		}
+
+		/**
+		 * @brief Divides two arrays element-wise, `out[i] = a[i] / b[i]`, using the
+		 * widest instruction set supported by the host CPU.
+		 */
+		SMATH_INLINE void div(const float *a, const float *b, float *out, std::size_t n, store_mode mode = store_mode::regular) {
+			detail::dispatch<detail::op_div>(a, b, out, n, mode);
+		}
+
+		/**
+		 * @brief Divides two arrays element-wise, `out[i] = a[i] / b[i]`, using the
+		 * widest instruction set supported by the host CPU.
+		 */
+		SMATH_INLINE void div(const double *a, const double *b, double *out, std::size_t n, store_mode mode = store_mode::regular) {
+			detail::dispatch<detail::op_div>(a, b, out, n, mode);
+		}
+
+		// -- Vectors --
+
+		/**
+		 * @brief Adds two arrays of vectors component-wise, `out[i] = a[i] + b[i]`.
+		 * @tparam L The number of components in the vector in range [1, 4]
+		 * @tparam T The type of the vector (float, double)
+		 */
+		template<length_t L, class T>
+		SMATH_INLINE void add(const vec<L, T> *a, const vec<L, T> *b, vec<L, T> *out, std::size_t n, store_mode mode = store_mode::regular) {
+			add(detail::components(a), detail::components(b), detail::components(out), n * static_cast<std::size_t>(L), mode);
+		}
+
+		/**
+		 * @brief Subtracts two arrays of vectors component-wise, `out[i] = a[i] - b[i]`.
+		 * @tparam L The number of components in the vector in range [1, 4]
+		 * @tparam T The type of the vector (float, double)
+		 */
+		template<length_t L, class T>
+		SMATH_INLINE void sub(const vec<L, T> *a, const vec<L, T> *b, vec<L, T> *out, std::size_t n, store_mode mode = store_mode::regular) {
+			sub(detail::components(a), detail::components(b), detail::components(out), n * static_cast<std::size_t>(L), mode);
+		}
+
+		/**
+		 * @brief Multiplies two arrays of vectors component-wise, `out[i] = a[i] * b[i]`.
+		 * @tparam L The number of components in the vector in range [1, 4]
+		 * @tparam T The type of the vector (float, double)
+		 */
+		template<length_t L, class T>
+		SMATH_INLINE void mul(const vec<L, T> *a, const vec<L, T> *b, vec<L, T> *out, std::size_t n, store_mode mode = store_mode::regular) {
+			mul(detail::components(a), detail::components(b), detail::components(out), n * static_cast<std::size_t>(L), mode);
+		}
+
+		/**
+		 * @brief Divides two arrays of vectors component-wise, `out[i] = a[i] / b[i]`.
+		 * @tparam L The number of components in the vector in range [1, 4]
+		 * @tparam T The type of the vector (float, double)
+		 */
+		template<length_t L, class T>
+		SMATH_INLINE void div(const vec<L, T> *a, const vec<L, T> *b, vec<L, T> *out, std::size_t n, store_mode mode = store_mode::regular) {
+			div(detail::components(a), detail::components(b), detail::components(out), n * static_cast<std::size_t>(L), mode);
+		}
+
+	} // namespace batch
+
+} // namespace smath
+
+#endif // BATCH_H
@@ -0,0 +1,522 @@
+#pragma once
+
+#ifndef BITS_H
+#define BITS_H
+
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+
+#include "detail/setup.hpp"
+#include "detail/function.hpp"
+
+#include "simd/simd.hpp"
+#include "span.hpp"
+#include "vec.hpp"
+
+namespace smath {
+
+	// Every function works on the 32 bits of an int, so negative values count
+	// their sign bit.
+
+	namespace detail {
+
+		// -- Scalar --
+
+		SMATH_INLINE SMATH_CONSTEXPR int popcount_scalar(unsigned x) {
+#if (SMATH_COMPILER & SMATH_COMPILER_GCC) || (SMATH_COMPILER & SMATH_COMPILER_CLANG)
+			// a single popcnt when the target has it (e.g. -mpopcnt)
+			return __builtin_popcount(x);
+#else
+			x = x - ((x >> 1) & 0x55555555u);
+			x = (x & 0x33333333u) + ((x >> 2) & 0x33333333u);
+			x = (x + (x >> 4)) & 0x0F0F0F0Fu;
+			return static_cast<int>((x * 0x01010101u) >> 24);
+#endif
+		}
+
+		SMATH_INLINE SMATH_CONSTEXPR int clz_scalar(unsigned x) {
+#if (SMATH_COMPILER & SMATH_COMPILER_GCC) || (SMATH_COMPILER & SMATH_COMPILER_CLANG)
+			// a single lzcnt when the target has it (e.g. -mlzcnt)
+			return x == 0 ? 32 : __builtin_clz(x);
+#else
+			x |= x >> 1;
+			x |= x >> 2;
+			x |= x >> 4;
+			x |= x >> 8;
+			x |= x >> 16;
+			return 32 - popcount_scalar(x);
+#endif
+		}
+
+		SMATH_INLINE SMATH_CONSTEXPR int ctz_scalar(unsigned x) {
+#if (SMATH_COMPILER & SMATH_COMPILER_GCC) || (SMATH_COMPILER & SMATH_COMPILER_CLANG)
+			return x == 0 ? 32 : __builtin_ctz(x);
+#else
+			return popcount_scalar((x & (0u - x)) - 1u);
+#endif
+		}
+
+		SMATH_INLINE SMATH_CONSTEXPR unsigned bit_reverse_scalar(unsigned x) {
+			x = ((x >> 1) & 0x55555555u) | ((x & 0x55555555u) << 1);
+			x = ((x >> 2) & 0x33333333u) | ((x & 0x33333333u) << 2);
+			x = ((x >> 4) & 0x0F0F0F0Fu) | ((x & 0x0F0F0F0Fu) << 4);
+			x = ((x >> 8) & 0x00FF00FFu) | ((x & 0x00FF00FFu) << 8);
+			return (x >> 16) | (x << 16);
+		}
+
+		// The Morton code helpers spread the low bits of a value to every second
+		// (or third) bit and gather them back. With BMI2 (e.g. -mbmi2) that is
+		// one pdep or pext, otherwise a few shifts and masks.
+
+		SMATH_INLINE SMATH_CONSTEXPR unsigned spread2_scalar(unsigned x) {
+#if (SMATH_ARCH & SMATH_ARCH_SSE2_BIT) && defined(__BMI2__)
+			if (!SMATH_IS_CONSTANT_EVALUATED()) {
+				return _pdep_u32(x, 0x55555555u);
+			}
+#endif
+			x &= 0x0000FFFFu;
+			x = (x | (x << 8)) & 0x00FF00FFu;
+			x = (x | (x << 4)) & 0x0F0F0F0Fu;
+			x = (x | (x << 2)) & 0x33333333u;
+			return (x | (x << 1)) & 0x55555555u;
+		}
+
+		SMATH_INLINE SMATH_CONSTEXPR unsigned gather2_scalar(unsigned x) {
+#if (SMATH_ARCH & SMATH_ARCH_SSE2_BIT) && defined(__BMI2__)
+			if (!SMATH_IS_CONSTANT_EVALUATED()) {
+				return _pext_u32(x, 0x55555555u);
+			}
+#endif
+			x &= 0x55555555u;
+			x = (x | (x >> 1)) & 0x33333333u;
+			x = (x | (x >> 2)) & 0x0F0F0F0Fu;
+			x = (x | (x >> 4)) & 0x00FF00FFu;
+			return (x | (x >> 8)) & 0x0000FFFFu;
+		}
+
+		SMATH_INLINE SMATH_CONSTEXPR unsigned spread3_scalar(unsigned x) {
+#if (SMATH_ARCH & SMATH_ARCH_SSE2_BIT) && defined(__BMI2__)
+			if (!SMATH_IS_CONSTANT_EVALUATED()) {
+				return _pdep_u32(x, 0x09249249u);
+			}
+#endif
+			x &= 0x000003FFu;
+			x = (x | (x << 16)) & 0xFF0000FFu;
+			x = (x | (x << 8)) & 0x0300F00Fu;
+			x = (x | (x << 4)) & 0x030C30C3u;
+			return (x | (x << 2)) & 0x09249249u;
+		}
+
+		SMATH_INLINE SMATH_CONSTEXPR unsigned gather3_scalar(unsigned x) {
+#if (SMATH_ARCH & SMATH_ARCH_SSE2_BIT) && defined(__BMI2__)
+			if (!SMATH_IS_CONSTANT_EVALUATED()) {
+				return _pext_u32(x, 0x09249249u);
+			}
+#endif
+			x &= 0x09249249u;
+			x = (x | (x >> 2)) & 0x030C30C3u;
+			x = (x | (x >> 4)) & 0x0300F00Fu;
+			x = (x | (x >> 8)) & 0xFF0000FFu;
+			return (x | (x >> 16)) & 0x000003FFu;
+		}
+
+		SMATH_INLINE SMATH_CONSTEXPR vec<2, int> morton_decode_scalar(unsigned code, std::integral_constant<length_t, 2>) {
+			return vec<2, int>(static_cast<int>(gather2_scalar(code)), static_cast<int>(gather2_scalar(code >> 1)));
+		}
+
+		SMATH_INLINE SMATH_CONSTEXPR vec<3, int> morton_decode_scalar(unsigned code, std::integral_constant<length_t, 3>) {
+			return vec<3, int>(static_cast<int>(gather3_scalar(code)), static_cast<int>(gather3_scalar(code >> 1)), static_cast<int>(gather3_scalar(code >> 2)));
+		}
+
+		// -- Batch --
+
+		// The batches only shift arithmetically, so every right shift is
+		// followed by a mask or only ever sees non-negative lanes.
+
+		/**
+		 * @brief Counts the set bits of every lane with shifts and adds, as
+		 * the integer multiply is slow without SSE4.1.
+		 */
+		template<class B>
+		SMATH_INLINE B popcount_batch(B x) {
+			x = x - ((x >> 1) & B(0x55555555));
+			x = (x & B(0x33333333)) + ((x >> 2) & B(0x33333333));
+			x = (x + (x >> 4)) & B(0x0F0F0F0F);
+			x = x + (x >> 8);
+			x = x + (x >> 16);
+			return x & B(0x3F);
+		}
+
+		// AVX-512 counts the bits of every lane in one instruction, and with VL
+		// also those of the vec4i batches
+#if (SMATH_ARCH & SMATH_ARCH_AVX512_BIT) && defined(__AVX512VPOPCNTDQ__)
+		SMATH_INLINE simd::i32x16 popcount_batch(simd::i32x16 x) {
+			return simd::i32x16(_mm512_popcnt_epi32(x.data));
+		}
+#	if defined(__AVX512VL__)
+		SMATH_INLINE simd::i32x4 popcount_batch(simd::i32x4 x) {
+			return simd::i32x4(_mm_popcnt_epi32(x.data));
+		}
+#	endif
+#endif
+
+		/**
+		 * @brief Sets every bit below the highest set bit of every lane. Negative
+		 * lanes become all ones, as their highest bit is already set.
+		 */
+		template<class B>
+		SMATH_INLINE B smear_right(B x) {
+			x = x | (x >> 1);
+			x = x | (x >> 2);
+			x = x | (x >> 4);
+			x = x | (x >> 8);
+			return x | (x >> 16);
+		}
+
+		template<class B>
+		SMATH_INLINE B clz_batch(const B &x) {
+			return B(32) - popcount_batch(smear_right(x));
+		}
+
+#if (SMATH_ARCH & SMATH_ARCH_AVX512_BIT) && defined(__AVX512CD__)
+		SMATH_INLINE simd::i32x16 clz_batch(const simd::i32x16 &x) {
+			return simd::i32x16(_mm512_lzcnt_epi32(x.data));
+		}
+#	if defined(__AVX512VL__)
+		SMATH_INLINE simd::i32x4 clz_batch(const simd::i32x4 &x) {
+			return simd::i32x4(_mm_lzcnt_epi32(x.data));
+		}
+#	endif
+#endif
+
+		template<class B>
+		SMATH_INLINE B ctz_batch(const B &x) {
+			// the bits below the lowest set bit, or all of them for 0
+			return popcount_batch((x & -x) - B(1));
+		}
+
+		template<class B>
+		SMATH_INLINE B ilog2_batch(const B &x) {
+			return B(31) - clz_batch(x);
+		}
+
+		template<class B>
+		SMATH_INLINE B next_pow2_batch(const B &x) {
+			return smear_right(max(x, B(1)) - B(1)) + B(1);
+		}
+
+		template<class B>
+		SMATH_INLINE B bit_reverse_batch(B x) {
+			x = ((x >> 1) & B(0x55555555)) | ((x & B(0x55555555)) << 1);
+			x = ((x >> 2) & B(0x33333333)) | ((x & B(0x33333333)) << 2);
+			x = ((x >> 4) & B(0x0F0F0F0F)) | ((x & B(0x0F0F0F0F)) << 4);
+			x = ((x >> 8) & B(0x00FF00FF)) | ((x & B(0x00FF00FF)) << 8);
+			return ((x >> 16) & B(0xFFFF)) | (x << 16);
+		}
+
+		/**
+		 * @brief Runs a function over full native int batches and the scalar
+		 * version over the remaining elements.
+		 */
+		template<class FB, class FS>
+		SMATH_INLINE void apply_bits_span(span<const int> in, span<int> out, FB batch_op, FS scalar_op) {
+			assert(in.size() == out.size());
+
+			using B = simd::native<int>;
+			const std::size_t width{ static_cast<std::size_t>(B::size()) };
+			const std::size_t n{ in.size() };
+
+			std::size_t i{ 0 };
+			for (; i + width <= n; i += width) {
+				batch_op(B::loadu(in.data() + i)).storeu(out.data() + i);
+			}
+			for (; i < n; ++i) {
+				out[i] = scalar_op(in[i]);
+			}
+		}
+
+		/**
+		 * @brief Template class to run a bit function on every component of a
+		 * vector. The four components of a vec4i fill one SIMD batch, so they
+		 * go through the batch kernels instead.
+		 * @tparam L The number of components of the vector.
+		 */
+		template<length_t L>
+		struct compute_bits {
+			template<class FB, class FS>
+			SMATH_CONSTEXPR static vec<L, int> call(const vec<L, int> &v, FB, FS scalar_op) {
+				return function::map(scalar_op, v);
+			}
+		};
+
+		template<>
+		struct compute_bits<4> {
+			template<class FB, class FS>
+			SMATH_CONSTEXPR static vec<4, int> call(const vec<4, int> &v, FB batch_op, FS scalar_op) {
+				if (SMATH_IS_CONSTANT_EVALUATED()) {
+					return function::map(scalar_op, v);
+				}
+				vec<4, int> r{ 0 };
+				batch_op(simd::batch<int, 4>::loadu(&v.x)).storeu(&r.x);
+				return r;
+			}
+		};
+
+	} // namespace detail
+
+	// -- Scalar --
+
+	/**
+	 * @brief Counts the set bits of an integer.
+	 */
+	SMATH_INLINE SMATH_CONSTEXPR int popcount(int x) {
+		return detail::popcount_scalar(static_cast<unsigned>(x));
+	}
+
+	/**
+	 * @brief Counts the zero bits above the highest set bit.
+	 * @returns A count in range [0, 32], which is 32 for 0.
+	 */
+	SMATH_INLINE SMATH_CONSTEXPR int clz(int x) {
+		return detail::clz_scalar(static_cast<unsigned>(x));
+	}
+
+	/**
+	 * @brief Counts the zero bits below the lowest set bit.
+	 * @returns A count in range [0, 32], which is 32 for 0.
+	 */
+	SMATH_INLINE SMATH_CONSTEXPR int ctz(int x) {
+		return detail::ctz_scalar(static_cast<unsigned>(x));
+	}
+
+	/**
+	 * @brief Calculates the base 2 logarithm rounded down, which is the index
+	 * of the highest set bit, e.g. the number of mip levels below a size.
+	 * @returns The logarithm for `x` > 0, or -1 for 0.
+	 */
+	SMATH_INLINE SMATH_CONSTEXPR int ilog2(int x) {
+		return 31 - smath::clz(x);
+	}
+
+	/**
+	 * @brief Rounds up to a power of two.
+	 * @returns The smallest power of two not less than `x`, which is 1 for
+	 * `x` <= 1. Values above 2^30 have no result that fits in an int.
+	 */
+	SMATH_INLINE SMATH_CONSTEXPR int next_pow2(int x) {
+		return x <= 1 ? 1 : static_cast<int>(1u << (32 - smath::clz(x - 1)));
+	}
+
+	/**
+	 * @returns True if `x` is a positive power of two.
+	 */
+	SMATH_INLINE SMATH_CONSTEXPR bool is_pow2(int x) {
+		return x > 0 && (x & (x - 1)) == 0;
+	}
+
+	/**
+	 * @brief Reverses the order of the 32 bits of an integer.
+	 */
+	SMATH_INLINE SMATH_CONSTEXPR int bit_reverse(int x) {
+		return static_cast<int>(detail::bit_reverse_scalar(static_cast<unsigned>(x)));
+	}
+
+	/**
+	 * @brief Interleaves the low 16 bits of the components into a Morton
+	 * (Z-order) code, with the bits of `x` in the even positions, so nearby
+	 * points in 2D get nearby codes.
+	 */
+	SMATH_INLINE SMATH_CONSTEXPR int morton_encode(const vec<2, int> &v) {
+		return static_cast<int>(detail::spread2_scalar(static_cast<unsigned>(v.x)) | (detail::spread2_scalar(static_cast<unsigned>(v.y)) << 1));
+	}
+
+	/**
+	 * @brief Interleaves the low 10 bits of the components into a 3D Morton
+	 * code, with `x`, `y` and `z` in bits 0, 1 and 2 of every group of three.
+	 */
+	SMATH_INLINE SMATH_CONSTEXPR int morton_encode(const vec<3, int> &v) {
+		return static_cast<int>(detail::spread3_scalar(static_cast<unsigned>(v.x))
+			| (detail::spread3_scalar(static_cast<unsigned>(v.y)) << 1)
+			| (detail::spread3_scalar(static_cast<unsigned>(v.z)) << 2));
+	}
+
+	/**
+	 * @brief Splits a Morton code back into the components given to
+	 * smath::morton_encode, e.g. `smath::morton_decode<2>(code)`.
+	 * @tparam L The number of components of the code (2, 3)
+	 * @returns The non-negative components, of 16 bits in 2D and 10 bits in 3D.
+	 */
+	template<length_t L>
+	SMATH_INLINE SMATH_CONSTEXPR vec<L, int> morton_decode(int code) {
+		SMATH_STATIC_ASSERT(L == 2 || L == 3, "'morton_decode' only works on 2 or 3 components");
+		return detail::morton_decode_scalar(static_cast<unsigned>(code), std::integral_constant<length_t, L>());
+	}
+
+	// -- Vector --
+
+	/**
+	 * @brief Counts the set bits of each component.
+	 * @tparam L The number of components in the vector in range [1, 4]
+	 */
+	template<length_t L>
+	SMATH_INLINE SMATH_CONSTEXPR vec<L, int> popcount(const vec<L, int> &v) {
+		return detail::compute_bits<L>::call(v,
+			[](const simd::batch<int, 4> &b) { return detail::popcount_batch(b); },
+			[](int x) { return smath::popcount(x); });
+	}
+
+	/**
+	 * @brief Counts the zero bits above the highest set bit of each component.
+	 * @tparam L The number of components in the vector in range [1, 4]
+	 */
+	template<length_t L>
+	SMATH_INLINE SMATH_CONSTEXPR vec<L, int> clz(const vec<L, int> &v) {
+		return detail::compute_bits<L>::call(v,
+			[](const simd::batch<int, 4> &b) { return detail::clz_batch(b); },
+			[](int x) { return smath::clz(x); });
+	}
+
+	/**
+	 * @brief Counts the zero bits below the lowest set bit of each component.
+	 * @tparam L The number of components in the vector in range [1, 4]
+	 */
+	template<length_t L>
+	SMATH_INLINE SMATH_CONSTEXPR vec<L, int> ctz(const vec<L, int> &v) {
+		return detail::compute_bits<L>::call(v,
+			[](const simd::batch<int, 4> &b) { return detail::ctz_batch(b); },
+			[](int x) { return smath::ctz(x); });
+	}
+
+	/**
+	 * @brief Calculates the base 2 logarithm of each component rounded down.
+	 * @tparam L The number of components in the vector in range [1, 4]
+	 */
+	template<length_t L>
+	SMATH_INLINE SMATH_CONSTEXPR vec<L, int> ilog2(const vec<L, int> &v) {
+		return detail::compute_bits<L>::call(v,
+			[](const simd::batch<int, 4> &b) { return detail::ilog2_batch(b); },
+			[](int x) { return smath::ilog2(x); });
+	}
+
+	/**
+	 * @brief Rounds each component up to a power of two.
+	 * @tparam L The number of components in the vector in range [1, 4]
+	 */
+	template<length_t L>
+	SMATH_INLINE SMATH_CONSTEXPR vec<L, int> next_pow2(const vec<L, int> &v) {
+		return detail::compute_bits<L>::call(v,
+			[](const simd::batch<int, 4> &b) { return detail::next_pow2_batch(b); },
+			[](int x) { return smath::next_pow2(x); });
+	}
+
+	/**
+	 * @brief Checks whether each component is a positive power of two.
+	 * @tparam L The number of components in the vector in range [1, 4]
+	 */
+	template<length_t L>
+	SMATH_INLINE SMATH_CONSTEXPR vec<L, bool> is_pow2(const vec<L, int> &v) {
+		return function::map([](int x) { return smath::is_pow2(x); }, v);
+	}
+
+	/**
+	 * @brief Reverses the order of the bits of each component.
+	 * @tparam L The number of components in the vector in range [1, 4]
+	 */
+	template<length_t L>
+	SMATH_INLINE SMATH_CONSTEXPR vec<L, int> bit_reverse(const vec<L, int> &v) {
+		return detail::compute_bits<L>::call(v,
+			[](const simd::batch<int, 4> &b) { return detail::bit_reverse_batch(b); },
+			[](int x) { return smath::bit_reverse(x); });
+	}
+
+	// -- Batch --
+
+	/**
+	 * @brief Counts the set bits of every element of a range.
+	 * @param out The output range, of the same size as `in`, which may be `in`.
+	 */
+	SMATH_INLINE void popcount(span<const int> in, span<int> out) {
+		detail::apply_bits_span(in, out,
+			[](const simd::native<int> &b) { return detail::popcount_batch(b); },
+			[](int x) { return smath::popcount(x); });
+	}
+
+	template<length_t L>
+	SMATH_INLINE void popcount(typename detail::identity<span<const vec<L, int>>>::type in, span<vec<L, int>> out) {
+		smath::popcount(detail::component_span(in), detail::component_span(out));
+	}
+
+	/**
+	 * @brief Counts the zero bits above the highest set bit of every element.
+	 */
+	SMATH_INLINE void clz(span<const int> in, span<int> out) {
+		detail::apply_bits_span(in, out,
+			[](const simd::native<int> &b) { return detail::clz_batch(b); },
+			[](int x) { return smath::clz(x); });
+	}
+
+	template<length_t L>
+	SMATH_INLINE void clz(typename detail::identity<span<const vec<L, int>>>::type in, span<vec<L, int>> out) {
+		smath::clz(detail::component_span(in), detail::component_span(out));
+	}
+
+	/**
+	 * @brief Counts the zero bits below the lowest set bit of every element.
+	 */
+	SMATH_INLINE void ctz(span<const int> in, span<int> out) {
+		detail::apply_bits_span(in, out,
+			[](const simd::native<int> &b) { return detail::ctz_batch(b); },
+			[](int x) { return smath::ctz(x); });
+	}
+
+	template<length_t L>
+	SMATH_INLINE void ctz(typename detail::identity<span<const vec<L, int>>>::type in, span<vec<L, int>> out) {
+		smath::ctz(detail::component_span(in), detail::component_span(out));
+	}
+
+	/**
+	 * @brief Calculates the base 2 logarithm of every element rounded down.
+	 */
+	SMATH_INLINE void ilog2(span<const int> in, span<int> out) {
+		detail::apply_bits_span(in, out,
+			[](const simd::native<int> &b) { return detail::ilog2_batch(b); },
+			[](int x) { return smath::ilog2(x); });
+	}
+
+	template<length_t L>
+	SMATH_INLINE void ilog2(typename detail::identity<span<const vec<L, int>>>::type in, span<vec<L, int>> out) {
+		smath::ilog2(detail::component_span(in), detail::component_span(out));
+	}
+
+	/**
+	 * @brief Rounds every element up to a power of two.
+	 */
+	SMATH_INLINE void next_pow2(span<const int> in, span<int> out) {
+		detail::apply_bits_span(in, out,
+			[](const simd::native<int> &b) { return detail::next_pow2_batch(b); },
+			[](int x) { return smath::next_pow2(x); });
+	}
+
+	template<length_t L>
+	SMATH_INLINE void next_pow2(typename detail::identity<span<const vec<L, int>>>::type in, span<vec<L, int>> out) {
+		smath::next_pow2(detail::component_span(in), detail::component_span(out));
+	}
+
+	/**
+	 * @brief Reverses the order of the bits of every element.
+	 */
+	SMATH_INLINE void bit_reverse(span<const int> in, span<int> out) {
+		detail::apply_bits_span(in, out,
+			[](const simd::native<int> &b) { return detail::bit_reverse_batch(b); },
+			[](int x) { return smath::bit_reverse(x); });
+	}
+
+	template<length_t L>
+	SMATH_INLINE void bit_reverse(typename detail::identity<span<const vec<L, int>>>::type in, span<vec<L, int>> out) {
+		smath::bit_reverse(detail::component_span(in), detail::component_span(out));
+	}
+
+} // namespace smath
+
+#endif // BITS_H
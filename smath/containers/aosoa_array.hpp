@@ -0,0 +1,255 @@
+#pragma once
+
+#ifndef CONTAINERS_AOSOA_ARRAY_H
+#define CONTAINERS_AOSOA_ARRAY_H
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "../detail/setup.hpp"
+
+#include "../memory.hpp"
+#include "../simd/simd.hpp"
+#include "../template_types.hpp"
+#include "../vec.hpp"
+
+namespace smath {
+
+	namespace detail {
+
+		/**
+		 * @brief The default number of lanes of an aosoa_array block, which is the
+		 * width of the widest native batch but at least 4.
+		 */
+		template<class T>
+		struct aosoa_default_width {
+			static const length_t value = simd::native<T>::size() > 4 ? simd::native<T>::size() : 4;
+		};
+
+	} // namespace detail
+
+	/**
+	 * Block of `W` vectors stored as one run of `W` lanes per component, so each
+	 * component of the block loads into a single SIMD batch.
+	 * @tparam L The number of components of each vector, in range [1, 4]
+	 * @tparam T The type of the components (int, float, double)
+	 * @tparam W The number of vectors in the block (4, 8 or 16)
+	 */
+	template<length_t L, class T, length_t W>
+	struct alignas(sizeof(T) * W) aosoa_block {
+		using batch_type = simd::batch<T, W>;
+
+		T lanes[static_cast<std::size_t>(L)][static_cast<std::size_t>(W)];
+
+		/**
+		 * @returns The number of vectors in the block.
+		 */
+		static SMATH_CONSTEXPR length_t size() {
+			return W;
+		}
+
+		// -- Component accesses --
+
+		T* data(length_t c) {
+			return lanes[c];
+		}
+
+		const T* data(length_t c) const {
+			return lanes[c];
+		}
+
+		/**
+		 * @returns Component `c` of every vector in the block as one batch.
+		 */
+		batch_type load(length_t c) const {
+			return batch_type::load(lanes[c]);
+		}
+
+		/**
+		 * @brief Stores a batch into component `c` of every vector in the block.
+		 */
+		void store(length_t c, const batch_type &b) {
+			b.store(lanes[c]);
+		}
+
+		// -- Element accesses --
+
+		vec<L, T> get(length_t i) const {
+			vec<L, T> result;
+			for (length_t c = 0; c < L; ++c) {
+				result[c] = lanes[c][i];
+			}
+			return result;
+		}
+
+		void set(length_t i, const vec<L, T> &v) {
+			for (length_t c = 0; c < L; ++c) {
+				lanes[c][i] = v[c];
+			}
+		}
+	};
+
+	/**
+	 * Array-of-structure-of-arrays container of vectors, storing the vectors in
+	 * blocks of `W` with the components of each block in separate runs.
+	 *
+	 * Streaming over the blocks feeds SIMD kernels one batch per component,
+	 * while all the components of an element stay within the same block. The
+	 * last block is padded with zero vectors.
+	 *
+	 * @tparam L The number of components of each vector, in range [1, 4]
+	 * @tparam T The type of the components (int, float, double)
+	 * @tparam W The number of vectors per block (4, 8 or 16), defaulting to the
+	 * widest native SIMD width
+	 * @tparam Allocator The allocator of the blocks, rebound from `T`
+	 */
+	template<length_t L, class T, length_t W = detail::aosoa_default_width<T>::value, class Allocator = aligned_allocator<T>>
+	class aosoa_array {
+	public:
+
+		using value_type = vec<L, T>;
+		using block_type = aosoa_block<L, T, W>;
+		using allocator_type = typename std::allocator_traits<Allocator>::template rebind_alloc<block_type>;
+		using batch_type = typename block_type::batch_type;
+		using size_type = std::size_t;
+		using block_iterator = block_type *;
+		using const_block_iterator = const block_type *;
+
+		// -- Constructors --
+
+		aosoa_array() = default;
+
+		/**
+		 * @brief Creates an array of `n` copies of `value`.
+		 */
+		explicit aosoa_array(size_type n, const vec<L, T> &value = vec<L, T>()) {
+			resize(n, value);
+		}
+
+		explicit aosoa_array(const Allocator &alloc)
+			: m_blocks(allocator_type(alloc))
+		{}
+
+		aosoa_array(size_type n, const vec<L, T> &value, const Allocator &alloc)
+			: m_blocks(allocator_type(alloc))
+		{
+			resize(n, value);
+		}
+
+		// -- Capacity --
+
+		/**
+		 * @returns The number of vectors in each block.
+		 */
+		static SMATH_CONSTEXPR length_t block_size() {
+			return W;
+		}
+
+		size_type size() const {
+			return m_size;
+		}
+
+		bool empty() const {
+			return m_size == 0;
+		}
+
+		size_type block_count() const {
+			return m_blocks.size();
+		}
+
+		void reserve(size_type n) {
+			m_blocks.reserve(blocks_for(n));
+		}
+
+		/**
+		 * @brief Changes the number of vectors, filling new vectors with `value`.
+		 */
+		void resize(size_type n, const vec<L, T> &value = vec<L, T>()) {
+			// clear the padding of the last block before shrinking into it
+			for (size_type i = n; i < m_size && i < blocks_for(n) * width(); ++i) {
+				set(i, vec<L, T>());
+			}
+
+			m_blocks.resize(blocks_for(n), block_type{});
+			for (size_type i = m_size; i < n; ++i) {
+				set(i, value);
+			}
+			m_size = n;
+		}
+
+		void clear() {
+			m_blocks.clear();
+			m_size = 0;
+		}
+
+		void push_back(const vec<L, T> &value) {
+			resize(m_size + 1, value);
+		}
+
+		// -- Element accesses --
+
+		/**
+		 * @returns A copy of the vector at index `i`.
+		 */
+		vec<L, T> operator[](size_type i) const {
+			return get(i);
+		}
+
+		vec<L, T> get(size_type i) const {
+			assert(i < m_size);
+			return m_blocks[i / width()].get(static_cast<length_t>(i % width()));
+		}
+
+		void set(size_type i, const vec<L, T> &v) {
+			assert(i < m_blocks.size() * width());
+			m_blocks[i / width()].set(static_cast<length_t>(i % width()), v);
+		}
+
+		// -- Block accesses --
+
+		block_type& block(size_type b) {
+			return m_blocks[b];
+		}
+
+		const block_type& block(size_type b) const {
+			return m_blocks[b];
+		}
+
+		block_iterator block_begin() {
+			return m_blocks.data();
+		}
+
+		block_iterator block_end() {
+			return m_blocks.data() + m_blocks.size();
+		}
+
+		const_block_iterator block_begin() const {
+			return m_blocks.data();
+		}
+
+		const_block_iterator block_end() const {
+			return m_blocks.data() + m_blocks.size();
+		}
+
+	private:
+
+		std::vector<block_type, allocator_type> m_blocks;
+		size_type m_size{ 0 };
+
+		static SMATH_CONSTEXPR size_type width() {
+			return static_cast<size_type>(W);
+		}
+
+		static SMATH_CONSTEXPR size_type blocks_for(size_type n) {
+			return (n + width() - 1) / width();
+		}
+
+		SMATH_STATIC_ASSERT(smath::is_valid_vector(L), "'aosoa_array' only works on vectors with 1 to 4 components");
+		SMATH_STATIC_ASSERT(smath::is_integer_type<T>::value || smath::is_floating_type<T>::value, "'aosoa_array' only accepts integer or floating-point components");
+		SMATH_STATIC_ASSERT(W == 4 || W == 8 || W == 16, "'aosoa_array' only supports blocks of 4, 8 or 16 vectors");
+	};
+
+} // namespace smath
+
+#endif // CONTAINERS_AOSOA_ARRAY_H
@@ -0,0 +1,1082 @@
+#pragma once
+
+#ifndef CONTAINERS_SOA_ARRAY_H
+#define CONTAINERS_SOA_ARRAY_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <utility>
+
+#include "../detail/setup.hpp"
+
+#include "../exponential.hpp"
+#include "../math.hpp"
+#include "../memory.hpp"
+#include "../simd/simd.hpp"
+#include "../template_types.hpp"
+#include "../vec.hpp"
+
+#include "soa_expression.hpp"
+
+namespace smath {
+
+	namespace detail {
+
+		/**
+		 * @brief Operators shared by the element proxies of every length, which
+		 * read the element as a vector and write the result back.
+		 * @tparam Derived The proxy type, soa_ref<L, T>
+		 * @tparam L The number of components of the element.
+		 * @tparam T The type of the components.
+		 */
+		template<class Derived, length_t L, class T>
+		struct soa_ref_base {
+
+			// -- Unary arithmetic operators --
+
+			Derived& operator+=(const vec<L, T> &v) {
+				Derived &self{ static_cast<Derived &>(*this) };
+				return self = static_cast<vec<L, T>>(self) + v;
+			}
+
+			Derived& operator+=(T scalar) {
+				Derived &self{ static_cast<Derived &>(*this) };
+				return self = static_cast<vec<L, T>>(self) + scalar;
+			}
+
+			Derived& operator-=(const vec<L, T> &v) {
+				Derived &self{ static_cast<Derived &>(*this) };
+				return self = static_cast<vec<L, T>>(self) - v;
+			}
+
+			Derived& operator-=(T scalar) {
+				Derived &self{ static_cast<Derived &>(*this) };
+				return self = static_cast<vec<L, T>>(self) - scalar;
+			}
+
+			Derived& operator*=(const vec<L, T> &v) {
+				Derived &self{ static_cast<Derived &>(*this) };
+				return self = static_cast<vec<L, T>>(self) * v;
+			}
+
+			Derived& operator*=(T scalar) {
+				Derived &self{ static_cast<Derived &>(*this) };
+				return self = static_cast<vec<L, T>>(self) * scalar;
+			}
+
+			Derived& operator/=(const vec<L, T> &v) {
+				Derived &self{ static_cast<Derived &>(*this) };
+				return self = static_cast<vec<L, T>>(self) / v;
+			}
+
+			Derived& operator/=(T scalar) {
+				Derived &self{ static_cast<Derived &>(*this) };
+				return self = static_cast<vec<L, T>>(self) / scalar;
+			}
+
+			// -- Binary arithmetic operators --
+
+			// Hidden friends taking vectors, so proxies and vectors can be mixed
+			// through the implicit conversion of the proxy.
+
+			friend vec<L, T> operator+(const vec<L, T> &a, const vec<L, T> &b) {
+				return a + b;
+			}
+
+			friend vec<L, T> operator+(const vec<L, T> &a, T scalar) {
+				return a + scalar;
+			}
+
+			friend vec<L, T> operator+(T scalar, const vec<L, T> &a) {
+				return scalar + a;
+			}
+
+			friend vec<L, T> operator-(const vec<L, T> &a, const vec<L, T> &b) {
+				return a - b;
+			}
+
+			friend vec<L, T> operator-(const vec<L, T> &a, T scalar) {
+				return a - scalar;
+			}
+
+			friend vec<L, T> operator-(T scalar, const vec<L, T> &a) {
+				return scalar - a;
+			}
+
+			friend vec<L, T> operator*(const vec<L, T> &a, const vec<L, T> &b) {
+				return a * b;
+			}
+
+			friend vec<L, T> operator*(const vec<L, T> &a, T scalar) {
+				return a * scalar;
+			}
+
+			friend vec<L, T> operator*(T scalar, const vec<L, T> &a) {
+				return scalar * a;
+			}
+
+			friend vec<L, T> operator/(const vec<L, T> &a, const vec<L, T> &b) {
+				return a / b;
+			}
+
+			friend vec<L, T> operator/(const vec<L, T> &a, T scalar) {
+				return a / scalar;
+			}
+
+			friend vec<L, T> operator/(T scalar, const vec<L, T> &a) {
+				return scalar / a;
+			}
+
+			// -- Boolean operators --
+
+			friend bool operator==(const vec<L, T> &a, const vec<L, T> &b) {
+				return a == b;
+			}
+
+			friend bool operator!=(const vec<L, T> &a, const vec<L, T> &b) {
+				return a != b;
+			}
+		};
+
+	} // namespace detail
+
+	/**
+	 * Reference to one element of a soa_array, with references to its x, y, z
+	 * and w components in the separate streams. Behaves like a vec<L, T>,
+	 * converting to one and writing assignments back to the array.
+	 * @tparam L The number of components of the element, in range [1, 4]
+	 * @tparam T The type of the components (int, float, double)
+	 */
+	template<length_t L, class T>
+	struct soa_ref;
+
+	template<class T>
+	struct soa_ref<1, T> : detail::soa_ref_base<soa_ref<1, T>, 1, T> {
+
+		// -- Components --
+
+		T &x;
+
+		// -- Constructors --
+
+		/**
+		 * @brief Refers to element `i` of the component streams of an array.
+		 */
+		soa_ref(T *const *streams, std::size_t i)
+			: x(streams[0][i])
+		{}
+
+		soa_ref(const soa_ref<1, T> &r) = default;
+
+		// -- Conversions --
+
+		operator vec<1, T>() const {
+			return vec<1, T>(x);
+		}
+
+		// -- Assignment operators --
+
+		soa_ref<1, T>& operator=(const vec<1, T> &v) {
+			x = v.x;
+			return *this;
+		}
+
+		soa_ref<1, T>& operator=(const soa_ref<1, T> &r) {
+			x = r.x;
+			return *this;
+		}
+
+		// -- Element accesses --
+
+		T& operator[](length_t i) const {
+			assert(i >= 0 && i < 1);
+			switch(i) {
+				default:
+				case 0:
+					return x;
+			}
+		}
+	};
+
+	template<class T>
+	struct soa_ref<2, T> : detail::soa_ref_base<soa_ref<2, T>, 2, T> {
+
+		// -- Components --
+
+		T &x;
+		T &y;
+
+		// -- Constructors --
+
+		/**
+		 * @brief Refers to element `i` of the component streams of an array.
+		 */
+		soa_ref(T *const *streams, std::size_t i)
+			: x(streams[0][i]), y(streams[1][i])
+		{}
+
+		soa_ref(const soa_ref<2, T> &r) = default;
+
+		// -- Conversions --
+
+		operator vec<2, T>() const {
+			return vec<2, T>(x, y);
+		}
+
+		// -- Assignment operators --
+
+		soa_ref<2, T>& operator=(const vec<2, T> &v) {
+			x = v.x;
+			y = v.y;
+			return *this;
+		}
+
+		soa_ref<2, T>& operator=(const soa_ref<2, T> &r) {
+			x = r.x;
+			y = r.y;
+			return *this;
+		}
+
+		// -- Element accesses --
+
+		T& operator[](length_t i) const {
+			assert(i >= 0 && i < 2);
+			switch(i) {
+				default:
+				case 0:
+					return x;
+				case 1:
+					return y;
+			}
+		}
+	};
+
+	template<class T>
+	struct soa_ref<3, T> : detail::soa_ref_base<soa_ref<3, T>, 3, T> {
+
+		// -- Components --
+
+		T &x;
+		T &y;
+		T &z;
+
+		// -- Constructors --
+
+		/**
+		 * @brief Refers to element `i` of the component streams of an array.
+		 */
+		soa_ref(T *const *streams, std::size_t i)
+			: x(streams[0][i]), y(streams[1][i]), z(streams[2][i])
+		{}
+
+		soa_ref(const soa_ref<3, T> &r) = default;
+
+		// -- Conversions --
+
+		operator vec<3, T>() const {
+			return vec<3, T>(x, y, z);
+		}
+
+		// -- Assignment operators --
+
+		soa_ref<3, T>& operator=(const vec<3, T> &v) {
+			x = v.x;
+			y = v.y;
+			z = v.z;
+			return *this;
+		}
+
+		soa_ref<3, T>& operator=(const soa_ref<3, T> &r) {
+			x = r.x;
+			y = r.y;
+			z = r.z;
+			return *this;
+		}
+
+		// -- Element accesses --
+
+		T& operator[](length_t i) const {
+			assert(i >= 0 && i < 3);
+			switch(i) {
+				default:
+				case 0:
+					return x;
+				case 1:
+					return y;
+				case 2:
+					return z;
+			}
+		}
+	};
+
+	template<class T>
+	struct soa_ref<4, T> : detail::soa_ref_base<soa_ref<4, T>, 4, T> {
+
+		// -- Components --
+
+		T &x;
+		T &y;
+		T &z;
+		T &w;
+
+		// -- Constructors --
+
+		/**
+		 * @brief Refers to element `i` of the component streams of an array.
+		 */
+		soa_ref(T *const *streams, std::size_t i)
+			: x(streams[0][i]), y(streams[1][i]), z(streams[2][i]), w(streams[3][i])
+		{}
+
+		soa_ref(const soa_ref<4, T> &r) = default;
+
+		// -- Conversions --
+
+		operator vec<4, T>() const {
+			return vec<4, T>(x, y, z, w);
+		}
+
+		// -- Assignment operators --
+
+		soa_ref<4, T>& operator=(const vec<4, T> &v) {
+			x = v.x;
+			y = v.y;
+			z = v.z;
+			w = v.w;
+			return *this;
+		}
+
+		soa_ref<4, T>& operator=(const soa_ref<4, T> &r) {
+			x = r.x;
+			y = r.y;
+			z = r.z;
+			w = r.w;
+			return *this;
+		}
+
+		// -- Element accesses --
+
+		T& operator[](length_t i) const {
+			assert(i >= 0 && i < 4);
+			switch(i) {
+				default:
+				case 0:
+					return x;
+				case 1:
+					return y;
+				case 2:
+					return z;
+				case 3:
+					return w;
+			}
+		}
+	};
+
+	namespace detail {
+
+		/**
+		 * @brief Template class to divide two streams, which uses the SIMD batches
+		 * for floating-point types and the division of each element for integers.
+		 */
+		template<class T, bool Floating>
+		struct soa_divide {
+			template<class B>
+			static void call(T *dst, const T *src, std::size_t n, std::size_t) {
+				for (std::size_t i = 0; i < n; ++i) {
+					dst[i] /= src[i];
+				}
+			}
+
+			template<class B>
+			static void call(T *dst, T value, std::size_t n, std::size_t) {
+				for (std::size_t i = 0; i < n; ++i) {
+					dst[i] /= value;
+				}
+			}
+		};
+
+		template<class T>
+		struct soa_divide<T, true> {
+			template<class B>
+			static void call(T *dst, const T *src, std::size_t, std::size_t padded) {
+				for (std::size_t i = 0; i < padded; i += static_cast<std::size_t>(B::size())) {
+					(B::load(dst + i) / B::load(src + i)).store(dst + i);
+				}
+			}
+
+			template<class B>
+			static void call(T *dst, T value, std::size_t, std::size_t padded) {
+				const B divisor{ value };
+				for (std::size_t i = 0; i < padded; i += static_cast<std::size_t>(B::size())) {
+					(B::load(dst + i) / divisor).store(dst + i);
+				}
+			}
+		};
+
+	} // namespace detail
+
+	/**
+	 * Structure-of-arrays container of vectors, storing each component in a
+	 * separate stream so whole-array operations run at the full SIMD width.
+	 *
+	 * The streams are aligned to 64 bytes and padded to a multiple of the widest
+	 * SIMD batch, so operations never need a scalar remainder loop.
+	 *
+	 * @tparam L The number of components of each element, in range [1, 4]
+	 * @tparam T The type of the components (int, float, double)
+	 * @tparam Allocator The allocator of the streams, which must return memory
+	 * aligned to 64 bytes, such as aligned_allocator or arena_allocator
+	 */
+	template<length_t L, class T, class Allocator>
+	class soa_array {
+	public:
+
+		using value_type = vec<L, T>;
+		using reference = soa_ref<L, T>;
+		using const_reference = vec<L, T>;
+		using size_type = std::size_t;
+		using batch_type = simd::native<T>;
+		using allocator_type = Allocator;
+
+		/**
+		 * @brief The alignment of each stream in bytes.
+		 */
+		static const std::size_t alignment = 64;
+
+		// -- Constructors --
+
+		soa_array() = default;
+
+		/**
+		 * @brief Creates an array of `n` zero vectors.
+		 */
+		explicit soa_array(size_type n) {
+			resize(n);
+		}
+
+		/**
+		 * @brief Creates an array of `n` copies of `value`.
+		 */
+		soa_array(size_type n, const vec<L, T> &value) {
+			resize(n, value);
+		}
+
+		explicit soa_array(const Allocator &alloc)
+			: m_alloc(alloc)
+		{}
+
+		soa_array(size_type n, const vec<L, T> &value, const Allocator &alloc)
+			: m_alloc(alloc)
+		{
+			resize(n, value);
+		}
+
+		soa_array(const soa_array<L, T, Allocator> &other)
+			: m_alloc(std::allocator_traits<Allocator>::select_on_container_copy_construction(other.m_alloc))
+		{
+			reserve(other.m_size);
+			for (length_t c = 0; c < L; ++c) {
+				if (other.m_size > 0) {
+					std::memcpy(m_streams[c], other.m_streams[c], stream_bytes(other.m_size));
+				}
+			}
+			m_size = other.m_size;
+		}
+
+		soa_array(soa_array<L, T, Allocator> &&other) noexcept
+			: m_alloc(other.m_alloc)
+		{
+			swap(other);
+		}
+
+		~soa_array() {
+			deallocate(m_data, m_capacity);
+		}
+
+		soa_array<L, T, Allocator>& operator=(soa_array<L, T, Allocator> other) noexcept {
+			swap(other);
+			return *this;
+		}
+
+		/**
+		 * @brief Evaluates a lazy expression into a new array in one pass over
+		 * each stream.
+		 */
+		template<class E, class = typename std::enable_if<detail::is_soa_expression<E>::value>::type>
+		soa_array(const E &expr) {
+			resize(expr.size());
+			evaluate(expr);
+		}
+
+		/**
+		 * @brief Evaluates a lazy expression into this array, which may also be
+		 * one of its operands.
+		 */
+		template<class E, class = typename std::enable_if<detail::is_soa_expression<E>::value>::type>
+		soa_array<L, T, Allocator>& operator=(const E &expr) {
+			resize(expr.size());
+			evaluate(expr);
+			return *this;
+		}
+
+		void swap(soa_array<L, T, Allocator> &other) noexcept {
+			std::swap(m_alloc, other.m_alloc);
+			std::swap(m_data, other.m_data);
+			std::swap(m_size, other.m_size);
+			std::swap(m_capacity, other.m_capacity);
+			set_streams();
+			other.set_streams();
+		}
+
+		// -- Capacity --
+
+		/**
+		 * @returns The number of components of each element.
+		 */
+		static SMATH_CONSTEXPR length_t length() {
+			return L;
+		}
+
+		size_type size() const {
+			return m_size;
+		}
+
+		/**
+		 * @returns The number of elements each stream can hold, including the
+		 * padding after the last element.
+		 */
+		size_type capacity() const {
+			return m_capacity;
+		}
+
+		bool empty() const {
+			return m_size == 0;
+		}
+
+		/**
+		 * @brief Grows the streams to hold at least `n` elements.
+		 */
+		void reserve(size_type n) {
+			const size_type padded{ round_up(n, block()) };
+			if (padded <= m_capacity) {
+				return;
+			}
+
+			T *data{ allocate(padded) };
+			for (length_t c = 0; c < L; ++c) {
+				if (m_size > 0) {
+					std::memcpy(data + static_cast<size_type>(c) * padded, m_streams[c], m_size * sizeof(T));
+				}
+			}
+
+			deallocate(m_data, m_capacity);
+			m_data = data;
+			m_capacity = padded;
+			set_streams();
+		}
+
+		/**
+		 * @brief Changes the number of elements, filling new elements with `value`.
+		 */
+		void resize(size_type n, const vec<L, T> &value = vec<L, T>()) {
+			if (n > m_capacity) {
+				reserve(n > 2 * m_capacity ? n : 2 * m_capacity);
+			}
+			if (n > m_size) {
+				for (length_t c = 0; c < L; ++c) {
+					std::fill(m_streams[c] + m_size, m_streams[c] + n, value[c]);
+				}
+			}
+			m_size = n;
+		}
+
+		void clear() {
+			m_size = 0;
+		}
+
+		void push_back(const vec<L, T> &value) {
+			resize(m_size + 1, value);
+		}
+
+		// -- Element accesses --
+
+		reference operator[](size_type i) {
+			assert(i < m_size);
+			return reference(m_streams, i);
+		}
+
+		const_reference operator[](size_type i) const {
+			assert(i < m_size);
+			vec<L, T> result;
+			for (length_t c = 0; c < L; ++c) {
+				result[c] = m_streams[c][i];
+			}
+			return result;
+		}
+
+		/**
+		 * @returns The stream holding component `c` of every element, aligned to
+		 * `alignment` bytes.
+		 */
+		T* data(length_t c) {
+			assert(c >= 0 && c < L);
+			return m_streams[c];
+		}
+
+		const T* data(length_t c) const {
+			assert(c >= 0 && c < L);
+			return m_streams[c];
+		}
+
+		// -- Unary arithmetic operators --
+
+		soa_array<L, T, Allocator>& operator+=(const soa_array<L, T, Allocator> &other) {
+			return apply(other, [](const batch_type &a, const batch_type &b) { return a + b; });
+		}
+
+		soa_array<L, T, Allocator>& operator+=(const vec<L, T> &v) {
+			return apply(v, [](const batch_type &a, const batch_type &b) { return a + b; });
+		}
+
+		soa_array<L, T, Allocator>& operator+=(T scalar) {
+			return *this += vec<L, T>(scalar);
+		}
+
+		soa_array<L, T, Allocator>& operator-=(const soa_array<L, T, Allocator> &other) {
+			return apply(other, [](const batch_type &a, const batch_type &b) { return a - b; });
+		}
+
+		soa_array<L, T, Allocator>& operator-=(const vec<L, T> &v) {
+			return apply(v, [](const batch_type &a, const batch_type &b) { return a - b; });
+		}
+
+		soa_array<L, T, Allocator>& operator-=(T scalar) {
+			return *this -= vec<L, T>(scalar);
+		}
+
+		soa_array<L, T, Allocator>& operator*=(const soa_array<L, T, Allocator> &other) {
+			return apply(other, [](const batch_type &a, const batch_type &b) { return a * b; });
+		}
+
+		soa_array<L, T, Allocator>& operator*=(const vec<L, T> &v) {
+			return apply(v, [](const batch_type &a, const batch_type &b) { return a * b; });
+		}
+
+		soa_array<L, T, Allocator>& operator*=(T scalar) {
+			return *this *= vec<L, T>(scalar);
+		}
+
+		soa_array<L, T, Allocator>& operator/=(const soa_array<L, T, Allocator> &other) {
+			assert(m_size == other.m_size);
+			for (length_t c = 0; c < L; ++c) {
+				detail::soa_divide<T, is_floating_type<T>::value>::template call<batch_type>(m_streams[c], other.m_streams[c], m_size, padded_size());
+			}
+			return *this;
+		}
+
+		soa_array<L, T, Allocator>& operator/=(const vec<L, T> &v) {
+			for (length_t c = 0; c < L; ++c) {
+				detail::soa_divide<T, is_floating_type<T>::value>::template call<batch_type>(m_streams[c], v[c], m_size, padded_size());
+			}
+			return *this;
+		}
+
+		soa_array<L, T, Allocator>& operator/=(T scalar) {
+			return *this /= vec<L, T>(scalar);
+		}
+
+		template<class E, class = typename std::enable_if<detail::is_soa_expression<E>::value>::type>
+		soa_array<L, T, Allocator>& operator+=(const E &expr) {
+			return *this = *this + expr;
+		}
+
+		template<class E, class = typename std::enable_if<detail::is_soa_expression<E>::value>::type>
+		soa_array<L, T, Allocator>& operator-=(const E &expr) {
+			return *this = *this - expr;
+		}
+
+		template<class E, class = typename std::enable_if<detail::is_soa_expression<E>::value>::type>
+		soa_array<L, T, Allocator>& operator*=(const E &expr) {
+			return *this = *this * expr;
+		}
+
+		template<class E, class = typename std::enable_if<detail::is_soa_expression<E>::value>::type>
+		soa_array<L, T, Allocator>& operator/=(const E &expr) {
+			return *this = *this / expr;
+		}
+
+		// -- Functions --
+
+		/**
+		 * @brief Applies `func` to every SIMD batch of every stream.
+		 * @param func Callable taking and returning a batch_type.
+		 */
+		template<class F>
+		soa_array<L, T, Allocator>& transform(F func) {
+			for (length_t c = 0; c < L; ++c) {
+				for (size_type i = 0; i < padded_size(); i += width()) {
+					func(batch_type::load(m_streams[c] + i)).store(m_streams[c] + i);
+				}
+			}
+			return *this;
+		}
+
+		/**
+		 * @brief Applies `func` to every component of every element.
+		 * @param func Callable taking and returning a T.
+		 */
+		template<class F>
+		soa_array<L, T, Allocator>& transform_elements(F func) {
+			for (length_t c = 0; c < L; ++c) {
+				for (size_type i = 0; i < m_size; ++i) {
+					m_streams[c][i] = func(m_streams[c][i]);
+				}
+			}
+			return *this;
+		}
+
+		allocator_type get_allocator() const {
+			return m_alloc;
+		}
+
+	private:
+
+		Allocator m_alloc{};
+		T *m_data{ nullptr };
+		T *m_streams[static_cast<std::size_t>(L)]{};
+		size_type m_size{ 0 };
+		size_type m_capacity{ 0 };
+
+		// -- Storage --
+
+		/**
+		 * @returns The number of elements that make up 64 bytes, which is at least
+		 * the width of the widest batch.
+		 */
+		static SMATH_CONSTEXPR size_type block() {
+			return alignment / sizeof(T) > width() ? alignment / sizeof(T) : width();
+		}
+
+		static SMATH_CONSTEXPR size_type width() {
+			return static_cast<size_type>(batch_type::size());
+		}
+
+		static SMATH_CONSTEXPR size_type round_up(size_type n, size_type multiple) {
+			return (n + multiple - 1) / multiple * multiple;
+		}
+
+		static SMATH_CONSTEXPR size_type stream_bytes(size_type capacity) {
+			return capacity * sizeof(T);
+		}
+
+		T* allocate(size_type capacity) {
+			T *data{ std::allocator_traits<Allocator>::allocate(m_alloc, capacity * L) };
+			assert(reinterpret_cast<std::uintptr_t>(data) % alignment == 0 && "soa_array allocator must return memory aligned to 64 bytes");
+			std::memset(data, 0, stream_bytes(capacity) * L);
+			return data;
+		}
+
+		void deallocate(T *data, size_type capacity) {
+			if (data != nullptr) {
+				std::allocator_traits<Allocator>::deallocate(m_alloc, data, capacity * L);
+			}
+		}
+
+		void set_streams() {
+			for (length_t c = 0; c < L; ++c) {
+				m_streams[c] = (m_data != nullptr) ? m_data + static_cast<size_type>(c) * m_capacity : nullptr;
+			}
+		}
+
+		/**
+		 * @returns The number of elements rounded up to whole batches, which the
+		 * padding of the streams always covers.
+		 */
+		size_type padded_size() const {
+			return round_up(m_size, width());
+		}
+
+		/**
+		 * @brief Stores every batch of a lazy expression. Each batch only reads
+		 * the same elements of the operands, so the array may be one of them.
+		 */
+		template<class E>
+		void evaluate(const E &expr) {
+			SMATH_STATIC_ASSERT(E::length == L, "expression must have the same number of components as the array");
+			for (length_t c = 0; c < L; ++c) {
+				for (size_type i = 0; i < padded_size(); i += width()) {
+					expr.load(c, i).store(m_streams[c] + i);
+				}
+			}
+		}
+
+		template<class F>
+		soa_array<L, T, Allocator>& apply(const soa_array<L, T, Allocator> &other, F func) {
+			assert(m_size == other.m_size);
+			for (length_t c = 0; c < L; ++c) {
+				for (size_type i = 0; i < padded_size(); i += width()) {
+					func(batch_type::load(m_streams[c] + i), batch_type::load(other.m_streams[c] + i)).store(m_streams[c] + i);
+				}
+			}
+			return *this;
+		}
+
+		template<class F>
+		soa_array<L, T, Allocator>& apply(const vec<L, T> &v, F func) {
+			for (length_t c = 0; c < L; ++c) {
+				const batch_type value{ v[c] };
+				for (size_type i = 0; i < padded_size(); i += width()) {
+					func(batch_type::load(m_streams[c] + i), value).store(m_streams[c] + i);
+				}
+			}
+			return *this;
+		}
+
+		SMATH_STATIC_ASSERT(smath::is_valid_vector(L), "'soa_array' only works on vectors with 1 to 4 components");
+		SMATH_STATIC_ASSERT(smath::is_integer_type<T>::value || smath::is_floating_type<T>::value, "'soa_array' only accepts integer or floating-point components");
+	};
+
+#if SMATH_CONFIG_EXPRESSIONS == SMATH_DISABLE
+
+	// -- Binary arithmetic operators --
+
+	template<length_t L, class T, class A>
+	soa_array<L, T, A> operator+(soa_array<L, T, A> a, const soa_array<L, T, A> &b) {
+		a += b;
+		return a;
+	}
+
+	template<length_t L, class T, class A>
+	soa_array<L, T, A> operator+(soa_array<L, T, A> a, const vec<L, T> &v) {
+		a += v;
+		return a;
+	}
+
+	template<length_t L, class T, class A>
+	soa_array<L, T, A> operator+(soa_array<L, T, A> a, T scalar) {
+		a += scalar;
+		return a;
+	}
+
+	template<length_t L, class T, class A>
+	soa_array<L, T, A> operator-(soa_array<L, T, A> a, const soa_array<L, T, A> &b) {
+		a -= b;
+		return a;
+	}
+
+	template<length_t L, class T, class A>
+	soa_array<L, T, A> operator-(soa_array<L, T, A> a, const vec<L, T> &v) {
+		a -= v;
+		return a;
+	}
+
+	template<length_t L, class T, class A>
+	soa_array<L, T, A> operator-(soa_array<L, T, A> a, T scalar) {
+		a -= scalar;
+		return a;
+	}
+
+	template<length_t L, class T, class A>
+	soa_array<L, T, A> operator*(soa_array<L, T, A> a, const soa_array<L, T, A> &b) {
+		a *= b;
+		return a;
+	}
+
+	template<length_t L, class T, class A>
+	soa_array<L, T, A> operator*(soa_array<L, T, A> a, const vec<L, T> &v) {
+		a *= v;
+		return a;
+	}
+
+	template<length_t L, class T, class A>
+	soa_array<L, T, A> operator*(soa_array<L, T, A> a, T scalar) {
+		a *= scalar;
+		return a;
+	}
+
+	template<length_t L, class T, class A>
+	soa_array<L, T, A> operator/(soa_array<L, T, A> a, const soa_array<L, T, A> &b) {
+		a /= b;
+		return a;
+	}
+
+	template<length_t L, class T, class A>
+	soa_array<L, T, A> operator/(soa_array<L, T, A> a, const vec<L, T> &v) {
+		a /= v;
+		return a;
+	}
+
+	template<length_t L, class T, class A>
+	soa_array<L, T, A> operator/(soa_array<L, T, A> a, T scalar) {
+		a /= scalar;
+		return a;
+	}
+
+	template<length_t L, class T, class A>
+	soa_array<L, T, A> operator+(const vec<L, T> &v, soa_array<L, T, A> a) {
+		a += v;
+		return a;
+	}
+
+	template<length_t L, class T, class A>
+	soa_array<L, T, A> operator+(T scalar, soa_array<L, T, A> a) {
+		a += scalar;
+		return a;
+	}
+
+	template<length_t L, class T, class A>
+	soa_array<L, T, A> operator*(const vec<L, T> &v, soa_array<L, T, A> a) {
+		a *= v;
+		return a;
+	}
+
+	template<length_t L, class T, class A>
+	soa_array<L, T, A> operator*(T scalar, soa_array<L, T, A> a) {
+		a *= scalar;
+		return a;
+	}
+
+	template<length_t L, class T, class A>
+	soa_array<L, T, A> operator-(const vec<L, T> &v, const soa_array<L, T, A> &a) {
+		soa_array<L, T, A> result(a.size(), v, a.get_allocator());
+		result -= a;
+		return result;
+	}
+
+	template<length_t L, class T, class A>
+	soa_array<L, T, A> operator-(T scalar, const soa_array<L, T, A> &a) {
+		return vec<L, T>(scalar) - a;
+	}
+
+	template<length_t L, class T, class A>
+	soa_array<L, T, A> operator/(const vec<L, T> &v, const soa_array<L, T, A> &a) {
+		soa_array<L, T, A> result(a.size(), v, a.get_allocator());
+		result /= a;
+		return result;
+	}
+
+	template<length_t L, class T, class A>
+	soa_array<L, T, A> operator/(T scalar, const soa_array<L, T, A> &a) {
+		return vec<L, T>(scalar) / a;
+	}
+
+	// -- Unary arithmetic operators --
+
+	template<length_t L, class T, class A>
+	soa_array<L, T, A> operator-(soa_array<L, T, A> a) {
+		a.transform([](const typename soa_array<L, T, A>::batch_type &b) { return -b; });
+		return a;
+	}
+
+	// -- Functions --
+
+	/**
+	 * @brief Performs the square root on every component of every element.
+	 * @returns An array containing the square roots.
+	 */
+	template<length_t L, class T, class A>
+	soa_array<L, T, A> sqrt(soa_array<L, T, A> a) {
+		SMATH_STATIC_ASSERT(smath::is_floating_type<T>::value, "'sqrt' only accepts a floating-point soa_array");
+		a.transform([](const typename soa_array<L, T, A>::batch_type &b) { return sqrt(b); });
+		return a;
+	}
+
+	/**
+	 * @brief Converts every component of every element into its absolute value.
+	 * @returns An array containing the absolute values.
+	 */
+	template<length_t L, class T, class A>
+	soa_array<L, T, A> abs(soa_array<L, T, A> a) {
+		a.transform([](const typename soa_array<L, T, A>::batch_type &b) { return abs(b); });
+		return a;
+	}
+
+#endif
+
+	/**
+	 * @brief Performs the logarithm on every component of every element.
+	 * @param acc The trade-off between speed and accuracy.
+	 * @returns An array containing the logarithms.
+	 */
+	template<length_t L, class T, class A, class P = default_precision, class = detail::enable_precision<P>>
+	soa_array<L, T, A> log(soa_array<L, T, A> a, P acc = P()) {
+		SMATH_STATIC_ASSERT(smath::is_floating_type<T>::value, "'log' only accepts a floating-point soa_array");
+		detail::with_precision(acc, [&a](auto p) {
+			a.transform([](const typename soa_array<L, T, A>::batch_type &b) { return detail::log_batch<decltype(p)::value>(b); });
+		});
+		return a;
+	}
+
+	namespace detail {
+
+		template<length_t L, class T, class A>
+		void round_array(soa_array<L, T, A> &a, round_mode mode, std::true_type) {
+			a.transform([mode](const typename soa_array<L, T, A>::batch_type &b) { return round_batch(b, mode); });
+		}
+
+		/**
+		 * @brief Integer components are already whole.
+		 */
+		template<length_t L, class T, class A>
+		void round_array(soa_array<L, T, A> &, round_mode, std::false_type) {}
+
+	} // namespace detail
+
+	/**
+	 * @brief Rounds every component of every element to a whole number.
+	 * @param mode The direction to round in.
+	 * @returns An array containing the rounded values.
+	 */
+	template<length_t L, class T, class A>
+	soa_array<L, T, A> round(soa_array<L, T, A> a, round_mode mode) {
+		detail::round_array(a, mode, std::integral_constant<bool, smath::is_floating_type<T>::value>());
+		return a;
+	}
+
+	/**
+	 * @brief Rounds every component of every element to the nearest whole number.
+	 * @returns An array containing the rounded values.
+	 */
+	template<length_t L, class T, class A>
+	soa_array<L, T, A> round(soa_array<L, T, A> a) {
+		detail::round_array(a, round_mode::half_away, std::integral_constant<bool, smath::is_floating_type<T>::value>());
+		return a;
+	}
+
+	/**
+	 * @brief Rounds every component of every element downwards.
+	 * @returns An array containing the rounded values.
+	 */
+	template<length_t L, class T, class A>
+	soa_array<L, T, A> floor(soa_array<L, T, A> a) {
+		detail::round_array(a, round_mode::down, std::integral_constant<bool, smath::is_floating_type<T>::value>());
+		return a;
+	}
+
+	/**
+	 * @brief Rounds every component of every element upwards.
+	 * @returns An array containing the rounded values.
+	 */
+	template<length_t L, class T, class A>
+	soa_array<L, T, A> ceil(soa_array<L, T, A> a) {
+		detail::round_array(a, round_mode::up, std::integral_constant<bool, smath::is_floating_type<T>::value>());
+		return a;
+	}
+
+	/**
+	 * @brief Rounds every component of every element towards zero.
+	 * @returns An array containing the rounded values.
+	 */
+	template<length_t L, class T, class A>
+	soa_array<L, T, A> trunc(soa_array<L, T, A> a) {
+		detail::round_array(a, round_mode::toward_zero, std::integral_constant<bool, smath::is_floating_type<T>::value>());
+		return a;
+	}
+
+} // namespace smath
+
+#endif // CONTAINERS_SOA_ARRAY_H
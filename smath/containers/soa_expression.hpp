@@ -0,0 +1,375 @@
+#pragma once
+
+#ifndef CONTAINERS_SOA_EXPRESSION_H
+#define CONTAINERS_SOA_EXPRESSION_H
+
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+
+#include "../detail/setup.hpp"
+
+#include "../memory.hpp"
+#include "../simd/simd.hpp"
+#include "../template_types.hpp"
+#include "../vec.hpp"
+
+namespace smath {
+
+	template<length_t L, class T, class Allocator = aligned_allocator<T>>
+	class soa_array;
+
+	/**
+	 * Base of the lazy soa_array expressions. Every node produces one SIMD batch
+	 * of component `c` at element `i` through `load(c, i)`, so assigning an
+	 * expression to an array evaluates the whole tree in a single pass over each
+	 * stream instead of one pass per operator.
+	 * @tparam E The type of the node.
+	 */
+	template<class E>
+	struct soa_expression {};
+
+	namespace detail {
+
+		/**
+		 * @brief Array operand of an expression.
+		 */
+		template<length_t L, class T>
+		struct soa_leaf : soa_expression<soa_leaf<L, T>> {
+			using component_type = T;
+			using batch_type = simd::native<T>;
+			static const length_t length = L;
+
+			const T *streams[static_cast<std::size_t>(L)];
+			std::size_t n;
+
+			template<class A>
+			explicit soa_leaf(const soa_array<L, T, A> &array)
+				: n(array.size())
+			{
+				for (length_t c = 0; c < L; ++c) {
+					streams[c] = array.data(c);
+				}
+			}
+
+			std::size_t size() const {
+				return n;
+			}
+
+			batch_type load(length_t c, std::size_t i) const {
+				return batch_type::load(streams[c] + i);
+			}
+		};
+
+		/**
+		 * @brief Vector or scalar operand of an expression, the same for every
+		 * element.
+		 */
+		template<length_t L, class T>
+		struct soa_broadcast : soa_expression<soa_broadcast<L, T>> {
+			using component_type = T;
+			using batch_type = simd::native<T>;
+			static const length_t length = L;
+
+			vec<L, T> value;
+
+			explicit soa_broadcast(const vec<L, T> &value)
+				: value(value)
+			{}
+
+			std::size_t size() const {
+				return static_cast<std::size_t>(-1);
+			}
+
+			batch_type load(length_t c, std::size_t) const {
+				return batch_type(value[c]);
+			}
+		};
+
+		template<class Op, class A>
+		struct soa_unary : soa_expression<soa_unary<Op, A>> {
+			using component_type = typename A::component_type;
+			using batch_type = typename A::batch_type;
+			static const length_t length = A::length;
+
+			A a;
+
+			explicit soa_unary(const A &a)
+				: a(a)
+			{}
+
+			std::size_t size() const {
+				return a.size();
+			}
+
+			batch_type load(length_t c, std::size_t i) const {
+				return Op::call(a.load(c, i));
+			}
+		};
+
+		template<class Op, class A, class B>
+		struct soa_binary : soa_expression<soa_binary<Op, A, B>> {
+			using component_type = typename A::component_type;
+			using batch_type = typename A::batch_type;
+			static const length_t length = A::length;
+
+			A a;
+			B b;
+
+			soa_binary(const A &a, const B &b)
+				: a(a), b(b)
+			{}
+
+			/**
+			 * @returns The size of the array operands, ignoring broadcasts.
+			 */
+			std::size_t size() const {
+				assert(a.size() == b.size() || a.size() == static_cast<std::size_t>(-1) || b.size() == static_cast<std::size_t>(-1));
+				return a.size() < b.size() ? a.size() : b.size();
+			}
+
+			batch_type load(length_t c, std::size_t i) const {
+				return Op::call(a.load(c, i), b.load(c, i));
+			}
+		};
+
+		// -- Operations --
+
+		struct soa_op_add {
+			template<class B>
+			static B call(const B &a, const B &b) {
+				return a + b;
+			}
+		};
+
+		struct soa_op_sub {
+			template<class B>
+			static B call(const B &a, const B &b) {
+				return a - b;
+			}
+		};
+
+		struct soa_op_mul {
+			template<class B>
+			static B call(const B &a, const B &b) {
+				return a * b;
+			}
+		};
+
+		struct soa_op_div {
+			template<class B>
+			static B call(const B &a, const B &b) {
+				return divide(a, b, std::integral_constant<bool, is_floating_type<typename B::value_type>::value>());
+			}
+
+			template<class B>
+			static B divide(const B &a, const B &b, std::true_type) {
+				return a / b;
+			}
+
+			/**
+			 * @brief Integer batches have no division, so the lanes are divided one
+			 * at a time, skipping zero divisors in the padding.
+			 */
+			template<class B>
+			static B divide(const B &a, const B &b, std::false_type) {
+				using T = typename B::value_type;
+				T x[static_cast<std::size_t>(B::size())];
+				T y[static_cast<std::size_t>(B::size())];
+				a.storeu(x);
+				b.storeu(y);
+				for (std::size_t i = 0; i < static_cast<std::size_t>(B::size()); ++i) {
+					x[i] = y[i] != 0 ? x[i] / y[i] : 0;
+				}
+				return B::loadu(x);
+			}
+		};
+
+		struct soa_op_neg {
+			template<class B>
+			static B call(const B &a) {
+				return -a;
+			}
+		};
+
+		struct soa_op_sqrt {
+			template<class B>
+			static B call(const B &a) {
+				SMATH_STATIC_ASSERT(smath::is_floating_type<typename B::value_type>::value, "'sqrt' only accepts a floating-point soa_array");
+				return sqrt(a);
+			}
+		};
+
+		struct soa_op_abs {
+			template<class B>
+			static B call(const B &a) {
+				return abs(a);
+			}
+		};
+
+		// -- Traits --
+
+		template<class X, class D = typename std::decay<X>::type>
+		struct is_soa_expression : std::is_base_of<soa_expression<D>, D> {};
+
+		template<class X>
+		struct is_soa_operand : is_soa_expression<X> {};
+
+		template<length_t L, class T, class A>
+		struct is_soa_operand<soa_array<L, T, A>> : std::true_type {};
+
+		/**
+		 * @brief The number of components and their type for an array or an
+		 * expression.
+		 */
+		template<class X, bool Array = !is_soa_expression<X>::value>
+		struct soa_info {
+			static const length_t length = X::length;
+			using component_type = typename X::component_type;
+		};
+
+		template<length_t L, class T, class A>
+		struct soa_info<soa_array<L, T, A>, true> {
+			static const length_t length = L;
+			using component_type = T;
+		};
+
+		// -- Operand conversions --
+
+		template<length_t L, class T, class A>
+		SMATH_INLINE soa_leaf<L, T> to_soa_expression(const soa_array<L, T, A> &a) {
+			return soa_leaf<L, T>(a);
+		}
+
+		template<class E, class = typename std::enable_if<is_soa_expression<E>::value>::type>
+		SMATH_INLINE const E& to_soa_expression(const E &e) {
+			return e;
+		}
+
+		/**
+		 * @brief Converts an operand of a binary operator with an array or
+		 * expression of `L` components of `T`.
+		 */
+		template<length_t L, class T, class X>
+		struct soa_operand {
+			using type = typename std::decay<decltype(to_soa_expression(std::declval<const X &>()))>::type;
+
+			static type make(const X &x) {
+				return to_soa_expression(x);
+			}
+		};
+
+		template<length_t L, class T>
+		struct soa_operand<L, T, vec<L, T>> {
+			using type = soa_broadcast<L, T>;
+
+			static type make(const vec<L, T> &v) {
+				return type(v);
+			}
+		};
+
+		template<length_t L, class T>
+		struct soa_operand<L, T, T> {
+			using type = soa_broadcast<L, T>;
+
+			static type make(T scalar) {
+				return type(vec<L, T>(scalar));
+			}
+		};
+
+		/**
+		 * @brief Builds the node for `a Op b`, where at least one of the operands
+		 * is an array or an expression.
+		 */
+		template<class Op, class A, class B>
+		struct soa_binary_builder {
+			using info = soa_info<typename std::conditional<is_soa_operand<A>::value, A, B>::type>;
+			using left = soa_operand<info::length, typename info::component_type, A>;
+			using right = soa_operand<info::length, typename info::component_type, B>;
+			using type = soa_binary<Op, typename left::type, typename right::type>;
+
+			static type make(const A &a, const B &b) {
+				return type(left::make(a), right::make(b));
+			}
+		};
+
+		template<class A, class B>
+		using enable_soa_binary = typename std::enable_if<is_soa_operand<A>::value || is_soa_operand<B>::value>::type;
+
+	} // namespace detail
+
+#if SMATH_CONFIG_EXPRESSIONS == SMATH_ENABLE
+
+	// -- Binary arithmetic operators --
+
+	template<class A, class B, class = detail::enable_soa_binary<A, B>>
+	typename detail::soa_binary_builder<detail::soa_op_add, A, B>::type operator+(const A &a, const B &b) {
+		return detail::soa_binary_builder<detail::soa_op_add, A, B>::make(a, b);
+	}
+
+	template<class A, class B, class = detail::enable_soa_binary<A, B>>
+	typename detail::soa_binary_builder<detail::soa_op_sub, A, B>::type operator-(const A &a, const B &b) {
+		return detail::soa_binary_builder<detail::soa_op_sub, A, B>::make(a, b);
+	}
+
+	template<class A, class B, class = detail::enable_soa_binary<A, B>>
+	typename detail::soa_binary_builder<detail::soa_op_mul, A, B>::type operator*(const A &a, const B &b) {
+		return detail::soa_binary_builder<detail::soa_op_mul, A, B>::make(a, b);
+	}
+
+	template<class A, class B, class = detail::enable_soa_binary<A, B>>
+	typename detail::soa_binary_builder<detail::soa_op_div, A, B>::type operator/(const A &a, const B &b) {
+		return detail::soa_binary_builder<detail::soa_op_div, A, B>::make(a, b);
+	}
+
+	// -- Unary operators and functions --
+
+	// Each unary function is overloaded for arrays and for the two kinds of
+	// inner nodes, which keeps them more specialized than the generic scalar
+	// templates of the same name.
+
+#	define SMATH_SOA_UNARY(name, op) \
+		template<length_t L, class T, class Alloc> \
+		detail::soa_unary<detail::op, detail::soa_leaf<L, T>> name(const soa_array<L, T, Alloc> &a) { \
+			return detail::soa_unary<detail::op, detail::soa_leaf<L, T>>(detail::soa_leaf<L, T>(a)); \
+		} \
+		template<class Op, class A> \
+		detail::soa_unary<detail::op, detail::soa_unary<Op, A>> name(const detail::soa_unary<Op, A> &e) { \
+			return detail::soa_unary<detail::op, detail::soa_unary<Op, A>>(e); \
+		} \
+		template<class Op, class A, class B> \
+		detail::soa_unary<detail::op, detail::soa_binary<Op, A, B>> name(const detail::soa_binary<Op, A, B> &e) { \
+			return detail::soa_unary<detail::op, detail::soa_binary<Op, A, B>>(e); \
+		}
+
+	SMATH_SOA_UNARY(operator-, soa_op_neg)
+	SMATH_SOA_UNARY(sqrt, soa_op_sqrt)
+	SMATH_SOA_UNARY(abs, soa_op_abs)
+
+	// The functions without a SIMD kernel evaluate the expression into an
+	// array first.
+
+#	define SMATH_SOA_EVALUATE(name) \
+		template<class Op, class A> \
+		soa_array<A::length, typename A::component_type> name(const detail::soa_unary<Op, A> &e) { \
+			return name(soa_array<A::length, typename A::component_type>(e)); \
+		} \
+		template<class Op, class A, class B> \
+		soa_array<A::length, typename A::component_type> name(const detail::soa_binary<Op, A, B> &e) { \
+			return name(soa_array<A::length, typename A::component_type>(e)); \
+		}
+
+	SMATH_SOA_EVALUATE(log)
+	SMATH_SOA_EVALUATE(floor)
+	SMATH_SOA_EVALUATE(ceil)
+	SMATH_SOA_EVALUATE(round)
+	SMATH_SOA_EVALUATE(trunc)
+
+#	undef SMATH_SOA_EVALUATE
+#	undef SMATH_SOA_UNARY
+
+#endif
+
+} // namespace smath
+
+#endif // CONTAINERS_SOA_EXPRESSION_H
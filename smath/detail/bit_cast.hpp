@@ -0,0 +1,39 @@
+#pragma once
+
+#ifndef BIT_CAST_H
+#define BIT_CAST_H
+
+#include <cstring>
+#include <type_traits>
+
+#include "setup.hpp"
+
+namespace smath {
+
+	namespace detail {
+
+		/**
+		 * @brief Reinterprets the bits of an object as another type of the same
+		 * size, as C++20 std::bit_cast, without the undefined behaviour of
+		 * casting pointers. It is constexpr when the compiler has the builtin.
+		 * @tparam To The type to reinterpret the bits as.
+		 * @returns An object of type `To` with the same bits as `from`.
+		 */
+		template<class To, class From>
+		SMATH_INLINE SMATH_CONSTEXPR_BIT_CAST To bit_cast(const From &from) noexcept {
+			SMATH_STATIC_ASSERT(sizeof(To) == sizeof(From), "'bit_cast' only accepts types of the same size");
+			SMATH_STATIC_ASSERT(std::is_trivially_copyable<To>::value && std::is_trivially_copyable<From>::value, "'bit_cast' only accepts trivially copyable types");
+#if SMATH_HAS_BUILTIN_BIT_CAST
+			return __builtin_bit_cast(To, from);
+#else
+			To to;
+			std::memcpy(&to, &from, sizeof(To));
+			return to;
+#endif
+		}
+
+	} // namespace detail
+
+} // namespace smath
+
+#endif // BIT_CAST_H
@@ -0,0 +1,129 @@
+#pragma once
+
+#ifndef CPU_H
+#define CPU_H
+
+#include "setup.hpp"
+
+#if SMATH_HAS_CPU_DISPATCH
+#	if SMATH_COMPILER & SMATH_COMPILER_VC
+#		include <intrin.h>
+#	else
+#		include <cpuid.h>
+#	endif
+#endif
+
+namespace smath {
+
+	/**
+	 * @brief Instruction set extensions supported by the host CPU and enabled
+	 * by the operating system.
+	 */
+	struct cpu_info {
+		bool sse2;
+		bool sse41;
+		bool avx;
+		bool avx2;
+		bool fma;
+		bool avx512f;
+		bool f16c;
+		bool bmi2;
+	};
+
+	namespace detail {
+
+#if SMATH_HAS_CPU_DISPATCH
+		/**
+		 * @brief Executes `cpuid` for the given leaf and subleaf.
+		 * @returns False if the leaf is higher than the CPU supports.
+		 */
+		SMATH_INLINE bool cpuid(unsigned leaf, unsigned subleaf, unsigned regs[4]) {
+#	if SMATH_COMPILER & SMATH_COMPILER_VC
+			int info[4];
+			__cpuid(info, 0);
+			if (static_cast<unsigned>(info[0]) < leaf) {
+				return false;
+			}
+			__cpuidex(info, static_cast<int>(leaf), static_cast<int>(subleaf));
+			for (int i = 0; i < 4; ++i) {
+				regs[i] = static_cast<unsigned>(info[i]);
+			}
+			return true;
+#	else
+			return __get_cpuid_count(leaf, subleaf, &regs[0], &regs[1], &regs[2], &regs[3]) != 0;
+#	endif
+		}
+
+		/**
+		 * @returns The XCR0 register, listing the register states saved by the
+		 * operating system on a context switch.
+		 */
+		SMATH_INLINE unsigned long long xgetbv() {
+#	if SMATH_COMPILER & SMATH_COMPILER_VC
+			return _xgetbv(0);
+#	else
+			unsigned lo;
+			unsigned hi;
+			__asm__ __volatile__("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+			return (static_cast<unsigned long long>(hi) << 32) | lo;
+#	endif
+		}
+#endif
+
+		/**
+		 * @brief Queries the CPU with `cpuid`, clearing the AVX and AVX-512 families
+		 * when the operating system does not save their registers.
+		 */
+		SMATH_INLINE cpu_info detect_cpu_features() {
+			cpu_info info{ false, false, false, false, false, false, false, false };
+
+#if SMATH_HAS_CPU_DISPATCH
+			unsigned regs[4]{ 0, 0, 0, 0 };
+			if (!cpuid(1, 0, regs)) {
+				return info;
+			}
+
+			const unsigned ecx1{ regs[2] };
+			const unsigned edx1{ regs[3] };
+
+			info.sse2 = (edx1 & (1u << 26)) != 0;
+			info.sse41 = (ecx1 & (1u << 19)) != 0;
+
+			// XMM (bit 1) and YMM (bit 2) state, then opmask and ZMM state (bits 5 to 7)
+			const bool osxsave{ (ecx1 & (1u << 27)) != 0 };
+			const unsigned long long xcr0{ osxsave ? xgetbv() : 0 };
+			const bool os_avx{ (xcr0 & 0x6) == 0x6 };
+			const bool os_avx512{ (xcr0 & 0xE6) == 0xE6 };
+
+			info.avx = os_avx && (ecx1 & (1u << 28)) != 0;
+			info.fma = info.avx && (ecx1 & (1u << 12)) != 0;
+			info.f16c = info.avx && (ecx1 & (1u << 29)) != 0;
+
+			if (cpuid(7, 0, regs)) {
+				const unsigned ebx7{ regs[1] };
+
+				info.avx2 = info.avx && (ebx7 & (1u << 5)) != 0;
+				info.bmi2 = (ebx7 & (1u << 8)) != 0;
+				info.avx512f = os_avx512 && (ebx7 & (1u << 16)) != 0;
+			}
+#endif
+
+			return info;
+		}
+
+	} // namespace detail
+
+	/**
+	 * @brief Detects the instruction set extensions of the host CPU on the first
+	 * call and caches them.
+	 * @returns The features supported by the CPU running the program, all false
+	 * on non-x86 targets or when `SMATH_FORCE_PURE` is defined.
+	 */
+	SMATH_INLINE const cpu_info& cpu_features() {
+		static const cpu_info info{ detail::detect_cpu_features() };
+		return info;
+	}
+
+} // namespace smath
+
+#endif // CPU_H
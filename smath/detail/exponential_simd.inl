@@ -0,0 +1,80 @@
+/**
+ * SIMD implementation of the exponential.hpp functions for vec<4, float> and
+ * vec<4, double>, enabled by defining SMATH_FORCE_INTRINSICS.
+ */
+
+namespace smath {
+
+	namespace detail {
+
+		template<class T>
+		struct compute_inv_sqrt<4, T, true> {
+			template<accuracy A>
+			SMATH_CONSTEXPR_BIT_CAST static vec<4, T> call(const vec<4, T> &v, precision<A> acc) {
+				if (SMATH_IS_CONSTANT_EVALUATED()) {
+					return compute_inv_sqrt<4, T, false>::call(v, acc);
+				}
+				return vec4_store(inv_sqrt_batch<A>(vec4_load(v)));
+			}
+		};
+
+		template<class T>
+		struct compute_sqrt<4, T, true> {
+			template<accuracy A>
+			SMATH_CONSTEXPR static vec<4, T> call(const vec<4, T> &v, precision<A> acc) {
+				if (SMATH_IS_CONSTANT_EVALUATED()) {
+					return compute_sqrt<4, T, false>::call(v, acc);
+				}
+				return vec4_store(sqrt_batch<A>(vec4_load(v)));
+			}
+		};
+
+		template<class T>
+		struct compute_exp<4, T, true> {
+			template<accuracy A>
+			static vec<4, T> exp(const vec<4, T> &v, precision<A>) {
+				return vec4_store(exp_batch<A>(vec4_load(v)));
+			}
+
+			template<accuracy A>
+			static vec<4, T> exp2(const vec<4, T> &v, precision<A>) {
+				return vec4_store(exp2_batch<A>(vec4_load(v)));
+			}
+
+			template<accuracy A>
+			static vec<4, T> expm1(const vec<4, T> &v, precision<A>) {
+				return vec4_store(expm1_batch<A>(vec4_load(v)));
+			}
+
+			template<accuracy A>
+			static vec<4, T> pow(const vec<4, T> &a, const vec<4, T> &b, precision<A>) {
+				return vec4_store(pow_batch<A>(vec4_load(a), vec4_load(b)));
+			}
+		};
+
+		template<class T>
+		struct compute_log<4, T, true> {
+			template<accuracy A>
+			static vec<4, T> log(const vec<4, T> &v, precision<A>) {
+				return vec4_store(log_batch<A>(vec4_load(v)));
+			}
+
+			template<accuracy A>
+			static vec<4, T> log2(const vec<4, T> &v, precision<A>) {
+				return vec4_store(log2_batch<A>(vec4_load(v)));
+			}
+
+			template<accuracy A>
+			static vec<4, T> log10(const vec<4, T> &v, precision<A>) {
+				return vec4_store(log10_batch<A>(vec4_load(v)));
+			}
+
+			template<accuracy A>
+			static vec<4, T> log1p(const vec<4, T> &v, precision<A>) {
+				return vec4_store(log1p_batch<A>(vec4_load(v)));
+			}
+		};
+
+	} // namespace detail
+
+} // namespace smath
@@ -3,69 +3,49 @@
 #ifndef FUNCTION_H
 #define FUNCTION_H
 
+#include <cstddef>
+#include <utility>
+
 #include "../types/qualifier.hpp"
 
 namespace smath {
 
 	namespace function {
 
-		/**
-		 * @brief Template class to execute a function with a single (one) parameter.
-		 * @tparam L The number of components of the vector.
-		 * @tparam T The type of the vector (bool, int, double, float)
-		 */
-		template<template<length_t L, class T> class vec, length_t L, class A, class T>
-		struct one{};
+		namespace detail {
 
-		template<template<length_t L, class T> class vec, class A, class T>
-		struct one<vec, 1, A, T> {
-			SMATH_CONSTEXPR static vec<1, A> apply(A (*func) (T x), const vec<1, T> &v) {
-				return vec<1, A>(func(v.x));
+			template<std::size_t I, class F, length_t L, class T, class... V>
+			SMATH_INLINE SMATH_CONSTEXPR auto call(F &func, const vec<L, T> &v, const V &... rest)
+				-> decltype(func(v[0], rest[0]...)) {
+				return func(v[static_cast<int>(I)], rest[static_cast<int>(I)]...);
 			}
-		};
 
-		template<template<length_t L, class T> class vec, class A, class T>
-		struct one<vec, 2, A, T> {
-			SMATH_CONSTEXPR static vec<2, A> apply(A (*func) (T x), const vec<2, T> &v) {
-				return vec<2, A>(func(v.x), func(v.y));
+			template<class F, length_t L, class T, class... V, std::size_t... I>
+			SMATH_INLINE SMATH_CONSTEXPR auto map(std::index_sequence<I...>, F &func, const vec<L, T> &v, const V &... rest)
+				-> vec<L, decltype(func(v[0], rest[0]...))> {
+				return vec<L, decltype(func(v[0], rest[0]...))>(call<I>(func, v, rest...)...);
 			}
-		};
 
-		template<template<length_t L, class T> class vec, class A, class T>
-		struct one<vec, 3, A, T> {
-			SMATH_CONSTEXPR static vec<3, A> apply(A (*func) (T x), const vec<3, T> &v) {
-				return vec<3, A>(func(v.x), func(v.y), func(v.z));
-			}
-		};
+		} // namespace detail
 
 		/**
-		 * @brief Template class to execute a function with two parameters.
-		 * @tparam L The number of components of the vector.
-		 * @tparam T The type of the vector (bool, int, double, float)
+		 * @brief Applies a function to every component of one or more vectors of
+		 * the same length, passing the components with the same index together.
+		 *
+		 * The function is a template parameter instead of a function pointer, so
+		 * the calls are inlined and can be vectorized. Pass overloaded functions,
+		 * such as `std::floor`, wrapped in a lambda.
+		 *
+		 * @tparam L The number of components of the vectors.
+		 * @param func Callable taking one component of each vector.
+		 * @returns A vector of length `L` with the results, of the type
+		 * returned by `func`.
 		 */
-		template<template<length_t L, class T> class vec, length_t L, class T>
-		struct two{};
-
-		template<template<length_t L, class T> class vec, class T>
-		struct two<vec, 1, T> {
-			SMATH_CONSTEXPR static vec<1, T> apply(T (*func) (T x, T y), const vec<1, T> &a, const vec<1, T> &b) {
-				return vec<1, T>(func(a.x, b.x));
-			}
-		};
-
-		template<template<length_t L, class T> class vec, class T>
-		struct two<vec, 2, T> {
-			SMATH_CONSTEXPR static vec<2, T> apply(T (*func) (T x, T y), const vec<2, T> &a, const vec<2, T> &b) {
-				return vec<2, T>(func(a.x, b.x), func(a.y, b.y));
-			}
-		};
-
-		template<template<length_t L, class T> class vec, class T>
-		struct two<vec, 3, T> {
-			SMATH_CONSTEXPR static vec<3, T> apply(T (*func) (T x, T y), const vec<3, T> &a, const vec<3, T> &b) {
-				return vec<3, T>(func(a.x, b.x), func(a.y, b.y), func(a.z, b.z));
-			}
-		};
+		template<class F, length_t L, class T, class... V>
+		SMATH_INLINE SMATH_CONSTEXPR auto map(F &&func, const vec<L, T> &v, const V &... rest)
+			-> decltype(detail::map(std::make_index_sequence<static_cast<std::size_t>(L)>(), func, v, rest...)) {
+			return detail::map(std::make_index_sequence<static_cast<std::size_t>(L)>(), func, v, rest...);
+		}
 
 	} // namespace function
 
@@ -0,0 +1,25 @@
+/**
+ * SIMD implementation of the geometric.hpp functions for vec<4, float> and
+ * vec<4, double>, enabled by defining SMATH_FORCE_INTRINSICS.
+ */
+
+namespace smath {
+
+	namespace detail {
+
+		// The shuffle-add reduction is used instead of `dpps`, which sums the
+		// products in a different order and would not match the scalar result.
+
+		template<class T>
+		struct compute_dot<4, T, true> {
+			SMATH_CONSTEXPR static T call(const vec<4, T> &a, const vec<4, T> &b) {
+				if (SMATH_IS_CONSTANT_EVALUATED()) {
+					return compute_dot<4, T, false>::call(a, b);
+				}
+				return simd::reduce_add(vec4_load(a) * vec4_load(b));
+			}
+		};
+
+	} // namespace detail
+
+} // namespace smath
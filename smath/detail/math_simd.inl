@@ -0,0 +1,99 @@
+/**
+ * SIMD implementation of the math.hpp functions for vec<4, float> and
+ * vec<4, double>, enabled by defining SMATH_FORCE_INTRINSICS.
+ */
+
+namespace smath {
+
+	namespace detail {
+
+		template<class T>
+		struct compute_min_max<4, T, true> {
+			SMATH_CONSTEXPR static vec<4, T> minimum(const vec<4, T> &a, const vec<4, T> &b) {
+				if (SMATH_IS_CONSTANT_EVALUATED()) {
+					return compute_min_max<4, T, false>::minimum(a, b);
+				}
+				return vec4_store(min(vec4_load(a), vec4_load(b)));
+			}
+
+			SMATH_CONSTEXPR static vec<4, T> maximum(const vec<4, T> &a, const vec<4, T> &b) {
+				if (SMATH_IS_CONSTANT_EVALUATED()) {
+					return compute_min_max<4, T, false>::maximum(a, b);
+				}
+				// smath::max keeps the first operand for NaNs and equal values, while
+				// the SIMD max keeps the second
+				return vec4_store(max(vec4_load(b), vec4_load(a)));
+			}
+
+			// the reductions fold the components in order, as the generic version,
+			// since the shuffles of simd::reduce_min and reduce_max pair them
+			// differently and so pick other results for NaNs and signed zeros.
+			// Three scalar min/max instructions cost no more than the shuffles
+
+			SMATH_CONSTEXPR static T min_component(const vec<4, T> &v) {
+				return compute_min_max<4, T, false>::min_component(v);
+			}
+
+			SMATH_CONSTEXPR static T max_component(const vec<4, T> &v) {
+				return compute_min_max<4, T, false>::max_component(v);
+			}
+		};
+
+		template<class T>
+		struct compute_fma<4, T, true> {
+			SMATH_CONSTEXPR static vec<4, T> call(const vec<4, T> &a, const vec<4, T> &b, const vec<4, T> &c) {
+				if (SMATH_IS_CONSTANT_EVALUATED()) {
+					return compute_fma<4, T, false>::call(a, b, c);
+				}
+				return vec4_store(fma(vec4_load(a), vec4_load(b), vec4_load(c)));
+			}
+		};
+
+		template<class T>
+		struct compute_round<4, T, true> {
+			SMATH_CONSTEXPR static vec<4, T> call(const vec<4, T> &v, round_mode mode) {
+				if (SMATH_IS_CONSTANT_EVALUATED()) {
+					return compute_round<4, T, false>::call(v, mode);
+				}
+				return vec4_store(round_batch(vec4_load(v), mode));
+			}
+		};
+
+		template<class T>
+		struct compute_clamp<4, T, true> {
+			SMATH_CONSTEXPR static vec<4, T> call(const vec<4, T> &x, const vec<4, T> &lo, const vec<4, T> &hi) {
+				if (SMATH_IS_CONSTANT_EVALUATED()) {
+					return compute_clamp<4, T, false>::call(x, lo, hi);
+				}
+				// the operands of max are swapped to match smath::max, see maximum
+				return vec4_store(min(max(vec4_load(lo), vec4_load(x)), vec4_load(hi)));
+			}
+		};
+
+		template<class T>
+		struct compute_step<4, T, true> {
+			SMATH_CONSTEXPR static vec<4, T> call(const vec<4, T> &edge, const vec<4, T> &x) {
+				if (SMATH_IS_CONSTANT_EVALUATED()) {
+					return compute_step<4, T, false>::call(edge, x);
+				}
+				using B = simd::batch<T, 4>;
+				return vec4_store(select(vec4_load(x) < vec4_load(edge), B(T(0)), B(T(1))));
+			}
+		};
+
+		template<class T>
+		struct compute_smoothstep<4, T, true> {
+			SMATH_CONSTEXPR static vec<4, T> call(const vec<4, T> &edge0, const vec<4, T> &edge1, const vec<4, T> &x) {
+				if (SMATH_IS_CONSTANT_EVALUATED()) {
+					return compute_smoothstep<4, T, false>::call(edge0, edge1, x);
+				}
+				using B = simd::batch<T, 4>;
+				const B e0{ vec4_load(edge0) };
+				const B t{ min(max(B(T(0)), (vec4_load(x) - e0) / (vec4_load(edge1) - e0)), B(T(1))) };
+				return vec4_store(t * t * (B(T(3)) - B(T(2)) * t));
+			}
+		};
+
+	} // namespace detail
+
+} // namespace smath
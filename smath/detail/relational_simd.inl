@@ -0,0 +1,77 @@
+/**
+ * SIMD implementation of the relational.hpp comparisons for vec<4, float> and
+ * vec<4, double>, enabled by defining SMATH_FORCE_INTRINSICS.
+ */
+
+namespace smath {
+
+	namespace detail {
+
+		// -- Mask conversions --
+
+		SMATH_INLINE vec<4, bool> vec4_mask_store(int bits) {
+			return vec<4, bool>((bits & 0x1) != 0, (bits & 0x2) != 0, (bits & 0x4) != 0, (bits & 0x8) != 0);
+		}
+
+		template<class T>
+		SMATH_INLINE typename simd::batch<T, 4>::mask_type vec4_mask_load(const vec<4, bool> &m) {
+			return simd::batch<T, 4>::mask_type::from_bits(
+				static_cast<int>(m.x) | (static_cast<int>(m.y) << 1) | (static_cast<int>(m.z) << 2) | (static_cast<int>(m.w) << 3)
+			);
+		}
+
+		template<class T>
+		struct compute_relational<4, T, true> {
+			SMATH_CONSTEXPR static vec<4, bool> less_than(const vec<4, T> &a, const vec<4, T> &b) {
+				if (SMATH_IS_CONSTANT_EVALUATED()) {
+					return compute_relational<4, T, false>::less_than(a, b);
+				}
+				return vec4_mask_store(simd::bits(vec4_load(a) < vec4_load(b)));
+			}
+
+			SMATH_CONSTEXPR static vec<4, bool> less_than_equal(const vec<4, T> &a, const vec<4, T> &b) {
+				if (SMATH_IS_CONSTANT_EVALUATED()) {
+					return compute_relational<4, T, false>::less_than_equal(a, b);
+				}
+				return vec4_mask_store(simd::bits(vec4_load(a) <= vec4_load(b)));
+			}
+
+			SMATH_CONSTEXPR static vec<4, bool> greater_than(const vec<4, T> &a, const vec<4, T> &b) {
+				if (SMATH_IS_CONSTANT_EVALUATED()) {
+					return compute_relational<4, T, false>::greater_than(a, b);
+				}
+				return vec4_mask_store(simd::bits(vec4_load(a) > vec4_load(b)));
+			}
+
+			SMATH_CONSTEXPR static vec<4, bool> greater_than_equal(const vec<4, T> &a, const vec<4, T> &b) {
+				if (SMATH_IS_CONSTANT_EVALUATED()) {
+					return compute_relational<4, T, false>::greater_than_equal(a, b);
+				}
+				return vec4_mask_store(simd::bits(vec4_load(a) >= vec4_load(b)));
+			}
+
+			SMATH_CONSTEXPR static vec<4, bool> equal(const vec<4, T> &a, const vec<4, T> &b) {
+				if (SMATH_IS_CONSTANT_EVALUATED()) {
+					return compute_relational<4, T, false>::equal(a, b);
+				}
+				return vec4_mask_store(simd::bits(vec4_load(a) == vec4_load(b)));
+			}
+
+			SMATH_CONSTEXPR static vec<4, bool> not_equal(const vec<4, T> &a, const vec<4, T> &b) {
+				if (SMATH_IS_CONSTANT_EVALUATED()) {
+					return compute_relational<4, T, false>::not_equal(a, b);
+				}
+				return vec4_mask_store(simd::bits(vec4_load(a) != vec4_load(b)));
+			}
+
+			SMATH_CONSTEXPR static vec<4, T> select(const vec<4, bool> &mask, const vec<4, T> &a, const vec<4, T> &b) {
+				if (SMATH_IS_CONSTANT_EVALUATED()) {
+					return compute_relational<4, T, false>::select(mask, a, b);
+				}
+				return vec4_store(simd::select(vec4_mask_load<T>(mask), vec4_load(a), vec4_load(b)));
+			}
+		};
+
+	} // namespace detail
+
+} // namespace smath
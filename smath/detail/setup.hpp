@@ -130,4 +130,171 @@ namespace smath {
 
 #define SMATH_INLINE inline
 
+// for the kernels that only pay off once their constants are hoisted out of
+// the loop calling them, which compilers give up on past a size
+#if SMATH_COMPILER & SMATH_COMPILER_VC
+#	define SMATH_FORCE_INLINE __forceinline
+#elif SMATH_COMPILER & (SMATH_COMPILER_GCC | SMATH_COMPILER_CLANG)
+#	define SMATH_FORCE_INLINE inline __attribute__((__always_inline__))
+#else
+#	define SMATH_FORCE_INLINE inline
+#endif
+
+// -- is_constant_evaluated
+// P0595 std::is_constant_evaluated http://www.open-std.org/jtc1/sc22/wg21/docs/papers/2019/p0595r2.html
+#if defined(__has_builtin)
+#	if __has_builtin(__builtin_is_constant_evaluated)
+#		define SMATH_HAS_IS_CONSTANT_EVALUATED 1
+#	endif
+#endif
+
+#if !defined(SMATH_HAS_IS_CONSTANT_EVALUATED)
+#	if (defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 9) || (defined(_MSC_VER) && _MSC_VER >= 1925)
+#		define SMATH_HAS_IS_CONSTANT_EVALUATED 1
+#	else
+#		define SMATH_HAS_IS_CONSTANT_EVALUATED 0
+#	endif
+#endif
+
+#if SMATH_HAS_IS_CONSTANT_EVALUATED
+#	define SMATH_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#else
+#	define SMATH_IS_CONSTANT_EVALUATED() false
+#endif
+
+// -- bit_cast
+// P0476 std::bit_cast http://www.open-std.org/jtc1/sc22/wg21/docs/papers/2018/p0476r2.html
+#if defined(__has_builtin)
+#	if __has_builtin(__builtin_bit_cast)
+#		define SMATH_HAS_BUILTIN_BIT_CAST 1
+#	endif
+#endif
+
+#if !defined(SMATH_HAS_BUILTIN_BIT_CAST)
+#	if (defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11) || (defined(_MSC_VER) && _MSC_VER >= 1926)
+#		define SMATH_HAS_BUILTIN_BIT_CAST 1
+#	else
+#		define SMATH_HAS_BUILTIN_BIT_CAST 0
+#	endif
+#endif
+
+// functions built on bit casts are only constexpr with the builtin
+#if SMATH_HAS_BUILTIN_BIT_CAST
+#	define SMATH_CONSTEXPR_BIT_CAST SMATH_CONSTEXPR
+#else
+#	define SMATH_CONSTEXPR_BIT_CAST
+#endif
+
+//    _____ _____ __  __ _____
+//   / ____|_   _|  \/  |  __ \.
+//  | (___   | | | \  / | |  | |
+//   \___ \  | | | |\/| | |  | |
+//   ____) |_| |_| |  | | |__| |
+//  |_____/|_____|_|  |_|_____/
+//
+
+#define SMATH_ARCH_PURE_BIT    0x00000000
+#define SMATH_ARCH_SSE2_BIT    0x00000001
+#define SMATH_ARCH_SSE3_BIT    0x00000002
+#define SMATH_ARCH_SSSE3_BIT   0x00000004
+#define SMATH_ARCH_SSE41_BIT   0x00000008
+#define SMATH_ARCH_SSE42_BIT   0x00000010
+#define SMATH_ARCH_AVX_BIT     0x00000020
+#define SMATH_ARCH_AVX2_BIT    0x00000040
+#define SMATH_ARCH_AVX512_BIT  0x00000080
+#define SMATH_ARCH_FMA_BIT     0x00000100
+
+#define SMATH_ARCH_PURE    SMATH_ARCH_PURE_BIT
+#define SMATH_ARCH_SSE2    SMATH_ARCH_SSE2_BIT
+#define SMATH_ARCH_SSE3    (SMATH_ARCH_SSE3_BIT | SMATH_ARCH_SSE2)
+#define SMATH_ARCH_SSSE3   (SMATH_ARCH_SSSE3_BIT | SMATH_ARCH_SSE3)
+#define SMATH_ARCH_SSE41   (SMATH_ARCH_SSE41_BIT | SMATH_ARCH_SSSE3)
+#define SMATH_ARCH_SSE42   (SMATH_ARCH_SSE42_BIT | SMATH_ARCH_SSE41)
+#define SMATH_ARCH_AVX     (SMATH_ARCH_AVX_BIT | SMATH_ARCH_SSE42)
+#define SMATH_ARCH_AVX2    (SMATH_ARCH_AVX2_BIT | SMATH_ARCH_AVX)
+#define SMATH_ARCH_AVX512  (SMATH_ARCH_AVX512_BIT | SMATH_ARCH_AVX2)
+
+// only the instruction sets enabled at compile time are used (e.g. -mavx2 or /arch:AVX2),
+// defining SMATH_FORCE_PURE disables all of them
+#if defined(SMATH_FORCE_PURE)
+#	define SMATH_ARCH_ISA SMATH_ARCH_PURE
+#elif defined(__AVX512F__)
+#	define SMATH_ARCH_ISA SMATH_ARCH_AVX512
+#elif defined(__AVX2__)
+#	define SMATH_ARCH_ISA SMATH_ARCH_AVX2
+#elif defined(__AVX__)
+#	define SMATH_ARCH_ISA SMATH_ARCH_AVX
+#elif defined(__SSE4_2__)
+#	define SMATH_ARCH_ISA SMATH_ARCH_SSE42
+#elif defined(__SSE4_1__)
+#	define SMATH_ARCH_ISA SMATH_ARCH_SSE41
+#elif defined(__SSSE3__)
+#	define SMATH_ARCH_ISA SMATH_ARCH_SSSE3
+#elif defined(__SSE3__)
+#	define SMATH_ARCH_ISA SMATH_ARCH_SSE3
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#	define SMATH_ARCH_ISA SMATH_ARCH_SSE2
+#else
+#	define SMATH_ARCH_ISA SMATH_ARCH_PURE
+#endif
+
+// FMA is a separate extension, Visual C++ implies it with /arch:AVX2. It is kept with
+// SMATH_FORCE_PURE, since compilers fuse products on their own when the target has it
+#if defined(__FMA__) || defined(__ARM_FEATURE_FMA) || ((SMATH_ARCH_ISA & SMATH_ARCH_AVX2_BIT) && defined(_MSC_VER))
+#	define SMATH_ARCH (SMATH_ARCH_ISA | SMATH_ARCH_FMA_BIT)
+#else
+#	define SMATH_ARCH SMATH_ARCH_ISA
+#endif
+
+// -- Runtime dispatch
+// Kernels for newer instruction sets are compiled for every x86 target and only
+// selected at runtime when cpu_features() reports the host supports them.
+#if !defined(SMATH_FORCE_PURE) && (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86))
+#	define SMATH_HAS_CPU_DISPATCH 1
+#else
+#	define SMATH_HAS_CPU_DISPATCH 0
+#endif
+
+#if SMATH_HAS_CPU_DISPATCH && !(SMATH_COMPILER & SMATH_COMPILER_VC)
+#	define SMATH_TARGET(isa) __attribute__((target(isa)))
+#else
+#	define SMATH_TARGET(isa)
+#endif
+
+// -- SIMD vectors
+// Defining SMATH_FORCE_INTRINSICS before including smath stores and operates on
+// vec<4, float> and vec<4, double> using SIMD registers. Constant expressions
+// fall back to the scalar implementation, so this requires is_constant_evaluated.
+#if defined(SMATH_FORCE_INTRINSICS) && (SMATH_ARCH & SMATH_ARCH_SSE2_BIT) && SMATH_HAS_IS_CONSTANT_EVALUATED
+#	define SMATH_CONFIG_SIMD SMATH_ENABLE
+#else
+#	define SMATH_CONFIG_SIMD SMATH_DISABLE
+#endif
+
+// -- Expression templates
+// Defining SMATH_FORCE_EXPRESSIONS before including smath makes the soa_array
+// operators build lazy expressions, which are evaluated in a single pass over
+// the streams when assigned to an array.
+#if defined(SMATH_FORCE_EXPRESSIONS)
+#	define SMATH_CONFIG_EXPRESSIONS SMATH_ENABLE
+#else
+#	define SMATH_CONFIG_EXPRESSIONS SMATH_DISABLE
+#endif
+
+// -- Precision
+// Defining SMATH_DEFAULT_PRECISION as SMATH_PRECISION_FAST, SMATH_PRECISION_BALANCED
+// or SMATH_PRECISION_PRECISE before including smath sets the accuracy of the
+// approximated functions for the calls that do not pass a precision policy.
+#define SMATH_PRECISION_FAST     0
+#define SMATH_PRECISION_BALANCED 1
+#define SMATH_PRECISION_PRECISE  2
+
+#if !defined(SMATH_DEFAULT_PRECISION)
+#	define SMATH_DEFAULT_PRECISION SMATH_PRECISION_BALANCED
+#endif
+
+#if SMATH_DEFAULT_PRECISION != SMATH_PRECISION_FAST && SMATH_DEFAULT_PRECISION != SMATH_PRECISION_BALANCED && SMATH_DEFAULT_PRECISION != SMATH_PRECISION_PRECISE
+#	error "SMATH_DEFAULT_PRECISION must be SMATH_PRECISION_FAST, SMATH_PRECISION_BALANCED or SMATH_PRECISION_PRECISE"
+#endif
+
 #endif // SETUP_H
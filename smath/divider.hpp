@@ -0,0 +1,207 @@
+#pragma once
+
+#ifndef DIVIDER_H
+#define DIVIDER_H
+
+#include "detail/setup.hpp"
+
+#include "simd/simd.hpp"
+#include "template_types.hpp"
+#include "vec.hpp"
+
+namespace smath {
+
+	/**
+	 * Precomputed division by a runtime-invariant divisor, replacing the
+	 * hardware division with a multiply-high, shift and add.
+	 *
+	 * Credit to Hacker's Delight (Warren, chapter 10) and libdivide for the
+	 * magic number algorithm.
+	 *
+	 * @tparam T The type of the divisor, currently only int.
+	 */
+	template<class T>
+	struct divider;
+
+	template<>
+	struct divider<int> {
+
+		// -- Data --
+
+		int divisor;
+		int magic;
+		int shift;
+		int add_mask;
+		int sign_mask;
+
+		// -- Constructors --
+
+		/**
+		 * @brief Computes the magic number for dividing by `d`.
+		 * @param d The divisor, which must not be 0.
+		 */
+		explicit divider(int d)
+			: divisor(d), magic(0), shift(0), add_mask(0), sign_mask(d < 0 ? -1 : 0)
+		{
+			assert(d != 0 && "divider requires a non-zero divisor");
+
+			if (d == 1 || d == -1) {
+				return;
+			}
+
+			const unsigned two31{ 0x80000000u };
+			const unsigned ad{ d < 0 ? 0u - static_cast<unsigned>(d) : static_cast<unsigned>(d) };
+			const unsigned t{ two31 + (static_cast<unsigned>(d) >> 31) };
+			const unsigned anc{ t - 1 - t % ad };
+
+			int p{ 31 };
+			unsigned q1{ two31 / anc };
+			unsigned r1{ two31 - q1 * anc };
+			unsigned q2{ two31 / ad };
+			unsigned r2{ two31 - q2 * ad };
+			unsigned delta;
+
+			do {
+				++p;
+				q1 *= 2;
+				r1 *= 2;
+				if (r1 >= anc) {
+					++q1;
+					r1 -= anc;
+				}
+				q2 *= 2;
+				r2 *= 2;
+				if (r2 >= ad) {
+					++q2;
+					r2 -= ad;
+				}
+				delta = ad - r2;
+			} while (q1 < delta || (q1 == delta && r1 == 0));
+
+			const unsigned m{ q2 + 1 };
+			magic = static_cast<int>(d < 0 ? 0u - m : m);
+			shift = p - 32;
+
+			// the magic number overflowed into the sign bit, so the dividend is
+			// added back (or subtracted for a negative divisor) after multiplying
+			add_mask = ((d > 0 && magic < 0) || (d < 0 && magic > 0)) ? -1 : 0;
+		}
+
+		// -- Division --
+
+		/**
+		 * @brief Divides every lane of a SIMD batch, truncating towards zero
+		 * like operator/
+		 * @tparam B A batch of int lanes from smath::simd.
+		 * @returns The quotient of each lane.
+		 */
+		template<class B>
+		B divide(const B &n) const {
+			const B sign{ sign_mask };
+			if (magic == 0) {
+				// dividing by 1 or -1
+				return (n ^ sign) - sign;
+			}
+
+			B q{ mulhi(n, B(magic)) + (((n ^ sign) - sign) & B(add_mask)) };
+			q = q >> shift;
+			return q - (q >> 31);
+		}
+
+		/**
+		 * @brief Calculates the remainder of every lane of a SIMD batch, with the
+		 * sign of the dividend like operator%
+		 * @tparam B A batch of int lanes from smath::simd.
+		 * @returns The remainder of each lane.
+		 */
+		template<class B>
+		B remainder(const B &n) const {
+			return n - divide(n) * B(divisor);
+		}
+	};
+
+	namespace detail {
+
+		/**
+		 * @brief Applies a divider to every component of a vector using a single
+		 * 4-lane batch.
+		 */
+		template<length_t L, class F>
+		SMATH_INLINE vec<L, int> compute_divider(const vec<L, int> &v, F func) {
+			alignas(16) int lanes[4]{ 0, 0, 0, 0 };
+			for (length_t i = 0; i < L; ++i) {
+				lanes[i] = v[i];
+			}
+
+			func(simd::i32x4::load(lanes)).store(lanes);
+
+			vec<L, int> result;
+			for (length_t i = 0; i < L; ++i) {
+				result[i] = lanes[i];
+			}
+			return result;
+		}
+
+	} // namespace detail
+
+	/**
+	 * @brief Divides an integer using a precomputed divider.
+	 * @returns `n / d.divisor`
+	 */
+	SMATH_INLINE int operator/(int n, const divider<int> &d) {
+		return d.divide(simd::batch<int, 1>(n))[0];
+	}
+
+	/**
+	 * @brief Calculates the remainder of an integer using a precomputed divider.
+	 * @returns `n % d.divisor`
+	 */
+	SMATH_INLINE int operator%(int n, const divider<int> &d) {
+		return d.remainder(simd::batch<int, 1>(n))[0];
+	}
+
+	/**
+	 * @brief Divides every component of a vector using a precomputed divider.
+	 * @tparam L The number of components in the vector in range [1, 4]
+	 * @returns A vector where each component is `v[i] / d.divisor`.
+	 */
+	template<length_t L>
+	SMATH_INLINE vec<L, int> operator/(const vec<L, int> &v, const divider<int> &d) {
+		SMATH_STATIC_ASSERT(smath::is_valid_vector(L), "'operator/' only works on vectors with 1 to 4 components");
+		return detail::compute_divider(v, [&d](const simd::i32x4 &n) { return d.divide(n); });
+	}
+
+	/**
+	 * @brief Calculates the remainder of every component of a vector using a
+	 * precomputed divider.
+	 * @tparam L The number of components in the vector in range [1, 4]
+	 * @returns A vector where each component is `v[i] % d.divisor`.
+	 */
+	template<length_t L>
+	SMATH_INLINE vec<L, int> operator%(const vec<L, int> &v, const divider<int> &d) {
+		SMATH_STATIC_ASSERT(smath::is_valid_vector(L), "'operator%' only works on vectors with 1 to 4 components");
+		return detail::compute_divider(v, [&d](const simd::i32x4 &n) { return d.remainder(n); });
+	}
+
+	/**
+	 * @brief Divides every lane of a SIMD batch using a precomputed divider.
+	 * @returns A batch where each lane is `n[i] / d.divisor`.
+	 */
+	template<length_t N>
+	SMATH_INLINE simd::batch<int, N> operator/(const simd::batch<int, N> &n, const divider<int> &d) {
+		return d.divide(n);
+	}
+
+	/**
+	 * @brief Calculates the remainder of every lane of a SIMD batch using a
+	 * precomputed divider.
+	 * @returns A batch where each lane is `n[i] % d.divisor`.
+	 */
+	template<length_t N>
+	SMATH_INLINE simd::batch<int, N> operator%(const simd::batch<int, N> &n, const divider<int> &d) {
+		return d.remainder(n);
+	}
+
+} // namespace smath
+
+#endif // DIVIDER_H
@@ -3,105 +3,2208 @@
 #ifndef EXPONENTIAL_H
 #define EXPONENTIAL_H
 
+#include <cassert>
 #include <cmath>
 #include <cstdint>
+#include <limits>
+#include <type_traits>
 
 #include "detail/setup.hpp"
+#include "detail/bit_cast.hpp"
 #include "detail/function.hpp"
 
+#include "precision.hpp"
+#include "simd/simd.hpp"
+#include "span.hpp"
 #include "template_types.hpp"
 #include "vec.hpp"
 
 namespace smath {
 
+	namespace detail {
+
+		template<class T>
+		struct inv_sqrt_magic;
+
+		template<>
+		struct inv_sqrt_magic<float> {
+			using bits_type = std::uint32_t;
+			static const bits_type value = 0x5f375a86;
+		};
+
+		template<>
+		struct inv_sqrt_magic<double> {
+			using bits_type = std::uint64_t;
+			static const bits_type value = 0x5fe6eb50c7b537a9;
+		};
+
+		/**
+		 * Denormals have no exponent for the estimates to halve, so they are
+		 * scaled up by 2^64 into the normal range and their inverse square
+		 * roots by 2^32 afterwards.
+		 */
+		template<class T>
+		struct inv_sqrt_denormal {
+			static constexpr T scale = T(18446744073709551616.0);
+			static constexpr T root = T(4294967296.0);
+		};
+
+		/**
+		 * @brief Estimates the inverse square root with the bit trick, followed by
+		 * `steps` Newton steps that each square the relative error, starting from
+		 * below 2e-3 after the first step. The last step adds a small correction
+		 * to `y`, which rounds less than scaling `y` by a factor near 1.
+		 *
+		 * Credit to Quake III: Arena for the first implementation, and to
+		 * https://cs.uwaterloo.ca/~m32rober/rsqrt.pdf for the double constant.
+		 */
+		template<class T>
+		SMATH_CONSTEXPR_BIT_CAST T inv_sqrt_estimate(T a, int steps) {
+			if (!(a > T(0))) {
+				return (a == T(0)) ? std::numeric_limits<T>::infinity() : std::numeric_limits<T>::quiet_NaN();
+			}
+			if (a == std::numeric_limits<T>::infinity()) {
+				return T(0);
+			}
+			if (a < std::numeric_limits<T>::min()) {
+				return inv_sqrt_estimate(a * inv_sqrt_denormal<T>::scale, steps) * inv_sqrt_denormal<T>::root;
+			}
+
+			using U = typename inv_sqrt_magic<T>::bits_type;
+			const T h{ a * T(0.5) };
+			T y{ bit_cast<T>(static_cast<U>(inv_sqrt_magic<T>::value - (bit_cast<U>(a) >> 1))) };
+			for (int i = 1; i < steps; ++i) {
+				y = y * (T(1.5) - h * y * y);
+			}
+			// floats take the last step in double, which leaves only the final rounding
+			using W = typename std::conditional<sizeof(T) == sizeof(float), double, T>::type;
+			const W w{ static_cast<W>(y) };
+			return static_cast<T>(w + w * (W(0.5) - static_cast<W>(h) * (w * w)));
+		}
+
+		template<class B>
+		SMATH_INLINE B inv_sqrt_precise(const B &a);
+
+		/**
+		 * @brief Calculates `1 / sqrt(a)` within 1 ULP. A float is computed in
+		 * double, which leaves only the final rounding.
+		 */
+		inline float inv_sqrt_precise(float a) {
+			return static_cast<float>(1.0 / ::std::sqrt(static_cast<double>(a)));
+		}
+
+		inline double inv_sqrt_precise(double a) {
+			return inv_sqrt_precise(simd::batch<double, 1>(a))[0];
+		}
+
+		template<accuracy A, class T>
+		SMATH_CONSTEXPR_BIT_CAST T inv_sqrt_scalar(T a) {
+			if constexpr (A == accuracy::fast) {
+				return inv_sqrt_estimate(a, 2);
+			} else if constexpr (A == accuracy::precise) {
+				return inv_sqrt_precise(a);
+			} else {
+				return inv_sqrt_estimate(a, sizeof(T) == sizeof(float) ? 3 : 4);
+			}
+		}
+
+		/**
+		 * @brief Refines the estimate `e` of the inverse square root of `a` to
+		 * below 2 ULP, where `c = 1/2 - a * e^2 / 2` is the relative correction.
+		 * Floats take one step of second order, `e + e * c * (1 + 3c / 2)`,
+		 * which cubes the error of the estimate, while doubles take a Newton step
+		 * before the correction. Adding the small correction to `e` last keeps
+		 * the rounding errors below 1 ULP.
+		 */
+		template<class B>
+		SMATH_INLINE B inv_sqrt_refine(const B &a, const B &e) {
+			using T = typename B::value_type;
+			const B h{ a * B(T(0.5)) };
+			if (sizeof(T) == sizeof(float)) {
+				const B c{ B(T(0.5)) - h * (e * e) };
+				return e + e * (c * (B(T(1)) + B(T(1.5)) * c));
+			}
+			const B y{ e * (B(T(1.5)) - h * (e * e)) };
+			return y + y * (B(T(0.5)) - h * (y * y));
+		}
+
+		/**
+		 * @brief Calculates the inverse square root of every lane of a batch from
+		 * the estimate instruction of the backend.
+		 */
+		template<accuracy A, class B>
+		SMATH_INLINE B inv_sqrt_batch(const B &a) {
+			using T = typename B::value_type;
+			if constexpr (A == accuracy::precise) {
+				return inv_sqrt_precise(a);
+			} else {
+				// the estimate instructions flush denormals to zero
+				const auto tiny = a < B(::std::numeric_limits<T>::min());
+				const B x{ select(tiny, a * B(inv_sqrt_denormal<T>::scale), a) };
+				const B root{ select(tiny, B(inv_sqrt_denormal<T>::root), B(T(1))) };
+				const B e{ rsqrt(x) };
+				if constexpr (A == accuracy::fast) {
+					return e * root;
+				} else {
+					const B y{ inv_sqrt_refine(x, e) };
+					// the steps give NaN for zero and infinity, whose estimate is exact
+					return select(y == y, y, e) * root;
+				}
+			}
+		}
+
+		/**
+		 * @brief Template class to compute the inverse square root of every
+		 * component, specialized in exponential_simd.inl for vectors stored in
+		 * SIMD registers.
+		 * @tparam L The number of components of the vector.
+		 * @tparam T The type of the vector (float, double)
+		 * @tparam Simd Whether the vector is stored in a SIMD register.
+		 */
+		template<length_t L, class T, bool Simd>
+		struct compute_inv_sqrt {
+			template<accuracy A>
+			SMATH_CONSTEXPR_BIT_CAST static vec<L, T> call(const vec<L, T> &v, precision<A>) {
+				return function::map([](T x) { return inv_sqrt_scalar<A>(x); }, v);
+			}
+		};
+
+		/**
+		 * @brief Template class to compute the square root of every component,
+		 * specialized in exponential_simd.inl for vectors stored in SIMD
+		 * registers.
+		 * @tparam L The number of components of the vector.
+		 * @tparam T The type of the vector (int, float, double)
+		 * @tparam Simd Whether the vector is stored in a SIMD register.
+		 */
+		template<length_t L, class T, bool Simd>
+		struct compute_sqrt {
+			template<accuracy A>
+			SMATH_CONSTEXPR static vec<L, T> call(const vec<L, T> &v, precision<A>) {
+				return function::map([](T x) { return ::std::sqrt(x); }, v);
+			}
+		};
+
+	} // namespace detail
+
 	/**
-	 * @brief Performs the fast, inverse square root of a floating-point number
-	 * with 7 digits of precision.
+	 * @brief Performs the inverse square root of a floating-point number.
 	 *
-	 * Credit to Quake III: Arena for first implementation of the fast, inverse
-	 * square root.
+	 * `fast` and `balanced` use the bit trick with 2 or 3 Newton steps, for a
+	 * relative error below 5e-6 or 2 ULP, denormals included, and are constexpr
+	 * when the compiler has a builtin bit cast.
 	 *
-	 * @returns The inverse square root of a given floating-point number, up
-	 * to 7 digits of precision.
+	 * @param acc The trade-off between speed and accuracy.
+	 * @returns The inverse square root of the input number.
 	 */
-	SMATH_CONSTEXPR float inv_sqrt(const float &a) {
-		float y{ a };
-		float x{ y * 0.5f };
-
-		std::uint_fast32_t i = *(std::uint_fast32_t *) &y;
-		i = 0x5f375a86 - (i >> 1);
-		y = *(float *) &i;
-		y = y * (1.5f - (x * y * y));
-		y = y * (1.5f - (x * y * y));
-		return y;
+	template<class P = default_precision, class = detail::enable_precision<P>>
+	SMATH_INLINE SMATH_CONSTEXPR_BIT_CAST float inv_sqrt(const float &a, P acc = P()) {
+		return detail::with_precision(acc, [a](auto p) { return detail::inv_sqrt_scalar<decltype(p)::value>(a); });
 	}
 
 	/**
-	 * @brief Performs the fast, inverse square root of a floating-point number
-	 * with 15 digits of precision.
+	 * @brief Performs the inverse square root of a floating-point number.
 	 *
-	 * Credit to https://cs.uwaterloo.ca/~m32rober/rsqrt.pdf for the extension
-	 * of the fast, inverse square root to work with higher precision.
+	 * `fast` and `balanced` use the bit trick with 2 or 4 Newton steps, for a
+	 * relative error below 5e-6 or 2 ULP.
 	 *
-	 * @returns The inverse square root of a given floating-point number, up
-	 * to 15 digits of precision.
+	 * @param acc The trade-off between speed and accuracy.
+	 * @returns The inverse square root of the input number.
 	 */
-	SMATH_CONSTEXPR double inv_sqrt(const double &a) {
-		double y{ a };
-		double x{ y * 0.5 };
+	template<class P = default_precision, class = detail::enable_precision<P>>
+	SMATH_INLINE SMATH_CONSTEXPR_BIT_CAST double inv_sqrt(const double &a, P acc = P()) {
+		return detail::with_precision(acc, [a](auto p) { return detail::inv_sqrt_scalar<decltype(p)::value>(a); });
+	}
 
-		std::uint_fast64_t i = *(std::uint_fast64_t *) &y;
-		i = 0x5fe6eb50c7b537a9 - (i >> 1);
-		y = *(double *) &i;
-		y = y * (1.5 - (x * y * y));
-		y = y * (1.5 - (x * y * y));
-		return y;
+	/**
+	 * @brief Performs the inverse square root on all of the components of a
+	 * vector. Vectors stored in SIMD registers use the estimate instruction
+	 * of the target, refined by Newton steps for `balanced`.
+	 * @tparam L The number of components in the vector in range [1, 4]
+	 * @tparam T The type of the vector (float, double)
+	 * @param acc The trade-off between speed and accuracy.
+	 * @returns A vector containing the inverse square root of all the components.
+	 */
+	template<length_t L, class T, class P = default_precision, class = detail::enable_precision<P>>
+	SMATH_INLINE SMATH_CONSTEXPR_BIT_CAST vec<L, T> inv_sqrt(const vec<L, T> &v, P acc = P()) {
+		SMATH_STATIC_ASSERT(smath::is_floating_type<T>::value, "'inv_sqrt' only accepts a floating-point vector");
+		SMATH_STATIC_ASSERT(smath::is_valid_vector(L), "'inv_sqrt' only works on vectors with 1 to 4 components");
+		return detail::with_precision(acc, [&v](auto p) { return detail::compute_inv_sqrt<L, T, detail::is_simd<L, T>::value>::call(v, p); });
 	}
 
 	/**
-	 * @brief Performs the square root of a floating-point number.
-	 * @returns The square root of the floating-point input number.
+	 * @brief Performs the square root of a number.
+	 *
+	 * Every accuracy gets the correctly rounded result, which the hardware
+	 * computes faster than an estimate can be refined for a single value.
+	 *
+	 * @returns The square root of the input number.
 	 */
-	template<class T>
-	SMATH_INLINE SMATH_CONSTEXPR const T sqrt(const T &a) {
+	template<class T, class P = default_precision, class = detail::enable_precision<P>>
+	SMATH_INLINE SMATH_CONSTEXPR const T sqrt(const T &a, P = P()) {
 		return ::std::sqrt(a);
 	}
 
 	/**
 	 * @brief Performs the square root on all of the components of a vector.
+	 *
+	 * `fast` multiplies SIMD vectors by the estimate of the inverse square
+	 * root, for a relative error below 5e-4. Otherwise, and for the other
+	 * vectors, the result is correctly rounded.
+	 *
 	 * @tparam L The number of components in the vector in range [1, 4]
 	 * @tparam T The type of the vector (int, float, double)
+	 * @param acc The trade-off between speed and accuracy.
 	 * @returns A vector containing the square root of all the components.
 	 */
-	template<length_t L, class T>
-	SMATH_INLINE SMATH_CONSTEXPR vec<L, T> sqrt(const vec<L, T> &v) {
+	template<length_t L, class T, class P = default_precision, class = detail::enable_precision<P>>
+	SMATH_INLINE SMATH_CONSTEXPR vec<L, T> sqrt(const vec<L, T> &v, P acc = P()) {
 		SMATH_STATIC_ASSERT(smath::is_integer_type<T>::value || smath::is_floating_type<T>::value, "'sqrt' only accepts an integer or floating-point vector");
 		SMATH_STATIC_ASSERT(smath::is_valid_vector(L), "'sqrt' only works on vectors with 1 to 4 components");
-		return function::one<vec, L, T, T>::apply(::std::sqrt, v);
+		return detail::with_precision(acc, [&v](auto p) { return detail::compute_sqrt<L, T, detail::is_simd<L, T>::value>::call(v, p); });
 	}
 
 	/**
-	 * @brief Performs the log of a floating-point number.
-	 * @returns The log of the floating-point input number.
+	 * @brief Performs the log of an integer, with the result of std::log
+	 * truncated. `float` and `double` have overloads with an accuracy below.
+	 * @returns The log of the input number.
 	 */
 	template<class T>
 	SMATH_INLINE SMATH_CONSTEXPR const T log(const T &a) {
 		return ::std::log(a);
 	}
 
+	namespace detail {
+
+		/**
+		 * Constants of the exponential kernels. ln(2) is split so that `k * ln2_hi`
+		 * is exact for every exponent `k` (Cody and Waite), and the polynomials,
+		 * with the highest degree first, approximate `e^r` for `|r| <= ln(2) / 2`.
+		 */
+		template<class T>
+		struct exp_constants;
+
+		template<>
+		struct exp_constants<float> {
+			static constexpr float log2e = 1.44269504088896341f;
+			static constexpr float ln2 = 0.693147180559945309f;
+			static constexpr float ln2_hi = 6.9314575195e-01f;
+			static constexpr float ln2_lo = 1.4286067653e-06f;
+			static constexpr float ln2_tail = -1.9046543e-09f;
+
+			// normal powers of two used to scale results, and the precision
+			static constexpr float min_scale = -125.f;
+			static constexpr float max_scale = 127.f;
+			static constexpr float digits = 24.f;
+			static constexpr float two_digits = 16777216.f;
+			// multiplying by 2^12 + 1 splits a factor into two halves (Veltkamp)
+			static constexpr float product_split = 4097.f;
+
+			// inputs beyond which e^x or 2^x overflows or underflows to 0, and
+			// e^x - 1 rounds to -1
+			static constexpr float max_exp = 89.f;
+			static constexpr float min_exp = -104.f;
+			static constexpr float max_exp2 = 129.f;
+			static constexpr float min_exp2 = -151.f;
+			static constexpr float min_expm1 = -18.f;
+			static constexpr float max_pow = 17179869184.f;
+
+			// e^r = 1 + r + r^2 * p(r), minimax for `fast` and Cephes for `balanced`
+			static constexpr float fast[2]{ 1.6950570e-1f, 5.0484375e-1f };
+			static constexpr float balanced[6]{ 1.9875691500e-4f, 1.3981999507e-3f, 8.3334519073e-3f, 4.1665795894e-2f, 1.6666665459e-1f, 5.0000001201e-1f };
+
+			// r * (e^r + 1) / (e^r - 1) = 2 + r^2 * p(r^2), from FreeBSD
+			static constexpr float precise[2]{ -2.7667332906e-3f, 1.6666625440e-1f };
+
+			// the rational approximation of e^r - 1 used by FreeBSD's expm1
+			static constexpr float expm1_precise[2]{ 1.5807170421e-3f, -3.3333212137e-2f };
+		};
+
+		template<>
+		struct exp_constants<double> {
+			static constexpr double log2e = 1.44269504088896338700e+00;
+			static constexpr double ln2 = 6.93147180559945286227e-01;
+			static constexpr double ln2_hi = 6.93147180369123816490e-01;
+			static constexpr double ln2_lo = 1.90821492927058770002e-10;
+			static constexpr double ln2_tail = 2.3190468138462996e-17;
+
+			static constexpr double min_scale = -1021.0;
+			static constexpr double max_scale = 1023.0;
+			static constexpr double digits = 53.0;
+			static constexpr double two_digits = 9007199254740992.0;
+			static constexpr double product_split = 134217729.0;
+
+			static constexpr double max_exp = 710.0;
+			static constexpr double min_exp = -746.0;
+			static constexpr double max_exp2 = 1025.0;
+			static constexpr double min_exp2 = -1076.0;
+			static constexpr double min_expm1 = -38.0;
+			static constexpr double max_pow = 73786976294838206464.0;
+
+			static constexpr double fast[2]{ 1.6950570e-1, 5.0484375e-1 };
+
+			// 2^(r / 4) for r in [-1/2, 1/2], fitted to about 2^-28 and squared
+			// twice, which is enough for floats evaluated in double
+			static constexpr double pow_float[5]{
+				3.758257036326025e-05, 8.676586785280673e-04, 1.501415595032314e-02, 1.7328676970255974e-01, 1.0
+			};
+
+			// the Taylor series up to r^13
+			static constexpr double balanced[12]{
+				1.6059043836821613e-10, 2.0876756987868099e-09, 2.5052108385441720e-08, 2.7557319223985888e-07,
+				2.7557319223985893e-06, 2.4801587301587302e-05, 1.9841269841269841e-04, 1.3888888888888889e-03,
+				8.3333333333333332e-03, 4.1666666666666664e-02, 1.6666666666666666e-01, 5.0000000000000000e-01
+			};
+
+			static constexpr double precise[5]{
+				4.13813679705723846039e-08, -1.65339022054652515390e-06, 6.61375632143793436117e-05,
+				-2.77777777770155933842e-03, 1.66666666666666019037e-01
+			};
+
+			static constexpr double expm1_precise[5]{
+				-2.01099218183624371326e-07, 4.00821782732936239552e-06, -7.93650757867487942473e-05,
+				1.58730158725481460165e-03, -3.33333333333331316428e-02
+			};
+		};
+
+		/**
+		 * Constants of the logarithm kernels, for `1 + f` in [sqrt(2) / 2, sqrt(2)].
+		 * The polynomials have the highest degree first, and the multipliers of
+		 * log2 and log10 are split like ln(2) (fdlibm).
+		 */
+		template<class T>
+		struct log_constants;
+
+		template<>
+		struct log_constants<float> {
+			// log(1 + f) = f - f^2 / 2 + f^3 * p(f), minimax for `fast`
+			static constexpr float fast[3]{ 0.12640222f, -0.25941026f, 0.34034373f };
+
+			// log(1 + f) = 2 * atanh(s) with s = f / (2 + f), in powers of s^2, from FreeBSD
+			static constexpr float precise[4]{ 0.24279078841209412f, 0.2849878668785095f, 0.40000972151756287f, 0.6666666269302368f };
+
+			// multiplying by split + 1 keeps the top half of the bits
+			static constexpr float split = 4097.f;
+			static constexpr float log2e_hi = 1.4428710938e+00f;
+			static constexpr float log2e_lo = -1.7605285393e-04f;
+			static constexpr float log10e_hi = 4.3432617188e-01f;
+			static constexpr float log10e_lo = -3.1689971365e-05f;
+			static constexpr float log10_2_hi = 3.0102920532e-01f;
+			static constexpr float log10_2_lo = 7.9034151668e-07f;
+			static constexpr float log10e = 0.434294481903251827651f;
+		};
+
+		template<>
+		struct log_constants<double> {
+			static constexpr double fast[3]{ 0.12640222114837424, -0.2594102633722427, 0.340343729442484 };
+
+			static constexpr double precise[7]{
+				1.479819860511658591e-01, 1.531383769920937332e-01, 1.818357216161805012e-01, 2.222219843214978396e-01,
+				2.857142874366239149e-01, 3.999999999940941908e-01, 6.666666666666735130e-01
+			};
+
+			// log2(1 + f) = s * p(s^2) with s = f / (2 + f), fitted to about 2^-37,
+			// which is enough for floats evaluated in double
+			static constexpr double pow_float[5]{
+				0.3407120415619086, 0.41167376623771057, 0.5770835660048659, 0.9617966734515485, 2.885390081789987
+			};
+
+			static constexpr double split = 4294967297.0;
+			static constexpr double log2e_hi = 1.44269504072144627571e+00;
+			static constexpr double log2e_lo = 1.67517131648865118353e-10;
+			static constexpr double log10e_hi = 4.34294481878168880939e-01;
+			static constexpr double log10e_lo = 2.50829467116452752298e-11;
+			static constexpr double log10_2_hi = 3.01029995663611771306e-01;
+			static constexpr double log10_2_lo = 3.69423907715893078616e-13;
+			static constexpr double log10e = 0.434294481903251827651;
+		};
+
+		/**
+		 * @brief Evaluates a polynomial with Horner's rule.
+		 * @param c The coefficients, with the highest degree first.
+		 */
+		template<class B, class T, std::size_t N>
+		SMATH_INLINE B horner(const B &x, const T (&c)[N]) {
+			B r{ c[0] };
+			for (std::size_t i = 1; i < N; ++i) {
+				r = r * x + B(c[i]);
+			}
+			return r;
+		}
+
+		/**
+		 * @brief Calculates the rounding error of `p = a * b`, so that `a * b` is
+		 * exactly `p` plus the result. Without FMA instructions, the factors are
+		 * split into halves whose products are exact (Dekker).
+		 */
+		template<class B>
+		SMATH_INLINE B product_error(const B &a, const B &b, const B &p) {
+#if SMATH_ARCH & SMATH_ARCH_FMA_BIT
+			return fma(a, b, -p);
+#else
+			using C = exp_constants<typename B::value_type>;
+			const B sa{ a * B(C::product_split) };
+			const B sb{ b * B(C::product_split) };
+			const B a_hi{ sa - (sa - a) };
+			const B b_hi{ sb - (sb - b) };
+			const B a_lo{ a - a_hi };
+			const B b_lo{ b - b_hi };
+			return (((a_hi * b_hi - p) + a_hi * b_lo) + a_lo * b_hi) + a_lo * b_lo;
+#endif
+		}
+
+		/**
+		 * @brief Calculates the square root of every lane of a batch, as `a` times
+		 * the estimate of its inverse square root for `fast`.
+		 */
+		template<accuracy A, class B>
+		SMATH_INLINE B sqrt_batch(const B &a) {
+			using T = typename B::value_type;
+			using C = exp_constants<T>;
+			if constexpr (A != accuracy::fast) {
+				return sqrt(a);
+			} else {
+				// the estimates flush denormals to zero, so they are scaled up by
+				// an even power of two first
+				const auto tiny = a < B(::std::numeric_limits<T>::min());
+				const B x{ select(tiny, a * B(C::two_digits) * B(C::two_digits), a) };
+				const B r{ x * rsqrt(x) };
+				const B y{ select(tiny, r * B(T(1) / C::two_digits), r) };
+				// 0 * inf and inf * 0 are NaN, while the square roots are exact
+				return select((a == B(T(0))) | (a == B(::std::numeric_limits<T>::infinity())), a, y);
+			}
+		}
+
+		/**
+		 * @brief Approximates `e^r - 1` as `hi - d` for `r = hi - lo` in
+		 * [-ln(2) / 2, ln(2) / 2], where `lo` holds the rounding error of the
+		 * reduction. Keeping `hi` apart lets the callers add it to 1 or to
+		 * `1 - 2^-k` before the smaller correction.
+		 * @returns The correction `d`.
+		 */
+		template<accuracy A, class B>
+		SMATH_INLINE B expm1_correction(const B &hi, const B &lo) {
+			using T = typename B::value_type;
+			using C = exp_constants<T>;
+			const B r{ hi - lo };
+			if constexpr (A == accuracy::fast) {
+				return lo - r * r * horner(r, C::fast);
+			} else if constexpr (A == accuracy::precise) {
+				// e^r - 1 = r + r * c / (2 - c)
+				const B c{ r - r * r * horner(r * r, C::precise) };
+				return lo - (r * c) / (B(T(2)) - c);
+			} else {
+				return lo - r * r * horner(r, C::balanced);
+			}
+		}
+
+		/**
+		 * @brief Multiplies every lane by `2^k` with a single rounding, for `p`
+		 * in [0.5, 2] and whole `k` up to twice the range of normal exponents.
+		 */
+		template<class B>
+		SMATH_INLINE B scale_pow2(const B &p, const B &k) {
+			using C = exp_constants<typename B::value_type>;
+			const B k1{ min(max(k, B(C::min_scale)), B(C::max_scale)) };
+			return p * pow2i(k1) * pow2i(k - k1);
+		}
+
+		/**
+		 * @brief Calculates `e^x` for every lane of a batch, with `x = k * ln(2) + r`.
+		 */
+		template<accuracy A, class B>
+		SMATH_INLINE B exp_batch(const B &x) {
+			using T = typename B::value_type;
+			using C = exp_constants<T>;
+			// clamping keeps `k` in range, and the results still overflow or underflow
+			const B xc{ min(max(x, B(C::min_exp)), B(C::max_exp)) };
+			const B k{ nearbyint(xc * B(C::log2e)) };
+			const B hi{ xc - k * B(C::ln2_hi) };
+			const B lo{ k * B(C::ln2_lo) };
+			return select(x == x, scale_pow2(B(T(1)) - (expm1_correction<A>(hi, lo) - hi), k), x);
+		}
+
+		/**
+		 * @brief Calculates `1 / sqrt(a)` for every lane of a batch within 1 ULP.
+		 * `1 / sqrt(a)` alone rounds twice, so the errors of `s = sqrt(a)` and of
+		 * `y = 1 / s` are recovered exactly as `a - s^2` and `1 - s * y`, and
+		 * corrected with `1 / sqrt(a) ~ y * (1 + (1 - s * y) - (a - s^2) * y^2 / 2)`.
+		 */
+		template<class B>
+		SMATH_INLINE B inv_sqrt_precise(const B &a) {
+			using T = typename B::value_type;
+			// small inputs are scaled up, since the rounding errors of their
+			// squares would be denormals that lose bits
+			const auto tiny = a < B(T(1) / inv_sqrt_denormal<T>::scale);
+			const B x{ select(tiny, a * B(inv_sqrt_denormal<T>::scale), a) };
+			const B s{ sqrt(x) };
+			const B y{ B(T(1)) / s };
+			const B sy{ s * y };
+			const B ss{ s * s };
+			const B c{ ((B(T(1)) - sy) - product_error(s, y, sy)) - ((x - ss) - product_error(s, s, ss)) * (B(T(0.5)) * (y * y)) };
+			const B r{ y + y * c };
+			// the correction is NaN for zero and infinity, whose `y` is exact
+			return select(r == r, r, y) * select(tiny, B(inv_sqrt_denormal<T>::root), B(T(1)));
+		}
+
+		/**
+		 * @brief Calculates `2^x` for every lane of a batch.
+		 */
+		template<accuracy A, class B>
+		SMATH_INLINE B exp2_batch(const B &x) {
+			using T = typename B::value_type;
+			using C = exp_constants<T>;
+			const B xc{ min(max(x, B(C::min_exp2)), B(C::max_exp2)) };
+			const B k{ nearbyint(xc) };
+			const B r{ xc - k };
+			const B hi{ r * B(C::ln2) };
+			// the rounding error of `r * ln(2)` is only worth keeping for `precise`
+			B lo{ T(0) };
+			if constexpr (A == accuracy::precise) {
+				lo = -(product_error(r, B(C::ln2), hi) + r * B(C::ln2_tail));
+			}
+			return select(x == x, scale_pow2(B(T(1)) - (expm1_correction<A>(hi, lo) - hi), k), x);
+		}
+
+		/**
+		 * @brief Calculates `e^x - 1` within 1 ULP for `x = k * ln(2) + hi - lo`,
+		 * evaluating every case of FreeBSD's expm1 and selecting one per lane.
+		 */
+		template<class B>
+		SMATH_INLINE B expm1_precise(const B &hi, const B &lo, const B &k) {
+			using T = typename B::value_type;
+			using C = exp_constants<T>;
+			const B one{ T(1) };
+			const B half{ T(0.5) };
+			const B two{ T(2) };
+
+			// r + c is the reduced argument, with c the rounding error of r
+			const B r{ hi - lo };
+			const B c{ (hi - r) - lo };
+			const B hfx{ r * half };
+			const B hxs{ r * hfx };
+			const B r1{ one + hxs * horner(hxs, C::expm1_precise) };
+			const B t{ B(T(3)) - r1 * hfx };
+			const B e0{ hxs * ((r1 - t) / (B(T(6)) - r * t)) };
+			const B e{ r * (e0 - c) - c - hxs };
+
+			const B p{ pow2i(min(max(-k, B(C::min_scale)), B(C::max_scale))) };
+			const B y_zero{ r - (r * e0 - hxs) };
+			const B y_minus_one{ half * (r - e) - half };
+			const B y_one{ select(r < B(T(-0.25)), -two * (e - (r + half)), one + two * (r - e)) };
+			const B y_far{ scale_pow2(one - (e - r), k) - one };
+			const B y_near{ scale_pow2((one - p) - (e - r), k) };
+			const B y_mid{ scale_pow2((r - (e + p)) + one, k) };
+
+			return select(k == B(T(0)), y_zero,
+				select(k == B(T(-1)), y_minus_one,
+				select(k == one, y_one,
+				select((k < B(T(-1))) | (k > B(T(56))), y_far,
+				select(k < B(T(20)), y_near, y_mid)))));
+		}
+
+		/**
+		 * @brief Calculates `e^x - 1` for every lane of a batch, accurately for
+		 * `x` near 0.
+		 */
+		template<accuracy A, class B>
+		SMATH_INLINE B expm1_batch(const B &x) {
+			using T = typename B::value_type;
+			using C = exp_constants<T>;
+			const B xc{ min(max(x, B(C::min_expm1)), B(C::max_exp)) };
+			const B k{ nearbyint(xc * B(C::log2e)) };
+			const B hi{ xc - k * B(C::ln2_hi) };
+			const B lo{ k * B(C::ln2_lo) };
+
+			B r;
+			if constexpr (A == accuracy::precise) {
+				r = expm1_precise(hi, lo, k);
+			} else {
+				// 2^k * (1 - 2^-k + hi - d), adding the exact terms first: `1 - 2^-k`
+				// while it fits in the precision, and only 1 once `2^-k` is too small.
+				// The `fast` polynomial is fitted relative to e^r rather than e^r - 1,
+				// which loses too much near 0, so both tiers use `balanced`
+				const B d{ expm1_correction<accuracy::balanced>(hi, lo) };
+				const B p{ pow2i(max(-k, B(C::min_scale))) };
+				const auto low = k < B(C::digits);
+				const B a{ select(low, B(T(1)) - p, B(T(1))) + hi };
+				r = scale_pow2(a - (d + select(low, B(T(0)), p)), k);
+			}
+			// zeros keep their sign
+			return select((x == B(T(0))) | (x != x), x, r);
+		}
+
+		/**
+		 * @brief Splits positive normal lanes into `2^e * (1 + f)`, with `1 + f`
+		 * in [sqrt(2) / 2, sqrt(2)].
+		 */
+		template<class B>
+		SMATH_INLINE void log_reduce_normal(const B &x, B &e, B &f) {
+			using T = typename B::value_type;
+			const B m{ mantissa(x) };
+			const auto big = m > B(T(1.41421356237309504880));
+			e = exponent(x) + select(big, B(T(1)), B(T(0)));
+			f = select(big, m * B(T(0.5)), m) - B(T(1));
+		}
+
+		/**
+		 * @brief Splits positive lanes as log_reduce_normal. Denormals are scaled
+		 * into the normal range first.
+		 */
+		template<class B>
+		SMATH_INLINE void log_reduce(const B &x, B &e, B &f) {
+			using T = typename B::value_type;
+			using C = exp_constants<T>;
+			const auto tiny = x < B(::std::numeric_limits<T>::min());
+			log_reduce_normal(select(tiny, x * B(C::two_digits), x), e, f);
+			e = e - select(tiny, B(C::digits), B(T(0)));
+		}
+
+		/**
+		 * @brief Splits `log(1 + f)` for `1 + f` in [sqrt(2) / 2, sqrt(2)] into
+		 * `f - h + t`, with `h = f^2 / 2`. `balanced` and `precise` use the
+		 * fdlibm kernel, whose division costs less than a longer polynomial.
+		 */
+		template<accuracy A, class B>
+		SMATH_INLINE void log1p_terms(const B &f, B &h, B &t) {
+			using T = typename B::value_type;
+			using C = log_constants<T>;
+			if constexpr (A == accuracy::fast) {
+				const B z{ f * f };
+				h = B(T(0.5)) * z;
+				t = f * z * horner(f, C::fast);
+			} else {
+				const B s{ f / (B(T(2)) + f) };
+				const B z{ s * s };
+				h = B(T(0.5)) * f * f;
+				t = s * (h + z * horner(z, C::precise));
+			}
+		}
+
+		/**
+		 * @brief Calculates `log(1 + f)` for `1 + f` in [sqrt(2) / 2, sqrt(2)].
+		 */
+		template<accuracy A, class B>
+		SMATH_INLINE B log1p_reduced(const B &f) {
+			B h, t;
+			log1p_terms<A>(f, h, t);
+			return f - (h - t);
+		}
+
+		/**
+		 * @brief Replaces the result of a logarithm kernel for the lanes where
+		 * `x` is 0, negative, infinite or NaN.
+		 */
+		template<class B>
+		SMATH_INLINE B log_special(const B &x, const B &r) {
+			using T = typename B::value_type;
+			const B inf{ ::std::numeric_limits<T>::infinity() };
+			const B y{ select(x == inf, x, select(x == B(T(0)), -inf, r)) };
+			return select((x < B(T(0))) | (x != x), B(::std::numeric_limits<T>::quiet_NaN()), y);
+		}
+
+		/**
+		 * @brief Calculates the natural logarithm of every lane of a batch.
+		 */
+		template<accuracy A, class B>
+		SMATH_INLINE B log_batch(const B &x) {
+			using T = typename B::value_type;
+			using E = exp_constants<T>;
+			B e, f, h, t;
+			log_reduce(x, e, f);
+			log1p_terms<A>(f, h, t);
+			const B r{ e * B(E::ln2_hi) - ((h - (t + e * B(E::ln2_lo))) - f) };
+			return log_special(x, r);
+		}
+
+		/**
+		 * @brief Calculates `log(1 + x)` for every lane of a batch, accurately for
+		 * `x` near 0.
+		 */
+		template<accuracy A, class B>
+		SMATH_INLINE B log1p_batch(const B &x) {
+			using T = typename B::value_type;
+			using E = exp_constants<T>;
+			const B one{ T(1) };
+			const B u{ one + x };
+			B e, f, h, t;
+			log_reduce(u, e, f);
+			log1p_terms<A>(f, h, t);
+			// log(1 + x) = log(u) + c / u, with c the rounding error of u, which
+			// Fast2Sum recovers exactly by subtracting the larger addend first
+			const B c{ select(x > one, one - (u - x), x - (u - one)) / u };
+			const B r{ e * B(E::ln2_hi) - ((h - (t + (e * B(E::ln2_lo) + c))) - f) };
+			// zeros keep their sign
+			return select(x == B(T(0)), x, log_special(u, r));
+		}
+
+		/**
+		 * @brief Splits `log(1 + f)` into `hi + lo`. Without FMA instructions,
+		 * `hi` has few enough bits that its products with the `_hi` multipliers
+		 * are exact.
+		 */
+		template<accuracy A, class B>
+		SMATH_INLINE void log1p_split(const B &f, B &hi, B &lo) {
+			B h, t;
+			log1p_terms<A>(f, h, t);
+			const B d{ f - h };
+#if SMATH_ARCH & SMATH_ARCH_FMA_BIT
+			// the compiler may fuse Veltkamp's split into FMA instructions, which
+			// keeps every bit in `hi`, so log1p_scale recovers the rounding instead
+			hi = d;
+#else
+			using C = log_constants<typename B::value_type>;
+			const B s{ d * B(C::split) };
+			hi = s - (s - d);
+#endif
+			lo = ((f - hi) - h) + t;
+		}
+
+		/**
+		 * @brief Multiplies `hi + lo` from log1p_split by `c_hi + c_lo`, into
+		 * `r_hi + r_lo`.
+		 */
+		template<class B>
+		SMATH_INLINE void log1p_scale(const B &hi, const B &lo, const B &c_hi, const B &c_lo, B &r_hi, B &r_lo) {
+			r_hi = hi * c_hi;
+			r_lo = (lo + hi) * c_lo + lo * c_hi;
+#if SMATH_ARCH & SMATH_ARCH_FMA_BIT
+			r_lo = r_lo + product_error(hi, c_hi, r_hi);
+#endif
+		}
+
+		/**
+		 * @brief Calculates the base 2 logarithm of every lane of a batch.
+		 */
+		template<accuracy A, class B>
+		SMATH_INLINE B log2_batch(const B &x) {
+			using T = typename B::value_type;
+			using C = log_constants<T>;
+			B e, f;
+			log_reduce(x, e, f);
+			if constexpr (A == accuracy::fast) {
+				return log_special(x, e + log1p_reduced<A>(f) * B(exp_constants<T>::log2e));
+			} else {
+				B hi, lo, r_hi, r_lo;
+				log1p_split<A>(f, hi, lo);
+				log1p_scale(hi, lo, B(C::log2e_hi), B(C::log2e_lo), r_hi, r_lo);
+				const B w{ e + r_hi };
+				return log_special(x, (r_lo + ((e - w) + r_hi)) + w);
+			}
+		}
+
+		/**
+		 * @brief Calculates the base 10 logarithm of every lane of a batch.
+		 */
+		template<accuracy A, class B>
+		SMATH_INLINE B log10_batch(const B &x) {
+			using T = typename B::value_type;
+			using C = log_constants<T>;
+			B e, f;
+			log_reduce(x, e, f);
+			if constexpr (A == accuracy::fast) {
+				const B l{ e * B(exp_constants<T>::ln2) + log1p_reduced<A>(f) };
+				return log_special(x, l * B(C::log10e));
+			} else {
+				B hi, lo, r_hi, r_lo;
+				log1p_split<A>(f, hi, lo);
+				log1p_scale(hi, lo, B(C::log10e_hi), B(C::log10e_lo), r_hi, r_lo);
+				const B e_hi{ e * B(C::log10_2_hi) };
+				r_lo = e * B(C::log10_2_lo) + r_lo;
+				const B w{ e_hi + r_hi };
+				return log_special(x, (r_lo + ((e_hi - w) + r_hi)) + w);
+			}
+		}
+
+		/**
+		 * @brief Calculates `|x|^y` for every lane, as `2^(y * (e + log2(1 + f)))`
+		 * with `e` and `f` from log_reduce of `|x|` and the product carried in two
+		 * parts, for finite non-zero `x`.
+		 */
+		template<accuracy A, class B>
+		SMATH_INLINE B pow_reduced(const B &e, const B &f, const B &y) {
+			using T = typename B::value_type;
+			using C = exp_constants<T>;
+			// larger exponents are even and overflow or underflow for any |x| != 1
+			const B yc{ min(max(y, B(-C::max_pow)), B(C::max_pow)) };
+
+			B k, t;
+			if constexpr (A == accuracy::fast) {
+				t = yc * e + yc * (log1p_reduced<A>(f) * B(C::log2e));
+				t = min(max(t, B(C::min_exp2)), B(C::max_exp2));
+				k = nearbyint(t);
+				t = t - k;
+			} else {
+				using L = log_constants<T>;
+				// y * e is carried in two parts. Without FMA instructions, `e` has
+				// few enough bits that the products with both halves of `y` are
+				// exact, which is cheaper than product_error
+#if SMATH_ARCH & SMATH_ARCH_FMA_BIT
+				const B p_hi{ yc * e };
+				const B p_lo{ product_error(yc, e, p_hi) };
+#else
+				const B sy{ yc * B(C::product_split) };
+				const B y_hi{ sy - (sy - yc) };
+				const B p_hi{ y_hi * e };
+				const B p_lo{ (yc - y_hi) * e };
+#endif
+				// y * log2(1 + f) as well, whose rounding error would otherwise grow
+				// with y
+				B hi, lo, r_hi, r_lo;
+				log1p_split<A>(f, hi, lo);
+				log1p_scale(hi, lo, B(L::log2e_hi), B(L::log2e_lo), r_hi, r_lo);
+				const B l_hi{ yc * r_hi };
+				const B l_lo{ product_error(yc, r_hi, l_hi) + yc * r_lo };
+				// the whole parts are taken out before adding, which is exact
+				const B kp{ nearbyint(p_hi) };
+				const B kl{ nearbyint(l_hi) };
+				t = ((p_hi - kp) + (l_hi - kl)) + (p_lo + l_lo);
+				const B k2{ nearbyint(t) };
+				k = min(max(kp + kl + k2, B(C::min_exp2)), B(C::max_exp2));
+				t = t - k2;
+			}
+			const B hi{ t * B(C::ln2) };
+			return scale_pow2(B(T(1)) - (expm1_correction<A>(hi, B(T(0))) - hi), k);
+		}
+
+		/**
+		 * @brief Calculates `2^(y * (e + log2(1 + f)))` for every lane of double
+		 * batches holding floats, with `e` and `f` from log_reduce. The error is
+		 * far below the rounding to float, so the result is within 1 ULP once
+		 * narrowed.
+		 */
+		template<class D>
+		SMATH_FORCE_INLINE D pow_float_lanes(const D &e, const D &f, const D &y) {
+			using F = exp_constants<float>;
+			using L = log_constants<double>;
+			const D s{ f / (D(2.0) + f) };
+			// the polynomial is evaluated in two halves, which shortens the chain
+			// of dependent operations behind the division
+			const D z{ s * s };
+			const D z2{ z * z };
+			const D p_lo{ D(L::pow_float[4]) + D(L::pow_float[3]) * z };
+			const D p_hi{ (D(L::pow_float[2]) + D(L::pow_float[1]) * z) + z2 * D(L::pow_float[0]) };
+			const D l{ e + s * (p_lo + z2 * p_hi) };
+			// float results overflow or underflow past these bounds, which keeps
+			// 2^k normal
+			const D t{ min(max(y * l, D(static_cast<double>(F::min_exp2))), D(static_cast<double>(F::max_exp2))) };
+			// adding 1.5 * 2^52 rounds to the nearest whole number, without the
+			// special cases of nearbyint
+			const D k{ (t + D(6755399441055744.0)) - D(6755399441055744.0) };
+			const D q{ horner(t - k, exp_constants<double>::pow_float) };
+			const D q2{ q * q };
+			return (q2 * q2) * pow2i(k);
+		}
+
+		/**
+		 * @brief Calculates `|x|^y` for every lane of a float batch, with `e` and
+		 * `f` from log_reduce of `|x|`. The reduction is exact, so it runs on the
+		 * float lanes, and the rest in double lanes.
+		 */
+		template<class B>
+		SMATH_FORCE_INLINE B pow_widened(const B &e, const B &f, const B &y) {
+			using D = simd::batch<double, B::size() / 2>;
+			D e_lo, e_hi, f_lo, f_hi, y_lo, y_hi;
+			widen(e, e_lo, e_hi);
+			widen(f, f_lo, f_hi);
+			widen(y, y_lo, y_hi);
+			return narrow(pow_float_lanes(e_lo, f_lo, y_lo), pow_float_lanes(e_hi, f_hi, y_hi));
+		}
+
+		/**
+		 * @brief Calculates `|x|^y` from log_reduce of `|x|` with the kernel of
+		 * each tier: floats past `fast` are evaluated in double lanes.
+		 */
+		template<accuracy A, class B>
+		SMATH_INLINE B pow_tiered(const B &e, const B &f, const B &y, std::true_type) {
+			if constexpr (A == accuracy::fast) {
+				return pow_reduced<A>(e, f, y);
+			} else {
+				return pow_widened(e, f, y);
+			}
+		}
+
+		template<accuracy A, class B>
+		SMATH_INLINE B pow_tiered(const B &e, const B &f, const B &y, std::false_type) {
+			return pow_reduced<A>(e, f, y);
+		}
+
+		/**
+		 * @brief Applies a scalar function to every lane of two batches.
+		 */
+		template<class B, class F>
+		SMATH_INLINE B map_lanes(const B &a, const B &b, F func) {
+			using T = typename B::value_type;
+			T x[static_cast<std::size_t>(B::size())];
+			T y[static_cast<std::size_t>(B::size())];
+			a.storeu(x);
+			b.storeu(y);
+			for (std::size_t i = 0; i < static_cast<std::size_t>(B::size()); ++i) {
+				x[i] = func(x[i], y[i]);
+			}
+			return B::loadu(x);
+		}
+
+		/**
+		 * @brief Calculates `x^y` for every lane of two batches with the kernel of
+		 * `A`, and the special cases of std::pow.
+		 */
+		template<accuracy A, class B>
+		SMATH_FORCE_INLINE B pow_kernel(const B &x, const B &y) {
+			using T = typename B::value_type;
+			using is_float = std::integral_constant<bool, sizeof(T) == sizeof(float)>;
+			const B zero{ T(0) };
+			const B one{ T(1) };
+			const B inf{ ::std::numeric_limits<T>::infinity() };
+			const B ax{ abs(x) };
+			// normal positive bases with finite exponents need none of the special
+			// cases, nor the scaling of denormals
+			const bool normal{ all((x >= B(::std::numeric_limits<T>::min())) & (x < inf) & (abs(y) < inf)) };
+			B e, f;
+			if (normal) {
+				log_reduce_normal(x, e, f);
+			} else {
+				log_reduce(ax, e, f);
+			}
+			B r{ pow_tiered<A>(e, f, y, is_float()) };
+			if (normal) {
+				return r;
+			}
+
+			// zero and infinite bases, then infinite exponents
+			r = select((ax == zero) | (ax == inf), select((ax == zero) ^ (y < zero), zero, inf), r);
+			r = select(abs(y) == inf, select(ax == one, one, select((ax > one) ^ (y < zero), inf, zero)), r);
+
+			// negative bases, including -0, flip the sign for odd whole exponents,
+			// and have no real power for other finite exponents
+			const auto whole = trunc(y) == y;
+			const auto odd = whole & (trunc(y * B(T(0.5))) != y * B(T(0.5)));
+			const auto negative = (x < zero) | ((x == zero) & (one / x < zero));
+			r = select(negative & odd, -r, r);
+			r = select((x < zero) & (ax != inf) & ~whole, B(::std::numeric_limits<T>::quiet_NaN()), r);
+
+			r = select((x != x) | (y != y), x + y, r);
+			return select((y == zero) | (x == one), one, r);
+		}
+
+		/**
+		 * @brief Calculates `x^y` for every lane of two batches, with the special
+		 * cases of std::pow. `precise` calls std::pow on each lane of double
+		 * batches. Each tier is a function of its own, which the range functions
+		 * inline into their loop.
+		 */
+		template<accuracy A, class B>
+		SMATH_FORCE_INLINE B pow_batch(const B &x, const B &y) {
+			using T = typename B::value_type;
+			if constexpr (A == accuracy::precise && sizeof(T) != sizeof(float)) {
+				return map_lanes(x, y, [](T a, T b) { return ::std::pow(a, b); });
+			} else {
+				return pow_kernel<A>(x, y);
+			}
+		}
+
+		/**
+		 * @brief Multiplies every lane by `2^n` for whole `n`, with a single
+		 * rounding as std::ldexp.
+		 */
+		template<class B>
+		SMATH_INLINE B ldexp_batch(const B &x, const B &n) {
+			using T = typename B::value_type;
+			using C = exp_constants<T>;
+			// x = m * 2^e with m in [1, 2), after scaling denormals
+			const auto tiny = abs(x) < B(::std::numeric_limits<T>::min());
+			const B a{ select(tiny, x * B(C::two_digits), x) };
+			const B e{ exponent(a) + select(tiny, n - B(C::digits), n) };
+			const B t{ min(max(e, B(T(2) * C::min_scale)), B(T(2) * C::max_scale)) };
+			const B r{ scale_pow2(mantissa(a), t) };
+			return select((x == B(T(0))) | ~(abs(x) < B(::std::numeric_limits<T>::infinity())), x, r);
+		}
+
+		/**
+		 * @brief Splits every lane into a significand in [0.5, 1) with the sign of
+		 * the lane and a power of two, as std::frexp. Zeros, infinities and NaNs
+		 * are returned unchanged with an exponent of 0.
+		 */
+		template<class B>
+		SMATH_INLINE B frexp_batch(const B &x, B &e) {
+			using T = typename B::value_type;
+			using C = exp_constants<T>;
+			const auto tiny = abs(x) < B(::std::numeric_limits<T>::min());
+			const B a{ select(tiny, x * B(C::two_digits), x) };
+			const auto special = (x == B(T(0))) | ~(abs(x) < B(::std::numeric_limits<T>::infinity()));
+			e = select(special, B(T(0)), exponent(a) + B(T(1)) - select(tiny, B(C::digits), B(T(0))));
+			return select(special, x, mantissa(a) * B(T(0.5)));
+		}
+
+		/**
+		 * @brief Loads the components of a vector into a 4-lane batch, with the
+		 * lanes past `L` set to `pad`.
+		 */
+		template<length_t L, class T>
+		SMATH_INLINE simd::batch<T, 4> vec_load_padded(const vec<L, T> &v, T pad) {
+			T lanes[4]{ pad, pad, pad, pad };
+			for (length_t i = 0; i < L; ++i) {
+				lanes[i] = v[i];
+			}
+			return simd::batch<T, 4>::loadu(lanes);
+		}
+
+		/**
+		 * @brief Stores the first `L` lanes of a batch as a vector. Inverse of
+		 * vec_load_padded.
+		 */
+		template<length_t L, class T>
+		SMATH_INLINE vec<L, T> vec_store_padded(const simd::batch<T, 4> &b) {
+			T lanes[4];
+			b.storeu(lanes);
+			vec<L, T> result;
+			for (length_t i = 0; i < L; ++i) {
+				result[i] = lanes[i];
+			}
+			return result;
+		}
+
+		/**
+		 * @brief Template class to compute the exponential functions of every
+		 * component, specialized in exponential_simd.inl for vectors stored in
+		 * SIMD registers. The other vectors are padded into a 4-lane batch as
+		 * compute_log, with zeros for the exponentials and ones for pow.
+		 * @tparam L The number of components of the vector.
+		 * @tparam T The type of the vector (float, double)
+		 * @tparam Simd Whether the vector is stored in a SIMD register.
+		 */
+		template<length_t L, class T, bool Simd>
+		struct compute_exp {
+			template<accuracy A>
+			static vec<L, T> exp(const vec<L, T> &v, precision<A>) {
+				return vec_store_padded<L>(exp_batch<A>(vec_load_padded(v, T(0))));
+			}
+
+			template<accuracy A>
+			static vec<L, T> exp2(const vec<L, T> &v, precision<A>) {
+				return vec_store_padded<L>(exp2_batch<A>(vec_load_padded(v, T(0))));
+			}
+
+			template<accuracy A>
+			static vec<L, T> expm1(const vec<L, T> &v, precision<A>) {
+				return vec_store_padded<L>(expm1_batch<A>(vec_load_padded(v, T(0))));
+			}
+
+			template<accuracy A>
+			static vec<L, T> pow(const vec<L, T> &a, const vec<L, T> &b, precision<A>) {
+				return vec_store_padded<L>(pow_batch<A>(vec_load_padded(a, T(1)), vec_load_padded(b, T(1))));
+			}
+		};
+
+		template<length_t L, class T, accuracy A>
+		SMATH_INLINE vec<L, T> log_padded(const vec<L, T> &v, precision<A>, std::true_type) {
+			return vec_store_padded<L>(log_batch<A>(vec_load_padded(v, T(1))));
+		}
+
+		template<length_t L, class T, accuracy A>
+		SMATH_INLINE vec<L, T> log_padded(const vec<L, T> &v, precision<A>, std::false_type) {
+			return function::map([](T x) { return static_cast<T>(::std::log(x)); }, v);
+		}
+
+		/**
+		 * @brief Template class to compute the logarithms of every component of a
+		 * vector, specialized in exponential_simd.inl for vectors stored in SIMD
+		 * registers. The other vectors are padded with ones into a 4-lane batch,
+		 * which runs the kernel once instead of calling the standard library per
+		 * component. Integer components keep the truncated result of std::log.
+		 * @tparam L The number of components of the vector.
+		 * @tparam T The type of the vector (int for `log`, float, double)
+		 * @tparam Simd Whether the vector is stored in a SIMD register.
+		 */
+		template<length_t L, class T, bool Simd>
+		struct compute_log {
+			template<accuracy A>
+			static vec<L, T> log(const vec<L, T> &v, precision<A> acc) {
+				return log_padded(v, acc, std::integral_constant<bool, is_floating_type<T>::value>());
+			}
+
+			template<accuracy A>
+			static vec<L, T> log2(const vec<L, T> &v, precision<A>) {
+				return vec_store_padded<L>(log2_batch<A>(vec_load_padded(v, T(1))));
+			}
+
+			template<accuracy A>
+			static vec<L, T> log10(const vec<L, T> &v, precision<A>) {
+				return vec_store_padded<L>(log10_batch<A>(vec_load_padded(v, T(1))));
+			}
+
+			template<accuracy A>
+			static vec<L, T> log1p(const vec<L, T> &v, precision<A>) {
+				return vec_store_padded<L>(log1p_batch<A>(vec_load_padded(v, T(0))));
+			}
+		};
+
+	} // namespace detail
+
+	// -- Exponential functions --
+
+	// Scalars call the standard library for every tier, which is faster for a
+	// single value and within 1 ULP. Vectors run the batch kernels, padded to
+	// four lanes when they are not stored in SIMD registers.
+
+	/**
+	 * @brief Calculates `e^a`.
+	 *
+	 * The relative error is below 2e-4 for `fast`, and the error below 2 ULP for
+	 * `balanced` and 1 ULP for `precise`.
+	 *
+	 * @param acc The trade-off between speed and accuracy.
+	 * @returns `e` raised to the power of `a`.
+	 */
+	SMATH_INLINE float exp(const float &a, accuracy = default_accuracy) {
+		return ::std::exp(a);
+	}
+
+	SMATH_INLINE double exp(const double &a, accuracy = default_accuracy) {
+		return ::std::exp(a);
+	}
+
+	/**
+	 * @brief Calculates `e^x` for all of the components of a vector.
+	 * @tparam L The number of components in the vector in range [1, 4]
+	 * @tparam T The type of the vector (float, double)
+	 * @param acc The trade-off between speed and accuracy.
+	 * @returns A vector containing `e` raised to the power of each component.
+	 */
+	template<length_t L, class T, class P = default_precision, class = detail::enable_precision<P>>
+	SMATH_INLINE vec<L, T> exp(const vec<L, T> &v, P acc = P()) {
+		SMATH_STATIC_ASSERT(smath::is_floating_type<T>::value, "'exp' only accepts a floating-point vector");
+		SMATH_STATIC_ASSERT(smath::is_valid_vector(L), "'exp' only works on vectors with 1 to 4 components");
+		return detail::with_precision(acc, [&v](auto p) { return detail::compute_exp<L, T, detail::is_simd<L, T>::value>::exp(v, p); });
+	}
+
+	/**
+	 * @brief Calculates `2^a`, with the same error bounds as smath::exp.
+	 * @param acc The trade-off between speed and accuracy.
+	 * @returns 2 raised to the power of `a`.
+	 */
+	SMATH_INLINE float exp2(const float &a, accuracy = default_accuracy) {
+		return ::std::exp2(a);
+	}
+
+	SMATH_INLINE double exp2(const double &a, accuracy = default_accuracy) {
+		return ::std::exp2(a);
+	}
+
+	/**
+	 * @brief Calculates `2^x` for all of the components of a vector.
+	 * @tparam L The number of components in the vector in range [1, 4]
+	 * @tparam T The type of the vector (float, double)
+	 * @param acc The trade-off between speed and accuracy.
+	 * @returns A vector containing 2 raised to the power of each component.
+	 */
+	template<length_t L, class T, class P = default_precision, class = detail::enable_precision<P>>
+	SMATH_INLINE vec<L, T> exp2(const vec<L, T> &v, P acc = P()) {
+		SMATH_STATIC_ASSERT(smath::is_floating_type<T>::value, "'exp2' only accepts a floating-point vector");
+		SMATH_STATIC_ASSERT(smath::is_valid_vector(L), "'exp2' only works on vectors with 1 to 4 components");
+		return detail::with_precision(acc, [&v](auto p) { return detail::compute_exp<L, T, detail::is_simd<L, T>::value>::exp2(v, p); });
+	}
+
+	/**
+	 * @brief Calculates `e^a - 1` without losing precision for `a` near 0, with
+	 * the same error bounds as smath::exp.
+	 * @param acc The trade-off between speed and accuracy.
+	 * @returns `e` raised to the power of `a`, minus 1.
+	 */
+	SMATH_INLINE float expm1(const float &a, accuracy = default_accuracy) {
+		return ::std::expm1(a);
+	}
+
+	SMATH_INLINE double expm1(const double &a, accuracy = default_accuracy) {
+		return ::std::expm1(a);
+	}
+
+	/**
+	 * @brief Calculates `e^x - 1` for all of the components of a vector.
+	 * @tparam L The number of components in the vector in range [1, 4]
+	 * @tparam T The type of the vector (float, double)
+	 * @param acc The trade-off between speed and accuracy.
+	 * @returns A vector containing `e` raised to the power of each component, minus 1.
+	 */
+	template<length_t L, class T, class P = default_precision, class = detail::enable_precision<P>>
+	SMATH_INLINE vec<L, T> expm1(const vec<L, T> &v, P acc = P()) {
+		SMATH_STATIC_ASSERT(smath::is_floating_type<T>::value, "'expm1' only accepts a floating-point vector");
+		SMATH_STATIC_ASSERT(smath::is_valid_vector(L), "'expm1' only works on vectors with 1 to 4 components");
+		return detail::with_precision(acc, [&v](auto p) { return detail::compute_exp<L, T, detail::is_simd<L, T>::value>::expm1(v, p); });
+	}
+
+	/**
+	 * @brief Raises `a` to the power of `b`, with the special cases of std::pow.
+	 *
+	 * `fast` has a relative error below 5e-4 for `|b| <= 6`, growing with `|b|`
+	 * past that as given by precision::max_pow_error(). Past `fast`, floats are
+	 * evaluated in double lanes and rounded once, within 1 ULP. For doubles,
+	 * `balanced` has an error below 2 ULP for `|b| <= 4`, growing as `fast`,
+	 * and `precise` uses std::pow, within 1 ULP.
+	 *
+	 * @param acc The trade-off between speed and accuracy.
+	 * @returns `a` raised to the power of `b`.
+	 */
+	SMATH_INLINE float pow(const float &a, const float &b, accuracy = default_accuracy) {
+		return ::std::pow(a, b);
+	}
+
+	SMATH_INLINE double pow(const double &a, const double &b, accuracy = default_accuracy) {
+		return ::std::pow(a, b);
+	}
+
+	/**
+	 * @brief Raises each component of a vector to the power of the matching
+	 * component of another.
+	 * @tparam L The number of components in the vector in range [1, 4]
+	 * @tparam T The type of the vector (float, double)
+	 * @param acc The trade-off between speed and accuracy.
+	 * @returns A vector containing each component of `a` raised to the power of `b`.
+	 */
+	template<length_t L, class T, class P = default_precision, class = detail::enable_precision<P>>
+	SMATH_INLINE vec<L, T> pow(const vec<L, T> &a, const vec<L, T> &b, P acc = P()) {
+		SMATH_STATIC_ASSERT(smath::is_floating_type<T>::value, "'pow' only accepts a floating-point vector");
+		SMATH_STATIC_ASSERT(smath::is_valid_vector(L), "'pow' only works on vectors with 1 to 4 components");
+		return detail::with_precision(acc, [&a, &b](auto p) { return detail::compute_exp<L, T, detail::is_simd<L, T>::value>::pow(a, b, p); });
+	}
+
+	/**
+	 * @brief Raises each component of a vector to the same power.
+	 */
+	template<length_t L, class T, class P = default_precision, class = detail::enable_precision<P>>
+	SMATH_INLINE vec<L, T> pow(const vec<L, T> &a, T b, P acc = P()) {
+		return smath::pow(a, vec<L, T>(b), acc);
+	}
+
+	/**
+	 * @brief Multiplies a floating-point number by a power of two, as std::ldexp.
+	 * @tparam T The type of number (float, double)
+	 * @param n The power of two.
+	 * @returns `a * 2^n`, exactly unless the result overflows or is denormal.
+	 */
+	template<class T>
+	SMATH_INLINE T ldexp(const T &a, int n) {
+		SMATH_STATIC_ASSERT(smath::is_floating_type<T>::value, "'ldexp' only accepts floating-point inputs");
+		return ::std::ldexp(a, n);
+	}
+
+	/**
+	 * @brief Multiplies each component of a vector by a power of two.
+	 * @tparam L The number of components in the vector in range [1, 4]
+	 * @tparam T The type of the vector (float, double)
+	 * @param n The power of two for each component.
+	 */
+	template<length_t L, class T>
+	SMATH_INLINE vec<L, T> ldexp(const vec<L, T> &v, const vec<L, int> &n) {
+		SMATH_STATIC_ASSERT(smath::is_floating_type<T>::value, "'ldexp' only accepts a floating-point vector");
+		return function::map([](T x, int e) { return ::std::ldexp(x, e); }, v, n);
+	}
+
+	/**
+	 * @brief Splits a floating-point number into a significand in [0.5, 1) and a
+	 * power of two, as std::frexp.
+	 * @tparam T The type of number (float, double)
+	 * @param e Set to the power of two, or 0 for zeros, infinities and NaNs.
+	 * @returns The significand, with the sign of `a`.
+	 */
+	template<class T>
+	SMATH_INLINE T frexp(const T &a, int &e) {
+		SMATH_STATIC_ASSERT(smath::is_floating_type<T>::value, "'frexp' only accepts floating-point inputs");
+		return ::std::frexp(a, &e);
+	}
+
+	/**
+	 * @brief Splits each component of a vector into a significand and a power
+	 * of two.
+	 * @tparam L The number of components in the vector in range [1, 4]
+	 * @tparam T The type of the vector (float, double)
+	 * @param e Set to the power of two of each component.
+	 * @returns The significand of each component.
+	 */
+	template<length_t L, class T>
+	SMATH_INLINE vec<L, T> frexp(const vec<L, T> &v, vec<L, int> &e) {
+		SMATH_STATIC_ASSERT(smath::is_floating_type<T>::value, "'frexp' only accepts a floating-point vector");
+		vec<L, T> r{ v };
+		for (int i = 0; i < static_cast<int>(L); ++i) {
+			r[i] = ::std::frexp(v[i], &e[i]);
+		}
+		return r;
+	}
+
+	// -- Logarithmic functions --
+
+	// Scalars call the standard library for every tier, which is faster for a
+	// single value and within 1 ULP. Vectors run the batch kernels, padded to
+	// four lanes when they are not stored in SIMD registers.
+
+	/**
+	 * @brief Performs the natural logarithm of a floating-point number.
+	 *
+	 * The relative error is below 2e-4 for `fast`, and the error within 1 ULP
+	 * for `balanced` and `precise`, which only differ for floats. Denormals are
+	 * exact inputs, 0 gives -infinity and negative numbers NaN, as std::log.
+	 *
+	 * @param acc The trade-off between speed and accuracy.
+	 * @returns The logarithm of `a`.
+	 */
+	SMATH_INLINE float log(const float &a, accuracy = default_accuracy) {
+		return ::std::log(a);
+	}
+
+	SMATH_INLINE double log(const double &a, accuracy = default_accuracy) {
+		return ::std::log(a);
+	}
+
 	/**
 	 * @brief Performs the logarithm on all of the components of a vector.
 	 * @tparam L The number of components in the vector in range [1, 4]
 	 * @tparam T The type of the vector (int, float, double)
+	 * @param acc The trade-off between speed and accuracy, ignored for integers.
 	 * @returns A vector containing the logarithm of all the components.
 	 */
-	template<length_t L, class T>
-	SMATH_INLINE SMATH_CONSTEXPR vec<L, T> log(const vec<L, T> &v) {
+	template<length_t L, class T, class P = default_precision, class = detail::enable_precision<P>>
+	SMATH_INLINE vec<L, T> log(const vec<L, T> &v, P acc = P()) {
 		SMATH_STATIC_ASSERT(smath::is_integer_type<T>::value || smath::is_floating_type<T>::value, "'log' only accepts an integer or floating-point vector");
 		SMATH_STATIC_ASSERT(smath::is_valid_vector(L), "'log' only works on vectors with 1 to 4 components");
-		return function::one<vec, L, T, T>::apply(::std::log, v);
+		return detail::with_precision(acc, [&v](auto p) { return detail::compute_log<L, T, detail::is_simd<L, T>::value>::log(v, p); });
+	}
+
+	/**
+	 * @brief Performs the base 2 logarithm of a floating-point number, with the
+	 * same error bounds as smath::log. Powers of two give exact results.
+	 * @param acc The trade-off between speed and accuracy.
+	 * @returns The base 2 logarithm of `a`.
+	 */
+	SMATH_INLINE float log2(const float &a, accuracy = default_accuracy) {
+		return ::std::log2(a);
+	}
+
+	SMATH_INLINE double log2(const double &a, accuracy = default_accuracy) {
+		return ::std::log2(a);
+	}
+
+	/**
+	 * @brief Performs the base 2 logarithm on all of the components of a vector.
+	 * @tparam L The number of components in the vector in range [1, 4]
+	 * @tparam T The type of the vector (float, double)
+	 * @param acc The trade-off between speed and accuracy.
+	 * @returns A vector containing the base 2 logarithm of all the components.
+	 */
+	template<length_t L, class T, class P = default_precision, class = detail::enable_precision<P>>
+	SMATH_INLINE vec<L, T> log2(const vec<L, T> &v, P acc = P()) {
+		SMATH_STATIC_ASSERT(smath::is_floating_type<T>::value, "'log2' only accepts a floating-point vector");
+		SMATH_STATIC_ASSERT(smath::is_valid_vector(L), "'log2' only works on vectors with 1 to 4 components");
+		return detail::with_precision(acc, [&v](auto p) { return detail::compute_log<L, T, detail::is_simd<L, T>::value>::log2(v, p); });
+	}
+
+	/**
+	 * @brief Performs the base 10 logarithm of a floating-point number, with the
+	 * same error bounds as smath::log.
+	 * @param acc The trade-off between speed and accuracy.
+	 * @returns The base 10 logarithm of `a`.
+	 */
+	SMATH_INLINE float log10(const float &a, accuracy = default_accuracy) {
+		return ::std::log10(a);
+	}
+
+	SMATH_INLINE double log10(const double &a, accuracy = default_accuracy) {
+		return ::std::log10(a);
+	}
+
+	/**
+	 * @brief Performs the base 10 logarithm on all of the components of a vector.
+	 * @tparam L The number of components in the vector in range [1, 4]
+	 * @tparam T The type of the vector (float, double)
+	 * @param acc The trade-off between speed and accuracy.
+	 * @returns A vector containing the base 10 logarithm of all the components.
+	 */
+	template<length_t L, class T, class P = default_precision, class = detail::enable_precision<P>>
+	SMATH_INLINE vec<L, T> log10(const vec<L, T> &v, P acc = P()) {
+		SMATH_STATIC_ASSERT(smath::is_floating_type<T>::value, "'log10' only accepts a floating-point vector");
+		SMATH_STATIC_ASSERT(smath::is_valid_vector(L), "'log10' only works on vectors with 1 to 4 components");
+		return detail::with_precision(acc, [&v](auto p) { return detail::compute_log<L, T, detail::is_simd<L, T>::value>::log10(v, p); });
+	}
+
+	/**
+	 * @brief Calculates `log(1 + a)` without losing precision for `a` near 0,
+	 * with the same error bounds as smath::log.
+	 * @param acc The trade-off between speed and accuracy.
+	 * @returns The logarithm of `1 + a`.
+	 */
+	SMATH_INLINE float log1p(const float &a, accuracy = default_accuracy) {
+		return ::std::log1p(a);
+	}
+
+	SMATH_INLINE double log1p(const double &a, accuracy = default_accuracy) {
+		return ::std::log1p(a);
+	}
+
+	/**
+	 * @brief Calculates `log(1 + x)` for all of the components of a vector.
+	 * @tparam L The number of components in the vector in range [1, 4]
+	 * @tparam T The type of the vector (float, double)
+	 * @param acc The trade-off between speed and accuracy.
+	 * @returns A vector containing the logarithm of 1 plus each component.
+	 */
+	template<length_t L, class T, class P = default_precision, class = detail::enable_precision<P>>
+	SMATH_INLINE vec<L, T> log1p(const vec<L, T> &v, P acc = P()) {
+		SMATH_STATIC_ASSERT(smath::is_floating_type<T>::value, "'log1p' only accepts a floating-point vector");
+		SMATH_STATIC_ASSERT(smath::is_valid_vector(L), "'log1p' only works on vectors with 1 to 4 components");
+		return detail::with_precision(acc, [&v](auto p) { return detail::compute_log<L, T, detail::is_simd<L, T>::value>::log1p(v, p); });
+	}
+
+	namespace detail {
+
+		/**
+		 * @brief Applies a function to every element of a range, running
+		 * `batch_op` over full native batches and `scalar_op` over the tail.
+		 * The ranges may be the same for an in-place update.
+		 */
+		template<class T, class FB, class FS>
+		SMATH_INLINE void apply_span(span<const T> in, span<T> out, FB batch_op, FS scalar_op) {
+			SMATH_STATIC_ASSERT(smath::is_floating_type<T>::value, "batch functions only accept floating-point ranges");
+			assert(in.size() == out.size());
+
+			using B = simd::native<T>;
+			const std::size_t width{ static_cast<std::size_t>(B::size()) };
+			const std::size_t n{ in.size() };
+
+			std::size_t i{ 0 };
+			for (; i + width <= n; i += width) {
+				batch_op(B::loadu(in.data() + i)).storeu(out.data() + i);
+			}
+			for (; i < n; ++i) {
+				out[i] = scalar_op(in[i]);
+			}
+		}
+
+		/**
+		 * @brief Applies a batch function to every element of a range, padding
+		 * the tail into a full batch, so the result of an element does not depend
+		 * on its position in the range. The padding lanes hold `pad`.
+		 */
+		template<class T, class FB>
+		SMATH_INLINE void apply_span_padded(span<const T> in, span<T> out, FB batch_op, T pad) {
+			SMATH_STATIC_ASSERT(smath::is_floating_type<T>::value, "batch functions only accept floating-point ranges");
+			assert(in.size() == out.size());
+
+			using B = simd::native<T>;
+			const std::size_t width{ static_cast<std::size_t>(B::size()) };
+			const std::size_t n{ in.size() };
+
+			// the tail goes through the same call as the full batches, so the
+			// kernel is inlined once into the loop
+			T x[static_cast<std::size_t>(B::size())];
+			const std::size_t full{ n - n % width };
+			for (std::size_t i = 0; i < n; i += width) {
+				const T *src{ in.data() + i };
+				T *dst{ out.data() + i };
+				if (i == full) {
+					for (std::size_t j = 0; j < width; ++j) {
+						x[j] = (i + j < n) ? in[i + j] : pad;
+					}
+					src = x;
+					dst = x;
+				}
+				batch_op(B::loadu(src)).storeu(dst);
+			}
+			for (std::size_t i = full; i < n; ++i) {
+				out[i] = x[i - full];
+			}
+		}
+
+		/**
+		 * @brief Applies a batch function of two ranges to every pair of elements,
+		 * padding the tail as apply_span_padded.
+		 */
+		template<class T, class FB>
+		SMATH_INLINE void apply_span_padded(span<const T> a, span<const T> b, span<T> out, FB batch_op, T pad) {
+			SMATH_STATIC_ASSERT(smath::is_floating_type<T>::value, "batch functions only accept floating-point ranges");
+			assert(a.size() == out.size() && b.size() == out.size());
+
+			using B = simd::native<T>;
+			const std::size_t width{ static_cast<std::size_t>(B::size()) };
+			const std::size_t n{ out.size() };
+
+			T x[static_cast<std::size_t>(B::size())];
+			T y[static_cast<std::size_t>(B::size())];
+			const std::size_t full{ n - n % width };
+			for (std::size_t i = 0; i < n; i += width) {
+				const T *src_a{ a.data() + i };
+				const T *src_b{ b.data() + i };
+				T *dst{ out.data() + i };
+				if (i == full) {
+					for (std::size_t j = 0; j < width; ++j) {
+						x[j] = (i + j < n) ? a[i + j] : pad;
+						y[j] = (i + j < n) ? b[i + j] : pad;
+					}
+					src_a = x;
+					src_b = y;
+					dst = x;
+				}
+				batch_op(B::loadu(src_a), B::loadu(src_b)).storeu(dst);
+			}
+			for (std::size_t i = full; i < n; ++i) {
+				out[i] = x[i - full];
+			}
+		}
+
+		/**
+		 * @brief Applies `batch_op(batch, p)` to every element of a range as
+		 * apply_span_padded, where `p` is the precision policy selected by `acc`,
+		 * resolved once, outside of the loop.
+		 */
+		template<class T, class P, class FB>
+		SMATH_INLINE void apply_span_tiered(span<const T> in, span<T> out, P acc, FB batch_op, T pad) {
+			using B = simd::native<T>;
+			with_precision(acc, [&](auto p) {
+				apply_span_padded(in, out, [&batch_op, p](const B &b) { return batch_op(b, p); }, pad);
+			});
+		}
+
+		template<class T, class P>
+		SMATH_INLINE void sqrt_span(span<const T> in, span<T> out, P acc) {
+			with_precision(acc, [&](auto p) {
+				if constexpr (decltype(p)::value == accuracy::fast) {
+					apply_span_padded(in, out, [](const simd::native<T> &b) { return sqrt_batch<accuracy::fast>(b); }, T(1));
+				} else {
+					apply_span(in, out,
+						[](const simd::native<T> &b) { return sqrt(b); },
+						[](T a) { return ::std::sqrt(a); });
+				}
+			});
+		}
+
+		template<class T, class P>
+		SMATH_INLINE void inv_sqrt_span(span<const T> in, span<T> out, P acc) {
+			apply_span_tiered(in, out, acc, [](const simd::native<T> &b, auto p) { return inv_sqrt_batch<decltype(p)::value>(b); }, T(1));
+		}
+
+		template<class T, class P>
+		SMATH_INLINE void exp_span(span<const T> in, span<T> out, P acc) {
+			apply_span_tiered(in, out, acc, [](const simd::native<T> &b, auto p) { return exp_batch<decltype(p)::value>(b); }, T(0));
+		}
+
+		template<class T, class P>
+		SMATH_INLINE void exp2_span(span<const T> in, span<T> out, P acc) {
+			apply_span_tiered(in, out, acc, [](const simd::native<T> &b, auto p) { return exp2_batch<decltype(p)::value>(b); }, T(0));
+		}
+
+		template<class T, class P>
+		SMATH_INLINE void expm1_span(span<const T> in, span<T> out, P acc) {
+			apply_span_tiered(in, out, acc, [](const simd::native<T> &b, auto p) { return expm1_batch<decltype(p)::value>(b); }, T(0));
+		}
+
+		template<class T, class P>
+		SMATH_INLINE void pow_span(span<const T> base, T exponent, span<T> out, P acc) {
+			apply_span_tiered(base, out, acc, [y = simd::native<T>{ exponent }](const simd::native<T> &b, auto p) { return pow_batch<decltype(p)::value>(b, y); }, T(1));
+		}
+
+		template<class T, class P>
+		SMATH_INLINE void pow_span(span<const T> base, span<const T> exponent, span<T> out, P acc) {
+			using B = simd::native<T>;
+			with_precision(acc, [&](auto p) {
+				apply_span_padded(base, exponent, out, [](const B &a, const B &b) { return pow_batch<decltype(p)::value>(a, b); }, T(1));
+			});
+		}
+
+		template<class T>
+		SMATH_INLINE void ldexp_span(span<const T> in, span<const int> exponents, span<T> out) {
+			SMATH_STATIC_ASSERT(smath::is_floating_type<T>::value, "'ldexp' only accepts floating-point ranges");
+			assert(in.size() == out.size() && exponents.size() == out.size());
+
+			using B = simd::native<T>;
+			const std::size_t width{ static_cast<std::size_t>(B::size()) };
+			const std::size_t n{ in.size() };
+
+			// the exponents are converted to lanes of T on the way in
+			T x[static_cast<std::size_t>(B::size())];
+			T e[static_cast<std::size_t>(B::size())];
+			std::size_t i{ 0 };
+			for (; i + width <= n; i += width) {
+				for (std::size_t j = 0; j < width; ++j) {
+					e[j] = static_cast<T>(exponents[i + j]);
+				}
+				ldexp_batch(B::loadu(in.data() + i), B::loadu(e)).storeu(out.data() + i);
+			}
+			if (i < n) {
+				for (std::size_t j = 0; j < width; ++j) {
+					x[j] = (i + j < n) ? in[i + j] : T(0);
+					e[j] = (i + j < n) ? static_cast<T>(exponents[i + j]) : T(0);
+				}
+				ldexp_batch(B::loadu(x), B::loadu(e)).storeu(x);
+				for (std::size_t j = 0; i + j < n; ++j) {
+					out[i + j] = x[j];
+				}
+			}
+		}
+
+		template<class T>
+		SMATH_INLINE void frexp_span(span<const T> in, span<T> mantissas, span<int> exponents) {
+			SMATH_STATIC_ASSERT(smath::is_floating_type<T>::value, "'frexp' only accepts floating-point ranges");
+			assert(in.size() == mantissas.size() && in.size() == exponents.size());
+
+			using B = simd::native<T>;
+			const std::size_t width{ static_cast<std::size_t>(B::size()) };
+			const std::size_t n{ in.size() };
+
+			T x[static_cast<std::size_t>(B::size())];
+			T e[static_cast<std::size_t>(B::size())];
+			for (std::size_t i = 0; i < n; i += width) {
+				const std::size_t count{ (n - i < width) ? n - i : width };
+				for (std::size_t j = 0; j < width; ++j) {
+					x[j] = (j < count) ? in[i + j] : T(0);
+				}
+				B be;
+				frexp_batch(B::loadu(x), be).storeu(x);
+				be.storeu(e);
+				for (std::size_t j = 0; j < count; ++j) {
+					mantissas[i + j] = x[j];
+					exponents[i + j] = static_cast<int>(e[j]);
+				}
+			}
+		}
+
+		template<class T, class P>
+		SMATH_INLINE void log_span(span<const T> in, span<T> out, P acc) {
+			apply_span_tiered(in, out, acc, [](const simd::native<T> &b, auto p) { return log_batch<decltype(p)::value>(b); }, T(1));
+		}
+
+		template<class T, class P>
+		SMATH_INLINE void log2_span(span<const T> in, span<T> out, P acc) {
+			apply_span_tiered(in, out, acc, [](const simd::native<T> &b, auto p) { return log2_batch<decltype(p)::value>(b); }, T(1));
+		}
+
+		template<class T, class P>
+		SMATH_INLINE void log10_span(span<const T> in, span<T> out, P acc) {
+			apply_span_tiered(in, out, acc, [](const simd::native<T> &b, auto p) { return log10_batch<decltype(p)::value>(b); }, T(1));
+		}
+
+		template<class T, class P>
+		SMATH_INLINE void log1p_span(span<const T> in, span<T> out, P acc) {
+			apply_span_tiered(in, out, acc, [](const simd::native<T> &b, auto p) { return log1p_batch<decltype(p)::value>(b); }, T(0));
+		}
+
+	} // namespace detail
+
+	// -- Batch functions --
+
+	/**
+	 * @brief Performs the square root of every element of a range.
+	 * @param in The input values.
+	 * @param out The output range, of the same size as `in`, which may be `in`.
+	 * @param acc The trade-off between speed and accuracy, as for vectors.
+	 */
+	template<class P = default_precision, class = detail::enable_precision<P>>
+	SMATH_INLINE void sqrt(span<const float> in, span<float> out, P acc = P()) {
+		detail::sqrt_span(in, out, acc);
+	}
+
+	template<class P = default_precision, class = detail::enable_precision<P>>
+	SMATH_INLINE void sqrt(span<const double> in, span<double> out, P acc = P()) {
+		detail::sqrt_span(in, out, acc);
+	}
+
+	/**
+	 * @brief Performs the square root on all of the components of a range of
+	 * vectors.
+	 * @tparam L The number of components in the vector in range [1, 4]
+	 * @tparam T The type of the vector (float, double)
+	 */
+	template<length_t L, class T, class P = default_precision, class = detail::enable_precision<P>>
+	SMATH_INLINE void sqrt(typename detail::identity<span<const vec<L, T>>>::type in, span<vec<L, T>> out, P acc = P()) {
+		detail::sqrt_span(detail::component_span(in), detail::component_span(out), acc);
+	}
+
+	/**
+	 * @brief Replaces every element of a range with its square root.
+	 */
+	template<class P = default_precision, class = detail::enable_precision<P>>
+	SMATH_INLINE void sqrt(span<float> values, P acc = P()) {
+		detail::sqrt_span<float>(values, values, acc);
+	}
+
+	template<class P = default_precision, class = detail::enable_precision<P>>
+	SMATH_INLINE void sqrt(span<double> values, P acc = P()) {
+		detail::sqrt_span<double>(values, values, acc);
+	}
+
+	template<length_t L, class T, class P = default_precision, class = detail::enable_precision<P>>
+	SMATH_INLINE void sqrt(span<vec<L, T>> values, P acc = P()) {
+		const span<T> c{ detail::component_span(values) };
+		detail::sqrt_span<T>(c, c, acc);
+	}
+
+	/**
+	 * @brief Performs the inverse square root of every element of a range,
+	 * from the estimate instruction of the target. The tail is padded into a
+	 * full batch, so every element gets the same result wherever it is.
+	 * @param in The input values.
+	 * @param out The output range, of the same size as `in`, which may be `in`.
+	 * @param acc The trade-off between speed and accuracy.
+	 */
+	template<class P = default_precision, class = detail::enable_precision<P>>
+	SMATH_INLINE void inv_sqrt(span<const float> in, span<float> out, P acc = P()) {
+		detail::inv_sqrt_span(in, out, acc);
+	}
+
+	template<class P = default_precision, class = detail::enable_precision<P>>
+	SMATH_INLINE void inv_sqrt(span<const double> in, span<double> out, P acc = P()) {
+		detail::inv_sqrt_span(in, out, acc);
+	}
+
+	/**
+	 * @brief Performs the inverse square root on all of the components of a
+	 * range of vectors.
+	 * @tparam L The number of components in the vector in range [1, 4]
+	 * @tparam T The type of the vector (float, double)
+	 */
+	template<length_t L, class T, class P = default_precision, class = detail::enable_precision<P>>
+	SMATH_INLINE void inv_sqrt(typename detail::identity<span<const vec<L, T>>>::type in, span<vec<L, T>> out, P acc = P()) {
+		detail::inv_sqrt_span(detail::component_span(in), detail::component_span(out), acc);
+	}
+
+	/**
+	 * @brief Replaces every element of a range with its inverse square root.
+	 */
+	template<class P = default_precision, class = detail::enable_precision<P>>
+	SMATH_INLINE void inv_sqrt(span<float> values, P acc = P()) {
+		detail::inv_sqrt_span<float>(values, values, acc);
+	}
+
+	template<class P = default_precision, class = detail::enable_precision<P>>
+	SMATH_INLINE void inv_sqrt(span<double> values, P acc = P()) {
+		detail::inv_sqrt_span<double>(values, values, acc);
+	}
+
+	template<length_t L, class T, class P = default_precision, class = detail::enable_precision<P>>
+	SMATH_INLINE void inv_sqrt(span<vec<L, T>> values, P acc = P()) {
+		const span<T> c{ detail::component_span(values) };
+		detail::inv_sqrt_span<T>(c, c, acc);
+	}
+
+	/**
+	 * @brief Performs the logarithm of every element of a range.
+	 * @param in The input values.
+	 * @param out The output range, of the same size as `in`, which may be `in`.
+	 * @param acc The trade-off between speed and accuracy.
+	 */
+	template<class P = default_precision, class = detail::enable_precision<P>>
+	SMATH_INLINE void log(span<const float> in, span<float> out, P acc = P()) {
+		detail::log_span(in, out, acc);
+	}
+
+	template<class P = default_precision, class = detail::enable_precision<P>>
+	SMATH_INLINE void log(span<const double> in, span<double> out, P acc = P()) {
+		detail::log_span(in, out, acc);
+	}
+
+	/**
+	 * @brief Performs the logarithm on all of the components of a range of
+	 * vectors.
+	 * @tparam L The number of components in the vector in range [1, 4]
+	 * @tparam T The type of the vector (float, double)
+	 */
+	template<length_t L, class T, class P = default_precision, class = detail::enable_precision<P>>
+	SMATH_INLINE void log(typename detail::identity<span<const vec<L, T>>>::type in, span<vec<L, T>> out, P acc = P()) {
+		detail::log_span(detail::component_span(in), detail::component_span(out), acc);
+	}
+
+	/**
+	 * @brief Replaces every element of a range with its logarithm.
+	 */
+	template<class P = default_precision, class = detail::enable_precision<P>>
+	SMATH_INLINE void log(span<float> values, P acc = P()) {
+		detail::log_span<float>(values, values, acc);
+	}
+
+	template<class P = default_precision, class = detail::enable_precision<P>>
+	SMATH_INLINE void log(span<double> values, P acc = P()) {
+		detail::log_span<double>(values, values, acc);
+	}
+
+	template<length_t L, class T, class P = default_precision, class = detail::enable_precision<P>>
+	SMATH_INLINE void log(span<vec<L, T>> values, P acc = P()) {
+		const span<T> c{ detail::component_span(values) };
+		detail::log_span<T>(c, c, acc);
+	}
+
+	/**
+	 * @brief Performs the base 2 logarithm of every element of a range.
+	 * @param in The input values.
+	 * @param out The output range, of the same size as `in`, which may be `in`.
+	 * @param acc The trade-off between speed and accuracy.
+	 */
+	template<class P = default_precision, class = detail::enable_precision<P>>
+	SMATH_INLINE void log2(span<const float> in, span<float> out, P acc = P()) {
+		detail::log2_span(in, out, acc);
+	}
+
+	template<class P = default_precision, class = detail::enable_precision<P>>
+	SMATH_INLINE void log2(span<const double> in, span<double> out, P acc = P()) {
+		detail::log2_span(in, out, acc);
+	}
+
+	/**
+	 * @brief Performs the base 2 logarithm on all of the components of a range
+	 * of vectors.
+	 * @tparam L The number of components in the vector in range [1, 4]
+	 * @tparam T The type of the vector (float, double)
+	 */
+	template<length_t L, class T, class P = default_precision, class = detail::enable_precision<P>>
+	SMATH_INLINE void log2(typename detail::identity<span<const vec<L, T>>>::type in, span<vec<L, T>> out, P acc = P()) {
+		detail::log2_span(detail::component_span(in), detail::component_span(out), acc);
+	}
+
+	/**
+	 * @brief Replaces every element of a range with its base 2 logarithm.
+	 */
+	template<class P = default_precision, class = detail::enable_precision<P>>
+	SMATH_INLINE void log2(span<float> values, P acc = P()) {
+		detail::log2_span<float>(values, values, acc);
+	}
+
+	template<class P = default_precision, class = detail::enable_precision<P>>
+	SMATH_INLINE void log2(span<double> values, P acc = P()) {
+		detail::log2_span<double>(values, values, acc);
+	}
+
+	template<length_t L, class T, class P = default_precision, class = detail::enable_precision<P>>
+	SMATH_INLINE void log2(span<vec<L, T>> values, P acc = P()) {
+		const span<T> c{ detail::component_span(values) };
+		detail::log2_span<T>(c, c, acc);
+	}
+
+	/**
+	 * @brief Performs the base 10 logarithm of every element of a range.
+	 * @param in The input values.
+	 * @param out The output range, of the same size as `in`, which may be `in`.
+	 * @param acc The trade-off between speed and accuracy.
+	 */
+	template<class P = default_precision, class = detail::enable_precision<P>>
+	SMATH_INLINE void log10(span<const float> in, span<float> out, P acc = P()) {
+		detail::log10_span(in, out, acc);
+	}
+
+	template<class P = default_precision, class = detail::enable_precision<P>>
+	SMATH_INLINE void log10(span<const double> in, span<double> out, P acc = P()) {
+		detail::log10_span(in, out, acc);
+	}
+
+	/**
+	 * @brief Performs the base 10 logarithm on all of the components of a range
+	 * of vectors.
+	 * @tparam L The number of components in the vector in range [1, 4]
+	 * @tparam T The type of the vector (float, double)
+	 */
+	template<length_t L, class T, class P = default_precision, class = detail::enable_precision<P>>
+	SMATH_INLINE void log10(typename detail::identity<span<const vec<L, T>>>::type in, span<vec<L, T>> out, P acc = P()) {
+		detail::log10_span(detail::component_span(in), detail::component_span(out), acc);
+	}
+
+	/**
+	 * @brief Replaces every element of a range with its base 10 logarithm.
+	 */
+	template<class P = default_precision, class = detail::enable_precision<P>>
+	SMATH_INLINE void log10(span<float> values, P acc = P()) {
+		detail::log10_span<float>(values, values, acc);
+	}
+
+	template<class P = default_precision, class = detail::enable_precision<P>>
+	SMATH_INLINE void log10(span<double> values, P acc = P()) {
+		detail::log10_span<double>(values, values, acc);
+	}
+
+	template<length_t L, class T, class P = default_precision, class = detail::enable_precision<P>>
+	SMATH_INLINE void log10(span<vec<L, T>> values, P acc = P()) {
+		const span<T> c{ detail::component_span(values) };
+		detail::log10_span<T>(c, c, acc);
+	}
+
+	/**
+	 * @brief Calculates `log(1 + x)` for every element of a range.
+	 * @param in The input values.
+	 * @param out The output range, of the same size as `in`, which may be `in`.
+	 * @param acc The trade-off between speed and accuracy.
+	 */
+	template<class P = default_precision, class = detail::enable_precision<P>>
+	SMATH_INLINE void log1p(span<const float> in, span<float> out, P acc = P()) {
+		detail::log1p_span(in, out, acc);
+	}
+
+	template<class P = default_precision, class = detail::enable_precision<P>>
+	SMATH_INLINE void log1p(span<const double> in, span<double> out, P acc = P()) {
+		detail::log1p_span(in, out, acc);
+	}
+
+	/**
+	 * @brief Calculates `log(1 + x)` for all of the components of a range of
+	 * vectors.
+	 * @tparam L The number of components in the vector in range [1, 4]
+	 * @tparam T The type of the vector (float, double)
+	 */
+	template<length_t L, class T, class P = default_precision, class = detail::enable_precision<P>>
+	SMATH_INLINE void log1p(typename detail::identity<span<const vec<L, T>>>::type in, span<vec<L, T>> out, P acc = P()) {
+		detail::log1p_span(detail::component_span(in), detail::component_span(out), acc);
+	}
+
+	/**
+	 * @brief Replaces every element of a range with `log(1 + x)`.
+	 */
+	template<class P = default_precision, class = detail::enable_precision<P>>
+	SMATH_INLINE void log1p(span<float> values, P acc = P()) {
+		detail::log1p_span<float>(values, values, acc);
+	}
+
+	template<class P = default_precision, class = detail::enable_precision<P>>
+	SMATH_INLINE void log1p(span<double> values, P acc = P()) {
+		detail::log1p_span<double>(values, values, acc);
+	}
+
+	template<length_t L, class T, class P = default_precision, class = detail::enable_precision<P>>
+	SMATH_INLINE void log1p(span<vec<L, T>> values, P acc = P()) {
+		const span<T> c{ detail::component_span(values) };
+		detail::log1p_span<T>(c, c, acc);
+	}
+
+	/**
+	 * @brief Calculates `e^x` for every element of a range.
+	 * @param in The input values.
+	 * @param out The output range, of the same size as `in`, which may be `in`.
+	 * @param acc The trade-off between speed and accuracy.
+	 */
+	template<class P = default_precision, class = detail::enable_precision<P>>
+	SMATH_INLINE void exp(span<const float> in, span<float> out, P acc = P()) {
+		detail::exp_span(in, out, acc);
+	}
+
+	template<class P = default_precision, class = detail::enable_precision<P>>
+	SMATH_INLINE void exp(span<const double> in, span<double> out, P acc = P()) {
+		detail::exp_span(in, out, acc);
+	}
+
+	/**
+	 * @brief Calculates `e^x` for all of the components of a range of
+	 * vectors.
+	 * @tparam L The number of components in the vector in range [1, 4]
+	 * @tparam T The type of the vector (float, double)
+	 */
+	template<length_t L, class T, class P = default_precision, class = detail::enable_precision<P>>
+	SMATH_INLINE void exp(typename detail::identity<span<const vec<L, T>>>::type in, span<vec<L, T>> out, P acc = P()) {
+		detail::exp_span(detail::component_span(in), detail::component_span(out), acc);
+	}
+
+	/**
+	 * @brief Replaces every element of a range with `e^x`.
+	 */
+	template<class P = default_precision, class = detail::enable_precision<P>>
+	SMATH_INLINE void exp(span<float> values, P acc = P()) {
+		detail::exp_span<float>(values, values, acc);
+	}
+
+	template<class P = default_precision, class = detail::enable_precision<P>>
+	SMATH_INLINE void exp(span<double> values, P acc = P()) {
+		detail::exp_span<double>(values, values, acc);
+	}
+
+	template<length_t L, class T, class P = default_precision, class = detail::enable_precision<P>>
+	SMATH_INLINE void exp(span<vec<L, T>> values, P acc = P()) {
+		const span<T> c{ detail::component_span(values) };
+		detail::exp_span<T>(c, c, acc);
+	}
+
+	/**
+	 * @brief Calculates `2^x` for every element of a range.
+	 * @param in The input values.
+	 * @param out The output range, of the same size as `in`, which may be `in`.
+	 * @param acc The trade-off between speed and accuracy.
+	 */
+	template<class P = default_precision, class = detail::enable_precision<P>>
+	SMATH_INLINE void exp2(span<const float> in, span<float> out, P acc = P()) {
+		detail::exp2_span(in, out, acc);
+	}
+
+	template<class P = default_precision, class = detail::enable_precision<P>>
+	SMATH_INLINE void exp2(span<const double> in, span<double> out, P acc = P()) {
+		detail::exp2_span(in, out, acc);
+	}
+
+	/**
+	 * @brief Calculates `2^x` for all of the components of a range of
+	 * vectors.
+	 * @tparam L The number of components in the vector in range [1, 4]
+	 * @tparam T The type of the vector (float, double)
+	 */
+	template<length_t L, class T, class P = default_precision, class = detail::enable_precision<P>>
+	SMATH_INLINE void exp2(typename detail::identity<span<const vec<L, T>>>::type in, span<vec<L, T>> out, P acc = P()) {
+		detail::exp2_span(detail::component_span(in), detail::component_span(out), acc);
+	}
+
+	/**
+	 * @brief Replaces every element of a range with `2^x`.
+	 */
+	template<class P = default_precision, class = detail::enable_precision<P>>
+	SMATH_INLINE void exp2(span<float> values, P acc = P()) {
+		detail::exp2_span<float>(values, values, acc);
+	}
+
+	template<class P = default_precision, class = detail::enable_precision<P>>
+	SMATH_INLINE void exp2(span<double> values, P acc = P()) {
+		detail::exp2_span<double>(values, values, acc);
+	}
+
+	template<length_t L, class T, class P = default_precision, class = detail::enable_precision<P>>
+	SMATH_INLINE void exp2(span<vec<L, T>> values, P acc = P()) {
+		const span<T> c{ detail::component_span(values) };
+		detail::exp2_span<T>(c, c, acc);
+	}
+
+	/**
+	 * @brief Calculates `e^x - 1` for every element of a range.
+	 * @param in The input values.
+	 * @param out The output range, of the same size as `in`, which may be `in`.
+	 * @param acc The trade-off between speed and accuracy.
+	 */
+	template<class P = default_precision, class = detail::enable_precision<P>>
+	SMATH_INLINE void expm1(span<const float> in, span<float> out, P acc = P()) {
+		detail::expm1_span(in, out, acc);
+	}
+
+	template<class P = default_precision, class = detail::enable_precision<P>>
+	SMATH_INLINE void expm1(span<const double> in, span<double> out, P acc = P()) {
+		detail::expm1_span(in, out, acc);
+	}
+
+	/**
+	 * @brief Calculates `e^x - 1` for all of the components of a range of
+	 * vectors.
+	 * @tparam L The number of components in the vector in range [1, 4]
+	 * @tparam T The type of the vector (float, double)
+	 */
+	template<length_t L, class T, class P = default_precision, class = detail::enable_precision<P>>
+	SMATH_INLINE void expm1(typename detail::identity<span<const vec<L, T>>>::type in, span<vec<L, T>> out, P acc = P()) {
+		detail::expm1_span(detail::component_span(in), detail::component_span(out), acc);
+	}
+
+	/**
+	 * @brief Replaces every element of a range with `e^x - 1`.
+	 */
+	template<class P = default_precision, class = detail::enable_precision<P>>
+	SMATH_INLINE void expm1(span<float> values, P acc = P()) {
+		detail::expm1_span<float>(values, values, acc);
+	}
+
+	template<class P = default_precision, class = detail::enable_precision<P>>
+	SMATH_INLINE void expm1(span<double> values, P acc = P()) {
+		detail::expm1_span<double>(values, values, acc);
+	}
+
+	template<length_t L, class T, class P = default_precision, class = detail::enable_precision<P>>
+	SMATH_INLINE void expm1(span<vec<L, T>> values, P acc = P()) {
+		const span<T> c{ detail::component_span(values) };
+		detail::expm1_span<T>(c, c, acc);
+	}
+
+	/**
+	 * @brief Raises every element of a range to the power of the matching
+	 * element of another.
+	 * @param base The values to raise.
+	 * @param exponent The powers, of the same size as `base`.
+	 * @param out The output range, of the same size as `base`, which may be
+	 * `base` or `exponent`.
+	 * @param acc The trade-off between speed and accuracy.
+	 */
+	template<class P = default_precision, class = detail::enable_precision<P>>
+	SMATH_INLINE void pow(span<const float> base, span<const float> exponent, span<float> out, P acc = P()) {
+		detail::pow_span(base, exponent, out, acc);
+	}
+
+	template<class P = default_precision, class = detail::enable_precision<P>>
+	SMATH_INLINE void pow(span<const double> base, span<const double> exponent, span<double> out, P acc = P()) {
+		detail::pow_span(base, exponent, out, acc);
+	}
+
+	/**
+	 * @brief Raises every element of a range to the same power.
+	 * @param base The values to raise.
+	 * @param exponent The power.
+	 * @param out The output range, of the same size as `base`, which may be `base`.
+	 * @param acc The trade-off between speed and accuracy.
+	 */
+	template<class P = default_precision, class = detail::enable_precision<P>>
+	SMATH_INLINE void pow(span<const float> base, float exponent, span<float> out, P acc = P()) {
+		detail::pow_span(base, exponent, out, acc);
+	}
+
+	template<class P = default_precision, class = detail::enable_precision<P>>
+	SMATH_INLINE void pow(span<const double> base, double exponent, span<double> out, P acc = P()) {
+		detail::pow_span(base, exponent, out, acc);
+	}
+
+	/**
+	 * @brief Raises all of the components of a range of vectors to the same power.
+	 * @tparam L The number of components in the vector in range [1, 4]
+	 * @tparam T The type of the vector (float, double)
+	 */
+	template<length_t L, class T, class P = default_precision, class = detail::enable_precision<P>>
+	SMATH_INLINE void pow(typename detail::identity<span<const vec<L, T>>>::type base, T exponent, span<vec<L, T>> out, P acc = P()) {
+		detail::pow_span(detail::component_span(base), exponent, detail::component_span(out), acc);
+	}
+
+	/**
+	 * @brief Raises every element of a range to the same power in place.
+	 */
+	template<class P = default_precision, class = detail::enable_precision<P>>
+	SMATH_INLINE void pow(span<float> values, float exponent, P acc = P()) {
+		detail::pow_span<float>(values, exponent, values, acc);
+	}
+
+	template<class P = default_precision, class = detail::enable_precision<P>>
+	SMATH_INLINE void pow(span<double> values, double exponent, P acc = P()) {
+		detail::pow_span<double>(values, exponent, values, acc);
+	}
+
+	template<length_t L, class T, class P = default_precision, class = detail::enable_precision<P>>
+	SMATH_INLINE void pow(span<vec<L, T>> values, T exponent, P acc = P()) {
+		const span<T> c{ detail::component_span(values) };
+		detail::pow_span<T>(c, exponent, c, acc);
+	}
+
+	/**
+	 * @brief Multiplies every element of a range by a power of two, with the
+	 * results of std::ldexp.
+	 * @param in The input values.
+	 * @param exponents The power of two for each element, of the same size as `in`.
+	 * @param out The output range, of the same size as `in`, which may be `in`.
+	 */
+	SMATH_INLINE void ldexp(span<const float> in, span<const int> exponents, span<float> out) {
+		detail::ldexp_span(in, exponents, out);
+	}
+
+	SMATH_INLINE void ldexp(span<const double> in, span<const int> exponents, span<double> out) {
+		detail::ldexp_span(in, exponents, out);
+	}
+
+	/**
+	 * @brief Splits every element of a range into a significand in [0.5, 1) and
+	 * a power of two, with the results of std::frexp.
+	 * @param in The input values.
+	 * @param mantissas The output significands, of the same size as `in`, which
+	 * may be `in`.
+	 * @param exponents The output powers of two, of the same size as `in`.
+	 */
+	SMATH_INLINE void frexp(span<const float> in, span<float> mantissas, span<int> exponents) {
+		detail::frexp_span(in, mantissas, exponents);
+	}
+
+	SMATH_INLINE void frexp(span<const double> in, span<double> mantissas, span<int> exponents) {
+		detail::frexp_span(in, mantissas, exponents);
 	}
 
 } // namespace smath
 
+#if SMATH_CONFIG_SIMD == SMATH_ENABLE
+#	include "detail/exponential_simd.inl"
+#endif
+
 #endif // EXPONENTIAL_H
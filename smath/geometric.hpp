@@ -0,0 +1,128 @@
+#pragma once
+
+#ifndef GEOMETRIC_H
+#define GEOMETRIC_H
+
+#include "detail/setup.hpp"
+
+#include "exponential.hpp"
+#include "template_types.hpp"
+#include "vec.hpp"
+
+namespace smath {
+
+	namespace detail {
+
+		/**
+		 * @brief Template class to compute the dot product of two vectors,
+		 * specialized in geometric_simd.inl for vectors stored in SIMD registers.
+		 * @tparam L The number of components of the vector.
+		 * @tparam T The type of the vector (int, float, double)
+		 * @tparam Simd Whether the vector is stored in a SIMD register.
+		 */
+		template<length_t L, class T, bool Simd>
+		struct compute_dot {};
+
+		template<class T, bool Simd>
+		struct compute_dot<1, T, Simd> {
+			SMATH_CONSTEXPR static T call(const vec<1, T> &a, const vec<1, T> &b) {
+				return a.x * b.x;
+			}
+		};
+
+		template<class T, bool Simd>
+		struct compute_dot<2, T, Simd> {
+			SMATH_CONSTEXPR static T call(const vec<2, T> &a, const vec<2, T> &b) {
+				return a.x * b.x + a.y * b.y;
+			}
+		};
+
+		template<class T, bool Simd>
+		struct compute_dot<3, T, Simd> {
+			SMATH_CONSTEXPR static T call(const vec<3, T> &a, const vec<3, T> &b) {
+				return a.x * b.x + a.y * b.y + a.z * b.z;
+			}
+		};
+
+		template<class T, bool Simd>
+		struct compute_dot<4, T, Simd> {
+			SMATH_CONSTEXPR static T call(const vec<4, T> &a, const vec<4, T> &b) {
+				// summed pairwise, in the same order as the SIMD reduction
+				return (a.x * b.x + a.z * b.z) + (a.y * b.y + a.w * b.w);
+			}
+		};
+
+	} // namespace detail
+
+	/**
+	 * @brief Calculates the dot product of two vectors.
+	 * @tparam L The number of components in the vector in range [1, 4]
+	 * @tparam T The type of the vector (int, float, double)
+	 * @returns The sum of the products of the components of `a` and `b`.
+	 */
+	template<length_t L, class T>
+	SMATH_CONSTEXPR T dot(const vec<L, T> &a, const vec<L, T> &b) {
+		SMATH_STATIC_ASSERT(smath::is_integer_type<T>::value || smath::is_floating_type<T>::value, "'dot' only accepts an integer or floating-point vector");
+		SMATH_STATIC_ASSERT(smath::is_valid_vector(L), "'dot' only works on vectors with 1 to 4 components");
+		return detail::compute_dot<L, T, detail::is_simd<L, T>::value>::call(a, b);
+	}
+
+	/**
+	 * @brief Calculates the length (magnitude) of a vector.
+	 * @tparam L The number of components in the vector in range [1, 4]
+	 * @tparam T The type of the vector (float, double)
+	 * @returns The square root of the dot product of the vector with itself.
+	 */
+	template<length_t L, class T>
+	SMATH_INLINE SMATH_CONSTEXPR T length(const vec<L, T> &v) {
+		SMATH_STATIC_ASSERT(smath::is_floating_type<T>::value, "'length' only accepts a floating-point vector");
+		return smath::sqrt(smath::dot(v, v));
+	}
+
+	/**
+	 * @brief Calculates the distance between two points.
+	 * @tparam L The number of components in the vector in range [1, 4]
+	 * @tparam T The type of the vector (float, double)
+	 * @returns The length of the vector from `a` to `b`.
+	 */
+	template<length_t L, class T>
+	SMATH_INLINE SMATH_CONSTEXPR T distance(const vec<L, T> &a, const vec<L, T> &b) {
+		return smath::length(b - a);
+	}
+
+	/**
+	 * @brief Scales a vector to a length of 1 using the fast, inverse square
+	 * root of its squared length.
+	 * @tparam L The number of components in the vector in range [1, 4]
+	 * @tparam T The type of the vector (float, double)
+	 * @param acc The accuracy of the inverse square root.
+	 * @returns A vector with the same direction as `v` and a length of 1.
+	 */
+	template<length_t L, class T, class P = default_precision, class = detail::enable_precision<P>>
+	SMATH_INLINE vec<L, T> normalize(const vec<L, T> &v, P acc = P()) {
+		SMATH_STATIC_ASSERT(smath::is_floating_type<T>::value, "'normalize' only accepts a floating-point vector");
+		return v * smath::inv_sqrt(smath::dot(v, v), acc);
+	}
+
+	/**
+	 * @brief Calculates the cross product of two 3-component vectors.
+	 * @tparam T The type of the vector (int, float, double)
+	 * @returns A vector perpendicular to both `a` and `b`.
+	 */
+	template<class T>
+	SMATH_CONSTEXPR vec<3, T> cross(const vec<3, T> &a, const vec<3, T> &b) {
+		SMATH_STATIC_ASSERT(smath::is_integer_type<T>::value || smath::is_floating_type<T>::value, "'cross' only accepts an integer or floating-point vector");
+		return vec<3, T>(
+			a.y * b.z - b.y * a.z,
+			a.z * b.x - b.z * a.x,
+			a.x * b.y - b.x * a.y
+		);
+	}
+
+} // namespace smath
+
+#if SMATH_CONFIG_SIMD == SMATH_ENABLE
+#	include "detail/geometric_simd.inl"
+#endif
+
+#endif // GEOMETRIC_H
@@ -0,0 +1,217 @@
+#pragma once
+
+#ifndef LAYOUT_H
+#define LAYOUT_H
+
+#include <cstddef>
+
+#include "detail/setup.hpp"
+
+#include "simd/simd.hpp"
+#include "span.hpp"
+#include "template_types.hpp"
+#include "vec.hpp"
+
+namespace smath {
+
+	namespace detail {
+
+		/**
+		 * @brief Number of vectors transposed at once by transform_aos, the widest
+		 * batch with an in-register transpose.
+		 */
+		template<class T>
+		struct aos_width {
+			static const length_t value = 4;
+		};
+
+#if SMATH_ARCH & SMATH_ARCH_AVX_BIT
+		template<>
+		struct aos_width<float> {
+			static const length_t value = 8;
+		};
+#endif
+
+		/**
+		 * @brief Template class to convert between interleaved vectors and one
+		 * batch per component, specialized for the layouts that have an
+		 * in-register transpose.
+		 * @tparam L The number of components of the vector.
+		 * @tparam T The type of the components (int, float, double)
+		 * @tparam W The number of vectors, which is the width of the batches.
+		 */
+		template<length_t L, class T, length_t W>
+		struct compute_aos {
+			static void load(const T *src, simd::batch<T, W> (&out)[static_cast<std::size_t>(L)]) {
+				T lanes[static_cast<std::size_t>(L)][static_cast<std::size_t>(W)];
+				for (length_t i = 0; i < W; ++i) {
+					for (length_t c = 0; c < L; ++c) {
+						lanes[c][i] = src[i * L + c];
+					}
+				}
+				for (length_t c = 0; c < L; ++c) {
+					out[c] = simd::batch<T, W>::loadu(lanes[c]);
+				}
+			}
+
+			static void store(const simd::batch<T, W> (&in)[static_cast<std::size_t>(L)], T *dst) {
+				T lanes[static_cast<std::size_t>(L)][static_cast<std::size_t>(W)];
+				for (length_t c = 0; c < L; ++c) {
+					in[c].storeu(lanes[c]);
+				}
+				for (length_t i = 0; i < W; ++i) {
+					for (length_t c = 0; c < L; ++c) {
+						dst[i * L + c] = lanes[c][i];
+					}
+				}
+			}
+		};
+
+		template<class T, length_t W>
+		struct compute_aos<3, T, W> {
+			using B = simd::batch<T, W>;
+
+			static void load(const T *src, B (&out)[3]) {
+				simd::deinterleave3(B::loadu(src), B::loadu(src + W), B::loadu(src + 2 * W), out[0], out[1], out[2]);
+			}
+
+			static void store(const B (&in)[3], T *dst) {
+				B r0, r1, r2;
+				simd::interleave3(in[0], in[1], in[2], r0, r1, r2);
+				r0.storeu(dst);
+				r1.storeu(dst + W);
+				r2.storeu(dst + 2 * W);
+			}
+		};
+
+		template<class T>
+		struct compute_aos<4, T, 4> {
+			using B = simd::batch<T, 4>;
+
+			static void load(const T *src, B (&out)[4]) {
+				for (length_t r = 0; r < 4; ++r) {
+					out[r] = B::loadu(src + 4 * r);
+				}
+				simd::transpose(out[0], out[1], out[2], out[3]);
+			}
+
+			static void store(const B (&in)[4], T *dst) {
+				B t[4]{ in[0], in[1], in[2], in[3] };
+				simd::transpose(t[0], t[1], t[2], t[3]);
+				for (length_t r = 0; r < 4; ++r) {
+					t[r].storeu(dst + 4 * r);
+				}
+			}
+		};
+
+		template<class T>
+		struct compute_aos<4, T, 8> {
+			using B = simd::batch<T, 8>;
+
+			static void load(const T *src, B (&out)[4]) {
+				for (length_t r = 0; r < 4; ++r) {
+					out[r] = B::loadu(src + 8 * r);
+				}
+				simd::deinterleave4(out[0], out[1], out[2], out[3]);
+			}
+
+			static void store(const B (&in)[4], T *dst) {
+				B t[4]{ in[0], in[1], in[2], in[3] };
+				simd::interleave4(t[0], t[1], t[2], t[3]);
+				for (length_t r = 0; r < 4; ++r) {
+					t[r].storeu(dst + 8 * r);
+				}
+			}
+		};
+
+	} // namespace detail
+
+	/**
+	 * @brief Loads `W` interleaved vectors as one batch per component.
+	 * @tparam L The number of components in the vector in range [1, 4]
+	 * @tparam T The type of the vector (int, float, double)
+	 * @tparam W The number of vectors to load, which is the width of the batches.
+	 * @param src The first of `W` consecutive vectors.
+	 * @param out The batch for each component, so `out[c][i]` is `src[i][c]`.
+	 */
+	template<length_t L, class T, length_t W>
+	SMATH_INLINE void load_soa(const vec<L, T> *src, simd::batch<T, W> (&out)[static_cast<std::size_t>(L)]) {
+		SMATH_STATIC_ASSERT(smath::is_valid_vector(L), "'load_soa' only works on vectors with 1 to 4 components");
+		SMATH_STATIC_ASSERT(sizeof(vec<L, T>) == sizeof(T) * static_cast<std::size_t>(L), "vector components must be tightly packed");
+		detail::compute_aos<L, T, W>::load(reinterpret_cast<const T *>(src), out);
+	}
+
+	/**
+	 * @brief Stores one batch per component as `W` interleaved vectors.
+	 * Inverse of load_soa.
+	 * @tparam L The number of components in the vector in range [1, 4]
+	 * @tparam T The type of the vector (int, float, double)
+	 * @tparam W The number of vectors to store, which is the width of the batches.
+	 */
+	template<length_t L, class T, length_t W>
+	SMATH_INLINE void store_aos(const simd::batch<T, W> (&in)[static_cast<std::size_t>(L)], vec<L, T> *dst) {
+		SMATH_STATIC_ASSERT(smath::is_valid_vector(L), "'store_aos' only works on vectors with 1 to 4 components");
+		SMATH_STATIC_ASSERT(sizeof(vec<L, T>) == sizeof(T) * static_cast<std::size_t>(L), "vector components must be tightly packed");
+		detail::compute_aos<L, T, W>::store(in, reinterpret_cast<T *>(dst));
+	}
+
+	/**
+	 * @brief Runs a structure-of-arrays kernel over a range of interleaved
+	 * vectors, transposing each group of vectors in registers instead of
+	 * converting the whole range first.
+	 *
+	 * The kernel is called with an array of one batch per component, which it
+	 * updates in place. The last group is padded with zero vectors that are
+	 * not written back.
+	 *
+	 * @tparam L The number of components in the vector in range [1, 4]
+	 * @tparam T The type of the vector (int, float, double)
+	 * @param in The input vectors.
+	 * @param out The output range, of the same size as `in`, which may be `in`.
+	 * @param kernel Callable taking `simd::batch<T, W> (&)[L]`.
+	 */
+	template<length_t L, class T, class F>
+	void transform_aos(typename detail::identity<span<const vec<L, T>>>::type in, span<vec<L, T>> out, F kernel) {
+		assert(in.size() == out.size());
+
+		const length_t W{ detail::aos_width<T>::value };
+		const std::size_t width{ static_cast<std::size_t>(W) };
+		const std::size_t n{ in.size() };
+
+		simd::batch<T, detail::aos_width<T>::value> c[static_cast<std::size_t>(L)];
+
+		std::size_t i{ 0 };
+		for (; i + width <= n; i += width) {
+			load_soa(in.data() + i, c);
+			kernel(c);
+			store_aos(c, out.data() + i);
+		}
+
+		if (i < n) {
+			vec<L, T> tail[static_cast<std::size_t>(W)]{};
+			for (std::size_t j = i; j < n; ++j) {
+				tail[j - i] = in[j];
+			}
+
+			load_soa(tail, c);
+			kernel(c);
+			store_aos(c, tail);
+
+			for (std::size_t j = i; j < n; ++j) {
+				out[j] = tail[j - i];
+			}
+		}
+	}
+
+	/**
+	 * @brief Runs a structure-of-arrays kernel over a range of interleaved
+	 * vectors in place.
+	 */
+	template<length_t L, class T, class F>
+	SMATH_INLINE void transform_aos(span<vec<L, T>> values, F kernel) {
+		transform_aos<L, T>(values, values, kernel);
+	}
+
+} // namespace smath
+
+#endif // LAYOUT_H
@@ -3,12 +3,20 @@
 #ifndef MATH_H
 #define MATH_H
 
+#include <cassert>
 #include <cmath>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
 
 #include "detail/setup.hpp"
 #include "detail/function.hpp"
 
+#include "exponential.hpp"
+#include "simd/simd.hpp"
+#include "span.hpp"
 #include "template_types.hpp"
+#include "vec.hpp"
 
 namespace smath {
 
@@ -48,6 +56,101 @@ namespace smath {
 		return smath::min(a, smath::min(b, c));
 	}
 
+	namespace detail {
+
+		/**
+		 * @brief Template class to compute the component-wise and horizontal
+		 * minimum and maximum of vectors, specialized in math_simd.inl for
+		 * vectors stored in SIMD registers.
+		 * @tparam L The number of components of the vector.
+		 * @tparam T The type of the vector (int, float, double)
+		 * @tparam Simd Whether the vector is stored in a SIMD register.
+		 */
+		template<length_t L, class T, bool Simd>
+		struct compute_min_max {
+			SMATH_CONSTEXPR static vec<L, T> minimum(const vec<L, T> &a, const vec<L, T> &b) {
+				return function::map([](T x, T y) { return smath::min(x, y); }, a, b);
+			}
+
+			SMATH_CONSTEXPR static vec<L, T> maximum(const vec<L, T> &a, const vec<L, T> &b) {
+				return function::map([](T x, T y) { return smath::max(x, y); }, a, b);
+			}
+
+			SMATH_CONSTEXPR static T min_component(const vec<L, T> &v) {
+				T r{ v[0] };
+				for (length_t i = 1; i < L; ++i) {
+					r = smath::min(r, v[i]);
+				}
+				return r;
+			}
+
+			SMATH_CONSTEXPR static T max_component(const vec<L, T> &v) {
+				T r{ v[0] };
+				for (length_t i = 1; i < L; ++i) {
+					r = smath::max(r, v[i]);
+				}
+				return r;
+			}
+		};
+
+	} // namespace detail
+
+	/**
+	 * @brief Calculates the minimum of each pair of components.
+	 * @tparam L The number of components in the vector in range [1, 4]
+	 * @tparam T The type of the vector (int, float, double)
+	 * @returns A vector with each component as `min(a[i], b[i])`.
+	 */
+	template<length_t L, class T>
+	SMATH_INLINE SMATH_CONSTEXPR vec<L, T> min(const vec<L, T> &a, const vec<L, T> &b) {
+		SMATH_STATIC_ASSERT(smath::is_valid_vector(L), "'min' only works on vectors with 1 to 4 components");
+		return detail::compute_min_max<L, T, detail::is_simd<L, T>::value>::minimum(a, b);
+	}
+
+	template<length_t L, class T>
+	SMATH_INLINE SMATH_CONSTEXPR vec<L, T> min(const vec<L, T> &a, T b) {
+		return smath::min(a, vec<L, T>(b));
+	}
+
+	/**
+	 * @brief Calculates the maximum of each pair of components.
+	 * @tparam L The number of components in the vector in range [1, 4]
+	 * @tparam T The type of the vector (int, float, double)
+	 * @returns A vector with each component as `max(a[i], b[i])`.
+	 */
+	template<length_t L, class T>
+	SMATH_INLINE SMATH_CONSTEXPR vec<L, T> max(const vec<L, T> &a, const vec<L, T> &b) {
+		SMATH_STATIC_ASSERT(smath::is_valid_vector(L), "'max' only works on vectors with 1 to 4 components");
+		return detail::compute_min_max<L, T, detail::is_simd<L, T>::value>::maximum(a, b);
+	}
+
+	template<length_t L, class T>
+	SMATH_INLINE SMATH_CONSTEXPR vec<L, T> max(const vec<L, T> &a, T b) {
+		return smath::max(a, vec<L, T>(b));
+	}
+
+	/**
+	 * @brief Calculates the smallest component of a vector.
+	 * @tparam L The number of components in the vector in range [1, 4]
+	 * @tparam T The type of the vector (int, float, double)
+	 */
+	template<length_t L, class T>
+	SMATH_INLINE SMATH_CONSTEXPR T min_component(const vec<L, T> &v) {
+		SMATH_STATIC_ASSERT(smath::is_valid_vector(L), "'min_component' only works on vectors with 1 to 4 components");
+		return detail::compute_min_max<L, T, detail::is_simd<L, T>::value>::min_component(v);
+	}
+
+	/**
+	 * @brief Calculates the largest component of a vector.
+	 * @tparam L The number of components in the vector in range [1, 4]
+	 * @tparam T The type of the vector (int, float, double)
+	 */
+	template<length_t L, class T>
+	SMATH_INLINE SMATH_CONSTEXPR T max_component(const vec<L, T> &v) {
+		SMATH_STATIC_ASSERT(smath::is_valid_vector(L), "'max_component' only works on vectors with 1 to 4 components");
+		return detail::compute_min_max<L, T, detail::is_simd<L, T>::value>::max_component(v);
+	}
+
 	/**
 	 * @brief Calculates the absolute value of the given type.
 	 * @returns `a` if `a` >= 0 else `-a`.
@@ -68,18 +171,181 @@ namespace smath {
 	SMATH_CONSTEXPR vec<L, T> abs(const vec<L, T> &v) {
 		SMATH_STATIC_ASSERT(smath::is_integer_type<T>::value || smath::is_floating_type<T>::value, "'abs' only accepts integer or floating-point inputs");
 		SMATH_STATIC_ASSERT(smath::is_valid_vector(L), "'abs' only works on vectors with 1 to 4 components");
-		return function::one<vec, L, T, T>::apply(::std::abs, v);
+		return function::map([](T x) { return ::std::abs(x); }, v);
+	}
+
+	// -- Rounding --
+
+	/**
+	 * Direction in which a value is rounded to a whole number.
+	 */
+	enum class round_mode {
+		half_away,   //!< to the nearest, with ties away from zero (std::round)
+		half_even,   //!< to the nearest, with ties to even
+		down,        //!< towards negative infinity (std::floor)
+		up,          //!< towards positive infinity (std::ceil)
+		toward_zero  //!< towards zero (std::trunc)
+	};
+
+	namespace detail {
+
+		/**
+		 * @brief Rounds a number in a constant expression, where the standard
+		 * library functions are not constexpr.
+		 *
+		 * Adding and subtracting 2^(digits - 1) rounds any smaller magnitude
+		 * to the nearest whole number with ties to even, and every mode is
+		 * derived from that. Larger magnitudes, infinities, NaNs and zeros are
+		 * returned unchanged.
+		 */
+		template<class T>
+		SMATH_CONSTEXPR T round_constexpr(const T &a, round_mode mode) {
+			const T whole{ T(1) / ::std::numeric_limits<T>::epsilon() };
+			const T m{ a < T(0) ? -a : a };
+			if (!(m < whole) || m == T(0)) {
+				return a;
+			}
+
+			const T nearest{ (m + whole) - whole };
+			const T t{ nearest > m ? nearest - T(1) : nearest };
+			T r{ t };
+			switch (mode) {
+				case round_mode::half_even:
+					r = nearest;
+					break;
+				case round_mode::down:
+					r = (a < T(0) && t != m) ? t + T(1) : t;
+					break;
+				case round_mode::up:
+					r = (a > T(0) && t != m) ? t + T(1) : t;
+					break;
+				case round_mode::toward_zero:
+					break;
+				case round_mode::half_away:
+				default:
+					r = (m - t >= T(0.5)) ? t + T(1) : t;
+					break;
+			}
+			// rounding the magnitude keeps the sign, so -0.5 gives -0 toward zero
+			return a < T(0) ? -r : r;
+		}
+
+		template<class T>
+		SMATH_CONSTEXPR T round_scalar(const T &a, round_mode mode, std::true_type) {
+			if (SMATH_IS_CONSTANT_EVALUATED()) {
+				return round_constexpr(a, mode);
+			}
+			switch (mode) {
+				case round_mode::half_even:
+					// only exact halves differ from rounding away from zero
+					return (::std::fabs(a - ::std::trunc(a)) == T(0.5)) ? T(2) * ::std::round(a / T(2)) : ::std::round(a);
+				case round_mode::down:
+					return ::std::floor(a);
+				case round_mode::up:
+					return ::std::ceil(a);
+				case round_mode::toward_zero:
+					return ::std::trunc(a);
+				case round_mode::half_away:
+				default:
+					return ::std::round(a);
+			}
+		}
+
+		template<class T>
+		SMATH_CONSTEXPR T round_scalar(const T &a, round_mode, std::false_type) {
+			return a;
+		}
+
+		/**
+		 * @brief Rounds every lane of a floating-point batch, without branching
+		 * on the values.
+		 */
+		template<class B>
+		SMATH_INLINE B round_batch(const B &a, round_mode mode) {
+			using T = typename B::value_type;
+			switch (mode) {
+				case round_mode::half_even:
+					return nearbyint(a);
+				case round_mode::down:
+					return floor(a);
+				case round_mode::up:
+					return ceil(a);
+				case round_mode::toward_zero:
+					return trunc(a);
+				case round_mode::half_away:
+				default: {
+					// away from the truncated value when the dropped part is at
+					// least a half, which keeps the sign of results rounded to zero
+					const B t{ trunc(a) };
+					return select(abs(a - t) >= B(T(0.5)), t + select(a < B(T(0)), B(T(-1)), B(T(1))), t);
+				}
+			}
+		}
+
+		/**
+		 * @returns The largest number below 1, which bounds smath::fract where
+		 * `a - floor(a)` rounds up to 1 for tiny negative numbers.
+		 */
+		template<class T>
+		SMATH_CONSTEXPR T fract_max() {
+			return T(1) - ::std::numeric_limits<T>::epsilon() / T(2);
+		}
+
+		/**
+		 * @brief Template class to round every component of a vector,
+		 * specialized in math_simd.inl for vectors stored in SIMD registers.
+		 * @tparam L The number of components of the vector.
+		 * @tparam T The type of the vector (int, float, double)
+		 * @tparam Simd Whether the vector is stored in a SIMD register.
+		 */
+		template<length_t L, class T, bool Simd>
+		struct compute_round {
+			SMATH_CONSTEXPR static vec<L, T> call(const vec<L, T> &v, round_mode mode) {
+				return function::map([mode](T x) {
+					return round_scalar(x, mode, std::integral_constant<bool, is_floating_type<T>::value>());
+				}, v);
+			}
+		};
+
+	} // namespace detail
+
+	/**
+	 * @brief Rounds a number to a whole number in the given direction. Whole
+	 * numbers, infinities and NaNs are returned unchanged.
+	 * @tparam T The type of number (int, float, double)
+	 * @param mode The direction to round in.
+	 * @returns The rounded number, of the same type as `a`.
+	 */
+	template<class T>
+	SMATH_INLINE SMATH_CONSTEXPR T round(const T &a, round_mode mode) {
+		SMATH_STATIC_ASSERT(smath::is_integer_type<T>::value || smath::is_floating_type<T>::value, "'round' only accepts integer or floating-point inputs");
+		return detail::round_scalar(a, mode, std::integral_constant<bool, smath::is_floating_type<T>::value>());
 	}
 
 	/**
-	 * @brief Rounds a number to the nearest integer.
+	 * @brief Rounds each component of a vector to a whole number in the given
+	 * direction.
+	 * @tparam L The number of components in the vector in range [1, 4]
+	 * @tparam T The type of the vector (int, float, double)
+	 * @param mode The direction to round in.
+	 * @returns A vector of length `L` and type `T` with each component rounded.
+	 */
+	template<length_t L, class T>
+	SMATH_INLINE SMATH_CONSTEXPR vec<L, T> round(const vec<L, T> &v, round_mode mode) {
+		SMATH_STATIC_ASSERT(smath::is_integer_type<T>::value || smath::is_floating_type<T>::value, "'round' only accepts integer or floating-point inputs");
+		SMATH_STATIC_ASSERT(smath::is_valid_vector(L), "'round' only works on vectors with 1 to 4 components");
+		return detail::compute_round<L, T, detail::is_simd<L, T>::value>::call(v, mode);
+	}
+
+	/**
+	 * @brief Rounds a number to the nearest integer, with halfway cases
+	 * rounded away from zero.
 	 * @tparam T The type of number (int, float, double)
 	 * @returns A number that is closest to the given input number.
 	 */
 	template<class T>
-	SMATH_CONSTEXPR T round(const T &a) {
-		SMATH_STATIC_ASSERT(smath::is_integer_type<T>::value || smath::is_floating_type<T>::value, "'round' only accepts integer or floating-point inputs");
-		return static_cast<T>(static_cast<int>(a + 0.5));
+	SMATH_INLINE SMATH_CONSTEXPR T round(const T &a) {
+		return smath::round(a, round_mode::half_away);
 	}
 
 	/**
@@ -90,10 +356,8 @@ namespace smath {
 	 * to the nearest whole number.
 	 */
 	template<length_t L, class T>
-	SMATH_CONSTEXPR vec<L, T> round(const vec<L, T> &v) {
-		SMATH_STATIC_ASSERT(smath::is_integer_type<T>::value || smath::is_floating_type<T>::value, "'round' only accepts integer or floating-point inputs");
-		SMATH_STATIC_ASSERT(smath::is_valid_vector(L), "'round' only works on vectors with 1 to 4 components");
-		return function::one<vec, L, T, T>::apply(::std::round, v);
+	SMATH_INLINE SMATH_CONSTEXPR vec<L, T> round(const vec<L, T> &v) {
+		return smath::round(v, round_mode::half_away);
 	}
 
 	/**
@@ -102,26 +366,22 @@ namespace smath {
 	 * @param a The number to round.
 	 * @param nearest The number to round up or down to.
 	 * @returns The input rounded to the nearest multiple of the input parameter.
+	 * @see smath::quantize_map to round many values to the same multiple.
 	 */
 	template<class T>
 	SMATH_CONSTEXPR T round_nearest(const T &a, const int &nearest) {
 		SMATH_STATIC_ASSERT(smath::is_integer_type<T>::value || smath::is_floating_type<T>::value, "'round_nearest' only accept integers or floating-point inputs");
-		return static_cast<T>(static_cast<int>(smath::round(static_cast<double>(a) / nearest) * nearest));
+		return static_cast<T>(smath::round(static_cast<double>(a) / nearest) * nearest);
 	}
 
 	/**
-	 * @brief Rounds the input number downwards, effectively removing the decimal
-	 * point if it exists.
+	 * @brief Rounds the input number downwards.
 	 * @tparam T The type of number (int, float, double)
-	 * @returns A number that has been rounded down.
+	 * @returns The largest whole number not greater than `a`.
 	 */
 	template<class T>
-	SMATH_CONSTEXPR T floor(const T &a) {
-		SMATH_STATIC_ASSERT(smath::is_integer_type<T>::value || smath::is_floating_type<T>::value, "'floor' only accepts integer or floating-point inputs");
-		if (smath::is_integer_type<T>::value) {
-			return a;
-		}
-		return static_cast<T>(static_cast<int>((a > 0) ? a : a - 1));
+	SMATH_INLINE SMATH_CONSTEXPR T floor(const T &a) {
+		return smath::round(a, round_mode::down);
 	}
 
 	/**
@@ -131,24 +391,18 @@ namespace smath {
 	 * @returns A vector of length `L` and type `T` with each component rounded down.
 	 */
 	template<length_t L, class T>
-	SMATH_CONSTEXPR vec<L, T> floor(const vec<L, T> &v) {
-		SMATH_STATIC_ASSERT(smath::is_integer_type<T>::value || smath::is_floating_type<T>::value, "'floor' only accepts integer or floating-point inputs");
-		SMATH_STATIC_ASSERT(smath::is_valid_vector(L), "'floor' only works on vectors with 1 to 4 components");
-		return function::one<vec, L, T, T>::apply(::std::floor, v);
+	SMATH_INLINE SMATH_CONSTEXPR vec<L, T> floor(const vec<L, T> &v) {
+		return smath::round(v, round_mode::down);
 	}
 
 	/**
 	 * @brief Rounds the input number upwards.
 	 * @tparam T The type of number (int, float, double)
-	 * @returns A number that has been rounded upwards.
+	 * @returns The smallest whole number not less than `a`.
 	 */
 	template<class T>
-	SMATH_CONSTEXPR T ceil(const T &a) {
-		SMATH_STATIC_ASSERT(smath::is_integer_type<T>::value || smath::is_floating_type<T>::value, "'ceil' only accepts integer or floating-point inputs");
-		if (smath::is_integer_type<T>::value) {
-			return a;
-		}
-		return static_cast<T>(static_cast<int>((a > 0) ? a + 1 : a));
+	SMATH_INLINE SMATH_CONSTEXPR T ceil(const T &a) {
+		return smath::round(a, round_mode::up);
 	}
 
 	/**
@@ -158,10 +412,85 @@ namespace smath {
 	 * @returns A vector of length `L` and type `T` with each component rounded up.
 	 */
 	template<length_t L, class T>
-	SMATH_CONSTEXPR vec<L, T> ceil(const vec<L, T> &v) {
-		SMATH_STATIC_ASSERT(smath::is_integer_type<T>::value || smath::is_floating_type<T>::value, "'ceil' only accepts integer or floating-point inputs");
-		SMATH_STATIC_ASSERT(smath::is_valid_vector(L), "'ceil' only works on vectors with 1 to 4 components");
-		return function::one<vec, L, T, T>::apply(::std::ceil, v);
+	SMATH_INLINE SMATH_CONSTEXPR vec<L, T> ceil(const vec<L, T> &v) {
+		return smath::round(v, round_mode::up);
+	}
+
+	/**
+	 * @brief Removes the fractional part of a number, rounding towards zero.
+	 * @tparam T The type of number (int, float, double)
+	 * @returns The whole number part of `a`.
+	 */
+	template<class T>
+	SMATH_INLINE SMATH_CONSTEXPR T trunc(const T &a) {
+		return smath::round(a, round_mode::toward_zero);
+	}
+
+	/**
+	 * @brief Removes the fractional part of each component of a vector.
+	 * @tparam L The number of components in the vector in range [1, 4]
+	 * @tparam T The type of the vector (int, float, double)
+	 * @returns A vector of length `L` and type `T` with each component rounded
+	 * towards zero.
+	 */
+	template<length_t L, class T>
+	SMATH_INLINE SMATH_CONSTEXPR vec<L, T> trunc(const vec<L, T> &v) {
+		return smath::round(v, round_mode::toward_zero);
+	}
+
+	/**
+	 * @brief Calculates the fractional part of a number as `a - floor(a)`,
+	 * which is in range [0, 1) for negative numbers as well. Tiny negative
+	 * numbers, whose difference rounds to 1, give the largest number below 1.
+	 * @tparam T The type of number (float, double)
+	 */
+	template<class T>
+	SMATH_INLINE SMATH_CONSTEXPR T fract(const T &a) {
+		SMATH_STATIC_ASSERT(smath::is_floating_type<T>::value, "'fract' only accepts floating-point inputs");
+		// the limit comes first so that NaNs are returned
+		return smath::min(detail::fract_max<T>(), a - smath::floor(a));
+	}
+
+	/**
+	 * @brief Calculates the fractional part of each component of a vector.
+	 * @tparam L The number of components in the vector in range [1, 4]
+	 * @tparam T The type of the vector (float, double)
+	 * @returns A vector with each component as `v[i] - floor(v[i])`, in range
+	 * [0, 1) as smath::fract.
+	 */
+	template<length_t L, class T>
+	SMATH_INLINE SMATH_CONSTEXPR vec<L, T> fract(const vec<L, T> &v) {
+		SMATH_STATIC_ASSERT(smath::is_floating_type<T>::value, "'fract' only accepts a floating-point vector");
+		return smath::min(vec<L, T>(detail::fract_max<T>()), v - smath::floor(v));
+	}
+
+	/**
+	 * @brief Splits a number into its whole and fractional parts, which both
+	 * have the sign of `a`, as std::modf.
+	 * @tparam T The type of number (float, double)
+	 * @param ipart Set to the whole number part of `a`.
+	 * @returns The fractional part of `a`.
+	 */
+	template<class T>
+	SMATH_INLINE T modf(const T &a, T &ipart) {
+		SMATH_STATIC_ASSERT(smath::is_floating_type<T>::value, "'modf' only accepts floating-point inputs");
+		return ::std::modf(a, &ipart);
+	}
+
+	/**
+	 * @brief Splits each component of a vector into its whole and fractional
+	 * parts.
+	 * @tparam L The number of components in the vector in range [1, 4]
+	 * @tparam T The type of the vector (float, double)
+	 * @param ipart Set to the whole number part of each component.
+	 * @returns The fractional part of each component.
+	 */
+	template<length_t L, class T>
+	SMATH_INLINE vec<L, T> modf(const vec<L, T> &v, vec<L, T> &ipart) {
+		SMATH_STATIC_ASSERT(smath::is_floating_type<T>::value, "'modf' only accepts a floating-point vector");
+		ipart = smath::trunc(v);
+		// infinities are whole, so their fractional part is a signed zero
+		return function::map([](T x, T i) { return ::std::copysign(::std::isinf(x) ? T(0) : x - i, x); }, v, ipart);
 	}
 
 	/**
@@ -173,16 +502,812 @@ namespace smath {
 	 * @param c The new minimum of the range to scale to.
 	 * @param d The new maximum of the range to scale to.
 	 * @returns A scaled value in the range [c, d].
+	 * @see smath::range_map to scale many values between the same ranges.
 	 */
 	template<class T>
 	SMATH_CONSTEXPR T scale(const T &x, const T &a, const T &b, const T &c, const T &d) {
 		SMATH_STATIC_ASSERT(smath::is_integer_type<T>::value || smath::is_floating_type<T>::value, "'scale' only accepts integer or floating-point inputs");
 		if (smath::is_integer_type<T>::value) {
-			return smath::round((d - c) * ((x - a) / static_cast<float>(b - a)) + c);
+			// double holds every int exactly, unlike float
+			return static_cast<T>(smath::round((d - c) * ((x - a) / static_cast<double>(b - a)) + c));
 		}
 		return (d - c) * ((x - a) / (b - a)) + c;
 	}
 
+	template<class T>
+	SMATH_CONSTEXPR T smoothstep(const T &edge0, const T &edge1, const T &x);
+
+	namespace detail {
+
+		template<class T>
+		SMATH_CONSTEXPR T fma_scalar(const T &a, const T &b, const T &c, std::true_type) {
+			return ::std::fma(a, b, c);
+		}
+
+		template<class T>
+		SMATH_CONSTEXPR T fma_scalar(const T &a, const T &b, const T &c, std::false_type) {
+			return a * b + c;
+		}
+
+		/**
+		 * @brief Multiplies and adds like the SIMD `fma`, with a single rounding
+		 * only when the target has FMA instructions, as std::fma is otherwise a
+		 * slow library call.
+		 */
+		template<class T>
+		SMATH_CONSTEXPR T fma_lane(const T &a, const T &b, const T &c, std::true_type) {
+#if SMATH_ARCH & SMATH_ARCH_FMA_BIT
+			return ::std::fma(a, b, c);
+#else
+			return a * b + c;
+#endif
+		}
+
+		template<class T>
+		SMATH_CONSTEXPR T fma_lane(const T &a, const T &b, const T &c, std::false_type) {
+			return a * b + c;
+		}
+
+		/**
+		 * @brief Template class to compute a multiply-add on every component,
+		 * specialized in math_simd.inl for vectors stored in SIMD registers.
+		 * @tparam L The number of components of the vector.
+		 * @tparam T The type of the vector (int, float, double)
+		 * @tparam Simd Whether the vector is stored in a SIMD register.
+		 */
+		template<length_t L, class T, bool Simd>
+		struct compute_fma {
+			SMATH_CONSTEXPR static vec<L, T> call(const vec<L, T> &a, const vec<L, T> &b, const vec<L, T> &c) {
+				return function::map([](T x, T y, T z) {
+					return fma_lane(x, y, z, std::integral_constant<bool, is_floating_type<T>::value>());
+				}, a, b, c);
+			}
+		};
+
+		/**
+		 * @brief Template classes to compute the GLSL-style range functions on
+		 * every component, specialized in math_simd.inl for vectors stored in
+		 * SIMD registers.
+		 * @tparam L The number of components of the vector.
+		 * @tparam T The type of the vector (int, float, double)
+		 * @tparam Simd Whether the vector is stored in a SIMD register.
+		 */
+		template<length_t L, class T, bool Simd>
+		struct compute_clamp {
+			SMATH_CONSTEXPR static vec<L, T> call(const vec<L, T> &x, const vec<L, T> &lo, const vec<L, T> &hi) {
+				return function::map([](T a, T b, T c) { return smath::min(smath::max(a, b), c); }, x, lo, hi);
+			}
+		};
+
+		template<length_t L, class T, bool Simd>
+		struct compute_step {
+			SMATH_CONSTEXPR static vec<L, T> call(const vec<L, T> &edge, const vec<L, T> &x) {
+				return function::map([](T e, T a) { return a < e ? T(0) : T(1); }, edge, x);
+			}
+		};
+
+		template<length_t L, class T, bool Simd>
+		struct compute_smoothstep {
+			SMATH_CONSTEXPR static vec<L, T> call(const vec<L, T> &edge0, const vec<L, T> &edge1, const vec<L, T> &x) {
+				return function::map([](T e0, T e1, T a) { return smath::smoothstep(e0, e1, a); }, edge0, edge1, x);
+			}
+		};
+
+		template<class T>
+		SMATH_INLINE void clamp_span(span<const T> in, T lo, T hi, span<T> out) {
+			const simd::native<T> blo(lo), bhi(hi);
+			apply_span(in, out,
+				[blo, bhi](const simd::native<T> &b) { return min(max(blo, b), bhi); },
+				[lo, hi](T a) { return smath::min(smath::max(a, lo), hi); });
+		}
+
+		template<class T>
+		SMATH_INLINE void step_span(T edge, span<const T> in, span<T> out) {
+			const simd::native<T> bedge(edge), zero(T(0)), one(T(1));
+			apply_span(in, out,
+				[bedge, zero, one](const simd::native<T> &b) { return select(b < bedge, zero, one); },
+				[edge](T a) { return a < edge ? T(0) : T(1); });
+		}
+
+		template<class T>
+		SMATH_INLINE void smoothstep_span(T edge0, T edge1, span<const T> in, span<T> out) {
+			using B = simd::native<T>;
+			const B b0(edge0), range(edge1 - edge0);
+			apply_span(in, out,
+				[b0, range](const B &b) {
+					const B t{ min(max(B(T(0)), (b - b0) / range), B(T(1))) };
+					return t * t * (B(T(3)) - B(T(2)) * t);
+				},
+				[edge0, edge1](T a) { return smath::smoothstep(edge0, edge1, a); });
+		}
+
+		template<class T>
+		SMATH_INLINE void round_span(span<const T> in, span<T> out, round_mode mode) {
+			using B = simd::native<T>;
+			// the mode is resolved once, outside of the loops
+			switch (mode) {
+				case round_mode::half_even:
+					apply_span(in, out, [](const B &b) { return nearbyint(b); }, [](T a) { return smath::round(a, round_mode::half_even); });
+					break;
+				case round_mode::down:
+					apply_span(in, out, [](const B &b) { return floor(b); }, [](T a) { return ::std::floor(a); });
+					break;
+				case round_mode::up:
+					apply_span(in, out, [](const B &b) { return ceil(b); }, [](T a) { return ::std::ceil(a); });
+					break;
+				case round_mode::toward_zero:
+					apply_span(in, out, [](const B &b) { return trunc(b); }, [](T a) { return ::std::trunc(a); });
+					break;
+				case round_mode::half_away:
+				default:
+					apply_span(in, out, [](const B &b) { return round_batch(b, round_mode::half_away); }, [](T a) { return ::std::round(a); });
+					break;
+			}
+		}
+
+		template<class T>
+		SMATH_INLINE void fract_span(span<const T> in, span<T> out) {
+			const simd::native<T> limit(fract_max<T>());
+			apply_span(in, out,
+				[limit](const simd::native<T> &b) { return min(limit, b - floor(b)); },
+				[](T a) { return smath::min(fract_max<T>(), a - ::std::floor(a)); });
+		}
+
+		/**
+		 * @brief Picks the smaller (or larger) of a new value and the current
+		 * extreme in every lane, keeping the current one when the new value is
+		 * NaN, as the SIMD min and max return their second operand.
+		 */
+		template<class B>
+		SMATH_INLINE B pick_extreme(const B &x, const B &current, std::false_type) {
+			return min(x, current);
+		}
+
+		template<class B>
+		SMATH_INLINE B pick_extreme(const B &x, const B &current, std::true_type) {
+			return max(x, current);
+		}
+
+		template<class T>
+		SMATH_INLINE bool is_extreme(const T &x, const T &current, std::false_type) {
+			return x < current;
+		}
+
+		template<class T>
+		SMATH_INLINE bool is_extreme(const T &x, const T &current, std::true_type) {
+			return x > current;
+		}
+
+		/**
+		 * @brief Finds the first index of the smallest (or largest) value of each
+		 * of `L` interleaved components, skipping NaNs.
+		 *
+		 * The first pass reduces whole batches to the extreme values and the
+		 * second compares batches against them, so both passes run on SIMD
+		 * registers. Every group of `L` batches covers whole elements, so lane
+		 * `j` of batch `k` in a group always holds component `(k * width + j) % L`.
+		 *
+		 * @returns The element index for each component, or the number of
+		 * elements when the range is empty or only holds NaNs.
+		 */
+		template<length_t L, class T, bool Max>
+		SMATH_INLINE vec<L, std::size_t> arg_extreme(span<const T> in) {
+			SMATH_STATIC_ASSERT(smath::is_floating_type<T>::value, "'argmin' and 'argmax' only accept floating-point ranges");
+			assert(in.size() % static_cast<std::size_t>(L) == 0);
+
+			using B = simd::native<T>;
+			using tag = std::integral_constant<bool, Max>;
+			const std::size_t width{ static_cast<std::size_t>(B::size()) };
+			const std::size_t group{ width * static_cast<std::size_t>(L) };
+			const std::size_t n{ in.size() };
+			const T init{ Max ? -std::numeric_limits<T>::infinity() : std::numeric_limits<T>::infinity() };
+
+			B acc[static_cast<std::size_t>(L)];
+			for (length_t k = 0; k < L; ++k) {
+				acc[k] = B(init);
+			}
+
+			std::size_t i{ 0 };
+			for (; i + group <= n; i += group) {
+				for (length_t k = 0; k < L; ++k) {
+					acc[k] = pick_extreme(B::loadu(in.data() + i + static_cast<std::size_t>(k) * width), acc[k], tag());
+				}
+			}
+
+			T best[static_cast<std::size_t>(L)];
+			T lanes[static_cast<std::size_t>(B::size())];
+			for (length_t c = 0; c < L; ++c) {
+				best[c] = init;
+			}
+			for (length_t k = 0; k < L; ++k) {
+				acc[k].storeu(lanes);
+				for (std::size_t j = 0; j < width; ++j) {
+					T &b{ best[(static_cast<std::size_t>(k) * width + j) % static_cast<std::size_t>(L)] };
+					b = is_extreme(lanes[j], b, tag()) ? lanes[j] : b;
+				}
+			}
+			for (; i < n; ++i) {
+				T &b{ best[i % static_cast<std::size_t>(L)] };
+				b = is_extreme(in[i], b, tag()) ? in[i] : b;
+			}
+
+			// the extreme values laid out like the accumulators
+			B pattern[static_cast<std::size_t>(L)];
+			for (length_t k = 0; k < L; ++k) {
+				for (std::size_t j = 0; j < width; ++j) {
+					lanes[j] = best[(static_cast<std::size_t>(k) * width + j) % static_cast<std::size_t>(L)];
+				}
+				pattern[k] = B::loadu(lanes);
+			}
+
+			const std::size_t count{ n / static_cast<std::size_t>(L) };
+			vec<L, std::size_t> index(count);
+			length_t found{ 0 };
+			i = 0;
+			for (; i + group <= n && found < L; i += group) {
+				for (length_t k = 0; k < L; ++k) {
+					if (!any(B::loadu(in.data() + i + static_cast<std::size_t>(k) * width) == pattern[k])) {
+						continue;
+					}
+					for (std::size_t e = i + static_cast<std::size_t>(k) * width; e < i + static_cast<std::size_t>(k + 1) * width; ++e) {
+						const length_t c{ static_cast<length_t>(e % static_cast<std::size_t>(L)) };
+						if (index[c] == count && in[e] == best[c]) {
+							index[c] = e / static_cast<std::size_t>(L);
+							++found;
+						}
+					}
+				}
+			}
+			for (; i < n && found < L; ++i) {
+				const length_t c{ static_cast<length_t>(i % static_cast<std::size_t>(L)) };
+				if (index[c] == count && in[i] == best[c]) {
+					index[c] = i / static_cast<std::size_t>(L);
+					++found;
+				}
+			}
+			return index;
+		}
+
+		/**
+		 * @brief Runs a multiply-add over full native batches and the
+		 * tail of the ranges, where `b` is read through `load_b` so it may be a
+		 * range or a single value.
+		 */
+		template<class T, class FB, class FS>
+		SMATH_INLINE void fma_span(span<const T> a, FB load_b, FS get_b, span<const T> c, span<T> out) {
+			SMATH_STATIC_ASSERT(smath::is_floating_type<T>::value, "batch functions only accept floating-point ranges");
+			assert(a.size() == out.size() && c.size() == out.size());
+
+			using B = simd::native<T>;
+			const std::size_t width{ static_cast<std::size_t>(B::size()) };
+			const std::size_t n{ out.size() };
+
+			std::size_t i{ 0 };
+			for (; i + width <= n; i += width) {
+				fma(B::loadu(a.data() + i), load_b(i), B::loadu(c.data() + i)).storeu(out.data() + i);
+			}
+			for (; i < n; ++i) {
+				out[i] = fma_lane(a[i], get_b(i), c[i], std::true_type());
+			}
+		}
+
+		template<class T>
+		SMATH_INLINE void fma_span(span<const T> a, span<const T> b, span<const T> c, span<T> out) {
+			assert(b.size() == out.size());
+			fma_span(a,
+				[b](std::size_t i) { return simd::native<T>::loadu(b.data() + i); },
+				[b](std::size_t i) { return b[i]; },
+				c, out);
+		}
+
+		template<class T>
+		SMATH_INLINE void mix_span(span<const T> a, span<const T> b, T t, span<T> out) {
+			assert(b.size() == out.size());
+			using B = simd::native<T>;
+			const std::size_t width{ static_cast<std::size_t>(B::size()) };
+			const std::size_t n{ out.size() };
+			const B tb(t);
+
+			std::size_t i{ 0 };
+			for (; i + width <= n; i += width) {
+				const B x{ B::loadu(a.data() + i) };
+				fma(tb, B::loadu(b.data() + i) - x, x).storeu(out.data() + i);
+			}
+			for (; i < n; ++i) {
+				out[i] = fma_lane(t, b[i] - a[i], a[i], std::true_type());
+			}
+		}
+
+	} // namespace detail
+
+	// -- Multiply-add --
+
+	/**
+	 * @brief Calculates `a * b + c` with a single rounding, which compiles to
+	 * one instruction when FMA is available and calls std::fma otherwise.
+	 * @tparam T The type of number (int, float, double)
+	 * @returns The product of `a` and `b` plus `c`.
+	 */
+	template<class T>
+	SMATH_INLINE SMATH_CONSTEXPR T fma(const T &a, const T &b, const T &c) {
+		SMATH_STATIC_ASSERT(smath::is_integer_type<T>::value || smath::is_floating_type<T>::value, "'fma' only accepts integer or floating-point inputs");
+		return detail::fma_scalar(a, b, c, std::integral_constant<bool, smath::is_floating_type<T>::value>());
+	}
+
+	/**
+	 * @brief Calculates `a * b + c` on every component, in one instruction when
+	 * FMA is available. Without it, vectors and ranges round the product before
+	 * the addition, as fusing each component in software is several times
+	 * slower than the two operations.
+	 * @tparam L The number of components in the vector in range [1, 4]
+	 * @tparam T The type of the vector (int, float, double)
+	 * @returns A vector of length `L` and type `T` with each component as
+	 * `a[i] * b[i] + c[i]`.
+	 */
+	template<length_t L, class T>
+	SMATH_INLINE SMATH_CONSTEXPR vec<L, T> fma(const vec<L, T> &a, const vec<L, T> &b, const vec<L, T> &c) {
+		SMATH_STATIC_ASSERT(smath::is_integer_type<T>::value || smath::is_floating_type<T>::value, "'fma' only accepts an integer or floating-point vector");
+		SMATH_STATIC_ASSERT(smath::is_valid_vector(L), "'fma' only works on vectors with 1 to 4 components");
+		return detail::compute_fma<L, T, detail::is_simd<L, T>::value>::call(a, b, c);
+	}
+
+	/**
+	 * @brief Scales a vector by a scalar and adds another vector, with the
+	 * rounding of the vector smath::fma.
+	 * @returns A vector with each component as `a[i] * scalar + c[i]`.
+	 */
+	template<length_t L, class T>
+	SMATH_INLINE SMATH_CONSTEXPR vec<L, T> fma(const vec<L, T> &a, T scalar, const vec<L, T> &c) {
+		return smath::fma(a, vec<L, T>(scalar), c);
+	}
+
+	template<length_t L, class T>
+	SMATH_INLINE SMATH_CONSTEXPR vec<L, T> fma(T scalar, const vec<L, T> &b, const vec<L, T> &c) {
+		return smath::fma(vec<L, T>(scalar), b, c);
+	}
+
+	/**
+	 * @brief Linearly interpolates between two values as `a + t * (b - a)`,
+	 * with a multiply-add that is fused when FMA is available.
+	 * @tparam T The type of number (float, double)
+	 * @param a The value at `t` = 0.
+	 * @param b The value at `t` = 1.
+	 * @param t The interpolation factor, usually in range [0, 1].
+	 * @returns The interpolated value.
+	 */
+	template<class T>
+	SMATH_INLINE SMATH_CONSTEXPR T mix(const T &a, const T &b, const T &t) {
+		SMATH_STATIC_ASSERT(smath::is_floating_type<T>::value, "'mix' only accepts floating-point inputs");
+		return detail::fma_lane(t, b - a, a, std::true_type());
+	}
+
+	/**
+	 * @brief Linearly interpolates every component between two vectors by the
+	 * same factor.
+	 * @tparam L The number of components in the vector in range [1, 4]
+	 * @tparam T The type of the vector (float, double)
+	 * @returns A vector with each component as `a[i] + t * (b[i] - a[i])`.
+	 */
+	template<length_t L, class T>
+	SMATH_INLINE SMATH_CONSTEXPR vec<L, T> mix(const vec<L, T> &a, const vec<L, T> &b, T t) {
+		SMATH_STATIC_ASSERT(smath::is_floating_type<T>::value, "'mix' only accepts a floating-point vector");
+		return smath::fma(t, b - a, a);
+	}
+
+	/**
+	 * @brief Linearly interpolates every component between two vectors by the
+	 * matching component of `t`.
+	 * @returns A vector with each component as `a[i] + t[i] * (b[i] - a[i])`.
+	 */
+	template<length_t L, class T>
+	SMATH_INLINE SMATH_CONSTEXPR vec<L, T> mix(const vec<L, T> &a, const vec<L, T> &b, const vec<L, T> &t) {
+		SMATH_STATIC_ASSERT(smath::is_floating_type<T>::value, "'mix' only accepts a floating-point vector");
+		return smath::fma(t, b - a, a);
+	}
+
+	/**
+	 * @brief Same as mix.
+	 */
+	template<class T>
+	SMATH_INLINE SMATH_CONSTEXPR T lerp(const T &a, const T &b, const T &t) {
+		return smath::mix(a, b, t);
+	}
+
+	template<length_t L, class T>
+	SMATH_INLINE SMATH_CONSTEXPR vec<L, T> lerp(const vec<L, T> &a, const vec<L, T> &b, T t) {
+		return smath::mix(a, b, t);
+	}
+
+	template<length_t L, class T>
+	SMATH_INLINE SMATH_CONSTEXPR vec<L, T> lerp(const vec<L, T> &a, const vec<L, T> &b, const vec<L, T> &t) {
+		return smath::mix(a, b, t);
+	}
+
+	// -- Ranges --
+
+	/**
+	 * @brief Restricts a value to a range. Vectors and ranges give the same
+	 * results, including `hi` for a NaN `x` and `x` for zeros equal to `lo`.
+	 * @tparam T The type of number (int, float, double)
+	 * @returns `lo` if `x` < `lo`, `hi` if `x` > `hi`, else `x`.
+	 */
+	template<class T>
+	SMATH_INLINE SMATH_CONSTEXPR T clamp(const T &x, const T &lo, const T &hi) {
+		SMATH_STATIC_ASSERT(smath::is_integer_type<T>::value || smath::is_floating_type<T>::value, "'clamp' only accepts integer or floating-point inputs");
+		return smath::min(smath::max(x, lo), hi);
+	}
+
+	/**
+	 * @brief Restricts every component of a vector to the range given by the
+	 * matching components of `lo` and `hi`.
+	 * @tparam L The number of components in the vector in range [1, 4]
+	 * @tparam T The type of the vector (int, float, double)
+	 * @returns A vector with each component clamped.
+	 */
+	template<length_t L, class T>
+	SMATH_INLINE SMATH_CONSTEXPR vec<L, T> clamp(const vec<L, T> &x, const vec<L, T> &lo, const vec<L, T> &hi) {
+		SMATH_STATIC_ASSERT(smath::is_integer_type<T>::value || smath::is_floating_type<T>::value, "'clamp' only accepts an integer or floating-point vector");
+		SMATH_STATIC_ASSERT(smath::is_valid_vector(L), "'clamp' only works on vectors with 1 to 4 components");
+		return detail::compute_clamp<L, T, detail::is_simd<L, T>::value>::call(x, lo, hi);
+	}
+
+	template<length_t L, class T>
+	SMATH_INLINE SMATH_CONSTEXPR vec<L, T> clamp(const vec<L, T> &x, T lo, T hi) {
+		return smath::clamp(x, vec<L, T>(lo), vec<L, T>(hi));
+	}
+
+	/**
+	 * @brief Restricts a value to the range [0, 1].
+	 * @tparam T The type of number (float, double)
+	 */
+	template<class T>
+	SMATH_INLINE SMATH_CONSTEXPR T saturate(const T &x) {
+		SMATH_STATIC_ASSERT(smath::is_floating_type<T>::value, "'saturate' only accepts floating-point inputs");
+		return smath::clamp(x, T(0), T(1));
+	}
+
+	template<length_t L, class T>
+	SMATH_INLINE SMATH_CONSTEXPR vec<L, T> saturate(const vec<L, T> &x) {
+		SMATH_STATIC_ASSERT(smath::is_floating_type<T>::value, "'saturate' only accepts a floating-point vector");
+		return smath::clamp(x, T(0), T(1));
+	}
+
+	/**
+	 * @brief Compares a value with an edge.
+	 * @tparam T The type of number (int, float, double)
+	 * @returns 0 if `x` < `edge`, else 1.
+	 */
+	template<class T>
+	SMATH_INLINE SMATH_CONSTEXPR T step(const T &edge, const T &x) {
+		SMATH_STATIC_ASSERT(smath::is_integer_type<T>::value || smath::is_floating_type<T>::value, "'step' only accepts integer or floating-point inputs");
+		return x < edge ? T(0) : T(1);
+	}
+
+	/**
+	 * @brief Compares every component of a vector with the matching edge.
+	 * @tparam L The number of components in the vector in range [1, 4]
+	 * @tparam T The type of the vector (int, float, double)
+	 * @returns A vector with each component as 0 if `x[i]` < `edge[i]`, else 1.
+	 */
+	template<length_t L, class T>
+	SMATH_INLINE SMATH_CONSTEXPR vec<L, T> step(const vec<L, T> &edge, const vec<L, T> &x) {
+		SMATH_STATIC_ASSERT(smath::is_integer_type<T>::value || smath::is_floating_type<T>::value, "'step' only accepts an integer or floating-point vector");
+		SMATH_STATIC_ASSERT(smath::is_valid_vector(L), "'step' only works on vectors with 1 to 4 components");
+		return detail::compute_step<L, T, detail::is_simd<L, T>::value>::call(edge, x);
+	}
+
+	template<length_t L, class T>
+	SMATH_INLINE SMATH_CONSTEXPR vec<L, T> step(T edge, const vec<L, T> &x) {
+		return smath::step(vec<L, T>(edge), x);
+	}
+
+	/**
+	 * @brief Hermite interpolation between 0 and 1 as `x` goes from `edge0` to
+	 * `edge1`, which is 0 below `edge0` and 1 above `edge1`.
+	 * @tparam T The type of number (float, double)
+	 * @returns `t * t * (3 - 2 * t)` with `t` = saturate((x - edge0) / (edge1 - edge0)).
+	 */
+	template<class T>
+	SMATH_CONSTEXPR T smoothstep(const T &edge0, const T &edge1, const T &x) {
+		SMATH_STATIC_ASSERT(smath::is_floating_type<T>::value, "'smoothstep' only accepts floating-point inputs");
+		const T t{ smath::clamp((x - edge0) / (edge1 - edge0), T(0), T(1)) };
+		return t * t * (T(3) - T(2) * t);
+	}
+
+	/**
+	 * @brief Hermite interpolation on every component of a vector between the
+	 * matching edges.
+	 * @tparam L The number of components in the vector in range [1, 4]
+	 * @tparam T The type of the vector (float, double)
+	 */
+	template<length_t L, class T>
+	SMATH_INLINE SMATH_CONSTEXPR vec<L, T> smoothstep(const vec<L, T> &edge0, const vec<L, T> &edge1, const vec<L, T> &x) {
+		SMATH_STATIC_ASSERT(smath::is_floating_type<T>::value, "'smoothstep' only accepts a floating-point vector");
+		SMATH_STATIC_ASSERT(smath::is_valid_vector(L), "'smoothstep' only works on vectors with 1 to 4 components");
+		return detail::compute_smoothstep<L, T, detail::is_simd<L, T>::value>::call(edge0, edge1, x);
+	}
+
+	template<length_t L, class T>
+	SMATH_INLINE SMATH_CONSTEXPR vec<L, T> smoothstep(T edge0, T edge1, const vec<L, T> &x) {
+		return smath::smoothstep(vec<L, T>(edge0), vec<L, T>(edge1), x);
+	}
+
+	// -- Batch functions --
+
+	/**
+	 * @brief Calculates `a[i] * b[i] + c[i]` for every element of the ranges.
+	 * @param out The output range, of the same size as the inputs, which may
+	 * be any of them.
+	 */
+	SMATH_INLINE void fma(span<const float> a, span<const float> b, span<const float> c, span<float> out) {
+		detail::fma_span(a, b, c, out);
+	}
+
+	SMATH_INLINE void fma(span<const double> a, span<const double> b, span<const double> c, span<double> out) {
+		detail::fma_span(a, b, c, out);
+	}
+
+	/**
+	 * @brief Calculates `a[i] * b + c[i]` for every element of the ranges.
+	 */
+	SMATH_INLINE void fma(span<const float> a, float b, span<const float> c, span<float> out) {
+		detail::fma_span(a,
+			[b](std::size_t) { return simd::native<float>(b); },
+			[b](std::size_t) { return b; },
+			c, out);
+	}
+
+	SMATH_INLINE void fma(span<const double> a, double b, span<const double> c, span<double> out) {
+		detail::fma_span(a,
+			[b](std::size_t) { return simd::native<double>(b); },
+			[b](std::size_t) { return b; },
+			c, out);
+	}
+
+	/**
+	 * @brief Calculates the multiply-add on all of the components of
+	 * ranges of vectors.
+	 * @tparam L The number of components in the vector in range [1, 4]
+	 * @tparam T The type of the vector (float, double)
+	 */
+	template<length_t L, class T>
+	SMATH_INLINE void fma(typename detail::identity<span<const vec<L, T>>>::type a, typename detail::identity<span<const vec<L, T>>>::type b,
+		typename detail::identity<span<const vec<L, T>>>::type c, span<vec<L, T>> out) {
+		detail::fma_span(detail::component_span(a), detail::component_span(b), detail::component_span(c), detail::component_span(out));
+	}
+
+	/**
+	 * @brief Linearly interpolates every element between two ranges by the
+	 * same factor.
+	 * @param out The output range, of the same size as the inputs, which may
+	 * be either of them.
+	 */
+	SMATH_INLINE void mix(span<const float> a, span<const float> b, float t, span<float> out) {
+		detail::mix_span(a, b, t, out);
+	}
+
+	SMATH_INLINE void mix(span<const double> a, span<const double> b, double t, span<double> out) {
+		detail::mix_span(a, b, t, out);
+	}
+
+	template<length_t L, class T>
+	SMATH_INLINE void mix(typename detail::identity<span<const vec<L, T>>>::type a, typename detail::identity<span<const vec<L, T>>>::type b,
+		typename detail::identity<T>::type t, span<vec<L, T>> out) {
+		detail::mix_span(detail::component_span(a), detail::component_span(b), t, detail::component_span(out));
+	}
+
+	/**
+	 * @brief Restricts every element of a range to [lo, hi].
+	 * @param out The output range, of the same size as `in`, which may be `in`.
+	 */
+	SMATH_INLINE void clamp(span<const float> in, float lo, float hi, span<float> out) {
+		detail::clamp_span(in, lo, hi, out);
+	}
+
+	SMATH_INLINE void clamp(span<const double> in, double lo, double hi, span<double> out) {
+		detail::clamp_span(in, lo, hi, out);
+	}
+
+	template<length_t L, class T>
+	SMATH_INLINE void clamp(typename detail::identity<span<const vec<L, T>>>::type in, typename detail::identity<T>::type lo,
+		typename detail::identity<T>::type hi, span<vec<L, T>> out) {
+		detail::clamp_span(detail::component_span(in), lo, hi, detail::component_span(out));
+	}
+
+	/**
+	 * @brief Restricts every element of a range to [0, 1].
+	 */
+	SMATH_INLINE void saturate(span<const float> in, span<float> out) {
+		detail::clamp_span(in, 0.f, 1.f, out);
+	}
+
+	SMATH_INLINE void saturate(span<const double> in, span<double> out) {
+		detail::clamp_span(in, 0.0, 1.0, out);
+	}
+
+	template<length_t L, class T>
+	SMATH_INLINE void saturate(typename detail::identity<span<const vec<L, T>>>::type in, span<vec<L, T>> out) {
+		detail::clamp_span(detail::component_span(in), T(0), T(1), detail::component_span(out));
+	}
+
+	/**
+	 * @brief Compares every element of a range with the same edge.
+	 */
+	SMATH_INLINE void step(float edge, span<const float> in, span<float> out) {
+		detail::step_span(edge, in, out);
+	}
+
+	SMATH_INLINE void step(double edge, span<const double> in, span<double> out) {
+		detail::step_span(edge, in, out);
+	}
+
+	template<length_t L, class T>
+	SMATH_INLINE void step(typename detail::identity<T>::type edge, typename detail::identity<span<const vec<L, T>>>::type in, span<vec<L, T>> out) {
+		detail::step_span(edge, detail::component_span(in), detail::component_span(out));
+	}
+
+	/**
+	 * @brief Hermite interpolation of every element of a range between the
+	 * same edges.
+	 */
+	SMATH_INLINE void smoothstep(float edge0, float edge1, span<const float> in, span<float> out) {
+		detail::smoothstep_span(edge0, edge1, in, out);
+	}
+
+	SMATH_INLINE void smoothstep(double edge0, double edge1, span<const double> in, span<double> out) {
+		detail::smoothstep_span(edge0, edge1, in, out);
+	}
+
+	template<length_t L, class T>
+	SMATH_INLINE void smoothstep(typename detail::identity<T>::type edge0, typename detail::identity<T>::type edge1,
+		typename detail::identity<span<const vec<L, T>>>::type in, span<vec<L, T>> out) {
+		detail::smoothstep_span(edge0, edge1, detail::component_span(in), detail::component_span(out));
+	}
+
+	/**
+	 * @brief Rounds every element of a range to a whole number.
+	 * @param out The output range, of the same size as `in`, which may be `in`.
+	 * @param mode The direction to round in.
+	 */
+	SMATH_INLINE void round(span<const float> in, span<float> out, round_mode mode = round_mode::half_away) {
+		detail::round_span(in, out, mode);
+	}
+
+	SMATH_INLINE void round(span<const double> in, span<double> out, round_mode mode = round_mode::half_away) {
+		detail::round_span(in, out, mode);
+	}
+
+	template<length_t L, class T>
+	SMATH_INLINE void round(typename detail::identity<span<const vec<L, T>>>::type in, span<vec<L, T>> out, round_mode mode = round_mode::half_away) {
+		detail::round_span(detail::component_span(in), detail::component_span(out), mode);
+	}
+
+	/**
+	 * @brief Rounds every element of a range downwards.
+	 */
+	SMATH_INLINE void floor(span<const float> in, span<float> out) {
+		detail::round_span(in, out, round_mode::down);
+	}
+
+	SMATH_INLINE void floor(span<const double> in, span<double> out) {
+		detail::round_span(in, out, round_mode::down);
+	}
+
+	template<length_t L, class T>
+	SMATH_INLINE void floor(typename detail::identity<span<const vec<L, T>>>::type in, span<vec<L, T>> out) {
+		detail::round_span(detail::component_span(in), detail::component_span(out), round_mode::down);
+	}
+
+	/**
+	 * @brief Rounds every element of a range upwards.
+	 */
+	SMATH_INLINE void ceil(span<const float> in, span<float> out) {
+		detail::round_span(in, out, round_mode::up);
+	}
+
+	SMATH_INLINE void ceil(span<const double> in, span<double> out) {
+		detail::round_span(in, out, round_mode::up);
+	}
+
+	template<length_t L, class T>
+	SMATH_INLINE void ceil(typename detail::identity<span<const vec<L, T>>>::type in, span<vec<L, T>> out) {
+		detail::round_span(detail::component_span(in), detail::component_span(out), round_mode::up);
+	}
+
+	/**
+	 * @brief Rounds every element of a range towards zero.
+	 */
+	SMATH_INLINE void trunc(span<const float> in, span<float> out) {
+		detail::round_span(in, out, round_mode::toward_zero);
+	}
+
+	SMATH_INLINE void trunc(span<const double> in, span<double> out) {
+		detail::round_span(in, out, round_mode::toward_zero);
+	}
+
+	template<length_t L, class T>
+	SMATH_INLINE void trunc(typename detail::identity<span<const vec<L, T>>>::type in, span<vec<L, T>> out) {
+		detail::round_span(detail::component_span(in), detail::component_span(out), round_mode::toward_zero);
+	}
+
+	/**
+	 * @brief Calculates the fractional part of every element of a range.
+	 */
+	SMATH_INLINE void fract(span<const float> in, span<float> out) {
+		detail::fract_span(in, out);
+	}
+
+	SMATH_INLINE void fract(span<const double> in, span<double> out) {
+		detail::fract_span(in, out);
+	}
+
+	template<length_t L, class T>
+	SMATH_INLINE void fract(typename detail::identity<span<const vec<L, T>>>::type in, span<vec<L, T>> out) {
+		detail::fract_span(detail::component_span(in), detail::component_span(out));
+	}
+
+	/**
+	 * @brief Finds the smallest element of a range, skipping NaNs.
+	 * @returns The index of the first smallest element, or `in.size()` when
+	 * the range is empty or only holds NaNs.
+	 */
+	SMATH_INLINE std::size_t argmin(span<const float> in) {
+		return detail::arg_extreme<1, float, false>(in)[0];
+	}
+
+	SMATH_INLINE std::size_t argmin(span<const double> in) {
+		return detail::arg_extreme<1, double, false>(in)[0];
+	}
+
+	/**
+	 * @brief Finds the smallest value of each component over a range of vectors.
+	 * @tparam L The number of components in the vector in range [1, 4]
+	 * @returns The index of the first element holding the smallest value of
+	 * each component, or `in.size()` for components that are all NaN.
+	 */
+	template<length_t L, class T>
+	SMATH_INLINE vec<L, std::size_t> argmin(span<const vec<L, T>> in) {
+		return detail::arg_extreme<L, T, false>(detail::component_span(in));
+	}
+
+	template<length_t L, class T>
+	SMATH_INLINE vec<L, std::size_t> argmin(span<vec<L, T>> in) {
+		return smath::argmin(span<const vec<L, T>>(in));
+	}
+
+	/**
+	 * @brief Finds the largest element of a range, skipping NaNs.
+	 * @returns The index of the first largest element, or `in.size()` when
+	 * the range is empty or only holds NaNs.
+	 */
+	SMATH_INLINE std::size_t argmax(span<const float> in) {
+		return detail::arg_extreme<1, float, true>(in)[0];
+	}
+
+	SMATH_INLINE std::size_t argmax(span<const double> in) {
+		return detail::arg_extreme<1, double, true>(in)[0];
+	}
+
+	/**
+	 * @brief Finds the largest value of each component over a range of vectors.
+	 * @tparam L The number of components in the vector in range [1, 4]
+	 * @returns The index of the first element holding the largest value of
+	 * each component, or `in.size()` for components that are all NaN.
+	 */
+	template<length_t L, class T>
+	SMATH_INLINE vec<L, std::size_t> argmax(span<const vec<L, T>> in) {
+		return detail::arg_extreme<L, T, true>(detail::component_span(in));
+	}
+
+	template<length_t L, class T>
+	SMATH_INLINE vec<L, std::size_t> argmax(span<vec<L, T>> in) {
+		return smath::argmax(span<const vec<L, T>>(in));
+	}
+
 } // namespace smath
 
+#if SMATH_CONFIG_SIMD == SMATH_ENABLE
+#	include "detail/math_simd.inl"
+#endif
+
 #endif // MATH_H
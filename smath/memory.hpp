@@ -0,0 +1,257 @@
+#pragma once
+
+#ifndef MEMORY_H
+#define MEMORY_H
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+#include "detail/setup.hpp"
+
+#include "span.hpp"
+
+namespace smath {
+
+	/**
+	 * Standard allocator returning memory aligned to at least `Alignment` bytes,
+	 * so the elements of std containers can be read with aligned SIMD loads.
+	 * @tparam T The type of the elements.
+	 * @tparam Alignment The alignment in bytes, a power of two.
+	 */
+	template<class T, std::size_t Alignment = 64>
+	class aligned_allocator {
+	public:
+
+		using value_type = T;
+		using size_type = std::size_t;
+		using difference_type = std::ptrdiff_t;
+		using propagate_on_container_move_assignment = std::true_type;
+		using is_always_equal = std::true_type;
+
+		/**
+		 * @brief The alignment of every allocation in bytes, which is never
+		 * less than the alignment of `T`.
+		 */
+		static const std::size_t alignment = Alignment > alignof(T) ? Alignment : alignof(T);
+
+		template<class U>
+		struct rebind {
+			using other = aligned_allocator<U, Alignment>;
+		};
+
+		// -- Constructors --
+
+		aligned_allocator() = default;
+
+		template<class U>
+		SMATH_CONSTEXPR aligned_allocator(const aligned_allocator<U, Alignment> &) noexcept {}
+
+		// -- Allocation --
+
+		T* allocate(size_type n) {
+			return static_cast<T *>(::operator new(n * sizeof(T), std::align_val_t(alignment)));
+		}
+
+		void deallocate(T *p, size_type) noexcept {
+			::operator delete(p, std::align_val_t(alignment));
+		}
+
+		// -- Boolean operators --
+
+		template<class U>
+		SMATH_CONSTEXPR bool operator==(const aligned_allocator<U, Alignment> &) const noexcept {
+			return true;
+		}
+
+		template<class U>
+		SMATH_CONSTEXPR bool operator!=(const aligned_allocator<U, Alignment> &) const noexcept {
+			return false;
+		}
+
+	private:
+
+		SMATH_STATIC_ASSERT((Alignment & (Alignment - 1)) == 0, "'aligned_allocator' alignment must be a power of two");
+	};
+
+	/**
+	 * Bump allocator for transient memory, such as per-frame scratch buffers.
+	 *
+	 * Allocating moves a pointer forward inside a block, and memory is only
+	 * given back all at once by reset(), which keeps the blocks so the next
+	 * frame allocates nothing from the system. Objects are never destroyed, so
+	 * it is meant for trivially destructible types such as vectors.
+	 */
+	class arena {
+	public:
+
+		/**
+		 * @brief The default alignment of every allocation in bytes.
+		 */
+		static const std::size_t alignment = 64;
+
+		// -- Constructors --
+
+		/**
+		 * @param block_bytes The size of each block requested from the system.
+		 * Larger allocations get a block of their own.
+		 */
+		explicit arena(std::size_t block_bytes = 1 << 20)
+			: m_block_bytes(block_bytes)
+		{}
+
+		arena(const arena &) = delete;
+		arena& operator=(const arena &) = delete;
+
+		~arena() {
+			for (const block &b : m_blocks) {
+				::operator delete(b.data, std::align_val_t(alignment));
+			}
+		}
+
+		// -- Allocation --
+
+		/**
+		 * @brief Allocates `bytes` bytes aligned to `align`, a power of two.
+		 * @returns The start of the allocation, valid until the next reset().
+		 */
+		void* allocate(std::size_t bytes, std::size_t align = alignment) {
+			assert(align != 0 && (align & (align - 1)) == 0);
+
+			while (m_current < m_blocks.size()) {
+				block &b{ m_blocks[m_current] };
+				const std::uintptr_t start{ reinterpret_cast<std::uintptr_t>(b.data) };
+				const std::size_t offset{ static_cast<std::size_t>(((start + b.used + align - 1) & ~(static_cast<std::uintptr_t>(align) - 1)) - start) };
+				if (offset + bytes <= b.size) {
+					b.used = offset + bytes;
+					return b.data + offset;
+				}
+				++m_current;
+			}
+
+			// blocks are aligned to `alignment`, so larger alignments need padding
+			const std::size_t padding{ align > alignment ? align - alignment : 0 };
+			const std::size_t size{ bytes + padding > m_block_bytes ? bytes + padding : m_block_bytes };
+			m_blocks.push_back(block{ static_cast<unsigned char *>(::operator new(size, std::align_val_t(alignment))), size, 0 });
+			return allocate(bytes, align);
+		}
+
+		/**
+		 * @brief Allocates an uninitialised range of `n` elements of type `T`.
+		 */
+		template<class T>
+		span<T> allocate(std::size_t n) {
+			const std::size_t align{ alignof(T) > alignment ? alignof(T) : alignment };
+			return span<T>(static_cast<T *>(allocate(n * sizeof(T), align)), n);
+		}
+
+		/**
+		 * @brief Frees every allocation at once, keeping the blocks for reuse.
+		 */
+		void reset() {
+			for (block &b : m_blocks) {
+				b.used = 0;
+			}
+			m_current = 0;
+		}
+
+		// -- Capacity --
+
+		/**
+		 * @returns The number of bytes handed out since the last reset,
+		 * including the alignment padding.
+		 */
+		std::size_t used() const {
+			std::size_t total{ 0 };
+			for (const block &b : m_blocks) {
+				total += b.used;
+			}
+			return total;
+		}
+
+		/**
+		 * @returns The number of bytes held in blocks.
+		 */
+		std::size_t capacity() const {
+			std::size_t total{ 0 };
+			for (const block &b : m_blocks) {
+				total += b.size;
+			}
+			return total;
+		}
+
+	private:
+
+		struct block {
+			unsigned char *data;
+			std::size_t size;
+			std::size_t used;
+		};
+
+		std::vector<block> m_blocks;
+		std::size_t m_current{ 0 };
+		std::size_t m_block_bytes;
+	};
+
+	/**
+	 * Standard allocator drawing from an arena, for containers that only live
+	 * until the arena is reset. Deallocation does nothing.
+	 * @tparam T The type of the elements.
+	 */
+	template<class T>
+	class arena_allocator {
+	public:
+
+		using value_type = T;
+		using size_type = std::size_t;
+		using difference_type = std::ptrdiff_t;
+		using propagate_on_container_copy_assignment = std::true_type;
+		using propagate_on_container_move_assignment = std::true_type;
+		using propagate_on_container_swap = std::true_type;
+
+		// -- Constructors --
+
+		arena_allocator(arena &source) noexcept
+			: m_arena(&source)
+		{}
+
+		template<class U>
+		arena_allocator(const arena_allocator<U> &other) noexcept
+			: m_arena(other.source())
+		{}
+
+		// -- Allocation --
+
+		T* allocate(size_type n) {
+			return m_arena->allocate<T>(n).data();
+		}
+
+		void deallocate(T *, size_type) noexcept {}
+
+		arena* source() const noexcept {
+			return m_arena;
+		}
+
+		// -- Boolean operators --
+
+		template<class U>
+		bool operator==(const arena_allocator<U> &other) const noexcept {
+			return m_arena == other.source();
+		}
+
+		template<class U>
+		bool operator!=(const arena_allocator<U> &other) const noexcept {
+			return m_arena != other.source();
+		}
+
+	private:
+
+		arena *m_arena;
+	};
+
+} // namespace smath
+
+#endif // MEMORY_H
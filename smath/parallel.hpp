@@ -0,0 +1,504 @@
+#pragma once
+
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "detail/setup.hpp"
+
+namespace smath {
+
+	namespace parallel {
+
+		/**
+		 * Work-stealing thread pool.
+		 *
+		 * Every worker owns a deque of tasks. A worker runs its own tasks from the
+		 * back (newest first, which keeps nested work in cache) and steals from
+		 * the front of the other deques (oldest first, which takes the largest
+		 * remaining pieces) when its own is empty.
+		 *
+		 * Threads that wait on the pool, such as the caller of parallel_for, help
+		 * by running queued tasks, so the pool may have no workers at all and
+		 * nested parallel calls cannot deadlock.
+		 *
+		 * Tasks must not throw. The parallel algorithms catch the exceptions of
+		 * their bodies and rethrow the first one on the caller.
+		 */
+		class thread_pool {
+		public:
+
+			using task = std::function<void()>;
+
+			// -- Constructors --
+
+			/**
+			 * @brief Starts the worker threads.
+			 * @param workers The number of worker threads, which may be 0.
+			 */
+			explicit thread_pool(std::size_t workers)
+				: m_queues(workers > 0 ? workers : 1)
+			{
+				for (std::size_t i = 0; i < workers; ++i) {
+					m_threads.emplace_back([this, i]() { worker_loop(i); });
+				}
+			}
+
+			thread_pool(const thread_pool &) = delete;
+			thread_pool& operator=(const thread_pool &) = delete;
+
+			/**
+			 * @brief Stops and joins the workers once the queued tasks are done.
+			 */
+			~thread_pool() {
+				{
+					std::lock_guard<std::mutex> lock(m_sleep_mutex);
+					m_stop = true;
+				}
+				m_wake.notify_all();
+				for (std::thread &t : m_threads) {
+					t.join();
+				}
+			}
+
+			// -- Capacity --
+
+			/**
+			 * @returns The number of worker threads.
+			 */
+			std::size_t size() const {
+				return m_threads.size();
+			}
+
+			/**
+			 * @returns The number of threads that run tasks while a caller waits,
+			 * which is the workers plus the caller.
+			 */
+			std::size_t concurrency() const {
+				return m_threads.size() + 1;
+			}
+
+			// -- Tasks --
+
+			/**
+			 * @brief Queues a task, on the calling worker's own deque when called
+			 * from a task of this pool.
+			 */
+			void submit(task t) {
+				const std::size_t self{ current_worker() };
+				const std::size_t index{ self < m_queues.size() ? self : m_next++ % m_queues.size() };
+				// counted before it is visible, so a thread taking it cannot
+				// decrement the count below zero
+				{
+					std::lock_guard<std::mutex> lock(m_sleep_mutex);
+					++m_pending;
+				}
+				{
+					std::lock_guard<std::mutex> lock(m_queues[index].mutex);
+					m_queues[index].tasks.push_back(std::move(t));
+				}
+				m_wake.notify_one();
+			}
+
+			/**
+			 * @brief Runs one queued task on the calling thread.
+			 * @returns Whether a task was found.
+			 */
+			bool run_one() {
+				task t;
+				const std::size_t self{ current_worker() };
+				if ((self < m_queues.size() && pop(self, t)) || steal(self, t)) {
+					t();
+					return true;
+				}
+				return false;
+			}
+
+		private:
+
+			struct worker_queue {
+				std::mutex mutex;
+				std::deque<task> tasks;
+			};
+
+			std::vector<worker_queue> m_queues;
+			std::vector<std::thread> m_threads;
+
+			std::mutex m_sleep_mutex;
+			std::condition_variable m_wake;
+			std::size_t m_pending{ 0 };
+			bool m_stop{ false };
+
+			std::atomic<std::size_t> m_next{ 0 };
+
+			struct worker_id {
+				const thread_pool *pool{ nullptr };
+				std::size_t index{ 0 };
+			};
+
+			/**
+			 * @returns The pool and queue index of the calling thread, if it is a
+			 * worker.
+			 */
+			static worker_id& this_worker() {
+				static thread_local worker_id id;
+				return id;
+			}
+
+			/**
+			 * @returns The queue index of the calling thread, or the number of
+			 * queues if it is not a worker of this pool.
+			 */
+			std::size_t current_worker() const {
+				const worker_id &id{ this_worker() };
+				return id.pool == this ? id.index : m_queues.size();
+			}
+
+			void take() {
+				std::lock_guard<std::mutex> lock(m_sleep_mutex);
+				--m_pending;
+			}
+
+			bool pop(std::size_t index, task &t) {
+				std::lock_guard<std::mutex> lock(m_queues[index].mutex);
+				if (m_queues[index].tasks.empty()) {
+					return false;
+				}
+				t = std::move(m_queues[index].tasks.back());
+				m_queues[index].tasks.pop_back();
+				take();
+				return true;
+			}
+
+			bool steal(std::size_t thief, task &t) {
+				const std::size_t n{ m_queues.size() };
+				const std::size_t start{ thief < n ? thief + 1 : 0 };
+				for (std::size_t k = 0; k < n; ++k) {
+					worker_queue &q{ m_queues[(start + k) % n] };
+					std::lock_guard<std::mutex> lock(q.mutex);
+					if (!q.tasks.empty()) {
+						t = std::move(q.tasks.front());
+						q.tasks.pop_front();
+						take();
+						return true;
+					}
+				}
+				return false;
+			}
+
+			void worker_loop(std::size_t index) {
+				this_worker() = worker_id{ this, index };
+				for (;;) {
+					if (run_one()) {
+						continue;
+					}
+
+					std::unique_lock<std::mutex> lock(m_sleep_mutex);
+					m_wake.wait(lock, [this]() { return m_stop || m_pending > 0; });
+					if (m_stop && m_pending == 0) {
+						return;
+					}
+				}
+			}
+		};
+
+		/**
+		 * @returns The shared pool, with one worker per hardware thread besides
+		 * the caller, created on first use.
+		 */
+		SMATH_INLINE thread_pool& default_pool() {
+			static thread_pool pool{ std::thread::hardware_concurrency() > 1 ? std::thread::hardware_concurrency() - 1 : 0 };
+			return pool;
+		}
+
+		/**
+		 * Options for the parallel algorithms.
+		 */
+		struct options {
+			/**
+			 * The number of elements per task, or 0 to time a few elements on the
+			 * calling thread and pick a grain that keeps the tasks around
+			 * `target_task` long.
+			 */
+			std::size_t grain{ 0 };
+
+			/**
+			 * Whether parallel_reduce splits the range at fixed positions and
+			 * combines the partial results in order, so floating-point results do
+			 * not depend on timing or the number of threads.
+			 */
+			bool deterministic{ false };
+
+			/**
+			 * The pool to run on, or nullptr for default_pool().
+			 */
+			thread_pool *pool{ nullptr };
+		};
+
+		namespace detail {
+
+			/**
+			 * @brief Duration of a task that the automatic grain aims for, long
+			 * enough to hide the cost of queueing it.
+			 */
+			static const std::chrono::nanoseconds target_task{ std::chrono::microseconds(50) };
+
+			/**
+			 * @brief Grain used by deterministic reductions without an explicit grain.
+			 */
+			static const std::size_t deterministic_grain{ 4096 };
+
+			/**
+			 * @brief Runs `body` over growing prefixes of the range on the calling
+			 * thread until the elapsed time is measurable, then picks the grain
+			 * for the rest of the range.
+			 * @param consumed Set to the number of elements already processed.
+			 * @returns The grain for the remaining elements.
+			 */
+			template<class F>
+			std::size_t tune_grain(std::size_t first, std::size_t n, std::size_t threads, F &body, std::size_t &consumed) {
+				using clock = std::chrono::steady_clock;
+
+				std::size_t probe{ 16 };
+				consumed = 0;
+				std::chrono::nanoseconds elapsed{ 0 };
+
+				// never probe more than a share of the range, so the rest can still
+				// be split between the threads
+				const std::size_t budget{ n / (4 * threads) };
+				while (consumed + probe <= budget) {
+					const clock::time_point start{ clock::now() };
+					body(first + consumed, first + consumed + probe);
+					elapsed += std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start);
+					consumed += probe;
+					if (elapsed >= target_task / 4) {
+						break;
+					}
+					probe *= 2;
+				}
+
+				const std::size_t remaining{ n - consumed };
+				const std::size_t balanced{ (remaining + 4 * threads - 1) / (4 * threads) };
+				if (consumed == 0 || elapsed.count() <= 0) {
+					return balanced > 0 ? balanced : 1;
+				}
+
+				const std::size_t grain{ static_cast<std::size_t>(
+					static_cast<double>(target_task.count()) * static_cast<double>(consumed) / static_cast<double>(elapsed.count())
+				) };
+				if (grain < 1) {
+					return 1;
+				}
+				return grain < balanced ? grain : (balanced > 0 ? balanced : 1);
+			}
+
+			/**
+			 * @brief Splits [first, last) into tasks of `grain` elements and waits
+			 * for them, running queued tasks while it waits.
+			 *
+			 * The tasks refer to `body` and to this frame, so the caller waits for
+			 * all of them even when a chunk throws, then rethrows the first
+			 * exception.
+			 */
+			template<class F>
+			void run_chunks(thread_pool &pool, std::size_t first, std::size_t last, std::size_t grain, F &body) {
+				const std::size_t n{ last - first };
+				if (n == 0) {
+					return;
+				}
+				if (pool.size() == 0 || n <= grain) {
+					body(first, last);
+					return;
+				}
+
+				const std::size_t chunks{ (n + grain - 1) / grain };
+				std::atomic<std::size_t> remaining{ chunks - 1 };
+				std::mutex error_mutex;
+				std::exception_ptr error;
+				const auto keep_first = [&error_mutex, &error]() {
+					std::lock_guard<std::mutex> lock(error_mutex);
+					if (!error) {
+						error = std::current_exception();
+					}
+				};
+
+				for (std::size_t c = 1; c < chunks; ++c) {
+					const std::size_t b{ first + c * grain };
+					const std::size_t e{ b + grain < last ? b + grain : last };
+					pool.submit([&body, &remaining, &keep_first, b, e]() {
+						try {
+							body(b, e);
+						} catch (...) {
+							keep_first();
+						}
+						remaining.fetch_sub(1, std::memory_order_release);
+					});
+				}
+
+				// the first chunk runs here, then the caller helps with the rest
+				try {
+					body(first, first + grain);
+				} catch (...) {
+					keep_first();
+				}
+				while (remaining.load(std::memory_order_acquire) > 0) {
+					if (!pool.run_one()) {
+						std::this_thread::yield();
+					}
+				}
+				if (error) {
+					std::rethrow_exception(error);
+				}
+			}
+
+		} // namespace detail
+
+		// -- Algorithms --
+
+		/**
+		 * @brief Calls `body(begin, end)` on subranges of [first, last) in
+		 * parallel, returning once all of them are done.
+		 * @param body Callable taking `(std::size_t begin, std::size_t end)`.
+		 */
+		template<class F>
+		void parallel_for(std::size_t first, std::size_t last, F body, const options &opts = options()) {
+			if (last <= first) {
+				return;
+			}
+
+			thread_pool &pool{ opts.pool != nullptr ? *opts.pool : default_pool() };
+			if (opts.grain != 0) {
+				detail::run_chunks(pool, first, last, opts.grain, body);
+				return;
+			}
+
+			std::size_t consumed{ 0 };
+			const std::size_t grain{ detail::tune_grain(first, last - first, pool.concurrency(), body, consumed) };
+			detail::run_chunks(pool, first + consumed, last, grain, body);
+		}
+
+		/**
+		 * @brief Writes `out[i] = func(in[i])` in parallel.
+		 *
+		 * Any function of one element works, for example
+		 * `[](const vec3 &v) { return smath::normalize(v); }` or `smath::floor<float>`.
+		 *
+		 * @param in A contiguous range, such as smath::span or std::vector.
+		 * @param out A contiguous range of the same size, which may be `in`.
+		 */
+		template<class In, class Out, class F>
+		void parallel_transform(const In &in, Out &&out, F func, const options &opts = options()) {
+			const auto *src{ in.data() };
+			auto *dst{ out.data() };
+			parallel_for(0, in.size(), [src, dst, &func](std::size_t b, std::size_t e) {
+				for (std::size_t i = b; i < e; ++i) {
+					dst[i] = func(src[i]);
+				}
+			}, opts);
+		}
+
+		/**
+		 * @brief Writes `out[i] = func(a[i], b[i])` in parallel, for example with
+		 * `std::plus<>()` or `std::multiplies<>()` on arrays of vectors.
+		 */
+		template<class A, class B, class Out, class F, class = typename std::enable_if<
+			!std::is_same<typename std::decay<F>::type, options>::value
+		>::type>
+		void parallel_transform(const A &a, const B &b, Out &&out, F func, const options &opts = options()) {
+			const auto *lhs{ a.data() };
+			const auto *rhs{ b.data() };
+			auto *dst{ out.data() };
+			parallel_for(0, a.size(), [lhs, rhs, dst, &func](std::size_t first, std::size_t last) {
+				for (std::size_t i = first; i < last; ++i) {
+					dst[i] = func(lhs[i], rhs[i]);
+				}
+			}, opts);
+		}
+
+		/**
+		 * @brief Combines `map(in[i])` for every element with `reduce`, starting
+		 * from `init`.
+		 *
+		 * `reduce` must be associative and commutative, since the partial
+		 * results are combined in the order the tasks finish. With
+		 * `opts.deterministic` the range is split every `opts.grain` elements
+		 * (4096 by default) and the partial results are combined in order, so
+		 * `reduce` only needs to be associative and the result is the same on
+		 * every run.
+		 *
+		 * @param reduce Callable combining two partial results.
+		 * @param map Callable turning an element into a partial result.
+		 */
+		template<class In, class T, class Reduce, class Map>
+		T parallel_transform_reduce(const In &in, T init, Reduce reduce, Map map, const options &opts = options()) {
+			const auto *src{ in.data() };
+			const std::size_t n{ in.size() };
+			if (n == 0) {
+				return init;
+			}
+
+			auto partial = [src, &reduce, &map](std::size_t b, std::size_t e) {
+				T acc{ map(src[b]) };
+				for (std::size_t i = b + 1; i < e; ++i) {
+					acc = reduce(acc, map(src[i]));
+				}
+				return acc;
+			};
+
+			if (opts.deterministic) {
+				const std::size_t grain{ opts.grain != 0 ? opts.grain : detail::deterministic_grain };
+				const std::size_t chunks{ (n + grain - 1) / grain };
+				std::vector<T> partials(chunks, init);
+
+				options chunk_opts{ opts };
+				chunk_opts.grain = 1;
+				parallel_for(0, chunks, [&](std::size_t b, std::size_t e) {
+					for (std::size_t c = b; c < e; ++c) {
+						partials[c] = partial(c * grain, (c + 1) * grain < n ? (c + 1) * grain : n);
+					}
+				}, chunk_opts);
+
+				T result{ init };
+				for (const T &p : partials) {
+					result = reduce(result, p);
+				}
+				return result;
+			}
+
+			// partial results are combined in the order the tasks finish
+			std::mutex mutex;
+			T result{ init };
+			parallel_for(0, n, [&](std::size_t b, std::size_t e) {
+				const T p{ partial(b, e) };
+				std::lock_guard<std::mutex> lock(mutex);
+				result = reduce(result, p);
+			}, opts);
+			return result;
+		}
+
+		/**
+		 * @brief Combines every element with `reduce`, starting from `init`, for
+		 * example summing an array of vectors with `std::plus<>()`.
+		 */
+		template<class In, class T, class Reduce>
+		T parallel_reduce(const In &in, T init, Reduce reduce, const options &opts = options()) {
+			return parallel_transform_reduce(in, init, reduce, [](const T &v) { return v; }, opts);
+		}
+
+	} // namespace parallel
+
+} // namespace smath
+
+#endif // PARALLEL_H
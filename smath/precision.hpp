@@ -0,0 +1,154 @@
+#pragma once
+
+#ifndef PRECISION_H
+#define PRECISION_H
+
+#include <limits>
+#include <type_traits>
+
+#include "detail/setup.hpp"
+
+namespace smath {
+
+	/**
+	 * Trade-off between speed and accuracy for the approximated functions.
+	 */
+	enum class accuracy {
+		fast,      //!< estimates and short polynomials, for a relative error below 5e-4
+		balanced,  //!< refined to an error below 2 ULP
+		precise    //!< correctly rounded or within 1 ULP
+	};
+
+	/**
+	 * Precision policy naming an accuracy in its type, passed to a function in
+	 * place of its `accuracy`, such as `smath::exp(x, smath::fast)`.
+	 *
+	 * The functions taking a policy are templates on it, and forward `A` to
+	 * their kernels as a template parameter, so the other tiers are never
+	 * instantiated. A runtime `accuracy` is accepted as well, and selects one of
+	 * the three kernels when called.
+	 *
+	 * @tparam A The accuracy of the policy.
+	 */
+	template<accuracy A>
+	struct precision {
+		static constexpr accuracy value = A;
+
+		constexpr operator accuracy() const {
+			return A;
+		}
+
+		/**
+		 * @tparam T The type of the results (float, double)
+		 * @returns The largest relative error of sqrt, inv_sqrt and the
+		 * exponential and logarithm functions taking the policy. smath::pow has
+		 * its own bound, max_pow_error(), and normalize adds the roundings of
+		 * the dot product and the scaling to its inverse square root.
+		 */
+		template<class T>
+		static constexpr T max_error() {
+			return A == accuracy::fast ? T(5e-4) : (A == accuracy::balanced ? T(2) : T(1)) * ::std::numeric_limits<T>::epsilon();
+		}
+
+		/**
+		 * @returns The largest error of the same functions as max_error() in
+		 * units in the last place, which is not bounded for `fast`.
+		 */
+		static constexpr int max_ulp() {
+			return A == accuracy::fast ? -1 : (A == accuracy::balanced ? 2 : 1);
+		}
+
+		/**
+		 * @brief smath::pow scales the error of its logarithm by the exponent, so
+		 * its bound grows past exponents of 6 in magnitude for `fast`, and of 4
+		 * for `balanced` doubles. Floats past `fast` are evaluated in double and
+		 * `precise` doubles call std::pow, which keeps them within 1 ULP.
+		 * @tparam T The type of the results (float, double)
+		 * @param exponent The largest magnitude of the exponents.
+		 * @returns The largest relative error of smath::pow.
+		 */
+		template<class T>
+		static constexpr T max_pow_error(T exponent) {
+			return A == accuracy::fast ? (exponent > T(6) ? T(1.5e-4) + T(6e-5) * exponent : T(5e-4)) :
+				T(max_pow_ulp<T>(static_cast<double>(exponent))) * ::std::numeric_limits<T>::epsilon();
+		}
+
+		/**
+		 * @tparam T The type of the results (float, double)
+		 * @param exponent The largest magnitude of the exponents.
+		 * @returns The largest error of smath::pow in units in the last place,
+		 * which is not bounded for `fast`.
+		 */
+		template<class T = double>
+		static constexpr double max_pow_ulp(double exponent) {
+			return A == accuracy::fast ? -1.0 : (A == accuracy::balanced && sizeof(T) > sizeof(float) ? (exponent > 4.0 ? 2.0 + (exponent - 4.0) / 6.0 : 2.0) : 1.0);
+		}
+	};
+
+	using fast_t = precision<accuracy::fast>;
+	using balanced_t = precision<accuracy::balanced>;
+	using precise_t = precision<accuracy::precise>;
+
+	inline constexpr fast_t fast{};
+	inline constexpr balanced_t balanced{};
+	inline constexpr precise_t precise{};
+
+	SMATH_STATIC_ASSERT(static_cast<int>(accuracy::fast) == SMATH_PRECISION_FAST &&
+		static_cast<int>(accuracy::balanced) == SMATH_PRECISION_BALANCED &&
+		static_cast<int>(accuracy::precise) == SMATH_PRECISION_PRECISE, "'accuracy' must match the SMATH_PRECISION values");
+
+	/**
+	 * The policy of the calls that do not pass one, set by SMATH_DEFAULT_PRECISION.
+	 */
+	using default_precision = precision<static_cast<accuracy>(SMATH_DEFAULT_PRECISION)>;
+
+	inline constexpr default_precision default_accuracy{};
+
+	namespace detail {
+
+		/**
+		 * @brief Whether `P` can be passed as the accuracy of a function: a
+		 * policy, or a runtime `accuracy`.
+		 */
+		template<class P>
+		struct is_precision : std::false_type {};
+
+		template<>
+		struct is_precision<accuracy> : std::true_type {};
+
+		template<accuracy A>
+		struct is_precision<precision<A>> : std::true_type {};
+
+		template<class P>
+		using enable_precision = typename std::enable_if<is_precision<P>::value>::type;
+
+		/**
+		 * @brief Calls `func` with the policy `p`, the only tier instantiated.
+		 */
+		template<accuracy A, class F>
+		SMATH_INLINE constexpr auto with_precision(precision<A> p, F func) -> decltype(func(p)) {
+			return func(p);
+		}
+
+		/**
+		 * @brief Calls `func` with the policy of `acc`, which instantiates it for
+		 * every tier.
+		 */
+		template<class F>
+		SMATH_INLINE constexpr auto with_precision(accuracy acc, F func) -> decltype(func(balanced_t())) {
+			switch (acc) {
+				case accuracy::fast:
+					return func(fast_t());
+				case accuracy::precise:
+					return func(precise_t());
+				case accuracy::balanced:
+				default:
+					return func(balanced_t());
+			}
+		}
+
+	} // namespace detail
+
+} // namespace smath
+
+#endif // PRECISION_H
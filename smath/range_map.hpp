@@ -0,0 +1,174 @@
+#pragma once
+
+#ifndef RANGE_MAP_H
+#define RANGE_MAP_H
+
+#include <type_traits>
+
+#include "detail/setup.hpp"
+
+#include "exponential.hpp"
+#include "math.hpp"
+#include "simd/simd.hpp"
+#include "span.hpp"
+#include "template_types.hpp"
+#include "vec.hpp"
+
+namespace smath {
+
+	/**
+	 * Precomputed mapping from range [a, b] to range [c, d], as smath::scale,
+	 * applied as `x * slope + offset` with one multiply-add. Like the vector
+	 * smath::fma, it is only fused when FMA is available, so scalars, vectors and
+	 * ranges give the same results.
+	 * @tparam T The type of the values (float, double)
+	 */
+	template<class T>
+	struct range_map {
+		SMATH_STATIC_ASSERT(smath::is_floating_type<T>::value, "'range_map' only accepts floating-point types");
+
+		// -- Data --
+
+		T slope;
+		T offset;
+
+		// -- Constructors --
+
+		/**
+		 * @brief Computes the mapping from [a, b] to [c, d].
+		 * @param a The minimum of the original range.
+		 * @param b The maximum of the original range, which must differ from `a`.
+		 * @param c The new minimum of the range to map to.
+		 * @param d The new maximum of the range to map to.
+		 */
+		SMATH_CONSTEXPR range_map(T a, T b, T c, T d)
+			: slope((d - c) / (b - a)), offset(c - a * ((d - c) / (b - a)))
+		{}
+
+		/**
+		 * @brief Creates the mapping `x * slope + offset`.
+		 */
+		SMATH_CONSTEXPR range_map(T slope, T offset)
+			: slope(slope), offset(offset)
+		{}
+
+		// -- Mapping --
+
+		SMATH_CONSTEXPR T operator()(const T &x) const {
+			return detail::fma_lane(x, slope, offset, std::true_type());
+		}
+
+		template<length_t L>
+		SMATH_CONSTEXPR vec<L, T> operator()(const vec<L, T> &v) const {
+			return smath::fma(v, slope, vec<L, T>(offset));
+		}
+
+		/**
+		 * @brief Maps every lane of a SIMD batch.
+		 * @tparam B A batch of T lanes from smath::simd.
+		 */
+		template<class B>
+		B apply(const B &b) const {
+			return fma(b, B(slope), B(offset));
+		}
+
+		/**
+		 * @brief Maps every element of a range.
+		 * @param out The output range, of the same size as `in`, which may be `in`.
+		 */
+		void operator()(span<const T> in, span<T> out) const {
+			const range_map m{ *this };
+			detail::apply_span(in, out,
+				[m](const simd::native<T> &b) { return m.apply(b); },
+				[m](T x) { return m(x); });
+		}
+
+		template<length_t L>
+		void operator()(typename detail::identity<span<const vec<L, T>>>::type in, span<vec<L, T>> out) const {
+			(*this)(detail::component_span(in), detail::component_span(out));
+		}
+
+		/**
+		 * @returns The mapping from [c, d] back to [a, b].
+		 */
+		SMATH_CONSTEXPR range_map inverse() const {
+			return range_map(T(1) / slope, -offset / slope);
+		}
+	};
+
+	/**
+	 * Precomputed mapping from range [a, b] to range [c, d] that rounds every
+	 * result to the nearest multiple of `step`, with ties away from zero, as
+	 * smath::round_nearest. The division by the step is folded into the
+	 * coefficients, so each value costs one multiply-add, one rounding
+	 * and one multiply.
+	 * @tparam T The type of the values (float, double)
+	 */
+	template<class T>
+	struct quantize_map {
+		SMATH_STATIC_ASSERT(smath::is_floating_type<T>::value, "'quantize_map' only accepts floating-point types");
+
+		// -- Data --
+
+		T slope;
+		T offset;
+		T step;
+
+		// -- Constructors --
+
+		/**
+		 * @brief Computes the mapping from [a, b] to multiples of `step` in [c, d].
+		 * @param step The spacing of the results, which must not be 0.
+		 */
+		SMATH_CONSTEXPR quantize_map(T a, T b, T c, T d, T step = T(1))
+			: slope(range_map<T>(a, b, c, d).slope / step), offset(range_map<T>(a, b, c, d).offset / step), step(step)
+		{}
+
+		/**
+		 * @brief Rounds values to the nearest multiple of `step` without mapping
+		 * them to another range.
+		 */
+		SMATH_CONSTEXPR explicit quantize_map(T step)
+			: slope(T(1) / step), offset(T(0)), step(step)
+		{}
+
+		// -- Mapping --
+
+		SMATH_CONSTEXPR T operator()(const T &x) const {
+			return smath::round(detail::fma_lane(x, slope, offset, std::true_type())) * step;
+		}
+
+		template<length_t L>
+		SMATH_CONSTEXPR vec<L, T> operator()(const vec<L, T> &v) const {
+			return smath::round(smath::fma(v, slope, vec<L, T>(offset))) * step;
+		}
+
+		/**
+		 * @brief Maps and rounds every lane of a SIMD batch.
+		 * @tparam B A batch of T lanes from smath::simd.
+		 */
+		template<class B>
+		B apply(const B &b) const {
+			return detail::round_batch(fma(b, B(slope), B(offset)), round_mode::half_away) * B(step);
+		}
+
+		/**
+		 * @brief Maps and rounds every element of a range.
+		 * @param out The output range, of the same size as `in`, which may be `in`.
+		 */
+		void operator()(span<const T> in, span<T> out) const {
+			const quantize_map m{ *this };
+			detail::apply_span(in, out,
+				[m](const simd::native<T> &b) { return m.apply(b); },
+				[m](T x) { return m(x); });
+		}
+
+		template<length_t L>
+		void operator()(typename detail::identity<span<const vec<L, T>>>::type in, span<vec<L, T>> out) const {
+			(*this)(detail::component_span(in), detail::component_span(out));
+		}
+	};
+
+} // namespace smath
+
+#endif // RANGE_MAP_H
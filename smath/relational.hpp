@@ -0,0 +1,215 @@
+#pragma once
+
+#ifndef RELATIONAL_H
+#define RELATIONAL_H
+
+#include "detail/setup.hpp"
+
+#include "template_types.hpp"
+#include "vec.hpp"
+
+namespace smath {
+
+	namespace detail {
+
+		/**
+		 * @brief Template class to compute the component-wise comparisons of two
+		 * vectors, specialized in relational_simd.inl for vectors stored in SIMD
+		 * registers.
+		 * @tparam L The number of components of the vector.
+		 * @tparam T The type of the vector (int, float, double)
+		 * @tparam Simd Whether the vector is stored in a SIMD register.
+		 */
+		template<length_t L, class T, bool Simd>
+		struct compute_relational {
+			SMATH_CONSTEXPR static vec<L, bool> less_than(const vec<L, T> &a, const vec<L, T> &b) {
+				vec<L, bool> result;
+				for (length_t i = 0; i < L; ++i) {
+					result[i] = a[i] < b[i];
+				}
+				return result;
+			}
+
+			SMATH_CONSTEXPR static vec<L, bool> less_than_equal(const vec<L, T> &a, const vec<L, T> &b) {
+				vec<L, bool> result;
+				for (length_t i = 0; i < L; ++i) {
+					result[i] = a[i] <= b[i];
+				}
+				return result;
+			}
+
+			SMATH_CONSTEXPR static vec<L, bool> greater_than(const vec<L, T> &a, const vec<L, T> &b) {
+				vec<L, bool> result;
+				for (length_t i = 0; i < L; ++i) {
+					result[i] = a[i] > b[i];
+				}
+				return result;
+			}
+
+			SMATH_CONSTEXPR static vec<L, bool> greater_than_equal(const vec<L, T> &a, const vec<L, T> &b) {
+				vec<L, bool> result;
+				for (length_t i = 0; i < L; ++i) {
+					result[i] = a[i] >= b[i];
+				}
+				return result;
+			}
+
+			SMATH_CONSTEXPR static vec<L, bool> equal(const vec<L, T> &a, const vec<L, T> &b) {
+				vec<L, bool> result;
+				for (length_t i = 0; i < L; ++i) {
+					result[i] = a[i] == b[i];
+				}
+				return result;
+			}
+
+			SMATH_CONSTEXPR static vec<L, bool> not_equal(const vec<L, T> &a, const vec<L, T> &b) {
+				vec<L, bool> result;
+				for (length_t i = 0; i < L; ++i) {
+					result[i] = a[i] != b[i];
+				}
+				return result;
+			}
+
+			SMATH_CONSTEXPR static vec<L, T> select(const vec<L, bool> &mask, const vec<L, T> &a, const vec<L, T> &b) {
+				vec<L, T> result;
+				for (length_t i = 0; i < L; ++i) {
+					result[i] = mask[i] ? a[i] : b[i];
+				}
+				return result;
+			}
+		};
+
+	} // namespace detail
+
+	/**
+	 * @brief Compares each component of two vectors with operator<
+	 * @tparam L The number of components in the vector in range [1, 4]
+	 * @tparam T The type of the vector (int, float, double)
+	 * @returns A boolean vector where each component is `a[i] < b[i]`.
+	 */
+	template<length_t L, class T>
+	SMATH_CONSTEXPR vec<L, bool> less_than(const vec<L, T> &a, const vec<L, T> &b) {
+		SMATH_STATIC_ASSERT(smath::is_valid_vector(L), "'less_than' only works on vectors with 1 to 4 components");
+		return detail::compute_relational<L, T, detail::is_simd<L, T>::value>::less_than(a, b);
+	}
+
+	/**
+	 * @brief Compares each component of two vectors with operator<=
+	 * @tparam L The number of components in the vector in range [1, 4]
+	 * @tparam T The type of the vector (int, float, double)
+	 * @returns A boolean vector where each component is `a[i] <= b[i]`.
+	 */
+	template<length_t L, class T>
+	SMATH_CONSTEXPR vec<L, bool> less_than_equal(const vec<L, T> &a, const vec<L, T> &b) {
+		SMATH_STATIC_ASSERT(smath::is_valid_vector(L), "'less_than_equal' only works on vectors with 1 to 4 components");
+		return detail::compute_relational<L, T, detail::is_simd<L, T>::value>::less_than_equal(a, b);
+	}
+
+	/**
+	 * @brief Compares each component of two vectors with operator>
+	 * @tparam L The number of components in the vector in range [1, 4]
+	 * @tparam T The type of the vector (int, float, double)
+	 * @returns A boolean vector where each component is `a[i] > b[i]`.
+	 */
+	template<length_t L, class T>
+	SMATH_CONSTEXPR vec<L, bool> greater_than(const vec<L, T> &a, const vec<L, T> &b) {
+		SMATH_STATIC_ASSERT(smath::is_valid_vector(L), "'greater_than' only works on vectors with 1 to 4 components");
+		return detail::compute_relational<L, T, detail::is_simd<L, T>::value>::greater_than(a, b);
+	}
+
+	/**
+	 * @brief Compares each component of two vectors with operator>=
+	 * @tparam L The number of components in the vector in range [1, 4]
+	 * @tparam T The type of the vector (int, float, double)
+	 * @returns A boolean vector where each component is `a[i] >= b[i]`.
+	 */
+	template<length_t L, class T>
+	SMATH_CONSTEXPR vec<L, bool> greater_than_equal(const vec<L, T> &a, const vec<L, T> &b) {
+		SMATH_STATIC_ASSERT(smath::is_valid_vector(L), "'greater_than_equal' only works on vectors with 1 to 4 components");
+		return detail::compute_relational<L, T, detail::is_simd<L, T>::value>::greater_than_equal(a, b);
+	}
+
+	/**
+	 * @brief Compares each component of two vectors with operator==
+	 * @tparam L The number of components in the vector in range [1, 4]
+	 * @tparam T The type of the vector (bool, int, float, double)
+	 * @returns A boolean vector where each component is `a[i] == b[i]`.
+	 */
+	template<length_t L, class T>
+	SMATH_CONSTEXPR vec<L, bool> equal(const vec<L, T> &a, const vec<L, T> &b) {
+		SMATH_STATIC_ASSERT(smath::is_valid_vector(L), "'equal' only works on vectors with 1 to 4 components");
+		return detail::compute_relational<L, T, detail::is_simd<L, T>::value>::equal(a, b);
+	}
+
+	/**
+	 * @brief Compares each component of two vectors with operator!=
+	 * @tparam L The number of components in the vector in range [1, 4]
+	 * @tparam T The type of the vector (bool, int, float, double)
+	 * @returns A boolean vector where each component is `a[i] != b[i]`.
+	 */
+	template<length_t L, class T>
+	SMATH_CONSTEXPR vec<L, bool> not_equal(const vec<L, T> &a, const vec<L, T> &b) {
+		SMATH_STATIC_ASSERT(smath::is_valid_vector(L), "'not_equal' only works on vectors with 1 to 4 components");
+		return detail::compute_relational<L, T, detail::is_simd<L, T>::value>::not_equal(a, b);
+	}
+
+	/**
+	 * @brief Checks if any component of a boolean vector is true.
+	 * @tparam L The number of components in the vector in range [1, 4]
+	 * @returns `true` if at least one component is true, `false` otherwise.
+	 */
+	template<length_t L>
+	SMATH_CONSTEXPR bool any(const vec<L, bool> &v) {
+		SMATH_STATIC_ASSERT(smath::is_valid_vector(L), "'any' only works on vectors with 1 to 4 components");
+		bool result{ false };
+		for (length_t i = 0; i < L; ++i) {
+			result = result || v[i];
+		}
+		return result;
+	}
+
+	/**
+	 * @brief Checks if all the components of a boolean vector are true.
+	 * @tparam L The number of components in the vector in range [1, 4]
+	 * @returns `true` if every component is true, `false` otherwise.
+	 */
+	template<length_t L>
+	SMATH_CONSTEXPR bool all(const vec<L, bool> &v) {
+		SMATH_STATIC_ASSERT(smath::is_valid_vector(L), "'all' only works on vectors with 1 to 4 components");
+		bool result{ true };
+		for (length_t i = 0; i < L; ++i) {
+			result = result && v[i];
+		}
+		return result;
+	}
+
+	/**
+	 * @brief Checks if none of the components of a boolean vector are true.
+	 * @tparam L The number of components in the vector in range [1, 4]
+	 * @returns `true` if every component is false, `false` otherwise.
+	 */
+	template<length_t L>
+	SMATH_CONSTEXPR bool none(const vec<L, bool> &v) {
+		return !smath::any(v);
+	}
+
+	/**
+	 * @brief Picks each component from one of two vectors without branching.
+	 * @tparam L The number of components in the vector in range [1, 4]
+	 * @tparam T The type of the vector (bool, int, float, double)
+	 * @param mask Selects `a[i]` where true and `b[i]` where false.
+	 * @returns A vector where each component is `mask[i] ? a[i] : b[i]`.
+	 */
+	template<length_t L, class T>
+	SMATH_CONSTEXPR vec<L, T> select(const vec<L, bool> &mask, const vec<L, T> &a, const vec<L, T> &b) {
+		SMATH_STATIC_ASSERT(smath::is_valid_vector(L), "'select' only works on vectors with 1 to 4 components");
+		return detail::compute_relational<L, T, detail::is_simd<L, T>::value>::select(mask, a, b);
+	}
+
+} // namespace smath
+
+#if SMATH_CONFIG_SIMD == SMATH_ENABLE
+#	include "detail/relational_simd.inl"
+#endif
+
+#endif // RELATIONAL_H
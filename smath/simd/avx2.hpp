@@ -0,0 +1,719 @@
+#pragma once
+
+#ifndef SIMD_AVX2_H
+#define SIMD_AVX2_H
+
+#include <cmath>
+
+#include "sse2.hpp"
+
+#if SMATH_ARCH & SMATH_ARCH_AVX_BIT
+
+namespace smath {
+
+	namespace simd {
+
+		// ----------------------------------
+		// --- 8 x single-precision (AVX) ---
+		// ----------------------------------
+
+		template<>
+		struct batch_mask<float, 8> {
+			__m256 data;
+
+			batch_mask() = default;
+			explicit batch_mask(__m256 m) : data(m) {}
+			explicit batch_mask(bool b) : data(_mm256_castsi256_ps(_mm256_set1_epi32(b ? -1 : 0))) {}
+
+			static batch_mask from_bits(int bits) {
+				return batch_mask(_mm256_castsi256_ps(_mm256_setr_epi32(
+					-(bits & 1), -((bits >> 1) & 1), -((bits >> 2) & 1), -((bits >> 3) & 1),
+					-((bits >> 4) & 1), -((bits >> 5) & 1), -((bits >> 6) & 1), -((bits >> 7) & 1)
+				)));
+			}
+
+			bool operator[](length_t i) const {
+				return ((_mm256_movemask_ps(data) >> i) & 1) != 0;
+			}
+		};
+
+		template<>
+		struct batch<float, 8> {
+			using value_type = float;
+			using mask_type = batch_mask<float, 8>;
+
+			__m256 data;
+
+			static SMATH_CONSTEXPR length_t size() {
+				return 8;
+			}
+
+			batch() = default;
+			batch(float scalar) : data(_mm256_set1_ps(scalar)) {}
+			explicit batch(__m256 r) : data(r) {}
+
+			static batch load(const float *p) {
+				return batch(_mm256_load_ps(p));
+			}
+
+			static batch loadu(const float *p) {
+				return batch(_mm256_loadu_ps(p));
+			}
+
+			void store(float *p) const {
+				_mm256_store_ps(p, data);
+			}
+
+			void storeu(float *p) const {
+				_mm256_storeu_ps(p, data);
+			}
+
+			float operator[](length_t i) const {
+				alignas(32) float lanes[8];
+				store(lanes);
+				return lanes[i];
+			}
+		};
+
+		// -- Mask operators --
+
+		SMATH_INLINE batch_mask<float, 8> operator&(batch_mask<float, 8> a, batch_mask<float, 8> b) {
+			return batch_mask<float, 8>(_mm256_and_ps(a.data, b.data));
+		}
+
+		SMATH_INLINE batch_mask<float, 8> operator|(batch_mask<float, 8> a, batch_mask<float, 8> b) {
+			return batch_mask<float, 8>(_mm256_or_ps(a.data, b.data));
+		}
+
+		SMATH_INLINE batch_mask<float, 8> operator^(batch_mask<float, 8> a, batch_mask<float, 8> b) {
+			return batch_mask<float, 8>(_mm256_xor_ps(a.data, b.data));
+		}
+
+		SMATH_INLINE batch_mask<float, 8> operator~(batch_mask<float, 8> a) {
+			return batch_mask<float, 8>(_mm256_xor_ps(a.data, _mm256_castsi256_ps(_mm256_set1_epi32(-1))));
+		}
+
+		SMATH_INLINE int bits(batch_mask<float, 8> m) {
+			return _mm256_movemask_ps(m.data);
+		}
+
+		SMATH_INLINE bool any(batch_mask<float, 8> m) {
+			return bits(m) != 0;
+		}
+
+		SMATH_INLINE bool all(batch_mask<float, 8> m) {
+			return bits(m) == 0xFF;
+		}
+
+		SMATH_INLINE bool none(batch_mask<float, 8> m) {
+			return bits(m) == 0;
+		}
+
+		// -- Arithmetic operators --
+
+		SMATH_INLINE f32x8 operator+(f32x8 a, f32x8 b) {
+			return f32x8(_mm256_add_ps(a.data, b.data));
+		}
+
+		SMATH_INLINE f32x8 operator-(f32x8 a, f32x8 b) {
+			return f32x8(_mm256_sub_ps(a.data, b.data));
+		}
+
+		SMATH_INLINE f32x8 operator*(f32x8 a, f32x8 b) {
+			return f32x8(_mm256_mul_ps(a.data, b.data));
+		}
+
+		SMATH_INLINE f32x8 operator/(f32x8 a, f32x8 b) {
+			return f32x8(_mm256_div_ps(a.data, b.data));
+		}
+
+		SMATH_INLINE f32x8 operator-(f32x8 a) {
+			return f32x8(_mm256_xor_ps(a.data, _mm256_set1_ps(-0.f)));
+		}
+
+		// -- Comparison operators --
+
+		SMATH_INLINE batch_mask<float, 8> operator==(f32x8 a, f32x8 b) {
+			return batch_mask<float, 8>(_mm256_cmp_ps(a.data, b.data, _CMP_EQ_OQ));
+		}
+
+		SMATH_INLINE batch_mask<float, 8> operator!=(f32x8 a, f32x8 b) {
+			return batch_mask<float, 8>(_mm256_cmp_ps(a.data, b.data, _CMP_NEQ_UQ));
+		}
+
+		SMATH_INLINE batch_mask<float, 8> operator<(f32x8 a, f32x8 b) {
+			return batch_mask<float, 8>(_mm256_cmp_ps(a.data, b.data, _CMP_LT_OQ));
+		}
+
+		SMATH_INLINE batch_mask<float, 8> operator<=(f32x8 a, f32x8 b) {
+			return batch_mask<float, 8>(_mm256_cmp_ps(a.data, b.data, _CMP_LE_OQ));
+		}
+
+		SMATH_INLINE batch_mask<float, 8> operator>(f32x8 a, f32x8 b) {
+			return batch_mask<float, 8>(_mm256_cmp_ps(a.data, b.data, _CMP_GT_OQ));
+		}
+
+		SMATH_INLINE batch_mask<float, 8> operator>=(f32x8 a, f32x8 b) {
+			return batch_mask<float, 8>(_mm256_cmp_ps(a.data, b.data, _CMP_GE_OQ));
+		}
+
+		// -- Functions --
+
+		SMATH_INLINE f32x8 select(batch_mask<float, 8> m, f32x8 a, f32x8 b) {
+			return f32x8(_mm256_blendv_ps(b.data, a.data, m.data));
+		}
+
+		SMATH_INLINE f32x8 min(f32x8 a, f32x8 b) {
+			return f32x8(_mm256_min_ps(a.data, b.data));
+		}
+
+		SMATH_INLINE f32x8 max(f32x8 a, f32x8 b) {
+			return f32x8(_mm256_max_ps(a.data, b.data));
+		}
+
+		SMATH_INLINE f32x8 abs(f32x8 a) {
+			return f32x8(_mm256_andnot_ps(_mm256_set1_ps(-0.f), a.data));
+		}
+
+		SMATH_INLINE f32x8 sqrt(f32x8 a) {
+			return f32x8(_mm256_sqrt_ps(a.data));
+		}
+
+		SMATH_INLINE f32x8 rsqrt(f32x8 a) {
+			return f32x8(_mm256_rsqrt_ps(a.data));
+		}
+
+		SMATH_INLINE f32x8 fma(f32x8 a, f32x8 b, f32x8 c) {
+#if SMATH_ARCH & SMATH_ARCH_FMA_BIT
+			return f32x8(_mm256_fmadd_ps(a.data, b.data, c.data));
+#else
+			// rounds the product first, as sse2.hpp
+			return a * b + c;
+#endif
+		}
+
+		// -- Rounding --
+
+		SMATH_INLINE f32x8 nearbyint(f32x8 a) {
+			return f32x8(_mm256_round_ps(a.data, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+		}
+
+		SMATH_INLINE f32x8 floor(f32x8 a) {
+			return f32x8(_mm256_round_ps(a.data, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC));
+		}
+
+		SMATH_INLINE f32x8 ceil(f32x8 a) {
+			return f32x8(_mm256_round_ps(a.data, _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC));
+		}
+
+		SMATH_INLINE f32x8 trunc(f32x8 a) {
+			return f32x8(_mm256_round_ps(a.data, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC));
+		}
+
+		// -- Exponents --
+
+		// AVX has no 256-bit integer shifts, so without AVX2 the SSE2 versions
+		// run on each half
+
+		SMATH_INLINE f32x8 pow2i(f32x8 n) {
+#if SMATH_ARCH & SMATH_ARCH_AVX2_BIT
+			const __m256i e{ _mm256_castps_si256(_mm256_add_ps(n.data, _mm256_set1_ps(8388735.f))) };
+			return f32x8(_mm256_castsi256_ps(_mm256_slli_epi32(e, 23)));
+#else
+			const f32x4 lo{ pow2i(f32x4(_mm256_castps256_ps128(n.data))) };
+			const f32x4 hi{ pow2i(f32x4(_mm256_extractf128_ps(n.data, 1))) };
+			return f32x8(_mm256_insertf128_ps(_mm256_castps128_ps256(lo.data), hi.data, 1));
+#endif
+		}
+
+		SMATH_INLINE f32x8 exponent(f32x8 a) {
+#if SMATH_ARCH & SMATH_ARCH_AVX2_BIT
+			const __m256i e{ _mm256_and_si256(_mm256_srli_epi32(_mm256_castps_si256(a.data), 23), _mm256_set1_epi32(0xff)) };
+			return f32x8(_mm256_sub_ps(_mm256_cvtepi32_ps(e), _mm256_set1_ps(127.f)));
+#else
+			const f32x4 lo{ exponent(f32x4(_mm256_castps256_ps128(a.data))) };
+			const f32x4 hi{ exponent(f32x4(_mm256_extractf128_ps(a.data, 1))) };
+			return f32x8(_mm256_insertf128_ps(_mm256_castps128_ps256(lo.data), hi.data, 1));
+#endif
+		}
+
+		SMATH_INLINE f32x8 mantissa(f32x8 a) {
+			const __m256 bits{ _mm256_castsi256_ps(_mm256_set1_epi32(static_cast<int>(0x807fffff))) };
+			return f32x8(_mm256_or_ps(_mm256_and_ps(a.data, bits), _mm256_set1_ps(1.f)));
+		}
+
+		// -- Reductions --
+
+		SMATH_INLINE float reduce_add(f32x8 a) {
+			return reduce_add(f32x4(_mm_add_ps(_mm256_castps256_ps128(a.data), _mm256_extractf128_ps(a.data, 1))));
+		}
+
+		SMATH_INLINE float reduce_min(f32x8 a) {
+			return reduce_min(f32x4(_mm_min_ps(_mm256_castps256_ps128(a.data), _mm256_extractf128_ps(a.data, 1))));
+		}
+
+		SMATH_INLINE float reduce_max(f32x8 a) {
+			return reduce_max(f32x4(_mm_max_ps(_mm256_castps256_ps128(a.data), _mm256_extractf128_ps(a.data, 1))));
+		}
+
+		// ----------------------------------
+		// --- 4 x double-precision (AVX) ---
+		// ----------------------------------
+
+		template<>
+		struct batch_mask<double, 4> {
+			__m256d data;
+
+			batch_mask() = default;
+			explicit batch_mask(__m256d m) : data(m) {}
+			explicit batch_mask(bool b) : data(_mm256_castsi256_pd(_mm256_set1_epi32(b ? -1 : 0))) {}
+
+			static batch_mask from_bits(int bits) {
+				return batch_mask(_mm256_castsi256_pd(_mm256_setr_epi64x(
+					-static_cast<long long>(bits & 1), -static_cast<long long>((bits >> 1) & 1),
+					-static_cast<long long>((bits >> 2) & 1), -static_cast<long long>((bits >> 3) & 1)
+				)));
+			}
+
+			bool operator[](length_t i) const {
+				return ((_mm256_movemask_pd(data) >> i) & 1) != 0;
+			}
+		};
+
+		template<>
+		struct batch<double, 4> {
+			using value_type = double;
+			using mask_type = batch_mask<double, 4>;
+
+			__m256d data;
+
+			static SMATH_CONSTEXPR length_t size() {
+				return 4;
+			}
+
+			batch() = default;
+			batch(double scalar) : data(_mm256_set1_pd(scalar)) {}
+			explicit batch(__m256d r) : data(r) {}
+
+			static batch load(const double *p) {
+				return batch(_mm256_load_pd(p));
+			}
+
+			static batch loadu(const double *p) {
+				return batch(_mm256_loadu_pd(p));
+			}
+
+			void store(double *p) const {
+				_mm256_store_pd(p, data);
+			}
+
+			void storeu(double *p) const {
+				_mm256_storeu_pd(p, data);
+			}
+
+			double operator[](length_t i) const {
+				alignas(32) double lanes[4];
+				store(lanes);
+				return lanes[i];
+			}
+		};
+
+		// -- Mask operators --
+
+		SMATH_INLINE batch_mask<double, 4> operator&(batch_mask<double, 4> a, batch_mask<double, 4> b) {
+			return batch_mask<double, 4>(_mm256_and_pd(a.data, b.data));
+		}
+
+		SMATH_INLINE batch_mask<double, 4> operator|(batch_mask<double, 4> a, batch_mask<double, 4> b) {
+			return batch_mask<double, 4>(_mm256_or_pd(a.data, b.data));
+		}
+
+		SMATH_INLINE batch_mask<double, 4> operator^(batch_mask<double, 4> a, batch_mask<double, 4> b) {
+			return batch_mask<double, 4>(_mm256_xor_pd(a.data, b.data));
+		}
+
+		SMATH_INLINE batch_mask<double, 4> operator~(batch_mask<double, 4> a) {
+			return batch_mask<double, 4>(_mm256_xor_pd(a.data, _mm256_castsi256_pd(_mm256_set1_epi32(-1))));
+		}
+
+		SMATH_INLINE int bits(batch_mask<double, 4> m) {
+			return _mm256_movemask_pd(m.data);
+		}
+
+		SMATH_INLINE bool any(batch_mask<double, 4> m) {
+			return bits(m) != 0;
+		}
+
+		SMATH_INLINE bool all(batch_mask<double, 4> m) {
+			return bits(m) == 0xF;
+		}
+
+		SMATH_INLINE bool none(batch_mask<double, 4> m) {
+			return bits(m) == 0;
+		}
+
+		// -- Arithmetic operators --
+
+		SMATH_INLINE f64x4 operator+(f64x4 a, f64x4 b) {
+			return f64x4(_mm256_add_pd(a.data, b.data));
+		}
+
+		SMATH_INLINE f64x4 operator-(f64x4 a, f64x4 b) {
+			return f64x4(_mm256_sub_pd(a.data, b.data));
+		}
+
+		SMATH_INLINE f64x4 operator*(f64x4 a, f64x4 b) {
+			return f64x4(_mm256_mul_pd(a.data, b.data));
+		}
+
+		SMATH_INLINE f64x4 operator/(f64x4 a, f64x4 b) {
+			return f64x4(_mm256_div_pd(a.data, b.data));
+		}
+
+		SMATH_INLINE f64x4 operator-(f64x4 a) {
+			return f64x4(_mm256_xor_pd(a.data, _mm256_set1_pd(-0.0)));
+		}
+
+		// -- Comparison operators --
+
+		SMATH_INLINE batch_mask<double, 4> operator==(f64x4 a, f64x4 b) {
+			return batch_mask<double, 4>(_mm256_cmp_pd(a.data, b.data, _CMP_EQ_OQ));
+		}
+
+		SMATH_INLINE batch_mask<double, 4> operator!=(f64x4 a, f64x4 b) {
+			return batch_mask<double, 4>(_mm256_cmp_pd(a.data, b.data, _CMP_NEQ_UQ));
+		}
+
+		SMATH_INLINE batch_mask<double, 4> operator<(f64x4 a, f64x4 b) {
+			return batch_mask<double, 4>(_mm256_cmp_pd(a.data, b.data, _CMP_LT_OQ));
+		}
+
+		SMATH_INLINE batch_mask<double, 4> operator<=(f64x4 a, f64x4 b) {
+			return batch_mask<double, 4>(_mm256_cmp_pd(a.data, b.data, _CMP_LE_OQ));
+		}
+
+		SMATH_INLINE batch_mask<double, 4> operator>(f64x4 a, f64x4 b) {
+			return batch_mask<double, 4>(_mm256_cmp_pd(a.data, b.data, _CMP_GT_OQ));
+		}
+
+		SMATH_INLINE batch_mask<double, 4> operator>=(f64x4 a, f64x4 b) {
+			return batch_mask<double, 4>(_mm256_cmp_pd(a.data, b.data, _CMP_GE_OQ));
+		}
+
+		// -- Functions --
+
+		SMATH_INLINE f64x4 select(batch_mask<double, 4> m, f64x4 a, f64x4 b) {
+			return f64x4(_mm256_blendv_pd(b.data, a.data, m.data));
+		}
+
+		SMATH_INLINE f64x4 min(f64x4 a, f64x4 b) {
+			return f64x4(_mm256_min_pd(a.data, b.data));
+		}
+
+		SMATH_INLINE f64x4 max(f64x4 a, f64x4 b) {
+			return f64x4(_mm256_max_pd(a.data, b.data));
+		}
+
+		SMATH_INLINE f64x4 abs(f64x4 a) {
+			return f64x4(_mm256_andnot_pd(_mm256_set1_pd(-0.0), a.data));
+		}
+
+		SMATH_INLINE f64x4 sqrt(f64x4 a) {
+			return f64x4(_mm256_sqrt_pd(a.data));
+		}
+
+		SMATH_INLINE f64x4 rsqrt(f64x4 a) {
+			// the SSE2 estimate on each half, as AVX has no 256-bit integer shifts
+			const f64x2 lo{ rsqrt(f64x2(_mm256_castpd256_pd128(a.data))) };
+			const f64x2 hi{ rsqrt(f64x2(_mm256_extractf128_pd(a.data, 1))) };
+			return f64x4(_mm256_insertf128_pd(_mm256_castpd128_pd256(lo.data), hi.data, 1));
+		}
+
+		SMATH_INLINE f64x4 fma(f64x4 a, f64x4 b, f64x4 c) {
+#if SMATH_ARCH & SMATH_ARCH_FMA_BIT
+			return f64x4(_mm256_fmadd_pd(a.data, b.data, c.data));
+#else
+			return a * b + c;
+#endif
+		}
+
+		// -- Rounding --
+
+		SMATH_INLINE f64x4 nearbyint(f64x4 a) {
+			return f64x4(_mm256_round_pd(a.data, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+		}
+
+		SMATH_INLINE f64x4 floor(f64x4 a) {
+			return f64x4(_mm256_round_pd(a.data, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC));
+		}
+
+		SMATH_INLINE f64x4 ceil(f64x4 a) {
+			return f64x4(_mm256_round_pd(a.data, _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC));
+		}
+
+		SMATH_INLINE f64x4 trunc(f64x4 a) {
+			return f64x4(_mm256_round_pd(a.data, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC));
+		}
+
+		// -- Exponents --
+
+		SMATH_INLINE f64x4 pow2i(f64x4 n) {
+#if SMATH_ARCH & SMATH_ARCH_AVX2_BIT
+			const __m256i e{ _mm256_castpd_si256(_mm256_add_pd(n.data, _mm256_set1_pd(4503599627371519.0))) };
+			return f64x4(_mm256_castsi256_pd(_mm256_slli_epi64(e, 52)));
+#else
+			const f64x2 lo{ pow2i(f64x2(_mm256_castpd256_pd128(n.data))) };
+			const f64x2 hi{ pow2i(f64x2(_mm256_extractf128_pd(n.data, 1))) };
+			return f64x4(_mm256_insertf128_pd(_mm256_castpd128_pd256(lo.data), hi.data, 1));
+#endif
+		}
+
+		SMATH_INLINE f64x4 exponent(f64x4 a) {
+#if SMATH_ARCH & SMATH_ARCH_AVX2_BIT
+			const __m256i e{ _mm256_and_si256(_mm256_srli_epi64(_mm256_castpd_si256(a.data), 52), _mm256_set1_epi64x(0x7ff)) };
+			const __m256d d{ _mm256_castsi256_pd(_mm256_or_si256(e, _mm256_castpd_si256(_mm256_set1_pd(4503599627370496.0)))) };
+			return f64x4(_mm256_sub_pd(d, _mm256_set1_pd(4503599627371519.0)));
+#else
+			const f64x2 lo{ exponent(f64x2(_mm256_castpd256_pd128(a.data))) };
+			const f64x2 hi{ exponent(f64x2(_mm256_extractf128_pd(a.data, 1))) };
+			return f64x4(_mm256_insertf128_pd(_mm256_castpd128_pd256(lo.data), hi.data, 1));
+#endif
+		}
+
+		SMATH_INLINE f64x4 mantissa(f64x4 a) {
+			const __m256d bits{ _mm256_castsi256_pd(_mm256_set1_epi64x(static_cast<long long>(0x800fffffffffffffull))) };
+			return f64x4(_mm256_or_pd(_mm256_and_pd(a.data, bits), _mm256_set1_pd(1.0)));
+		}
+
+		// -- Reductions --
+
+		SMATH_INLINE double reduce_add(f64x4 a) {
+			return reduce_add(f64x2(_mm_add_pd(_mm256_castpd256_pd128(a.data), _mm256_extractf128_pd(a.data, 1))));
+		}
+
+		SMATH_INLINE double reduce_min(f64x4 a) {
+			return reduce_min(f64x2(_mm_min_pd(_mm256_castpd256_pd128(a.data), _mm256_extractf128_pd(a.data, 1))));
+		}
+
+		SMATH_INLINE double reduce_max(f64x4 a) {
+			return reduce_max(f64x2(_mm_max_pd(_mm256_castpd256_pd128(a.data), _mm256_extractf128_pd(a.data, 1))));
+		}
+
+		// -- Conversions --
+
+		SMATH_INLINE void widen(f32x8 a, f64x4 &lo, f64x4 &hi) {
+			lo = f64x4(_mm256_cvtps_pd(_mm256_castps256_ps128(a.data)));
+			hi = f64x4(_mm256_cvtps_pd(_mm256_extractf128_ps(a.data, 1)));
+		}
+
+		SMATH_INLINE f32x8 narrow(f64x4 lo, f64x4 hi) {
+			return f32x8(_mm256_insertf128_ps(_mm256_castps128_ps256(_mm256_cvtpd_ps(lo.data)), _mm256_cvtpd_ps(hi.data), 1));
+		}
+
+#if SMATH_ARCH & SMATH_ARCH_AVX2_BIT
+		// ---------------------------------
+		// --- 8 x 32-bit integer (AVX2) ---
+		// ---------------------------------
+
+		template<>
+		struct batch_mask<int, 8> {
+			__m256i data;
+
+			batch_mask() = default;
+			explicit batch_mask(__m256i m) : data(m) {}
+			explicit batch_mask(bool b) : data(_mm256_set1_epi32(b ? -1 : 0)) {}
+
+			static batch_mask from_bits(int bits) {
+				const __m256i select{ _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128) };
+				return batch_mask(_mm256_cmpeq_epi32(_mm256_and_si256(_mm256_set1_epi32(bits), select), select));
+			}
+
+			bool operator[](length_t i) const {
+				return ((_mm256_movemask_ps(_mm256_castsi256_ps(data)) >> i) & 1) != 0;
+			}
+		};
+
+		template<>
+		struct batch<int, 8> {
+			using value_type = int;
+			using mask_type = batch_mask<int, 8>;
+
+			__m256i data;
+
+			static SMATH_CONSTEXPR length_t size() {
+				return 8;
+			}
+
+			batch() = default;
+			batch(int scalar) : data(_mm256_set1_epi32(scalar)) {}
+			explicit batch(__m256i r) : data(r) {}
+
+			static batch load(const int *p) {
+				return batch(_mm256_load_si256(reinterpret_cast<const __m256i *>(p)));
+			}
+
+			static batch loadu(const int *p) {
+				return batch(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(p)));
+			}
+
+			void store(int *p) const {
+				_mm256_store_si256(reinterpret_cast<__m256i *>(p), data);
+			}
+
+			void storeu(int *p) const {
+				_mm256_storeu_si256(reinterpret_cast<__m256i *>(p), data);
+			}
+
+			int operator[](length_t i) const {
+				alignas(32) int lanes[8];
+				store(lanes);
+				return lanes[i];
+			}
+		};
+
+		// -- Mask operators --
+
+		SMATH_INLINE batch_mask<int, 8> operator&(batch_mask<int, 8> a, batch_mask<int, 8> b) {
+			return batch_mask<int, 8>(_mm256_and_si256(a.data, b.data));
+		}
+
+		SMATH_INLINE batch_mask<int, 8> operator|(batch_mask<int, 8> a, batch_mask<int, 8> b) {
+			return batch_mask<int, 8>(_mm256_or_si256(a.data, b.data));
+		}
+
+		SMATH_INLINE batch_mask<int, 8> operator^(batch_mask<int, 8> a, batch_mask<int, 8> b) {
+			return batch_mask<int, 8>(_mm256_xor_si256(a.data, b.data));
+		}
+
+		SMATH_INLINE batch_mask<int, 8> operator~(batch_mask<int, 8> a) {
+			return batch_mask<int, 8>(_mm256_xor_si256(a.data, _mm256_set1_epi32(-1)));
+		}
+
+		SMATH_INLINE int bits(batch_mask<int, 8> m) {
+			return _mm256_movemask_ps(_mm256_castsi256_ps(m.data));
+		}
+
+		SMATH_INLINE bool any(batch_mask<int, 8> m) {
+			return bits(m) != 0;
+		}
+
+		SMATH_INLINE bool all(batch_mask<int, 8> m) {
+			return bits(m) == 0xFF;
+		}
+
+		SMATH_INLINE bool none(batch_mask<int, 8> m) {
+			return bits(m) == 0;
+		}
+
+		// -- Arithmetic operators --
+
+		SMATH_INLINE i32x8 operator+(i32x8 a, i32x8 b) {
+			return i32x8(_mm256_add_epi32(a.data, b.data));
+		}
+
+		SMATH_INLINE i32x8 operator-(i32x8 a, i32x8 b) {
+			return i32x8(_mm256_sub_epi32(a.data, b.data));
+		}
+
+		SMATH_INLINE i32x8 operator*(i32x8 a, i32x8 b) {
+			return i32x8(_mm256_mullo_epi32(a.data, b.data));
+		}
+
+		SMATH_INLINE i32x8 operator-(i32x8 a) {
+			return i32x8(_mm256_sub_epi32(_mm256_setzero_si256(), a.data));
+		}
+
+		// -- Bitwise operators --
+
+		SMATH_INLINE i32x8 operator&(i32x8 a, i32x8 b) {
+			return i32x8(_mm256_and_si256(a.data, b.data));
+		}
+
+		SMATH_INLINE i32x8 operator|(i32x8 a, i32x8 b) {
+			return i32x8(_mm256_or_si256(a.data, b.data));
+		}
+
+		SMATH_INLINE i32x8 operator^(i32x8 a, i32x8 b) {
+			return i32x8(_mm256_xor_si256(a.data, b.data));
+		}
+
+		SMATH_INLINE i32x8 operator<<(i32x8 a, int n) {
+			return i32x8(_mm256_sll_epi32(a.data, _mm_cvtsi32_si128(n)));
+		}
+
+		SMATH_INLINE i32x8 operator>>(i32x8 a, int n) {
+			return i32x8(_mm256_sra_epi32(a.data, _mm_cvtsi32_si128(n)));
+		}
+
+		// -- Comparison operators --
+
+		SMATH_INLINE batch_mask<int, 8> operator==(i32x8 a, i32x8 b) {
+			return batch_mask<int, 8>(_mm256_cmpeq_epi32(a.data, b.data));
+		}
+
+		SMATH_INLINE batch_mask<int, 8> operator!=(i32x8 a, i32x8 b) {
+			return ~(a == b);
+		}
+
+		SMATH_INLINE batch_mask<int, 8> operator<(i32x8 a, i32x8 b) {
+			return batch_mask<int, 8>(_mm256_cmpgt_epi32(b.data, a.data));
+		}
+
+		SMATH_INLINE batch_mask<int, 8> operator<=(i32x8 a, i32x8 b) {
+			return ~(b < a);
+		}
+
+		SMATH_INLINE batch_mask<int, 8> operator>(i32x8 a, i32x8 b) {
+			return batch_mask<int, 8>(_mm256_cmpgt_epi32(a.data, b.data));
+		}
+
+		SMATH_INLINE batch_mask<int, 8> operator>=(i32x8 a, i32x8 b) {
+			return ~(a < b);
+		}
+
+		// -- Functions --
+
+		SMATH_INLINE i32x8 select(batch_mask<int, 8> m, i32x8 a, i32x8 b) {
+			return i32x8(_mm256_blendv_epi8(b.data, a.data, m.data));
+		}
+
+		SMATH_INLINE i32x8 min(i32x8 a, i32x8 b) {
+			return i32x8(_mm256_min_epi32(a.data, b.data));
+		}
+
+		SMATH_INLINE i32x8 max(i32x8 a, i32x8 b) {
+			return i32x8(_mm256_max_epi32(a.data, b.data));
+		}
+
+		SMATH_INLINE i32x8 mulhi(i32x8 a, i32x8 b) {
+			const __m256i even{ _mm256_mul_epi32(a.data, b.data) };
+			const __m256i odd{ _mm256_mul_epi32(_mm256_srli_epi64(a.data, 32), _mm256_srli_epi64(b.data, 32)) };
+			return i32x8(_mm256_blend_epi32(_mm256_srli_epi64(even, 32), odd, 0xAA));
+		}
+
+		SMATH_INLINE i32x8 abs(i32x8 a) {
+			return i32x8(_mm256_abs_epi32(a.data));
+		}
+
+		// -- Reductions --
+
+		SMATH_INLINE int reduce_add(i32x8 a) {
+			return reduce_add(i32x4(_mm_add_epi32(_mm256_castsi256_si128(a.data), _mm256_extracti128_si256(a.data, 1))));
+		}
+
+		SMATH_INLINE int reduce_min(i32x8 a) {
+			return reduce_min(min(i32x4(_mm256_castsi256_si128(a.data)), i32x4(_mm256_extracti128_si256(a.data, 1))));
+		}
+
+		SMATH_INLINE int reduce_max(i32x8 a) {
+			return reduce_max(max(i32x4(_mm256_castsi256_si128(a.data)), i32x4(_mm256_extracti128_si256(a.data, 1))));
+		}
+#endif
+
+	} // namespace simd
+
+} // namespace smath
+
+#endif // SMATH_ARCH & SMATH_ARCH_AVX_BIT
+
+#endif // SIMD_AVX2_H
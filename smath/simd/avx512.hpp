@@ -0,0 +1,686 @@
+#pragma once
+
+#ifndef SIMD_AVX512_H
+#define SIMD_AVX512_H
+
+#include "avx2.hpp"
+
+#if SMATH_ARCH & SMATH_ARCH_AVX512_BIT
+
+namespace smath {
+
+	namespace simd {
+
+		// ---------------------------------------
+		// --- 16 x single-precision (AVX-512) ---
+		// ---------------------------------------
+
+		template<>
+		struct batch_mask<float, 16> {
+			__mmask16 data;
+
+			batch_mask() = default;
+			explicit batch_mask(__mmask16 m) : data(m) {}
+			explicit batch_mask(bool b) : data(static_cast<__mmask16>(b ? 0xFFFF : 0)) {}
+
+			static batch_mask from_bits(int bits) {
+				return batch_mask(static_cast<__mmask16>(bits & 0xFFFF));
+			}
+
+			bool operator[](length_t i) const {
+				return ((data >> i) & 1) != 0;
+			}
+		};
+
+		template<>
+		struct batch<float, 16> {
+			using value_type = float;
+			using mask_type = batch_mask<float, 16>;
+
+			__m512 data;
+
+			static SMATH_CONSTEXPR length_t size() {
+				return 16;
+			}
+
+			batch() = default;
+			batch(float scalar) : data(_mm512_set1_ps(scalar)) {}
+			explicit batch(__m512 r) : data(r) {}
+
+			static batch load(const float *p) {
+				return batch(_mm512_load_ps(p));
+			}
+
+			static batch loadu(const float *p) {
+				return batch(_mm512_loadu_ps(p));
+			}
+
+			void store(float *p) const {
+				_mm512_store_ps(p, data);
+			}
+
+			void storeu(float *p) const {
+				_mm512_storeu_ps(p, data);
+			}
+
+			float operator[](length_t i) const {
+				alignas(64) float lanes[16];
+				store(lanes);
+				return lanes[i];
+			}
+		};
+
+		// -- Mask operators --
+
+		SMATH_INLINE batch_mask<float, 16> operator&(batch_mask<float, 16> a, batch_mask<float, 16> b) {
+			return batch_mask<float, 16>(static_cast<__mmask16>(a.data & b.data));
+		}
+
+		SMATH_INLINE batch_mask<float, 16> operator|(batch_mask<float, 16> a, batch_mask<float, 16> b) {
+			return batch_mask<float, 16>(static_cast<__mmask16>(a.data | b.data));
+		}
+
+		SMATH_INLINE batch_mask<float, 16> operator^(batch_mask<float, 16> a, batch_mask<float, 16> b) {
+			return batch_mask<float, 16>(static_cast<__mmask16>(a.data ^ b.data));
+		}
+
+		SMATH_INLINE batch_mask<float, 16> operator~(batch_mask<float, 16> a) {
+			return batch_mask<float, 16>(static_cast<__mmask16>(~a.data & 0xFFFF));
+		}
+
+		SMATH_INLINE int bits(batch_mask<float, 16> m) {
+			return static_cast<int>(m.data);
+		}
+
+		SMATH_INLINE bool any(batch_mask<float, 16> m) {
+			return m.data != 0;
+		}
+
+		SMATH_INLINE bool all(batch_mask<float, 16> m) {
+			return m.data == 0xFFFF;
+		}
+
+		SMATH_INLINE bool none(batch_mask<float, 16> m) {
+			return m.data == 0;
+		}
+
+		// -- Arithmetic operators --
+
+		SMATH_INLINE f32x16 operator+(f32x16 a, f32x16 b) {
+			return f32x16(_mm512_add_ps(a.data, b.data));
+		}
+
+		SMATH_INLINE f32x16 operator-(f32x16 a, f32x16 b) {
+			return f32x16(_mm512_sub_ps(a.data, b.data));
+		}
+
+		SMATH_INLINE f32x16 operator*(f32x16 a, f32x16 b) {
+			return f32x16(_mm512_mul_ps(a.data, b.data));
+		}
+
+		SMATH_INLINE f32x16 operator/(f32x16 a, f32x16 b) {
+			return f32x16(_mm512_div_ps(a.data, b.data));
+		}
+
+		SMATH_INLINE f32x16 operator-(f32x16 a) {
+			// the floating-point logic instructions need AVX512DQ, so flip the sign bit as integers
+			return f32x16(_mm512_castsi512_ps(_mm512_xor_si512(_mm512_castps_si512(a.data), _mm512_castps_si512(_mm512_set1_ps(-0.f)))));
+		}
+
+		// -- Comparison operators --
+
+		SMATH_INLINE batch_mask<float, 16> operator==(f32x16 a, f32x16 b) {
+			return batch_mask<float, 16>(_mm512_cmp_ps_mask(a.data, b.data, _CMP_EQ_OQ));
+		}
+
+		SMATH_INLINE batch_mask<float, 16> operator!=(f32x16 a, f32x16 b) {
+			return batch_mask<float, 16>(_mm512_cmp_ps_mask(a.data, b.data, _CMP_NEQ_UQ));
+		}
+
+		SMATH_INLINE batch_mask<float, 16> operator<(f32x16 a, f32x16 b) {
+			return batch_mask<float, 16>(_mm512_cmp_ps_mask(a.data, b.data, _CMP_LT_OQ));
+		}
+
+		SMATH_INLINE batch_mask<float, 16> operator<=(f32x16 a, f32x16 b) {
+			return batch_mask<float, 16>(_mm512_cmp_ps_mask(a.data, b.data, _CMP_LE_OQ));
+		}
+
+		SMATH_INLINE batch_mask<float, 16> operator>(f32x16 a, f32x16 b) {
+			return batch_mask<float, 16>(_mm512_cmp_ps_mask(a.data, b.data, _CMP_GT_OQ));
+		}
+
+		SMATH_INLINE batch_mask<float, 16> operator>=(f32x16 a, f32x16 b) {
+			return batch_mask<float, 16>(_mm512_cmp_ps_mask(a.data, b.data, _CMP_GE_OQ));
+		}
+
+		// -- Functions --
+
+		SMATH_INLINE f32x16 select(batch_mask<float, 16> m, f32x16 a, f32x16 b) {
+			return f32x16(_mm512_mask_blend_ps(m.data, b.data, a.data));
+		}
+
+		SMATH_INLINE f32x16 min(f32x16 a, f32x16 b) {
+			return f32x16(_mm512_min_ps(a.data, b.data));
+		}
+
+		SMATH_INLINE f32x16 max(f32x16 a, f32x16 b) {
+			return f32x16(_mm512_max_ps(a.data, b.data));
+		}
+
+		SMATH_INLINE f32x16 abs(f32x16 a) {
+			return f32x16(_mm512_abs_ps(a.data));
+		}
+
+		SMATH_INLINE f32x16 sqrt(f32x16 a) {
+			return f32x16(_mm512_sqrt_ps(a.data));
+		}
+
+		SMATH_INLINE f32x16 rsqrt(f32x16 a) {
+			// relative error below 2^-14
+			return f32x16(_mm512_rsqrt14_ps(a.data));
+		}
+
+		SMATH_INLINE f32x16 fma(f32x16 a, f32x16 b, f32x16 c) {
+			return f32x16(_mm512_fmadd_ps(a.data, b.data, c.data));
+		}
+
+		// without optimization, GCC expands roundscale, getexp and getmant to
+		// macros passing an all-ones __mmask to a signed builtin parameter
+#if defined(__GNUC__) && !defined(__clang__)
+#	pragma GCC diagnostic push
+#	pragma GCC diagnostic ignored "-Wsign-conversion"
+#endif
+
+		// -- Rounding --
+
+		SMATH_INLINE f32x16 nearbyint(f32x16 a) {
+			return f32x16(_mm512_roundscale_ps(a.data, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+		}
+
+		SMATH_INLINE f32x16 floor(f32x16 a) {
+			return f32x16(_mm512_roundscale_ps(a.data, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC));
+		}
+
+		SMATH_INLINE f32x16 ceil(f32x16 a) {
+			return f32x16(_mm512_roundscale_ps(a.data, _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC));
+		}
+
+		SMATH_INLINE f32x16 trunc(f32x16 a) {
+			return f32x16(_mm512_roundscale_ps(a.data, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC));
+		}
+
+		// -- Exponents --
+
+		SMATH_INLINE f32x16 pow2i(f32x16 n) {
+			return f32x16(_mm512_scalef_ps(_mm512_set1_ps(1.f), n.data));
+		}
+
+		SMATH_INLINE f32x16 exponent(f32x16 a) {
+			return f32x16(_mm512_getexp_ps(a.data));
+		}
+
+		SMATH_INLINE f32x16 mantissa(f32x16 a) {
+			return f32x16(_mm512_getmant_ps(a.data, _MM_MANT_NORM_1_2, _MM_MANT_SIGN_src));
+		}
+
+#if defined(__GNUC__) && !defined(__clang__)
+#	pragma GCC diagnostic pop
+#endif
+
+		// -- Reductions --
+
+		SMATH_INLINE float reduce_add(f32x16 a) {
+			return reduce_add(f32x8(_mm256_castpd_ps(_mm512_castpd512_pd256(_mm512_castps_pd(a.data)))) + f32x8(_mm256_castpd_ps(_mm512_extractf64x4_pd(_mm512_castps_pd(a.data), 1))));
+		}
+
+		SMATH_INLINE float reduce_min(f32x16 a) {
+			return reduce_min(min(f32x8(_mm256_castpd_ps(_mm512_castpd512_pd256(_mm512_castps_pd(a.data)))), f32x8(_mm256_castpd_ps(_mm512_extractf64x4_pd(_mm512_castps_pd(a.data), 1)))));
+		}
+
+		SMATH_INLINE float reduce_max(f32x16 a) {
+			return reduce_max(max(f32x8(_mm256_castpd_ps(_mm512_castpd512_pd256(_mm512_castps_pd(a.data)))), f32x8(_mm256_castpd_ps(_mm512_extractf64x4_pd(_mm512_castps_pd(a.data), 1)))));
+		}
+
+		// --------------------------------------
+		// --- 8 x double-precision (AVX-512) ---
+		// --------------------------------------
+
+		template<>
+		struct batch_mask<double, 8> {
+			__mmask8 data;
+
+			batch_mask() = default;
+			explicit batch_mask(__mmask8 m) : data(m) {}
+			explicit batch_mask(bool b) : data(static_cast<__mmask8>(b ? 0xFF : 0)) {}
+
+			static batch_mask from_bits(int bits) {
+				return batch_mask(static_cast<__mmask8>(bits & 0xFF));
+			}
+
+			bool operator[](length_t i) const {
+				return ((data >> i) & 1) != 0;
+			}
+		};
+
+		template<>
+		struct batch<double, 8> {
+			using value_type = double;
+			using mask_type = batch_mask<double, 8>;
+
+			__m512d data;
+
+			static SMATH_CONSTEXPR length_t size() {
+				return 8;
+			}
+
+			batch() = default;
+			batch(double scalar) : data(_mm512_set1_pd(scalar)) {}
+			explicit batch(__m512d r) : data(r) {}
+
+			static batch load(const double *p) {
+				return batch(_mm512_load_pd(p));
+			}
+
+			static batch loadu(const double *p) {
+				return batch(_mm512_loadu_pd(p));
+			}
+
+			void store(double *p) const {
+				_mm512_store_pd(p, data);
+			}
+
+			void storeu(double *p) const {
+				_mm512_storeu_pd(p, data);
+			}
+
+			double operator[](length_t i) const {
+				alignas(64) double lanes[8];
+				store(lanes);
+				return lanes[i];
+			}
+		};
+
+		// -- Mask operators --
+
+		SMATH_INLINE batch_mask<double, 8> operator&(batch_mask<double, 8> a, batch_mask<double, 8> b) {
+			return batch_mask<double, 8>(static_cast<__mmask8>(a.data & b.data));
+		}
+
+		SMATH_INLINE batch_mask<double, 8> operator|(batch_mask<double, 8> a, batch_mask<double, 8> b) {
+			return batch_mask<double, 8>(static_cast<__mmask8>(a.data | b.data));
+		}
+
+		SMATH_INLINE batch_mask<double, 8> operator^(batch_mask<double, 8> a, batch_mask<double, 8> b) {
+			return batch_mask<double, 8>(static_cast<__mmask8>(a.data ^ b.data));
+		}
+
+		SMATH_INLINE batch_mask<double, 8> operator~(batch_mask<double, 8> a) {
+			return batch_mask<double, 8>(static_cast<__mmask8>(~a.data & 0xFF));
+		}
+
+		SMATH_INLINE int bits(batch_mask<double, 8> m) {
+			return static_cast<int>(m.data);
+		}
+
+		SMATH_INLINE bool any(batch_mask<double, 8> m) {
+			return m.data != 0;
+		}
+
+		SMATH_INLINE bool all(batch_mask<double, 8> m) {
+			return m.data == 0xFF;
+		}
+
+		SMATH_INLINE bool none(batch_mask<double, 8> m) {
+			return m.data == 0;
+		}
+
+		// -- Arithmetic operators --
+
+		SMATH_INLINE f64x8 operator+(f64x8 a, f64x8 b) {
+			return f64x8(_mm512_add_pd(a.data, b.data));
+		}
+
+		SMATH_INLINE f64x8 operator-(f64x8 a, f64x8 b) {
+			return f64x8(_mm512_sub_pd(a.data, b.data));
+		}
+
+		SMATH_INLINE f64x8 operator*(f64x8 a, f64x8 b) {
+			return f64x8(_mm512_mul_pd(a.data, b.data));
+		}
+
+		SMATH_INLINE f64x8 operator/(f64x8 a, f64x8 b) {
+			return f64x8(_mm512_div_pd(a.data, b.data));
+		}
+
+		SMATH_INLINE f64x8 operator-(f64x8 a) {
+			return f64x8(_mm512_castsi512_pd(_mm512_xor_si512(_mm512_castpd_si512(a.data), _mm512_castpd_si512(_mm512_set1_pd(-0.0)))));
+		}
+
+		// -- Comparison operators --
+
+		SMATH_INLINE batch_mask<double, 8> operator==(f64x8 a, f64x8 b) {
+			return batch_mask<double, 8>(_mm512_cmp_pd_mask(a.data, b.data, _CMP_EQ_OQ));
+		}
+
+		SMATH_INLINE batch_mask<double, 8> operator!=(f64x8 a, f64x8 b) {
+			return batch_mask<double, 8>(_mm512_cmp_pd_mask(a.data, b.data, _CMP_NEQ_UQ));
+		}
+
+		SMATH_INLINE batch_mask<double, 8> operator<(f64x8 a, f64x8 b) {
+			return batch_mask<double, 8>(_mm512_cmp_pd_mask(a.data, b.data, _CMP_LT_OQ));
+		}
+
+		SMATH_INLINE batch_mask<double, 8> operator<=(f64x8 a, f64x8 b) {
+			return batch_mask<double, 8>(_mm512_cmp_pd_mask(a.data, b.data, _CMP_LE_OQ));
+		}
+
+		SMATH_INLINE batch_mask<double, 8> operator>(f64x8 a, f64x8 b) {
+			return batch_mask<double, 8>(_mm512_cmp_pd_mask(a.data, b.data, _CMP_GT_OQ));
+		}
+
+		SMATH_INLINE batch_mask<double, 8> operator>=(f64x8 a, f64x8 b) {
+			return batch_mask<double, 8>(_mm512_cmp_pd_mask(a.data, b.data, _CMP_GE_OQ));
+		}
+
+		// -- Functions --
+
+		SMATH_INLINE f64x8 select(batch_mask<double, 8> m, f64x8 a, f64x8 b) {
+			return f64x8(_mm512_mask_blend_pd(m.data, b.data, a.data));
+		}
+
+		SMATH_INLINE f64x8 min(f64x8 a, f64x8 b) {
+			return f64x8(_mm512_min_pd(a.data, b.data));
+		}
+
+		SMATH_INLINE f64x8 max(f64x8 a, f64x8 b) {
+			return f64x8(_mm512_max_pd(a.data, b.data));
+		}
+
+		SMATH_INLINE f64x8 abs(f64x8 a) {
+			return f64x8(_mm512_abs_pd(a.data));
+		}
+
+		SMATH_INLINE f64x8 sqrt(f64x8 a) {
+			return f64x8(_mm512_sqrt_pd(a.data));
+		}
+
+		SMATH_INLINE f64x8 rsqrt(f64x8 a) {
+			return f64x8(_mm512_rsqrt14_pd(a.data));
+		}
+
+		SMATH_INLINE f64x8 fma(f64x8 a, f64x8 b, f64x8 c) {
+			return f64x8(_mm512_fmadd_pd(a.data, b.data, c.data));
+		}
+
+#if defined(__GNUC__) && !defined(__clang__)
+#	pragma GCC diagnostic push
+#	pragma GCC diagnostic ignored "-Wsign-conversion"
+#endif
+
+		// -- Rounding --
+
+		SMATH_INLINE f64x8 nearbyint(f64x8 a) {
+			return f64x8(_mm512_roundscale_pd(a.data, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+		}
+
+		SMATH_INLINE f64x8 floor(f64x8 a) {
+			return f64x8(_mm512_roundscale_pd(a.data, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC));
+		}
+
+		SMATH_INLINE f64x8 ceil(f64x8 a) {
+			return f64x8(_mm512_roundscale_pd(a.data, _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC));
+		}
+
+		SMATH_INLINE f64x8 trunc(f64x8 a) {
+			return f64x8(_mm512_roundscale_pd(a.data, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC));
+		}
+
+		// -- Exponents --
+
+		SMATH_INLINE f64x8 pow2i(f64x8 n) {
+			return f64x8(_mm512_scalef_pd(_mm512_set1_pd(1.0), n.data));
+		}
+
+		SMATH_INLINE f64x8 exponent(f64x8 a) {
+			return f64x8(_mm512_getexp_pd(a.data));
+		}
+
+		SMATH_INLINE f64x8 mantissa(f64x8 a) {
+			return f64x8(_mm512_getmant_pd(a.data, _MM_MANT_NORM_1_2, _MM_MANT_SIGN_src));
+		}
+
+#if defined(__GNUC__) && !defined(__clang__)
+#	pragma GCC diagnostic pop
+#endif
+
+		// -- Reductions --
+
+		SMATH_INLINE double reduce_add(f64x8 a) {
+			return reduce_add(f64x4(_mm512_castpd512_pd256(a.data)) + f64x4(_mm512_extractf64x4_pd(a.data, 1)));
+		}
+
+		SMATH_INLINE double reduce_min(f64x8 a) {
+			return reduce_min(min(f64x4(_mm512_castpd512_pd256(a.data)), f64x4(_mm512_extractf64x4_pd(a.data, 1))));
+		}
+
+		SMATH_INLINE double reduce_max(f64x8 a) {
+			return reduce_max(max(f64x4(_mm512_castpd512_pd256(a.data)), f64x4(_mm512_extractf64x4_pd(a.data, 1))));
+		}
+
+		// -- Conversions --
+
+		SMATH_INLINE void widen(f32x16 a, f64x8 &lo, f64x8 &hi) {
+			lo = f64x8(_mm512_cvtps_pd(_mm512_castps512_ps256(a.data)));
+			hi = f64x8(_mm512_cvtps_pd(_mm256_castpd_ps(_mm512_extractf64x4_pd(_mm512_castps_pd(a.data), 1))));
+		}
+
+		SMATH_INLINE f32x16 narrow(f64x8 lo, f64x8 hi) {
+			const __m256d l{ _mm256_castps_pd(_mm512_cvtpd_ps(lo.data)) };
+			const __m256d h{ _mm256_castps_pd(_mm512_cvtpd_ps(hi.data)) };
+			return f32x16(_mm512_castpd_ps(_mm512_insertf64x4(_mm512_castpd256_pd512(l), h, 1)));
+		}
+
+		// -------------------------------------
+		// --- 16 x 32-bit integer (AVX-512) ---
+		// -------------------------------------
+
+		template<>
+		struct batch_mask<int, 16> {
+			__mmask16 data;
+
+			batch_mask() = default;
+			explicit batch_mask(__mmask16 m) : data(m) {}
+			explicit batch_mask(bool b) : data(static_cast<__mmask16>(b ? 0xFFFF : 0)) {}
+
+			static batch_mask from_bits(int bits) {
+				return batch_mask(static_cast<__mmask16>(bits & 0xFFFF));
+			}
+
+			bool operator[](length_t i) const {
+				return ((data >> i) & 1) != 0;
+			}
+		};
+
+		template<>
+		struct batch<int, 16> {
+			using value_type = int;
+			using mask_type = batch_mask<int, 16>;
+
+			__m512i data;
+
+			static SMATH_CONSTEXPR length_t size() {
+				return 16;
+			}
+
+			batch() = default;
+			batch(int scalar) : data(_mm512_set1_epi32(scalar)) {}
+			explicit batch(__m512i r) : data(r) {}
+
+			static batch load(const int *p) {
+				return batch(_mm512_load_si512(p));
+			}
+
+			static batch loadu(const int *p) {
+				return batch(_mm512_loadu_si512(p));
+			}
+
+			void store(int *p) const {
+				_mm512_store_si512(p, data);
+			}
+
+			void storeu(int *p) const {
+				_mm512_storeu_si512(p, data);
+			}
+
+			int operator[](length_t i) const {
+				alignas(64) int lanes[16];
+				store(lanes);
+				return lanes[i];
+			}
+		};
+
+		// -- Mask operators --
+
+		SMATH_INLINE batch_mask<int, 16> operator&(batch_mask<int, 16> a, batch_mask<int, 16> b) {
+			return batch_mask<int, 16>(static_cast<__mmask16>(a.data & b.data));
+		}
+
+		SMATH_INLINE batch_mask<int, 16> operator|(batch_mask<int, 16> a, batch_mask<int, 16> b) {
+			return batch_mask<int, 16>(static_cast<__mmask16>(a.data | b.data));
+		}
+
+		SMATH_INLINE batch_mask<int, 16> operator^(batch_mask<int, 16> a, batch_mask<int, 16> b) {
+			return batch_mask<int, 16>(static_cast<__mmask16>(a.data ^ b.data));
+		}
+
+		SMATH_INLINE batch_mask<int, 16> operator~(batch_mask<int, 16> a) {
+			return batch_mask<int, 16>(static_cast<__mmask16>(~a.data & 0xFFFF));
+		}
+
+		SMATH_INLINE int bits(batch_mask<int, 16> m) {
+			return static_cast<int>(m.data);
+		}
+
+		SMATH_INLINE bool any(batch_mask<int, 16> m) {
+			return m.data != 0;
+		}
+
+		SMATH_INLINE bool all(batch_mask<int, 16> m) {
+			return m.data == 0xFFFF;
+		}
+
+		SMATH_INLINE bool none(batch_mask<int, 16> m) {
+			return m.data == 0;
+		}
+
+		// -- Arithmetic operators --
+
+		SMATH_INLINE i32x16 operator+(i32x16 a, i32x16 b) {
+			return i32x16(_mm512_add_epi32(a.data, b.data));
+		}
+
+		SMATH_INLINE i32x16 operator-(i32x16 a, i32x16 b) {
+			return i32x16(_mm512_sub_epi32(a.data, b.data));
+		}
+
+		SMATH_INLINE i32x16 operator*(i32x16 a, i32x16 b) {
+			return i32x16(_mm512_mullo_epi32(a.data, b.data));
+		}
+
+		SMATH_INLINE i32x16 operator-(i32x16 a) {
+			return i32x16(_mm512_sub_epi32(_mm512_setzero_si512(), a.data));
+		}
+
+		// -- Bitwise operators --
+
+		SMATH_INLINE i32x16 operator&(i32x16 a, i32x16 b) {
+			return i32x16(_mm512_and_si512(a.data, b.data));
+		}
+
+		SMATH_INLINE i32x16 operator|(i32x16 a, i32x16 b) {
+			return i32x16(_mm512_or_si512(a.data, b.data));
+		}
+
+		SMATH_INLINE i32x16 operator^(i32x16 a, i32x16 b) {
+			return i32x16(_mm512_xor_si512(a.data, b.data));
+		}
+
+		SMATH_INLINE i32x16 operator<<(i32x16 a, int n) {
+			return i32x16(_mm512_sll_epi32(a.data, _mm_cvtsi32_si128(n)));
+		}
+
+		SMATH_INLINE i32x16 operator>>(i32x16 a, int n) {
+			return i32x16(_mm512_sra_epi32(a.data, _mm_cvtsi32_si128(n)));
+		}
+
+		// -- Comparison operators --
+
+		SMATH_INLINE batch_mask<int, 16> operator==(i32x16 a, i32x16 b) {
+			return batch_mask<int, 16>(_mm512_cmp_epi32_mask(a.data, b.data, _MM_CMPINT_EQ));
+		}
+
+		SMATH_INLINE batch_mask<int, 16> operator!=(i32x16 a, i32x16 b) {
+			return batch_mask<int, 16>(_mm512_cmp_epi32_mask(a.data, b.data, _MM_CMPINT_NE));
+		}
+
+		SMATH_INLINE batch_mask<int, 16> operator<(i32x16 a, i32x16 b) {
+			return batch_mask<int, 16>(_mm512_cmp_epi32_mask(a.data, b.data, _MM_CMPINT_LT));
+		}
+
+		SMATH_INLINE batch_mask<int, 16> operator<=(i32x16 a, i32x16 b) {
+			return batch_mask<int, 16>(_mm512_cmp_epi32_mask(a.data, b.data, _MM_CMPINT_LE));
+		}
+
+		SMATH_INLINE batch_mask<int, 16> operator>(i32x16 a, i32x16 b) {
+			return batch_mask<int, 16>(_mm512_cmp_epi32_mask(a.data, b.data, _MM_CMPINT_NLE));
+		}
+
+		SMATH_INLINE batch_mask<int, 16> operator>=(i32x16 a, i32x16 b) {
+			return batch_mask<int, 16>(_mm512_cmp_epi32_mask(a.data, b.data, _MM_CMPINT_NLT));
+		}
+
+		// -- Functions --
+
+		SMATH_INLINE i32x16 select(batch_mask<int, 16> m, i32x16 a, i32x16 b) {
+			return i32x16(_mm512_mask_blend_epi32(m.data, b.data, a.data));
+		}
+
+		SMATH_INLINE i32x16 min(i32x16 a, i32x16 b) {
+			return i32x16(_mm512_min_epi32(a.data, b.data));
+		}
+
+		SMATH_INLINE i32x16 max(i32x16 a, i32x16 b) {
+			return i32x16(_mm512_max_epi32(a.data, b.data));
+		}
+
+		SMATH_INLINE i32x16 mulhi(i32x16 a, i32x16 b) {
+			const __m512i even{ _mm512_mul_epi32(a.data, b.data) };
+			const __m512i odd{ _mm512_mul_epi32(_mm512_srli_epi64(a.data, 32), _mm512_srli_epi64(b.data, 32)) };
+			return i32x16(_mm512_mask_blend_epi32(0xAAAA, _mm512_srli_epi64(even, 32), odd));
+		}
+
+		SMATH_INLINE i32x16 abs(i32x16 a) {
+			return i32x16(_mm512_abs_epi32(a.data));
+		}
+
+		// -- Reductions --
+
+		SMATH_INLINE int reduce_add(i32x16 a) {
+			return reduce_add(i32x8(_mm512_castsi512_si256(a.data)) + i32x8(_mm512_extracti64x4_epi64(a.data, 1)));
+		}
+
+		SMATH_INLINE int reduce_min(i32x16 a) {
+			return reduce_min(min(i32x8(_mm512_castsi512_si256(a.data)), i32x8(_mm512_extracti64x4_epi64(a.data, 1))));
+		}
+
+		SMATH_INLINE int reduce_max(i32x16 a) {
+			return reduce_max(max(i32x8(_mm512_castsi512_si256(a.data)), i32x8(_mm512_extracti64x4_epi64(a.data, 1))));
+		}
+
+	} // namespace simd
+
+} // namespace smath
+
+#endif // SMATH_ARCH & SMATH_ARCH_AVX512_BIT
+
+#endif // SIMD_AVX512_H
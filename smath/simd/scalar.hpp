@@ -0,0 +1,690 @@
+#pragma once
+
+#ifndef SIMD_SCALAR_H
+#define SIMD_SCALAR_H
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#include "../detail/bit_cast.hpp"
+#include "../detail/setup.hpp"
+
+namespace smath {
+
+	namespace simd {
+
+		namespace detail {
+
+			// -- Wrapping integer arithmetic --
+
+			// Integer lanes wrap on overflow like the SIMD instructions do, which
+			// keeps the scalar backend bit-identical without signed overflow.
+
+			template<class T>
+			SMATH_INLINE T wrap_add(T a, T b) {
+				return a + b;
+			}
+
+			SMATH_INLINE int wrap_add(int a, int b) {
+				return static_cast<int>(static_cast<unsigned>(a) + static_cast<unsigned>(b));
+			}
+
+			template<class T>
+			SMATH_INLINE T wrap_sub(T a, T b) {
+				return a - b;
+			}
+
+			SMATH_INLINE int wrap_sub(int a, int b) {
+				return static_cast<int>(static_cast<unsigned>(a) - static_cast<unsigned>(b));
+			}
+
+			template<class T>
+			SMATH_INLINE T wrap_mul(T a, T b) {
+				return a * b;
+			}
+
+			SMATH_INLINE int wrap_mul(int a, int b) {
+				return static_cast<int>(static_cast<unsigned>(a) * static_cast<unsigned>(b));
+			}
+
+			template<class T>
+			SMATH_INLINE T wrap_neg(T a) {
+				return -a;
+			}
+
+			SMATH_INLINE int wrap_neg(int a) {
+				return static_cast<int>(0u - static_cast<unsigned>(a));
+			}
+
+			template<class T>
+			SMATH_INLINE T lane_abs(T a) {
+				return ::std::abs(a);
+			}
+
+			SMATH_INLINE int lane_abs(int a) {
+				return (a < 0) ? wrap_neg(a) : a;
+			}
+
+			// -- Floating-point lanes --
+
+			// Rounding and exponents work on the bits like the SIMD backends, which
+			// keeps them off the slower library functions and gives the same bits.
+
+			template<class T>
+			struct lane_bits;
+
+			template<>
+			struct lane_bits<float> {
+				using type = std::uint32_t;
+				static constexpr int precision = 23;
+				static constexpr int bias = 127;
+				static constexpr type exponent_mask = 0xffu;
+				static constexpr type exponent_bits = 0x7f800000u;
+				static constexpr float magic = 8388608.f;
+			};
+
+			template<>
+			struct lane_bits<double> {
+				using type = std::uint64_t;
+				static constexpr int precision = 52;
+				static constexpr int bias = 1023;
+				static constexpr type exponent_mask = 0x7ffu;
+				static constexpr type exponent_bits = 0x7ff0000000000000u;
+				static constexpr double magic = 4503599627370496.0;
+			};
+
+			/**
+			 * @brief Rounds to the nearest integer with ties to even by adding and
+			 * subtracting 2^precision. Larger magnitudes, infinities and NaNs are
+			 * already whole, and the sign is kept for results that round to zero.
+			 */
+			template<class T>
+			SMATH_INLINE T lane_nearbyint(T a) {
+				using C = lane_bits<T>;
+				if (!(::std::fabs(a) < C::magic)) {
+					return a;
+				}
+				const T r{ ::std::fabs(a) + C::magic };
+				return ::std::copysign(r - C::magic, a);
+			}
+
+			/**
+			 * @brief `2^n` for whole `n` in the exponent range of normal numbers.
+			 */
+			template<class T>
+			SMATH_INLINE T lane_pow2i(T n) {
+				using C = lane_bits<T>;
+				using U = typename C::type;
+				return ::smath::detail::bit_cast<T>(static_cast<U>(static_cast<U>(static_cast<int>(n) + C::bias) << C::precision));
+			}
+
+			template<class T>
+			SMATH_INLINE T lane_exponent(T a) {
+				using C = lane_bits<T>;
+				const typename C::type e{ (::smath::detail::bit_cast<typename C::type>(a) >> C::precision) & C::exponent_mask };
+				return static_cast<T>(static_cast<int>(e) - C::bias);
+			}
+
+			template<class T>
+			SMATH_INLINE T lane_mantissa(T a) {
+				using C = lane_bits<T>;
+				using U = typename C::type;
+				return ::smath::detail::bit_cast<T>((::smath::detail::bit_cast<U>(a) & ~C::exponent_bits) | ::smath::detail::bit_cast<U>(T(1)));
+			}
+
+		} // namespace detail
+
+		/**
+		 * Mask produced by comparing two batches, holding one boolean per lane.
+		 * This is the scalar fallback used when no SIMD register exists for
+		 * the lane type and count.
+		 * @tparam T The type of the batches that were compared.
+		 * @tparam N The number of lanes.
+		 */
+		template<class T, length_t N>
+		struct batch_mask {
+			bool lanes[static_cast<std::size_t>(N)];
+
+			batch_mask() = default;
+
+			/**
+			 * @brief Sets every lane of the mask to the same value.
+			 */
+			explicit batch_mask(bool b) {
+				for (length_t i = 0; i < N; ++i) {
+					lanes[i] = b;
+				}
+			}
+
+			/**
+			 * @brief Creates a mask with lane `i` set when bit `i` is set.
+			 */
+			static batch_mask from_bits(int bits) {
+				batch_mask m;
+				for (length_t i = 0; i < N; ++i) {
+					m.lanes[i] = ((bits >> i) & 1) != 0;
+				}
+				return m;
+			}
+
+			bool operator[](length_t i) const {
+				return lanes[i];
+			}
+
+			// -- Mask operators --
+
+			friend batch_mask operator&(const batch_mask &a, const batch_mask &b) {
+				batch_mask m;
+				for (length_t i = 0; i < N; ++i) {
+					m.lanes[i] = a.lanes[i] && b.lanes[i];
+				}
+				return m;
+			}
+
+			friend batch_mask operator|(const batch_mask &a, const batch_mask &b) {
+				batch_mask m;
+				for (length_t i = 0; i < N; ++i) {
+					m.lanes[i] = a.lanes[i] || b.lanes[i];
+				}
+				return m;
+			}
+
+			friend batch_mask operator^(const batch_mask &a, const batch_mask &b) {
+				batch_mask m;
+				for (length_t i = 0; i < N; ++i) {
+					m.lanes[i] = a.lanes[i] != b.lanes[i];
+				}
+				return m;
+			}
+
+			friend batch_mask operator~(const batch_mask &a) {
+				batch_mask m;
+				for (length_t i = 0; i < N; ++i) {
+					m.lanes[i] = !a.lanes[i];
+				}
+				return m;
+			}
+
+			/**
+			 * @returns A bit field with bit `i` set when lane `i` is set.
+			 */
+			friend int bits(const batch_mask &m) {
+				int result{ 0 };
+				for (length_t i = 0; i < N; ++i) {
+					result |= static_cast<int>(m.lanes[i]) << i;
+				}
+				return result;
+			}
+
+			friend bool any(const batch_mask &m) {
+				return bits(m) != 0;
+			}
+
+			friend bool all(const batch_mask &m) {
+				return bits(m) == (1 << N) - 1;
+			}
+
+			friend bool none(const batch_mask &m) {
+				return bits(m) == 0;
+			}
+		};
+
+		/**
+		 * A fixed number of lanes operated on together. This is the scalar
+		 * fallback used when no SIMD register exists for the lane type and count,
+		 * and every operation gives the same bits as the SIMD backends.
+		 * @tparam T The type of each lane (int, float, double)
+		 * @tparam N The number of lanes.
+		 */
+		template<class T, length_t N>
+		struct batch {
+			using value_type = T;
+			using mask_type = batch_mask<T, N>;
+
+			T lanes[static_cast<std::size_t>(N)];
+
+			/**
+			 * @returns The number of lanes in the batch.
+			 */
+			static SMATH_CONSTEXPR length_t size() {
+				return N;
+			}
+
+			// -- Constructors --
+
+			batch() = default;
+
+			/**
+			 * @brief Sets every lane of the batch to the same scalar.
+			 */
+			batch(T scalar) {
+				for (length_t i = 0; i < N; ++i) {
+					lanes[i] = scalar;
+				}
+			}
+
+			// -- Loads and stores --
+
+			/**
+			 * @brief Loads `N` values from memory aligned to the size of the batch.
+			 */
+			static batch load(const T *p) {
+				return loadu(p);
+			}
+
+			/**
+			 * @brief Loads `N` values from memory with any alignment.
+			 */
+			static batch loadu(const T *p) {
+				batch b;
+				for (length_t i = 0; i < N; ++i) {
+					b.lanes[i] = p[i];
+				}
+				return b;
+			}
+
+			void store(T *p) const {
+				storeu(p);
+			}
+
+			void storeu(T *p) const {
+				for (length_t i = 0; i < N; ++i) {
+					p[i] = lanes[i];
+				}
+			}
+
+			T operator[](length_t i) const {
+				return lanes[i];
+			}
+
+			// -- Arithmetic operators --
+
+			friend batch operator+(const batch &a, const batch &b) {
+				batch r;
+				for (length_t i = 0; i < N; ++i) {
+					r.lanes[i] = detail::wrap_add(a.lanes[i], b.lanes[i]);
+				}
+				return r;
+			}
+
+			friend batch operator-(const batch &a, const batch &b) {
+				batch r;
+				for (length_t i = 0; i < N; ++i) {
+					r.lanes[i] = detail::wrap_sub(a.lanes[i], b.lanes[i]);
+				}
+				return r;
+			}
+
+			friend batch operator*(const batch &a, const batch &b) {
+				batch r;
+				for (length_t i = 0; i < N; ++i) {
+					r.lanes[i] = detail::wrap_mul(a.lanes[i], b.lanes[i]);
+				}
+				return r;
+			}
+
+			friend batch operator/(const batch &a, const batch &b) {
+				batch r;
+				for (length_t i = 0; i < N; ++i) {
+					r.lanes[i] = a.lanes[i] / b.lanes[i];
+				}
+				return r;
+			}
+
+			friend batch operator-(const batch &a) {
+				batch r;
+				for (length_t i = 0; i < N; ++i) {
+					r.lanes[i] = detail::wrap_neg(a.lanes[i]);
+				}
+				return r;
+			}
+
+			// -- Bitwise operators (integer lanes) --
+
+			friend batch operator&(const batch &a, const batch &b) {
+				batch r;
+				for (length_t i = 0; i < N; ++i) {
+					r.lanes[i] = a.lanes[i] & b.lanes[i];
+				}
+				return r;
+			}
+
+			friend batch operator|(const batch &a, const batch &b) {
+				batch r;
+				for (length_t i = 0; i < N; ++i) {
+					r.lanes[i] = a.lanes[i] | b.lanes[i];
+				}
+				return r;
+			}
+
+			friend batch operator^(const batch &a, const batch &b) {
+				batch r;
+				for (length_t i = 0; i < N; ++i) {
+					r.lanes[i] = a.lanes[i] ^ b.lanes[i];
+				}
+				return r;
+			}
+
+			friend batch operator<<(const batch &a, int n) {
+				batch r;
+				for (length_t i = 0; i < N; ++i) {
+					r.lanes[i] = static_cast<T>(static_cast<unsigned>(a.lanes[i]) << n);
+				}
+				return r;
+			}
+
+			friend batch operator>>(const batch &a, int n) {
+				// arithmetic shift, as with the SIMD instructions
+				batch r;
+				for (length_t i = 0; i < N; ++i) {
+					r.lanes[i] = a.lanes[i] >> n;
+				}
+				return r;
+			}
+
+			// -- Comparison operators --
+
+			friend mask_type operator==(const batch &a, const batch &b) {
+				mask_type m;
+				for (length_t i = 0; i < N; ++i) {
+					m.lanes[i] = a.lanes[i] == b.lanes[i];
+				}
+				return m;
+			}
+
+			friend mask_type operator!=(const batch &a, const batch &b) {
+				mask_type m;
+				for (length_t i = 0; i < N; ++i) {
+					m.lanes[i] = a.lanes[i] != b.lanes[i];
+				}
+				return m;
+			}
+
+			friend mask_type operator<(const batch &a, const batch &b) {
+				mask_type m;
+				for (length_t i = 0; i < N; ++i) {
+					m.lanes[i] = a.lanes[i] < b.lanes[i];
+				}
+				return m;
+			}
+
+			friend mask_type operator<=(const batch &a, const batch &b) {
+				mask_type m;
+				for (length_t i = 0; i < N; ++i) {
+					m.lanes[i] = a.lanes[i] <= b.lanes[i];
+				}
+				return m;
+			}
+
+			friend mask_type operator>(const batch &a, const batch &b) {
+				mask_type m;
+				for (length_t i = 0; i < N; ++i) {
+					m.lanes[i] = a.lanes[i] > b.lanes[i];
+				}
+				return m;
+			}
+
+			friend mask_type operator>=(const batch &a, const batch &b) {
+				mask_type m;
+				for (length_t i = 0; i < N; ++i) {
+					m.lanes[i] = a.lanes[i] >= b.lanes[i];
+				}
+				return m;
+			}
+
+			// -- Functions --
+
+			/**
+			 * @returns `a` where the mask is set, otherwise `b`.
+			 */
+			friend batch select(const mask_type &m, const batch &a, const batch &b) {
+				batch r;
+				for (length_t i = 0; i < N; ++i) {
+					r.lanes[i] = m.lanes[i] ? a.lanes[i] : b.lanes[i];
+				}
+				return r;
+			}
+
+			/**
+			 * @returns `a < b ? a : b` per lane, matching the SIMD min instructions
+			 * when either lane is NaN or both are zero.
+			 */
+			friend batch min(const batch &a, const batch &b) {
+				batch r;
+				for (length_t i = 0; i < N; ++i) {
+					r.lanes[i] = (a.lanes[i] < b.lanes[i]) ? a.lanes[i] : b.lanes[i];
+				}
+				return r;
+			}
+
+			/**
+			 * @returns `a > b ? a : b` per lane, matching the SIMD max instructions
+			 * when either lane is NaN or both are zero.
+			 */
+			friend batch max(const batch &a, const batch &b) {
+				batch r;
+				for (length_t i = 0; i < N; ++i) {
+					r.lanes[i] = (a.lanes[i] > b.lanes[i]) ? a.lanes[i] : b.lanes[i];
+				}
+				return r;
+			}
+
+			/**
+			 * @returns The high 32 bits of the signed 64-bit product of each lane,
+			 * only available for integer lanes.
+			 */
+			friend batch mulhi(const batch &a, const batch &b) {
+				batch r;
+				for (length_t i = 0; i < N; ++i) {
+					r.lanes[i] = static_cast<T>((static_cast<long long>(a.lanes[i]) * static_cast<long long>(b.lanes[i])) >> 32);
+				}
+				return r;
+			}
+
+			friend batch abs(const batch &a) {
+				batch r;
+				for (length_t i = 0; i < N; ++i) {
+					r.lanes[i] = detail::lane_abs(a.lanes[i]);
+				}
+				return r;
+			}
+
+			friend batch sqrt(const batch &a) {
+				batch r;
+				for (length_t i = 0; i < N; ++i) {
+					r.lanes[i] = ::std::sqrt(a.lanes[i]);
+				}
+				return r;
+			}
+
+			/**
+			 * @returns An estimate of `1 / sqrt(a)` per lane, with a relative error
+			 * below 2^-11. It is exact here, and the only function whose result
+			 * depends on the backend, as each one uses its estimate instruction.
+			 */
+			friend batch rsqrt(const batch &a) {
+				batch r;
+				for (length_t i = 0; i < N; ++i) {
+					r.lanes[i] = T(1) / ::std::sqrt(a.lanes[i]);
+				}
+				return r;
+			}
+
+			/**
+			 * @returns `a * b + c` per lane, with a single rounding only when
+			 * the target has FMA instructions, like the SIMD backends.
+			 */
+			friend batch fma(const batch &a, const batch &b, const batch &c) {
+#if SMATH_ARCH & SMATH_ARCH_FMA_BIT
+				batch r;
+				for (length_t i = 0; i < N; ++i) {
+					r.lanes[i] = ::std::fma(a.lanes[i], b.lanes[i], c.lanes[i]);
+				}
+				return r;
+#else
+				return a * b + c;
+#endif
+			}
+
+			// -- Rounding --
+
+			/**
+			 * @returns Each lane rounded to the nearest integer, with ties to even.
+			 */
+			friend batch nearbyint(const batch &a) {
+				batch r;
+				for (length_t i = 0; i < N; ++i) {
+					r.lanes[i] = detail::lane_nearbyint(a.lanes[i]);
+				}
+				return r;
+			}
+
+			friend batch floor(const batch &a) {
+				batch r;
+				for (length_t i = 0; i < N; ++i) {
+					r.lanes[i] = static_cast<T>(::std::floor(a.lanes[i]));
+				}
+				return r;
+			}
+
+			friend batch ceil(const batch &a) {
+				batch r;
+				for (length_t i = 0; i < N; ++i) {
+					r.lanes[i] = static_cast<T>(::std::ceil(a.lanes[i]));
+				}
+				return r;
+			}
+
+			friend batch trunc(const batch &a) {
+				batch r;
+				for (length_t i = 0; i < N; ++i) {
+					r.lanes[i] = static_cast<T>(::std::trunc(a.lanes[i]));
+				}
+				return r;
+			}
+
+			// -- Exponents --
+
+			/**
+			 * @returns `2^n` per lane, for whole numbers `n` in the exponent range
+			 * of normal numbers.
+			 */
+			friend batch pow2i(const batch &n) {
+				batch r;
+				for (length_t i = 0; i < N; ++i) {
+					r.lanes[i] = detail::lane_pow2i(n.lanes[i]);
+				}
+				return r;
+			}
+
+			/**
+			 * @returns The unbiased exponent of each lane, for normal numbers.
+			 */
+			friend batch exponent(const batch &a) {
+				batch r;
+				for (length_t i = 0; i < N; ++i) {
+					r.lanes[i] = detail::lane_exponent(a.lanes[i]);
+				}
+				return r;
+			}
+
+			/**
+			 * @returns The significand of each lane in [1, 2) with the sign of the
+			 * lane, for normal numbers.
+			 */
+			friend batch mantissa(const batch &a) {
+				batch r;
+				for (length_t i = 0; i < N; ++i) {
+					r.lanes[i] = detail::lane_mantissa(a.lanes[i]);
+				}
+				return r;
+			}
+
+			// -- Reductions --
+
+			// Lanes are combined pairwise, adding lane `i + N / 2` to lane `i` until
+			// one lane remains, which is the order used by every SIMD backend.
+
+			friend T reduce_add(const batch &a) {
+				batch r{ a };
+				for (length_t half = N / 2; half > 0; half /= 2) {
+					for (length_t i = 0; i < half; ++i) {
+						r.lanes[i] = detail::wrap_add(r.lanes[i], r.lanes[i + half]);
+					}
+				}
+				return r.lanes[0];
+			}
+
+			friend T reduce_min(const batch &a) {
+				batch r{ a };
+				for (length_t half = N / 2; half > 0; half /= 2) {
+					for (length_t i = 0; i < half; ++i) {
+						r.lanes[i] = (r.lanes[i] < r.lanes[i + half]) ? r.lanes[i] : r.lanes[i + half];
+					}
+				}
+				return r.lanes[0];
+			}
+
+			friend T reduce_max(const batch &a) {
+				batch r{ a };
+				for (length_t half = N / 2; half > 0; half /= 2) {
+					for (length_t i = 0; i < half; ++i) {
+						r.lanes[i] = (r.lanes[i] > r.lanes[i + half]) ? r.lanes[i] : r.lanes[i + half];
+					}
+				}
+				return r.lanes[0];
+			}
+		};
+
+		// -- Conversions --
+
+		/**
+		 * @brief Converts the lanes of a float batch to double, the first half
+		 * into `lo` and the second into `hi`, exactly.
+		 */
+		template<length_t N>
+		SMATH_INLINE void widen(const batch<float, N> &a, batch<double, N / 2> &lo, batch<double, N / 2> &hi) {
+			double lanes[static_cast<std::size_t>(N)];
+			for (length_t i = 0; i < N; ++i) {
+				lanes[i] = static_cast<double>(a[i]);
+			}
+			lo = batch<double, N / 2>::loadu(lanes);
+			hi = batch<double, N / 2>::loadu(lanes + N / 2);
+		}
+
+		/**
+		 * @brief Rounds two double batches to one float batch, with the lanes of
+		 * `lo` first. Inverse of widen.
+		 */
+		template<length_t N>
+		SMATH_INLINE batch<float, 2 * N> narrow(const batch<double, N> &lo, const batch<double, N> &hi) {
+			double lanes[static_cast<std::size_t>(2 * N)];
+			lo.storeu(lanes);
+			hi.storeu(lanes + N);
+			float r[static_cast<std::size_t>(2 * N)];
+			for (length_t i = 0; i < 2 * N; ++i) {
+				r[i] = static_cast<float>(lanes[i]);
+			}
+			return batch<float, 2 * N>::loadu(r);
+		}
+
+		// -- Batch types --
+
+		using f32x4  = batch<float, 4>;
+		using f32x8  = batch<float, 8>;
+		using f32x16 = batch<float, 16>;
+
+		using f64x2 = batch<double, 2>;
+		using f64x4 = batch<double, 4>;
+		using f64x8 = batch<double, 8>;
+
+		using i32x4  = batch<int, 4>;
+		using i32x8  = batch<int, 8>;
+		using i32x16 = batch<int, 16>;
+
+	} // namespace simd
+
+} // namespace smath
+
+#endif // SIMD_SCALAR_H
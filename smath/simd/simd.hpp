@@ -0,0 +1,89 @@
+#pragma once
+
+#ifndef SIMD_H
+#define SIMD_H
+
+/**
+ * Internal SIMD layer used to implement the vectorised paths of smath.
+ *
+ * `simd::batch<T, N>` holds `N` lanes of `T` and always compiles: the primary
+ * template is a portable scalar implementation, and the SSE2, AVX/AVX2 and
+ * AVX-512 backends specialise it for the widths the target supports. Every
+ * backend produces bit-identical results to the scalar one, including the
+ * lane order used by the reductions.
+ */
+
+#include "../detail/setup.hpp"
+
+#if SMATH_ARCH & SMATH_ARCH_SSE2_BIT
+#	if SMATH_COMPILER & SMATH_COMPILER_VC
+#		include <intrin.h>
+#	else
+#		include <immintrin.h>
+#	endif
+#endif
+
+#include "scalar.hpp"
+#include "sse2.hpp"
+#include "avx2.hpp"
+#include "avx512.hpp"
+#include "transpose.hpp"
+
+namespace smath {
+
+	namespace simd {
+
+		namespace detail {
+
+			template<class T>
+			struct native_width {
+				static const length_t value = 1;
+			};
+
+			template<>
+			struct native_width<float> {
+#if SMATH_ARCH & SMATH_ARCH_AVX512_BIT
+				static const length_t value = 16;
+#elif SMATH_ARCH & SMATH_ARCH_AVX_BIT
+				static const length_t value = 8;
+#else
+				static const length_t value = 4;
+#endif
+			};
+
+			template<>
+			struct native_width<double> {
+#if SMATH_ARCH & SMATH_ARCH_AVX512_BIT
+				static const length_t value = 8;
+#elif SMATH_ARCH & SMATH_ARCH_AVX_BIT
+				static const length_t value = 4;
+#else
+				static const length_t value = 2;
+#endif
+			};
+
+			template<>
+			struct native_width<int> {
+#if SMATH_ARCH & SMATH_ARCH_AVX512_BIT
+				static const length_t value = 16;
+#elif SMATH_ARCH & SMATH_ARCH_AVX2_BIT
+				static const length_t value = 8;
+#else
+				static const length_t value = 4;
+#endif
+			};
+
+		} // namespace detail
+
+		/**
+		 * @brief Widest batch of `T` supported by the instruction sets enabled at
+		 * compile time (the scalar backend uses the SSE2 widths).
+		 */
+		template<class T>
+		using native = batch<T, detail::native_width<T>::value>;
+
+	} // namespace simd
+
+} // namespace smath
+
+#endif // SIMD_H
@@ -0,0 +1,1032 @@
+#pragma once
+
+#ifndef SIMD_SSE2_H
+#define SIMD_SSE2_H
+
+#include <cmath>
+#include <limits>
+
+#include "scalar.hpp"
+
+#if SMATH_ARCH & SMATH_ARCH_SSE2_BIT
+
+namespace smath {
+
+	namespace simd {
+
+		// ----------------------------
+		// --- 4 x single-precision ---
+		// ----------------------------
+
+		template<>
+		struct batch_mask<float, 4> {
+			__m128 data;
+
+			batch_mask() = default;
+			explicit batch_mask(__m128 m) : data(m) {}
+			explicit batch_mask(bool b) : data(_mm_castsi128_ps(_mm_set1_epi32(b ? -1 : 0))) {}
+
+			static batch_mask from_bits(int bits) {
+				return batch_mask(_mm_castsi128_ps(_mm_setr_epi32(-(bits & 1), -((bits >> 1) & 1), -((bits >> 2) & 1), -((bits >> 3) & 1))));
+			}
+
+			bool operator[](length_t i) const {
+				return ((_mm_movemask_ps(data) >> i) & 1) != 0;
+			}
+		};
+
+		template<>
+		struct batch<float, 4> {
+			using value_type = float;
+			using mask_type = batch_mask<float, 4>;
+
+			__m128 data;
+
+			static SMATH_CONSTEXPR length_t size() {
+				return 4;
+			}
+
+			batch() = default;
+			batch(float scalar) : data(_mm_set1_ps(scalar)) {}
+			explicit batch(__m128 r) : data(r) {}
+
+			static batch load(const float *p) {
+				return batch(_mm_load_ps(p));
+			}
+
+			static batch loadu(const float *p) {
+				return batch(_mm_loadu_ps(p));
+			}
+
+			void store(float *p) const {
+				_mm_store_ps(p, data);
+			}
+
+			void storeu(float *p) const {
+				_mm_storeu_ps(p, data);
+			}
+
+			float operator[](length_t i) const {
+				alignas(16) float lanes[4];
+				store(lanes);
+				return lanes[i];
+			}
+		};
+
+		// -- Mask operators --
+
+		SMATH_INLINE batch_mask<float, 4> operator&(batch_mask<float, 4> a, batch_mask<float, 4> b) {
+			return batch_mask<float, 4>(_mm_and_ps(a.data, b.data));
+		}
+
+		SMATH_INLINE batch_mask<float, 4> operator|(batch_mask<float, 4> a, batch_mask<float, 4> b) {
+			return batch_mask<float, 4>(_mm_or_ps(a.data, b.data));
+		}
+
+		SMATH_INLINE batch_mask<float, 4> operator^(batch_mask<float, 4> a, batch_mask<float, 4> b) {
+			return batch_mask<float, 4>(_mm_xor_ps(a.data, b.data));
+		}
+
+		SMATH_INLINE batch_mask<float, 4> operator~(batch_mask<float, 4> a) {
+			return batch_mask<float, 4>(_mm_xor_ps(a.data, _mm_castsi128_ps(_mm_set1_epi32(-1))));
+		}
+
+		SMATH_INLINE int bits(batch_mask<float, 4> m) {
+			return _mm_movemask_ps(m.data);
+		}
+
+		SMATH_INLINE bool any(batch_mask<float, 4> m) {
+			return bits(m) != 0;
+		}
+
+		SMATH_INLINE bool all(batch_mask<float, 4> m) {
+			return bits(m) == 0xF;
+		}
+
+		SMATH_INLINE bool none(batch_mask<float, 4> m) {
+			return bits(m) == 0;
+		}
+
+		// -- Arithmetic operators --
+
+		SMATH_INLINE f32x4 operator+(f32x4 a, f32x4 b) {
+			return f32x4(_mm_add_ps(a.data, b.data));
+		}
+
+		SMATH_INLINE f32x4 operator-(f32x4 a, f32x4 b) {
+			return f32x4(_mm_sub_ps(a.data, b.data));
+		}
+
+		SMATH_INLINE f32x4 operator*(f32x4 a, f32x4 b) {
+			return f32x4(_mm_mul_ps(a.data, b.data));
+		}
+
+		SMATH_INLINE f32x4 operator/(f32x4 a, f32x4 b) {
+			return f32x4(_mm_div_ps(a.data, b.data));
+		}
+
+		SMATH_INLINE f32x4 operator-(f32x4 a) {
+			// negation only flips the sign bit
+			return f32x4(_mm_xor_ps(a.data, _mm_set1_ps(-0.f)));
+		}
+
+		// -- Comparison operators --
+
+		SMATH_INLINE batch_mask<float, 4> operator==(f32x4 a, f32x4 b) {
+			return batch_mask<float, 4>(_mm_cmpeq_ps(a.data, b.data));
+		}
+
+		SMATH_INLINE batch_mask<float, 4> operator!=(f32x4 a, f32x4 b) {
+			return batch_mask<float, 4>(_mm_cmpneq_ps(a.data, b.data));
+		}
+
+		SMATH_INLINE batch_mask<float, 4> operator<(f32x4 a, f32x4 b) {
+			return batch_mask<float, 4>(_mm_cmplt_ps(a.data, b.data));
+		}
+
+		SMATH_INLINE batch_mask<float, 4> operator<=(f32x4 a, f32x4 b) {
+			return batch_mask<float, 4>(_mm_cmple_ps(a.data, b.data));
+		}
+
+		SMATH_INLINE batch_mask<float, 4> operator>(f32x4 a, f32x4 b) {
+			return batch_mask<float, 4>(_mm_cmpgt_ps(a.data, b.data));
+		}
+
+		SMATH_INLINE batch_mask<float, 4> operator>=(f32x4 a, f32x4 b) {
+			return batch_mask<float, 4>(_mm_cmpge_ps(a.data, b.data));
+		}
+
+		// -- Functions --
+
+		SMATH_INLINE f32x4 select(batch_mask<float, 4> m, f32x4 a, f32x4 b) {
+#if SMATH_ARCH & SMATH_ARCH_SSE41_BIT
+			return f32x4(_mm_blendv_ps(b.data, a.data, m.data));
+#else
+			return f32x4(_mm_or_ps(_mm_and_ps(m.data, a.data), _mm_andnot_ps(m.data, b.data)));
+#endif
+		}
+
+		SMATH_INLINE f32x4 min(f32x4 a, f32x4 b) {
+			return f32x4(_mm_min_ps(a.data, b.data));
+		}
+
+		SMATH_INLINE f32x4 max(f32x4 a, f32x4 b) {
+			return f32x4(_mm_max_ps(a.data, b.data));
+		}
+
+		SMATH_INLINE f32x4 abs(f32x4 a) {
+			return f32x4(_mm_andnot_ps(_mm_set1_ps(-0.f), a.data));
+		}
+
+		SMATH_INLINE f32x4 sqrt(f32x4 a) {
+			return f32x4(_mm_sqrt_ps(a.data));
+		}
+
+		SMATH_INLINE f32x4 rsqrt(f32x4 a) {
+			// relative error below 1.5 * 2^-12
+			return f32x4(_mm_rsqrt_ps(a.data));
+		}
+
+		SMATH_INLINE f32x4 fma(f32x4 a, f32x4 b, f32x4 c) {
+#if SMATH_ARCH & SMATH_ARCH_FMA_BIT
+			return f32x4(_mm_fmadd_ps(a.data, b.data, c.data));
+#else
+			// without the instruction the product is rounded before the addition,
+			// as fusing each lane in software costs several times more
+			return a * b + c;
+#endif
+		}
+
+		// -- Rounding --
+
+#if SMATH_ARCH & SMATH_ARCH_SSE41_BIT
+		SMATH_INLINE f32x4 nearbyint(f32x4 a) {
+			return f32x4(_mm_round_ps(a.data, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+		}
+
+		SMATH_INLINE f32x4 floor(f32x4 a) {
+			return f32x4(_mm_round_ps(a.data, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC));
+		}
+
+		SMATH_INLINE f32x4 ceil(f32x4 a) {
+			return f32x4(_mm_round_ps(a.data, _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC));
+		}
+
+		SMATH_INLINE f32x4 trunc(f32x4 a) {
+			return f32x4(_mm_round_ps(a.data, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC));
+		}
+#else
+		// Adding and subtracting 2^23 with the sign of the input rounds to the
+		// nearest integer with ties to even. Larger magnitudes, infinities and
+		// NaNs are already whole and kept as they are, and the sign is restored
+		// so that negative results that round to zero give -0.
+
+		SMATH_INLINE f32x4 nearbyint(f32x4 a) {
+			const __m128 sign{ _mm_and_ps(a.data, _mm_set1_ps(-0.f)) };
+			const __m128 magic{ _mm_or_ps(_mm_set1_ps(8388608.f), sign) };
+			const __m128 r{ _mm_or_ps(_mm_sub_ps(_mm_add_ps(a.data, magic), magic), sign) };
+			const __m128 small{ _mm_cmplt_ps(_mm_andnot_ps(_mm_set1_ps(-0.f), a.data), _mm_set1_ps(8388608.f)) };
+			return f32x4(_mm_or_ps(_mm_and_ps(small, r), _mm_andnot_ps(small, a.data)));
+		}
+
+		SMATH_INLINE f32x4 floor(f32x4 a) {
+			const __m128 r{ nearbyint(a).data };
+			return f32x4(_mm_sub_ps(r, _mm_and_ps(_mm_cmpgt_ps(r, a.data), _mm_set1_ps(1.f))));
+		}
+
+		SMATH_INLINE f32x4 ceil(f32x4 a) {
+			const __m128 r{ nearbyint(a).data };
+			const __m128 sign{ _mm_and_ps(a.data, _mm_set1_ps(-0.f)) };
+			return f32x4(_mm_or_ps(_mm_add_ps(r, _mm_and_ps(_mm_cmplt_ps(r, a.data), _mm_set1_ps(1.f))), sign));
+		}
+
+		SMATH_INLINE f32x4 trunc(f32x4 a) {
+			const __m128 sign{ _mm_and_ps(a.data, _mm_set1_ps(-0.f)) };
+			return f32x4(_mm_or_ps(floor(f32x4(_mm_andnot_ps(_mm_set1_ps(-0.f), a.data))).data, sign));
+		}
+#endif
+
+		// -- Exponents --
+
+		SMATH_INLINE f32x4 pow2i(f32x4 n) {
+			// adding 2^23 + 127 leaves the biased exponent in the low bits
+			const __m128i e{ _mm_castps_si128(_mm_add_ps(n.data, _mm_set1_ps(8388735.f))) };
+			return f32x4(_mm_castsi128_ps(_mm_slli_epi32(e, 23)));
+		}
+
+		SMATH_INLINE f32x4 exponent(f32x4 a) {
+			const __m128i e{ _mm_and_si128(_mm_srli_epi32(_mm_castps_si128(a.data), 23), _mm_set1_epi32(0xff)) };
+			return f32x4(_mm_sub_ps(_mm_cvtepi32_ps(e), _mm_set1_ps(127.f)));
+		}
+
+		SMATH_INLINE f32x4 mantissa(f32x4 a) {
+			const __m128 bits{ _mm_castsi128_ps(_mm_set1_epi32(static_cast<int>(0x807fffff))) };
+			return f32x4(_mm_or_ps(_mm_and_ps(a.data, bits), _mm_set1_ps(1.f)));
+		}
+
+		// -- Reductions --
+
+		SMATH_INLINE float reduce_add(f32x4 a) {
+			const __m128 t{ _mm_add_ps(a.data, _mm_movehl_ps(a.data, a.data)) };
+			return _mm_cvtss_f32(_mm_add_ss(t, _mm_shuffle_ps(t, t, _MM_SHUFFLE(1, 1, 1, 1))));
+		}
+
+		SMATH_INLINE float reduce_min(f32x4 a) {
+			const __m128 t{ _mm_min_ps(a.data, _mm_movehl_ps(a.data, a.data)) };
+			return _mm_cvtss_f32(_mm_min_ss(t, _mm_shuffle_ps(t, t, _MM_SHUFFLE(1, 1, 1, 1))));
+		}
+
+		SMATH_INLINE float reduce_max(f32x4 a) {
+			const __m128 t{ _mm_max_ps(a.data, _mm_movehl_ps(a.data, a.data)) };
+			return _mm_cvtss_f32(_mm_max_ss(t, _mm_shuffle_ps(t, t, _MM_SHUFFLE(1, 1, 1, 1))));
+		}
+
+		// ----------------------------
+		// --- 2 x double-precision ---
+		// ----------------------------
+
+		template<>
+		struct batch_mask<double, 2> {
+			__m128d data;
+
+			batch_mask() = default;
+			explicit batch_mask(__m128d m) : data(m) {}
+			explicit batch_mask(bool b) : data(_mm_castsi128_pd(_mm_set1_epi32(b ? -1 : 0))) {}
+
+			static batch_mask from_bits(int bits) {
+				return batch_mask(_mm_castsi128_pd(_mm_setr_epi32(-(bits & 1), -(bits & 1), -((bits >> 1) & 1), -((bits >> 1) & 1))));
+			}
+
+			bool operator[](length_t i) const {
+				return ((_mm_movemask_pd(data) >> i) & 1) != 0;
+			}
+		};
+
+		template<>
+		struct batch<double, 2> {
+			using value_type = double;
+			using mask_type = batch_mask<double, 2>;
+
+			__m128d data;
+
+			static SMATH_CONSTEXPR length_t size() {
+				return 2;
+			}
+
+			batch() = default;
+			batch(double scalar) : data(_mm_set1_pd(scalar)) {}
+			explicit batch(__m128d r) : data(r) {}
+
+			static batch load(const double *p) {
+				return batch(_mm_load_pd(p));
+			}
+
+			static batch loadu(const double *p) {
+				return batch(_mm_loadu_pd(p));
+			}
+
+			void store(double *p) const {
+				_mm_store_pd(p, data);
+			}
+
+			void storeu(double *p) const {
+				_mm_storeu_pd(p, data);
+			}
+
+			double operator[](length_t i) const {
+				alignas(16) double lanes[2];
+				store(lanes);
+				return lanes[i];
+			}
+		};
+
+		// -- Mask operators --
+
+		SMATH_INLINE batch_mask<double, 2> operator&(batch_mask<double, 2> a, batch_mask<double, 2> b) {
+			return batch_mask<double, 2>(_mm_and_pd(a.data, b.data));
+		}
+
+		SMATH_INLINE batch_mask<double, 2> operator|(batch_mask<double, 2> a, batch_mask<double, 2> b) {
+			return batch_mask<double, 2>(_mm_or_pd(a.data, b.data));
+		}
+
+		SMATH_INLINE batch_mask<double, 2> operator^(batch_mask<double, 2> a, batch_mask<double, 2> b) {
+			return batch_mask<double, 2>(_mm_xor_pd(a.data, b.data));
+		}
+
+		SMATH_INLINE batch_mask<double, 2> operator~(batch_mask<double, 2> a) {
+			return batch_mask<double, 2>(_mm_xor_pd(a.data, _mm_castsi128_pd(_mm_set1_epi32(-1))));
+		}
+
+		SMATH_INLINE int bits(batch_mask<double, 2> m) {
+			return _mm_movemask_pd(m.data);
+		}
+
+		SMATH_INLINE bool any(batch_mask<double, 2> m) {
+			return bits(m) != 0;
+		}
+
+		SMATH_INLINE bool all(batch_mask<double, 2> m) {
+			return bits(m) == 0x3;
+		}
+
+		SMATH_INLINE bool none(batch_mask<double, 2> m) {
+			return bits(m) == 0;
+		}
+
+		// -- Arithmetic operators --
+
+		SMATH_INLINE f64x2 operator+(f64x2 a, f64x2 b) {
+			return f64x2(_mm_add_pd(a.data, b.data));
+		}
+
+		SMATH_INLINE f64x2 operator-(f64x2 a, f64x2 b) {
+			return f64x2(_mm_sub_pd(a.data, b.data));
+		}
+
+		SMATH_INLINE f64x2 operator*(f64x2 a, f64x2 b) {
+			return f64x2(_mm_mul_pd(a.data, b.data));
+		}
+
+		SMATH_INLINE f64x2 operator/(f64x2 a, f64x2 b) {
+			return f64x2(_mm_div_pd(a.data, b.data));
+		}
+
+		SMATH_INLINE f64x2 operator-(f64x2 a) {
+			return f64x2(_mm_xor_pd(a.data, _mm_set1_pd(-0.0)));
+		}
+
+		// -- Comparison operators --
+
+		SMATH_INLINE batch_mask<double, 2> operator==(f64x2 a, f64x2 b) {
+			return batch_mask<double, 2>(_mm_cmpeq_pd(a.data, b.data));
+		}
+
+		SMATH_INLINE batch_mask<double, 2> operator!=(f64x2 a, f64x2 b) {
+			return batch_mask<double, 2>(_mm_cmpneq_pd(a.data, b.data));
+		}
+
+		SMATH_INLINE batch_mask<double, 2> operator<(f64x2 a, f64x2 b) {
+			return batch_mask<double, 2>(_mm_cmplt_pd(a.data, b.data));
+		}
+
+		SMATH_INLINE batch_mask<double, 2> operator<=(f64x2 a, f64x2 b) {
+			return batch_mask<double, 2>(_mm_cmple_pd(a.data, b.data));
+		}
+
+		SMATH_INLINE batch_mask<double, 2> operator>(f64x2 a, f64x2 b) {
+			return batch_mask<double, 2>(_mm_cmpgt_pd(a.data, b.data));
+		}
+
+		SMATH_INLINE batch_mask<double, 2> operator>=(f64x2 a, f64x2 b) {
+			return batch_mask<double, 2>(_mm_cmpge_pd(a.data, b.data));
+		}
+
+		// -- Functions --
+
+		SMATH_INLINE f64x2 select(batch_mask<double, 2> m, f64x2 a, f64x2 b) {
+#if SMATH_ARCH & SMATH_ARCH_SSE41_BIT
+			return f64x2(_mm_blendv_pd(b.data, a.data, m.data));
+#else
+			return f64x2(_mm_or_pd(_mm_and_pd(m.data, a.data), _mm_andnot_pd(m.data, b.data)));
+#endif
+		}
+
+		SMATH_INLINE f64x2 min(f64x2 a, f64x2 b) {
+			return f64x2(_mm_min_pd(a.data, b.data));
+		}
+
+		SMATH_INLINE f64x2 max(f64x2 a, f64x2 b) {
+			return f64x2(_mm_max_pd(a.data, b.data));
+		}
+
+		SMATH_INLINE f64x2 abs(f64x2 a) {
+			return f64x2(_mm_andnot_pd(_mm_set1_pd(-0.0), a.data));
+		}
+
+		SMATH_INLINE f64x2 sqrt(f64x2 a) {
+			return f64x2(_mm_sqrt_pd(a.data));
+		}
+
+		/**
+		 * @returns An estimate of `1 / sqrt(a)` per lane. There is no estimate
+		 * instruction for doubles before AVX-512, so this is the bit trick
+		 * refined by two Newton steps, with a relative error below 5e-6.
+		 * Denormals are scaled up by 2^64 first, as the bit trick needs an
+		 * exponent to halve.
+		 */
+		SMATH_INLINE f64x2 rsqrt(f64x2 a) {
+			const auto tiny = a < f64x2(::std::numeric_limits<double>::min());
+			const f64x2 x{ select(tiny, a * f64x2(18446744073709551616.0), a) };
+			const __m128i i{ _mm_sub_epi64(_mm_set1_epi64x(0x5fe6eb50c7b537a9), _mm_srli_epi64(_mm_castpd_si128(x.data), 1)) };
+			const f64x2 h{ x * f64x2(0.5) };
+			f64x2 y{ _mm_castsi128_pd(i) };
+			y = y * (f64x2(1.5) - h * y * y);
+			y = y * (f64x2(1.5) - h * y * y);
+			y = select(tiny, y * f64x2(4294967296.0), y);
+
+			// zero, infinity, negatives and NaN as with the instructions for floats
+			const f64x2 inf{ ::std::numeric_limits<double>::infinity() };
+			return select(a == f64x2(0.0), inf,
+				select(a == inf, f64x2(0.0),
+				select(a > f64x2(0.0), y, f64x2(::std::numeric_limits<double>::quiet_NaN()))));
+		}
+
+		SMATH_INLINE f64x2 fma(f64x2 a, f64x2 b, f64x2 c) {
+#if SMATH_ARCH & SMATH_ARCH_FMA_BIT
+			return f64x2(_mm_fmadd_pd(a.data, b.data, c.data));
+#else
+			return a * b + c;
+#endif
+		}
+
+		// -- Rounding --
+
+#if SMATH_ARCH & SMATH_ARCH_SSE41_BIT
+		SMATH_INLINE f64x2 nearbyint(f64x2 a) {
+			return f64x2(_mm_round_pd(a.data, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+		}
+
+		SMATH_INLINE f64x2 floor(f64x2 a) {
+			return f64x2(_mm_round_pd(a.data, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC));
+		}
+
+		SMATH_INLINE f64x2 ceil(f64x2 a) {
+			return f64x2(_mm_round_pd(a.data, _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC));
+		}
+
+		SMATH_INLINE f64x2 trunc(f64x2 a) {
+			return f64x2(_mm_round_pd(a.data, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC));
+		}
+#else
+		// the same as the single-precision versions, with 2^52
+
+		SMATH_INLINE f64x2 nearbyint(f64x2 a) {
+			const __m128d sign{ _mm_and_pd(a.data, _mm_set1_pd(-0.0)) };
+			const __m128d magic{ _mm_or_pd(_mm_set1_pd(4503599627370496.0), sign) };
+			const __m128d r{ _mm_or_pd(_mm_sub_pd(_mm_add_pd(a.data, magic), magic), sign) };
+			const __m128d small{ _mm_cmplt_pd(_mm_andnot_pd(_mm_set1_pd(-0.0), a.data), _mm_set1_pd(4503599627370496.0)) };
+			return f64x2(_mm_or_pd(_mm_and_pd(small, r), _mm_andnot_pd(small, a.data)));
+		}
+
+		SMATH_INLINE f64x2 floor(f64x2 a) {
+			const __m128d r{ nearbyint(a).data };
+			return f64x2(_mm_sub_pd(r, _mm_and_pd(_mm_cmpgt_pd(r, a.data), _mm_set1_pd(1.0))));
+		}
+
+		SMATH_INLINE f64x2 ceil(f64x2 a) {
+			const __m128d r{ nearbyint(a).data };
+			const __m128d sign{ _mm_and_pd(a.data, _mm_set1_pd(-0.0)) };
+			return f64x2(_mm_or_pd(_mm_add_pd(r, _mm_and_pd(_mm_cmplt_pd(r, a.data), _mm_set1_pd(1.0))), sign));
+		}
+
+		SMATH_INLINE f64x2 trunc(f64x2 a) {
+			const __m128d sign{ _mm_and_pd(a.data, _mm_set1_pd(-0.0)) };
+			return f64x2(_mm_or_pd(floor(f64x2(_mm_andnot_pd(_mm_set1_pd(-0.0), a.data))).data, sign));
+		}
+#endif
+
+		// -- Exponents --
+
+		SMATH_INLINE f64x2 pow2i(f64x2 n) {
+			// adding 2^52 + 1023 leaves the biased exponent in the low bits
+			const __m128i e{ _mm_castpd_si128(_mm_add_pd(n.data, _mm_set1_pd(4503599627371519.0))) };
+			return f64x2(_mm_castsi128_pd(_mm_slli_epi64(e, 52)));
+		}
+
+		SMATH_INLINE f64x2 exponent(f64x2 a) {
+			// the biased exponent becomes the low bits of 2^52, without a 64-bit conversion
+			const __m128i e{ _mm_and_si128(_mm_srli_epi64(_mm_castpd_si128(a.data), 52), _mm_set1_epi64x(0x7ff)) };
+			const __m128d d{ _mm_castsi128_pd(_mm_or_si128(e, _mm_castpd_si128(_mm_set1_pd(4503599627370496.0)))) };
+			return f64x2(_mm_sub_pd(d, _mm_set1_pd(4503599627371519.0)));
+		}
+
+		SMATH_INLINE f64x2 mantissa(f64x2 a) {
+			const __m128d bits{ _mm_castsi128_pd(_mm_set1_epi64x(static_cast<long long>(0x800fffffffffffffull))) };
+			return f64x2(_mm_or_pd(_mm_and_pd(a.data, bits), _mm_set1_pd(1.0)));
+		}
+
+		// -- Reductions --
+
+		SMATH_INLINE double reduce_add(f64x2 a) {
+			return _mm_cvtsd_f64(_mm_add_sd(a.data, _mm_unpackhi_pd(a.data, a.data)));
+		}
+
+		SMATH_INLINE double reduce_min(f64x2 a) {
+			return _mm_cvtsd_f64(_mm_min_sd(a.data, _mm_unpackhi_pd(a.data, a.data)));
+		}
+
+		SMATH_INLINE double reduce_max(f64x2 a) {
+			return _mm_cvtsd_f64(_mm_max_sd(a.data, _mm_unpackhi_pd(a.data, a.data)));
+		}
+
+		// -- Conversions --
+
+		SMATH_INLINE void widen(f32x4 a, f64x2 &lo, f64x2 &hi) {
+			lo = f64x2(_mm_cvtps_pd(a.data));
+			hi = f64x2(_mm_cvtps_pd(_mm_movehl_ps(a.data, a.data)));
+		}
+
+		SMATH_INLINE f32x4 narrow(f64x2 lo, f64x2 hi) {
+			return f32x4(_mm_movelh_ps(_mm_cvtpd_ps(lo.data), _mm_cvtpd_ps(hi.data)));
+		}
+
+		// --------------------------
+		// --- 4 x 32-bit integer ---
+		// --------------------------
+
+		template<>
+		struct batch_mask<int, 4> {
+			__m128i data;
+
+			batch_mask() = default;
+			explicit batch_mask(__m128i m) : data(m) {}
+			explicit batch_mask(bool b) : data(_mm_set1_epi32(b ? -1 : 0)) {}
+
+			static batch_mask from_bits(int bits) {
+				return batch_mask(_mm_setr_epi32(-(bits & 1), -((bits >> 1) & 1), -((bits >> 2) & 1), -((bits >> 3) & 1)));
+			}
+
+			bool operator[](length_t i) const {
+				return ((_mm_movemask_ps(_mm_castsi128_ps(data)) >> i) & 1) != 0;
+			}
+		};
+
+		template<>
+		struct batch<int, 4> {
+			using value_type = int;
+			using mask_type = batch_mask<int, 4>;
+
+			__m128i data;
+
+			static SMATH_CONSTEXPR length_t size() {
+				return 4;
+			}
+
+			batch() = default;
+			batch(int scalar) : data(_mm_set1_epi32(scalar)) {}
+			explicit batch(__m128i r) : data(r) {}
+
+			static batch load(const int *p) {
+				return batch(_mm_load_si128(reinterpret_cast<const __m128i *>(p)));
+			}
+
+			static batch loadu(const int *p) {
+				return batch(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p)));
+			}
+
+			void store(int *p) const {
+				_mm_store_si128(reinterpret_cast<__m128i *>(p), data);
+			}
+
+			void storeu(int *p) const {
+				_mm_storeu_si128(reinterpret_cast<__m128i *>(p), data);
+			}
+
+			int operator[](length_t i) const {
+				alignas(16) int lanes[4];
+				store(lanes);
+				return lanes[i];
+			}
+		};
+
+		// -- Mask operators --
+
+		SMATH_INLINE batch_mask<int, 4> operator&(batch_mask<int, 4> a, batch_mask<int, 4> b) {
+			return batch_mask<int, 4>(_mm_and_si128(a.data, b.data));
+		}
+
+		SMATH_INLINE batch_mask<int, 4> operator|(batch_mask<int, 4> a, batch_mask<int, 4> b) {
+			return batch_mask<int, 4>(_mm_or_si128(a.data, b.data));
+		}
+
+		SMATH_INLINE batch_mask<int, 4> operator^(batch_mask<int, 4> a, batch_mask<int, 4> b) {
+			return batch_mask<int, 4>(_mm_xor_si128(a.data, b.data));
+		}
+
+		SMATH_INLINE batch_mask<int, 4> operator~(batch_mask<int, 4> a) {
+			return batch_mask<int, 4>(_mm_xor_si128(a.data, _mm_set1_epi32(-1)));
+		}
+
+		SMATH_INLINE int bits(batch_mask<int, 4> m) {
+			return _mm_movemask_ps(_mm_castsi128_ps(m.data));
+		}
+
+		SMATH_INLINE bool any(batch_mask<int, 4> m) {
+			return bits(m) != 0;
+		}
+
+		SMATH_INLINE bool all(batch_mask<int, 4> m) {
+			return bits(m) == 0xF;
+		}
+
+		SMATH_INLINE bool none(batch_mask<int, 4> m) {
+			return bits(m) == 0;
+		}
+
+		// -- Arithmetic operators --
+
+		SMATH_INLINE i32x4 operator+(i32x4 a, i32x4 b) {
+			return i32x4(_mm_add_epi32(a.data, b.data));
+		}
+
+		SMATH_INLINE i32x4 operator-(i32x4 a, i32x4 b) {
+			return i32x4(_mm_sub_epi32(a.data, b.data));
+		}
+
+		SMATH_INLINE i32x4 operator*(i32x4 a, i32x4 b) {
+#if SMATH_ARCH & SMATH_ARCH_SSE41_BIT
+			return i32x4(_mm_mullo_epi32(a.data, b.data));
+#else
+			// multiply the even and odd lanes separately and keep the low halves
+			const __m128i even{ _mm_mul_epu32(a.data, b.data) };
+			const __m128i odd{ _mm_mul_epu32(_mm_srli_epi64(a.data, 32), _mm_srli_epi64(b.data, 32)) };
+			return i32x4(_mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)), _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0))));
+#endif
+		}
+
+		SMATH_INLINE i32x4 operator-(i32x4 a) {
+			return i32x4(_mm_sub_epi32(_mm_setzero_si128(), a.data));
+		}
+
+		// -- Bitwise operators --
+
+		SMATH_INLINE i32x4 operator&(i32x4 a, i32x4 b) {
+			return i32x4(_mm_and_si128(a.data, b.data));
+		}
+
+		SMATH_INLINE i32x4 operator|(i32x4 a, i32x4 b) {
+			return i32x4(_mm_or_si128(a.data, b.data));
+		}
+
+		SMATH_INLINE i32x4 operator^(i32x4 a, i32x4 b) {
+			return i32x4(_mm_xor_si128(a.data, b.data));
+		}
+
+		SMATH_INLINE i32x4 operator<<(i32x4 a, int n) {
+			return i32x4(_mm_sll_epi32(a.data, _mm_cvtsi32_si128(n)));
+		}
+
+		SMATH_INLINE i32x4 operator>>(i32x4 a, int n) {
+			return i32x4(_mm_sra_epi32(a.data, _mm_cvtsi32_si128(n)));
+		}
+
+		// -- Comparison operators --
+
+		SMATH_INLINE batch_mask<int, 4> operator==(i32x4 a, i32x4 b) {
+			return batch_mask<int, 4>(_mm_cmpeq_epi32(a.data, b.data));
+		}
+
+		SMATH_INLINE batch_mask<int, 4> operator!=(i32x4 a, i32x4 b) {
+			return ~(a == b);
+		}
+
+		SMATH_INLINE batch_mask<int, 4> operator<(i32x4 a, i32x4 b) {
+			return batch_mask<int, 4>(_mm_cmplt_epi32(a.data, b.data));
+		}
+
+		SMATH_INLINE batch_mask<int, 4> operator<=(i32x4 a, i32x4 b) {
+			return ~(b < a);
+		}
+
+		SMATH_INLINE batch_mask<int, 4> operator>(i32x4 a, i32x4 b) {
+			return batch_mask<int, 4>(_mm_cmpgt_epi32(a.data, b.data));
+		}
+
+		SMATH_INLINE batch_mask<int, 4> operator>=(i32x4 a, i32x4 b) {
+			return ~(a < b);
+		}
+
+		// -- Functions --
+
+		SMATH_INLINE i32x4 select(batch_mask<int, 4> m, i32x4 a, i32x4 b) {
+#if SMATH_ARCH & SMATH_ARCH_SSE41_BIT
+			return i32x4(_mm_blendv_epi8(b.data, a.data, m.data));
+#else
+			return i32x4(_mm_or_si128(_mm_and_si128(m.data, a.data), _mm_andnot_si128(m.data, b.data)));
+#endif
+		}
+
+		SMATH_INLINE i32x4 min(i32x4 a, i32x4 b) {
+#if SMATH_ARCH & SMATH_ARCH_SSE41_BIT
+			return i32x4(_mm_min_epi32(a.data, b.data));
+#else
+			return select(a < b, a, b);
+#endif
+		}
+
+		SMATH_INLINE i32x4 max(i32x4 a, i32x4 b) {
+#if SMATH_ARCH & SMATH_ARCH_SSE41_BIT
+			return i32x4(_mm_max_epi32(a.data, b.data));
+#else
+			return select(a > b, a, b);
+#endif
+		}
+
+		SMATH_INLINE i32x4 mulhi(i32x4 a, i32x4 b) {
+#if SMATH_ARCH & SMATH_ARCH_SSE41_BIT
+			const __m128i even{ _mm_mul_epi32(a.data, b.data) };
+			const __m128i odd{ _mm_mul_epi32(_mm_srli_epi64(a.data, 32), _mm_srli_epi64(b.data, 32)) };
+			return i32x4(_mm_blend_epi16(_mm_srli_epi64(even, 32), odd, 0xCC));
+#else
+			// unsigned high product, corrected by subtracting the other operand for negative lanes
+			const __m128i even{ _mm_mul_epu32(a.data, b.data) };
+			const __m128i odd{ _mm_mul_epu32(_mm_srli_epi64(a.data, 32), _mm_srli_epi64(b.data, 32)) };
+			const __m128i high{ _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 3, 1)), _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 3, 1))) };
+			const __m128i fix{ _mm_add_epi32(_mm_and_si128(_mm_srai_epi32(a.data, 31), b.data), _mm_and_si128(_mm_srai_epi32(b.data, 31), a.data)) };
+			return i32x4(_mm_sub_epi32(high, fix));
+#endif
+		}
+
+		SMATH_INLINE i32x4 abs(i32x4 a) {
+#if SMATH_ARCH & SMATH_ARCH_SSSE3_BIT
+			return i32x4(_mm_abs_epi32(a.data));
+#else
+			const __m128i sign{ _mm_srai_epi32(a.data, 31) };
+			return i32x4(_mm_sub_epi32(_mm_xor_si128(a.data, sign), sign));
+#endif
+		}
+
+		// -- Reductions --
+
+		SMATH_INLINE int reduce_add(i32x4 a) {
+			const __m128i t{ _mm_add_epi32(a.data, _mm_unpackhi_epi64(a.data, a.data)) };
+			return _mm_cvtsi128_si32(_mm_add_epi32(t, _mm_shuffle_epi32(t, _MM_SHUFFLE(1, 1, 1, 1))));
+		}
+
+		SMATH_INLINE int reduce_min(i32x4 a) {
+			const i32x4 t{ min(a, i32x4(_mm_unpackhi_epi64(a.data, a.data))) };
+			return _mm_cvtsi128_si32(min(t, i32x4(_mm_shuffle_epi32(t.data, _MM_SHUFFLE(1, 1, 1, 1)))).data);
+		}
+
+		SMATH_INLINE int reduce_max(i32x4 a) {
+			const i32x4 t{ max(a, i32x4(_mm_unpackhi_epi64(a.data, a.data))) };
+			return _mm_cvtsi128_si32(max(t, i32x4(_mm_shuffle_epi32(t.data, _MM_SHUFFLE(1, 1, 1, 1)))).data);
+		}
+
+#if !(SMATH_ARCH & SMATH_ARCH_AVX_BIT)
+		// -----------------------------------------
+		// --- 4 x double-precision, without AVX ---
+		// -----------------------------------------
+
+		// Stored as two SSE2 registers holding lanes (0, 1) and (2, 3).
+
+		template<>
+		struct batch_mask<double, 4> {
+			batch_mask<double, 2> lo;
+			batch_mask<double, 2> hi;
+
+			batch_mask() = default;
+			batch_mask(batch_mask<double, 2> l, batch_mask<double, 2> h) : lo(l), hi(h) {}
+			explicit batch_mask(bool b) : lo(b), hi(b) {}
+
+			static batch_mask from_bits(int bits) {
+				return batch_mask(batch_mask<double, 2>::from_bits(bits), batch_mask<double, 2>::from_bits(bits >> 2));
+			}
+
+			bool operator[](length_t i) const {
+				return (i < 2) ? lo[i] : hi[i - 2];
+			}
+		};
+
+		template<>
+		struct batch<double, 4> {
+			using value_type = double;
+			using mask_type = batch_mask<double, 4>;
+
+			f64x2 lo;
+			f64x2 hi;
+
+			static SMATH_CONSTEXPR length_t size() {
+				return 4;
+			}
+
+			batch() = default;
+			batch(double scalar) : lo(scalar), hi(scalar) {}
+			batch(f64x2 l, f64x2 h) : lo(l), hi(h) {}
+
+			static batch load(const double *p) {
+				return batch(f64x2::load(p), f64x2::load(p + 2));
+			}
+
+			static batch loadu(const double *p) {
+				return batch(f64x2::loadu(p), f64x2::loadu(p + 2));
+			}
+
+			void store(double *p) const {
+				lo.store(p);
+				hi.store(p + 2);
+			}
+
+			void storeu(double *p) const {
+				lo.storeu(p);
+				hi.storeu(p + 2);
+			}
+
+			double operator[](length_t i) const {
+				return (i < 2) ? lo[i] : hi[i - 2];
+			}
+		};
+
+		// -- Mask operators --
+
+		SMATH_INLINE batch_mask<double, 4> operator&(batch_mask<double, 4> a, batch_mask<double, 4> b) {
+			return batch_mask<double, 4>(a.lo & b.lo, a.hi & b.hi);
+		}
+
+		SMATH_INLINE batch_mask<double, 4> operator|(batch_mask<double, 4> a, batch_mask<double, 4> b) {
+			return batch_mask<double, 4>(a.lo | b.lo, a.hi | b.hi);
+		}
+
+		SMATH_INLINE batch_mask<double, 4> operator^(batch_mask<double, 4> a, batch_mask<double, 4> b) {
+			return batch_mask<double, 4>(a.lo ^ b.lo, a.hi ^ b.hi);
+		}
+
+		SMATH_INLINE batch_mask<double, 4> operator~(batch_mask<double, 4> a) {
+			return batch_mask<double, 4>(~a.lo, ~a.hi);
+		}
+
+		SMATH_INLINE int bits(batch_mask<double, 4> m) {
+			return bits(m.lo) | (bits(m.hi) << 2);
+		}
+
+		SMATH_INLINE bool any(batch_mask<double, 4> m) {
+			return bits(m) != 0;
+		}
+
+		SMATH_INLINE bool all(batch_mask<double, 4> m) {
+			return bits(m) == 0xF;
+		}
+
+		SMATH_INLINE bool none(batch_mask<double, 4> m) {
+			return bits(m) == 0;
+		}
+
+		// -- Arithmetic operators --
+
+		SMATH_INLINE f64x4 operator+(f64x4 a, f64x4 b) {
+			return f64x4(a.lo + b.lo, a.hi + b.hi);
+		}
+
+		SMATH_INLINE f64x4 operator-(f64x4 a, f64x4 b) {
+			return f64x4(a.lo - b.lo, a.hi - b.hi);
+		}
+
+		SMATH_INLINE f64x4 operator*(f64x4 a, f64x4 b) {
+			return f64x4(a.lo * b.lo, a.hi * b.hi);
+		}
+
+		SMATH_INLINE f64x4 operator/(f64x4 a, f64x4 b) {
+			return f64x4(a.lo / b.lo, a.hi / b.hi);
+		}
+
+		SMATH_INLINE f64x4 operator-(f64x4 a) {
+			return f64x4(-a.lo, -a.hi);
+		}
+
+		// -- Comparison operators --
+
+		SMATH_INLINE batch_mask<double, 4> operator==(f64x4 a, f64x4 b) {
+			return batch_mask<double, 4>(a.lo == b.lo, a.hi == b.hi);
+		}
+
+		SMATH_INLINE batch_mask<double, 4> operator!=(f64x4 a, f64x4 b) {
+			return batch_mask<double, 4>(a.lo != b.lo, a.hi != b.hi);
+		}
+
+		SMATH_INLINE batch_mask<double, 4> operator<(f64x4 a, f64x4 b) {
+			return batch_mask<double, 4>(a.lo < b.lo, a.hi < b.hi);
+		}
+
+		SMATH_INLINE batch_mask<double, 4> operator<=(f64x4 a, f64x4 b) {
+			return batch_mask<double, 4>(a.lo <= b.lo, a.hi <= b.hi);
+		}
+
+		SMATH_INLINE batch_mask<double, 4> operator>(f64x4 a, f64x4 b) {
+			return batch_mask<double, 4>(a.lo > b.lo, a.hi > b.hi);
+		}
+
+		SMATH_INLINE batch_mask<double, 4> operator>=(f64x4 a, f64x4 b) {
+			return batch_mask<double, 4>(a.lo >= b.lo, a.hi >= b.hi);
+		}
+
+		// -- Functions --
+
+		SMATH_INLINE f64x4 select(batch_mask<double, 4> m, f64x4 a, f64x4 b) {
+			return f64x4(select(m.lo, a.lo, b.lo), select(m.hi, a.hi, b.hi));
+		}
+
+		SMATH_INLINE f64x4 min(f64x4 a, f64x4 b) {
+			return f64x4(min(a.lo, b.lo), min(a.hi, b.hi));
+		}
+
+		SMATH_INLINE f64x4 max(f64x4 a, f64x4 b) {
+			return f64x4(max(a.lo, b.lo), max(a.hi, b.hi));
+		}
+
+		SMATH_INLINE f64x4 abs(f64x4 a) {
+			return f64x4(abs(a.lo), abs(a.hi));
+		}
+
+		SMATH_INLINE f64x4 sqrt(f64x4 a) {
+			return f64x4(sqrt(a.lo), sqrt(a.hi));
+		}
+
+		SMATH_INLINE f64x4 rsqrt(f64x4 a) {
+			return f64x4(rsqrt(a.lo), rsqrt(a.hi));
+		}
+
+		SMATH_INLINE f64x4 fma(f64x4 a, f64x4 b, f64x4 c) {
+			return f64x4(fma(a.lo, b.lo, c.lo), fma(a.hi, b.hi, c.hi));
+		}
+
+		SMATH_INLINE f64x4 nearbyint(f64x4 a) {
+			return f64x4(nearbyint(a.lo), nearbyint(a.hi));
+		}
+
+		SMATH_INLINE f64x4 floor(f64x4 a) {
+			return f64x4(floor(a.lo), floor(a.hi));
+		}
+
+		SMATH_INLINE f64x4 ceil(f64x4 a) {
+			return f64x4(ceil(a.lo), ceil(a.hi));
+		}
+
+		SMATH_INLINE f64x4 trunc(f64x4 a) {
+			return f64x4(trunc(a.lo), trunc(a.hi));
+		}
+
+		SMATH_INLINE f64x4 pow2i(f64x4 n) {
+			return f64x4(pow2i(n.lo), pow2i(n.hi));
+		}
+
+		SMATH_INLINE f64x4 exponent(f64x4 a) {
+			return f64x4(exponent(a.lo), exponent(a.hi));
+		}
+
+		SMATH_INLINE f64x4 mantissa(f64x4 a) {
+			return f64x4(mantissa(a.lo), mantissa(a.hi));
+		}
+
+		// -- Reductions --
+
+		SMATH_INLINE double reduce_add(f64x4 a) {
+			return reduce_add(a.lo + a.hi);
+		}
+
+		SMATH_INLINE double reduce_min(f64x4 a) {
+			return reduce_min(min(a.lo, a.hi));
+		}
+
+		SMATH_INLINE double reduce_max(f64x4 a) {
+			return reduce_max(max(a.lo, a.hi));
+		}
+#endif
+
+	} // namespace simd
+
+} // namespace smath
+
+#endif // SMATH_ARCH & SMATH_ARCH_SSE2_BIT
+
+#endif // SIMD_SSE2_H
@@ -0,0 +1,306 @@
+#pragma once
+
+#ifndef SIMD_TRANSPOSE_H
+#define SIMD_TRANSPOSE_H
+
+#include <cstddef>
+
+#include "scalar.hpp"
+#include "sse2.hpp"
+#include "avx2.hpp"
+
+namespace smath {
+
+	namespace simd {
+
+		// -------------------------
+		// --- Generic transposes ---
+		// -------------------------
+
+		// The templates work on every batch by going through memory, and the
+		// backends below overload them with in-register shuffles.
+
+		/**
+		 * @brief Transposes a 4x4 matrix held as four 4-lane batches, so row `i`
+		 * becomes lane `i` of every batch.
+		 */
+		template<class B>
+		SMATH_INLINE void transpose(B &r0, B &r1, B &r2, B &r3) {
+			using T = typename B::value_type;
+			SMATH_STATIC_ASSERT(B::size() == 4, "'transpose' only works on 4-lane batches");
+
+			T m[4][4];
+			r0.storeu(m[0]);
+			r1.storeu(m[1]);
+			r2.storeu(m[2]);
+			r3.storeu(m[3]);
+
+			T t[4][4];
+			for (std::size_t r = 0; r < 4; ++r) {
+				for (std::size_t c = 0; c < 4; ++c) {
+					t[c][r] = m[r][c];
+				}
+			}
+
+			r0 = B::loadu(t[0]);
+			r1 = B::loadu(t[1]);
+			r2 = B::loadu(t[2]);
+			r3 = B::loadu(t[3]);
+		}
+
+		/**
+		 * @brief Splits `N` interleaved 3-component vectors, loaded as three
+		 * consecutive batches, into one batch per component.
+		 */
+		template<class B>
+		SMATH_INLINE void deinterleave3(const B &r0, const B &r1, const B &r2, B &x, B &y, B &z) {
+			using T = typename B::value_type;
+			const std::size_t n{ static_cast<std::size_t>(B::size()) };
+
+			T in[3 * static_cast<std::size_t>(B::size())];
+			r0.storeu(in);
+			r1.storeu(in + n);
+			r2.storeu(in + 2 * n);
+
+			T out[3][static_cast<std::size_t>(B::size())];
+			for (std::size_t i = 0; i < n; ++i) {
+				out[0][i] = in[3 * i];
+				out[1][i] = in[3 * i + 1];
+				out[2][i] = in[3 * i + 2];
+			}
+
+			x = B::loadu(out[0]);
+			y = B::loadu(out[1]);
+			z = B::loadu(out[2]);
+		}
+
+		/**
+		 * @brief Interleaves one batch per component back into `N` 3-component
+		 * vectors, stored as three consecutive batches. Inverse of deinterleave3.
+		 */
+		template<class B>
+		SMATH_INLINE void interleave3(const B &x, const B &y, const B &z, B &r0, B &r1, B &r2) {
+			using T = typename B::value_type;
+			const std::size_t n{ static_cast<std::size_t>(B::size()) };
+
+			T in[3][static_cast<std::size_t>(B::size())];
+			x.storeu(in[0]);
+			y.storeu(in[1]);
+			z.storeu(in[2]);
+
+			T out[3 * static_cast<std::size_t>(B::size())];
+			for (std::size_t i = 0; i < n; ++i) {
+				out[3 * i] = in[0][i];
+				out[3 * i + 1] = in[1][i];
+				out[3 * i + 2] = in[2][i];
+			}
+
+			r0 = B::loadu(out);
+			r1 = B::loadu(out + n);
+			r2 = B::loadu(out + 2 * n);
+		}
+
+		/**
+		 * @brief Splits `N` interleaved 4-component vectors, loaded as four
+		 * consecutive batches, into one batch per component.
+		 */
+		template<class B>
+		SMATH_INLINE void deinterleave4(B &r0, B &r1, B &r2, B &r3) {
+			using T = typename B::value_type;
+			const std::size_t n{ static_cast<std::size_t>(B::size()) };
+
+			T in[4 * static_cast<std::size_t>(B::size())];
+			r0.storeu(in);
+			r1.storeu(in + n);
+			r2.storeu(in + 2 * n);
+			r3.storeu(in + 3 * n);
+
+			T out[4][static_cast<std::size_t>(B::size())];
+			for (std::size_t i = 0; i < n; ++i) {
+				for (std::size_t c = 0; c < 4; ++c) {
+					out[c][i] = in[4 * i + c];
+				}
+			}
+
+			r0 = B::loadu(out[0]);
+			r1 = B::loadu(out[1]);
+			r2 = B::loadu(out[2]);
+			r3 = B::loadu(out[3]);
+		}
+
+		/**
+		 * @brief Interleaves one batch per component back into `N` 4-component
+		 * vectors, stored as four consecutive batches. Inverse of deinterleave4.
+		 */
+		template<class B>
+		SMATH_INLINE void interleave4(B &r0, B &r1, B &r2, B &r3) {
+			using T = typename B::value_type;
+			const std::size_t n{ static_cast<std::size_t>(B::size()) };
+
+			T in[4][static_cast<std::size_t>(B::size())];
+			r0.storeu(in[0]);
+			r1.storeu(in[1]);
+			r2.storeu(in[2]);
+			r3.storeu(in[3]);
+
+			T out[4 * static_cast<std::size_t>(B::size())];
+			for (std::size_t i = 0; i < n; ++i) {
+				for (std::size_t c = 0; c < 4; ++c) {
+					out[4 * i + c] = in[c][i];
+				}
+			}
+
+			r0 = B::loadu(out);
+			r1 = B::loadu(out + n);
+			r2 = B::loadu(out + 2 * n);
+			r3 = B::loadu(out + 3 * n);
+		}
+
+#if SMATH_ARCH & SMATH_ARCH_SSE2_BIT
+
+		// ----------------------------
+		// --- 4 x single-precision ---
+		// ----------------------------
+
+		SMATH_INLINE void transpose(f32x4 &r0, f32x4 &r1, f32x4 &r2, f32x4 &r3) {
+			_MM_TRANSPOSE4_PS(r0.data, r1.data, r2.data, r3.data);
+		}
+
+		// Per 128-bit lane: x0 y0 z0 x1 | y1 z1 x2 y2 | z2 x3 y3 z3 to one
+		// register per component, shared by the SSE and AVX versions.
+
+#	define SMATH_DEINTERLEAVE3(shuffle, m03, m14, m25, x, y, z) \
+				{ \
+					const auto xy = shuffle(m14, m25, _MM_SHUFFLE(2, 1, 3, 2)); \
+					const auto yz = shuffle(m03, m14, _MM_SHUFFLE(1, 0, 2, 1)); \
+					x = shuffle(m03, xy, _MM_SHUFFLE(2, 0, 3, 0)); \
+					y = shuffle(yz, xy, _MM_SHUFFLE(3, 1, 2, 0)); \
+					z = shuffle(yz, m25, _MM_SHUFFLE(3, 0, 3, 1)); \
+				}
+
+#	define SMATH_INTERLEAVE3(shuffle, unpacklo, unpackhi, x, y, z, m03, m14, m25) \
+				{ \
+					const auto zx0 = shuffle(z, x, _MM_SHUFFLE(1, 1, 0, 0)); \
+					m03 = shuffle(unpacklo(x, y), zx0, _MM_SHUFFLE(2, 0, 1, 0)); \
+					const auto yz1 = shuffle(y, z, _MM_SHUFFLE(2, 1, 2, 1)); \
+					m14 = shuffle(yz1, unpackhi(x, y), _MM_SHUFFLE(1, 0, 2, 0)); \
+					const auto zx2 = shuffle(z, x, _MM_SHUFFLE(3, 3, 2, 2)); \
+					const auto yz3 = shuffle(y, z, _MM_SHUFFLE(3, 3, 3, 3)); \
+					m25 = shuffle(zx2, yz3, _MM_SHUFFLE(2, 0, 2, 0)); \
+				}
+
+		SMATH_INLINE void deinterleave3(const f32x4 &r0, const f32x4 &r1, const f32x4 &r2, f32x4 &x, f32x4 &y, f32x4 &z) {
+			SMATH_DEINTERLEAVE3(_mm_shuffle_ps, r0.data, r1.data, r2.data, x.data, y.data, z.data)
+		}
+
+		SMATH_INLINE void interleave3(const f32x4 &x, const f32x4 &y, const f32x4 &z, f32x4 &r0, f32x4 &r1, f32x4 &r2) {
+			SMATH_INTERLEAVE3(_mm_shuffle_ps, _mm_unpacklo_ps, _mm_unpackhi_ps, x.data, y.data, z.data, r0.data, r1.data, r2.data)
+		}
+
+#endif // SMATH_ARCH & SMATH_ARCH_SSE2_BIT
+
+#if SMATH_ARCH & SMATH_ARCH_AVX_BIT
+
+		// ----------------------------------
+		// --- 8 x single-precision (AVX) ---
+		// ----------------------------------
+
+		SMATH_INLINE void deinterleave3(const f32x8 &r0, const f32x8 &r1, const f32x8 &r2, f32x8 &x, f32x8 &y, f32x8 &z) {
+			// gather vectors 0-3 into the low lanes and 4-7 into the high lanes
+			const __m256 m03{ _mm256_permute2f128_ps(r0.data, r1.data, 0x30) };
+			const __m256 m14{ _mm256_permute2f128_ps(r0.data, r2.data, 0x21) };
+			const __m256 m25{ _mm256_permute2f128_ps(r1.data, r2.data, 0x30) };
+			SMATH_DEINTERLEAVE3(_mm256_shuffle_ps, m03, m14, m25, x.data, y.data, z.data)
+		}
+
+		SMATH_INLINE void interleave3(const f32x8 &x, const f32x8 &y, const f32x8 &z, f32x8 &r0, f32x8 &r1, f32x8 &r2) {
+			__m256 m03, m14, m25;
+			SMATH_INTERLEAVE3(_mm256_shuffle_ps, _mm256_unpacklo_ps, _mm256_unpackhi_ps, x.data, y.data, z.data, m03, m14, m25)
+			r0.data = _mm256_permute2f128_ps(m03, m14, 0x20);
+			r1.data = _mm256_permute2f128_ps(m25, m03, 0x30);
+			r2.data = _mm256_permute2f128_ps(m14, m25, 0x31);
+		}
+
+		/**
+		 * @brief Transposes the 4x4 matrix in each 128-bit lane, as
+		 * _MM_TRANSPOSE4_PS on both halves at once.
+		 */
+		SMATH_INLINE void transpose_lanes(__m256 &r0, __m256 &r1, __m256 &r2, __m256 &r3) {
+			const __m256 t0{ _mm256_unpacklo_ps(r0, r1) };
+			const __m256 t1{ _mm256_unpacklo_ps(r2, r3) };
+			const __m256 t2{ _mm256_unpackhi_ps(r0, r1) };
+			const __m256 t3{ _mm256_unpackhi_ps(r2, r3) };
+			r0 = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(1, 0, 1, 0));
+			r1 = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(3, 2, 3, 2));
+			r2 = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(1, 0, 1, 0));
+			r3 = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(3, 2, 3, 2));
+		}
+
+		SMATH_INLINE void deinterleave4(f32x8 &r0, f32x8 &r1, f32x8 &r2, f32x8 &r3) {
+			// vectors 0-3 in the low lanes and 4-7 in the high lanes
+			__m256 v04{ _mm256_permute2f128_ps(r0.data, r2.data, 0x20) };
+			__m256 v15{ _mm256_permute2f128_ps(r0.data, r2.data, 0x31) };
+			__m256 v26{ _mm256_permute2f128_ps(r1.data, r3.data, 0x20) };
+			__m256 v37{ _mm256_permute2f128_ps(r1.data, r3.data, 0x31) };
+			transpose_lanes(v04, v15, v26, v37);
+			r0.data = v04;
+			r1.data = v15;
+			r2.data = v26;
+			r3.data = v37;
+		}
+
+		SMATH_INLINE void interleave4(f32x8 &r0, f32x8 &r1, f32x8 &r2, f32x8 &r3) {
+			__m256 v04{ r0.data }, v15{ r1.data }, v26{ r2.data }, v37{ r3.data };
+			transpose_lanes(v04, v15, v26, v37);
+			r0.data = _mm256_permute2f128_ps(v04, v15, 0x20);
+			r1.data = _mm256_permute2f128_ps(v26, v37, 0x20);
+			r2.data = _mm256_permute2f128_ps(v04, v15, 0x31);
+			r3.data = _mm256_permute2f128_ps(v26, v37, 0x31);
+		}
+
+		// ----------------------------------
+		// --- 4 x double-precision (AVX) ---
+		// ----------------------------------
+
+		SMATH_INLINE void transpose(f64x4 &r0, f64x4 &r1, f64x4 &r2, f64x4 &r3) {
+			const __m256d t0{ _mm256_unpacklo_pd(r0.data, r1.data) };
+			const __m256d t1{ _mm256_unpackhi_pd(r0.data, r1.data) };
+			const __m256d t2{ _mm256_unpacklo_pd(r2.data, r3.data) };
+			const __m256d t3{ _mm256_unpackhi_pd(r2.data, r3.data) };
+			r0.data = _mm256_permute2f128_pd(t0, t2, 0x20);
+			r1.data = _mm256_permute2f128_pd(t1, t3, 0x20);
+			r2.data = _mm256_permute2f128_pd(t0, t2, 0x31);
+			r3.data = _mm256_permute2f128_pd(t1, t3, 0x31);
+		}
+
+		SMATH_INLINE void deinterleave3(const f64x4 &r0, const f64x4 &r1, const f64x4 &r2, f64x4 &x, f64x4 &y, f64x4 &z) {
+			// x0 y0 | x2 y2, z0 x1 | z2 x3 and y1 z1 | y3 z3
+			const __m256d a{ _mm256_permute2f128_pd(r0.data, r1.data, 0x30) };
+			const __m256d b{ _mm256_permute2f128_pd(r0.data, r2.data, 0x21) };
+			const __m256d c{ _mm256_permute2f128_pd(r1.data, r2.data, 0x30) };
+			x.data = _mm256_shuffle_pd(a, b, 0xA);
+			y.data = _mm256_shuffle_pd(a, c, 0x5);
+			z.data = _mm256_shuffle_pd(b, c, 0xA);
+		}
+
+		SMATH_INLINE void interleave3(const f64x4 &x, const f64x4 &y, const f64x4 &z, f64x4 &r0, f64x4 &r1, f64x4 &r2) {
+			const __m256d a{ _mm256_shuffle_pd(x.data, y.data, 0x0) };
+			const __m256d b{ _mm256_shuffle_pd(z.data, x.data, 0xA) };
+			const __m256d c{ _mm256_shuffle_pd(y.data, z.data, 0xF) };
+			r0.data = _mm256_permute2f128_pd(a, b, 0x20);
+			r1.data = _mm256_permute2f128_pd(c, a, 0x30);
+			r2.data = _mm256_permute2f128_pd(b, c, 0x31);
+		}
+
+#endif // SMATH_ARCH & SMATH_ARCH_AVX_BIT
+
+#ifdef SMATH_DEINTERLEAVE3
+#	undef SMATH_DEINTERLEAVE3
+#	undef SMATH_INTERLEAVE3
+#endif
+
+	} // namespace simd
+
+} // namespace smath
+
+#endif // SIMD_TRANSPOSE_H
@@ -5,11 +5,25 @@
 
 #include "detail/setup.hpp"
 
+#include "batch.hpp"
+#include "bits.hpp"
 #include "constants.hpp"
+#include "divider.hpp"
 #include "exponential.hpp"
+#include "geometric.hpp"
+#include "layout.hpp"
 #include "math.hpp"
+#include "memory.hpp"
+#include "parallel.hpp"
+#include "precision.hpp"
+#include "range_map.hpp"
+#include "relational.hpp"
+#include "span.hpp"
 #include "template_types.hpp"
 #include "trigonometry.hpp"
 #include "vec.hpp"
 
+#include "containers/aosoa_array.hpp"
+#include "containers/soa_array.hpp"
+
 #endif // SMATH_H
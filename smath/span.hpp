@@ -0,0 +1,136 @@
+#pragma once
+
+#ifndef SPAN_H
+#define SPAN_H
+
+#include <cstddef>
+#include <type_traits>
+
+#include "detail/setup.hpp"
+
+#include "template_types.hpp"
+#include "vec.hpp"
+
+namespace smath {
+
+	/**
+	 * Non-owning view over a contiguous range of elements, used by the batch
+	 * overloads of the math functions. Mirrors the parts of C++20 std::span that
+	 * the library needs.
+	 * @tparam T The type of the elements, const-qualified for read-only views.
+	 */
+	template<class T>
+	class span {
+	public:
+
+		using element_type = T;
+		using value_type = typename std::remove_cv<T>::type;
+		using size_type = std::size_t;
+		using pointer = T *;
+		using iterator = T *;
+
+		// -- Constructors --
+
+		SMATH_CONSTEXPR span() = default;
+
+		SMATH_CONSTEXPR span(T *data, size_type size)
+			: m_data(data), m_size(size)
+		{}
+
+		template<std::size_t N>
+		SMATH_CONSTEXPR span(T (&arr)[N])
+			: m_data(arr), m_size(N)
+		{}
+
+		/**
+		 * @brief Views the elements of a contiguous container, such as
+		 * std::vector or std::array.
+		 */
+		template<class C, class = typename std::enable_if<
+			std::is_convertible<decltype(std::declval<C&>().data()), T *>::value
+		>::type>
+		SMATH_CONSTEXPR span(C &c)
+			: m_data(c.data()), m_size(c.size())
+		{}
+
+		/**
+		 * @brief Converts a view of mutable elements to a read-only view.
+		 */
+		template<class U, class = typename std::enable_if<
+			std::is_convertible<U(*)[], T(*)[]>::value
+		>::type>
+		SMATH_CONSTEXPR span(const span<U> &other)
+			: m_data(other.data()), m_size(other.size())
+		{}
+
+		// -- Accesses --
+
+		SMATH_CONSTEXPR T* data() const {
+			return m_data;
+		}
+
+		SMATH_CONSTEXPR size_type size() const {
+			return m_size;
+		}
+
+		SMATH_CONSTEXPR bool empty() const {
+			return m_size == 0;
+		}
+
+		SMATH_CONSTEXPR T& operator[](size_type i) const {
+			return m_data[i];
+		}
+
+		SMATH_CONSTEXPR iterator begin() const {
+			return m_data;
+		}
+
+		SMATH_CONSTEXPR iterator end() const {
+			return m_data + m_size;
+		}
+
+	private:
+
+		T *m_data{ nullptr };
+		size_type m_size{ 0 };
+	};
+
+	// -- Deduction guides --
+
+	template<class T, std::size_t N>
+	span(T (&)[N]) -> span<T>;
+
+	template<class C>
+	span(C &) -> span<typename std::remove_pointer<decltype(std::declval<C&>().data())>::type>;
+
+	namespace detail {
+
+		/**
+		 * @brief Prevents a parameter from taking part in template argument
+		 * deduction, so it converts to the type deduced from the others.
+		 */
+		template<class T>
+		struct identity {
+			using type = T;
+		};
+
+		/**
+		 * @brief Views a range of vectors as the range of their components.
+		 */
+		template<length_t L, class T>
+		SMATH_INLINE span<T> component_span(span<vec<L, T>> v) {
+			SMATH_STATIC_ASSERT(sizeof(vec<L, T>) == sizeof(T) * static_cast<std::size_t>(L), "vector components must be tightly packed");
+			return span<T>(reinterpret_cast<T *>(v.data()), v.size() * static_cast<std::size_t>(L));
+		}
+
+		template<length_t L, class T>
+		SMATH_INLINE span<const T> component_span(span<const vec<L, T>> v) {
+			SMATH_STATIC_ASSERT(sizeof(vec<L, T>) == sizeof(T) * static_cast<std::size_t>(L), "vector components must be tightly packed");
+			return span<const T>(reinterpret_cast<const T *>(v.data()), v.size() * static_cast<std::size_t>(L));
+		}
+
+	} // namespace detail
+
+} // namespace smath
+
+#endif // SPAN_H
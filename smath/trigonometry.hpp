@@ -27,7 +27,7 @@ namespace smath {
 	 */
 	template<length_t L, class T>
 	SMATH_INLINE SMATH_CONSTEXPR vec<L, T> radians(const vec<L, T> &v) {
-		return function::one<vec, L, T, T>::apply(radians, v);
+		return function::map([](T x) { return smath::radians(x); }, v);
 	}
 
 	/**
@@ -46,7 +46,7 @@ namespace smath {
 	 */
 	template<length_t L, class T>
 	SMATH_INLINE SMATH_CONSTEXPR vec<L, T> degrees(const vec<L, T> &v) {
-		return function::one<vec, L, T, T>::apply(degrees, v);
+		return function::map([](T x) { return smath::degrees(x); }, v);
 	}
 
 } // namespace smath
@@ -4,6 +4,7 @@
 #define QUALIFIER_H
 
 #include <cassert>
+#include <cstddef>
 #include <iostream>
 
 #include "../detail/setup.hpp"
@@ -26,6 +27,43 @@ namespace smath {
 	 */
 	template<length_t L, class T> struct vec;
 
+	namespace detail {
+
+		/**
+		 * Used to check if a vector is stored and operated on using SIMD registers.
+		 * @tparam L The length of the vector.
+		 * @tparam T The type of data stored in the vector.
+		 */
+		template<length_t L, class T>
+		struct is_simd {
+			static const bool value = false;
+		};
+
+#if SMATH_CONFIG_SIMD == SMATH_ENABLE
+		template<>
+		struct is_simd<4, float> {
+			static const bool value = true;
+		};
+
+		template<>
+		struct is_simd<4, double> {
+			static const bool value = true;
+		};
+#endif
+
+		/**
+		 * Used to get the alignment of the components of a vector, which is the
+		 * size of the whole vector when it is stored in a SIMD register.
+		 * @tparam L The length of the vector.
+		 * @tparam T The type of data stored in the vector.
+		 */
+		template<length_t L, class T>
+		struct storage_alignment {
+			static const std::size_t value = is_simd<L, T>::value ? sizeof(T) * L : alignof(T);
+		};
+
+	} // namespace detail
+
 } // namespace smath
 
 #endif // QUALIFIER_H
@@ -65,6 +65,7 @@ namespace smath {
 
 		// -- Unary arithmetic operators --
 
+		SMATH_CONSTEXPR vec<1, T>& operator=(const vec<1, T> &v) = default;
 		template<class A>
 		SMATH_CONSTEXPR vec<1, T>& operator=(const vec<1, A> &v);
 
@@ -95,6 +95,7 @@ namespace smath {
 
 		// -- Unary arithmetic operators --
 
+		SMATH_CONSTEXPR vec<2, T>& operator=(const vec<2, T> &v) = default;
 		template<class A>
 		SMATH_CONSTEXPR vec<2, T>& operator=(const vec<2, A> &v);
 
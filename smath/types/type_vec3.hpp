@@ -118,6 +118,7 @@ namespace smath {
 
 		// -- Unary arithmetic operators --
 
+		SMATH_CONSTEXPR vec<3, T>& operator=(const vec<3, T> &v) = default;
 		template<class A>
 		SMATH_CONSTEXPR vec<3, T>& operator=(const vec<3, A> &v);
 
@@ -12,7 +12,7 @@ namespace smath {
 
 		// -- Components --
 
-		T x;
+		alignas(detail::storage_alignment<4, T>::value) T x;
 		T y;
 		T z;
 		T w;
@@ -146,6 +146,7 @@ namespace smath {
 
 		// -- Unary arithmetic operators --
 
+		SMATH_CONSTEXPR vec<4, T>& operator=(const vec<4, T> &v) = default;
 		template<class A>
 		SMATH_CONSTEXPR vec<4, T>& operator=(const vec<4, A> &v);
 
@@ -4,6 +4,52 @@
 
 namespace smath {
 
+	namespace detail {
+
+		/**
+		 * @brief Template classes to compute the arithmetic operators on 4-component
+		 * vectors, specialized in type_vec4_simd.inl for vectors stored in SIMD
+		 * registers.
+		 * @tparam T The type of the vector (int, float, double)
+		 * @tparam Simd Whether the vector is stored in a SIMD register.
+		 */
+		template<class T, bool Simd>
+		struct compute_vec4_add {
+			SMATH_CONSTEXPR static vec<4, T> call(const vec<4, T> &a, const vec<4, T> &b) {
+				return vec<4, T>(a.x + b.x, a.y + b.y, a.z + b.z, a.w + b.w);
+			}
+		};
+
+		template<class T, bool Simd>
+		struct compute_vec4_sub {
+			SMATH_CONSTEXPR static vec<4, T> call(const vec<4, T> &a, const vec<4, T> &b) {
+				return vec<4, T>(a.x - b.x, a.y - b.y, a.z - b.z, a.w - b.w);
+			}
+		};
+
+		template<class T, bool Simd>
+		struct compute_vec4_mul {
+			SMATH_CONSTEXPR static vec<4, T> call(const vec<4, T> &a, const vec<4, T> &b) {
+				return vec<4, T>(a.x * b.x, a.y * b.y, a.z * b.z, a.w * b.w);
+			}
+		};
+
+		template<class T, bool Simd>
+		struct compute_vec4_div {
+			SMATH_CONSTEXPR static vec<4, T> call(const vec<4, T> &a, const vec<4, T> &b) {
+				return vec<4, T>(a.x / b.x, a.y / b.y, a.z / b.z, a.w / b.w);
+			}
+		};
+
+		template<class T, bool Simd>
+		struct compute_vec4_neg {
+			SMATH_CONSTEXPR static vec<4, T> call(const vec<4, T> &v) {
+				return vec<4, T>(-v.x, -v.y, -v.z, -v.w);
+			}
+		};
+
+	} // namespace detail
+
 	// -- Constructors --
 
 	template<class T>
@@ -139,81 +185,49 @@ namespace smath {
 	template<class T>
 	template<class A>
 	SMATH_CONSTEXPR vec<4, T>& vec<4, T>::operator+=(A scalar) {
-		this->x += static_cast<T>(scalar);
-		this->y += static_cast<T>(scalar);
-		this->z += static_cast<T>(scalar);
-		this->w += static_cast<T>(scalar);
-		return *this;
+		return (*this = detail::compute_vec4_add<T, detail::is_simd<4, T>::value>::call(*this, vec<4, T>(static_cast<T>(scalar))));
 	}
 
 	template<class T>
 	template<class A>
 	SMATH_CONSTEXPR vec<4, T>& vec<4, T>::operator+=(const vec<4, A> &v) {
-		this->x += static_cast<T>(v.x);
-		this->y += static_cast<T>(v.y);
-		this->z += static_cast<T>(v.z);
-		this->w += static_cast<T>(v.w);
-		return *this;
+		return (*this = detail::compute_vec4_add<T, detail::is_simd<4, T>::value>::call(*this, vec<4, T>(v)));
 	}
 
 	template<class T>
 	template<class A>
 	SMATH_CONSTEXPR vec<4, T>& vec<4, T>::operator-=(A scalar) {
-		this->x -= static_cast<T>(scalar);
-		this->y -= static_cast<T>(scalar);
-		this->z -= static_cast<T>(scalar);
-		this->w -= static_cast<T>(scalar);
-		return *this;
+		return (*this = detail::compute_vec4_sub<T, detail::is_simd<4, T>::value>::call(*this, vec<4, T>(static_cast<T>(scalar))));
 	}
 
 	template<class T>
 	template<class A>
 	SMATH_CONSTEXPR vec<4, T>& vec<4, T>::operator-=(const vec<4, A> &v) {
-		this->x -= static_cast<T>(v.x);
-		this->y -= static_cast<T>(v.y);
-		this->z -= static_cast<T>(v.z);
-		this->w -= static_cast<T>(v.w);
-		return *this;
+		return (*this = detail::compute_vec4_sub<T, detail::is_simd<4, T>::value>::call(*this, vec<4, T>(v)));
 	}
 
 	template<class T>
 	template<class A>
 	SMATH_CONSTEXPR vec<4, T>& vec<4, T>::operator*=(A scalar) {
-		this->x *= static_cast<T>(scalar);
-		this->y *= static_cast<T>(scalar);
-		this->z *= static_cast<T>(scalar);
-		this->w *= static_cast<T>(scalar);
-		return *this;
+		return (*this = detail::compute_vec4_mul<T, detail::is_simd<4, T>::value>::call(*this, vec<4, T>(static_cast<T>(scalar))));
 	}
 
 	template<class T>
 	template<class A>
 	SMATH_CONSTEXPR vec<4, T>& vec<4, T>::operator*=(const vec<4, A> &v) {
-		this->x *= static_cast<T>(v.x);
-		this->y *= static_cast<T>(v.y);
-		this->z *= static_cast<T>(v.z);
-		this->w *= static_cast<T>(v.w);
-		return *this;
+		return (*this = detail::compute_vec4_mul<T, detail::is_simd<4, T>::value>::call(*this, vec<4, T>(v)));
 	}
 
 	template<class T>
 	template<class A>
 	SMATH_CONSTEXPR vec<4, T>& vec<4, T>::operator/=(A scalar) {
-		this->x /= static_cast<T>(scalar);
-		this->y /= static_cast<T>(scalar);
-		this->z /= static_cast<T>(scalar);
-		this->w /= static_cast<T>(scalar);
-		return *this;
+		return (*this = detail::compute_vec4_div<T, detail::is_simd<4, T>::value>::call(*this, vec<4, T>(static_cast<T>(scalar))));
 	}
 
 	template<class T>
 	template<class A>
 	SMATH_CONSTEXPR vec<4, T>& vec<4, T>::operator/=(const vec<4, A> &v) {
-		this->x /= static_cast<T>(v.x);
-		this->y /= static_cast<T>(v.y);
-		this->z /= static_cast<T>(v.z);
-		this->w /= static_cast<T>(v.w);
-		return *this;
+		return (*this = detail::compute_vec4_div<T, detail::is_simd<4, T>::value>::call(*this, vec<4, T>(v)));
 	}
 
 	// -- Unary bit operators --
@@ -383,129 +397,69 @@ namespace smath {
 
 	template<class T>
 	SMATH_CONSTEXPR vec<4, T> operator-(const vec<4, T> &v) {
-		return vec<4, T>(-v.x, -v.y, -v.z, -v.w);
+		return detail::compute_vec4_neg<T, detail::is_simd<4, T>::value>::call(v);
 	}
 
 	// -- Binary arithmetic operators --
 
 	template<class T>
 	SMATH_CONSTEXPR vec<4, T> operator+(const vec<4, T> &v, T scalar) {
-		return vec<4, T>(
-			v.x + scalar,
-			v.y + scalar,
-			v.z + scalar,
-			v.w + scalar
-		);
+		return detail::compute_vec4_add<T, detail::is_simd<4, T>::value>::call(v, vec<4, T>(scalar));
 	}
 
 	template<class T>
 	SMATH_CONSTEXPR vec<4, T> operator+(T scalar, const vec<4, T> &v) {
-		return vec<4, T>(
-			scalar + v.x,
-			scalar + v.y,
-			scalar + v.z,
-			scalar + v.w
-		);
+		return detail::compute_vec4_add<T, detail::is_simd<4, T>::value>::call(vec<4, T>(scalar), v);
 	}
 
 	template<class T>
 	SMATH_CONSTEXPR vec<4, T> operator+(const vec<4, T> &v1, const vec<4, T> &v2) {
-		return vec<4, T>(
-			v1.x + v2.x,
-			v1.y + v2.y,
-			v1.z + v2.z,
-			v1.w + v2.w
-		);
+		return detail::compute_vec4_add<T, detail::is_simd<4, T>::value>::call(v1, v2);
 	}
 
 	template<class T>
 	SMATH_CONSTEXPR vec<4, T> operator-(const vec<4, T> &v, T scalar) {
-		return vec<4, T>(
-			v.x - scalar,
-			v.y - scalar,
-			v.z - scalar,
-			v.w - scalar
-		);
+		return detail::compute_vec4_sub<T, detail::is_simd<4, T>::value>::call(v, vec<4, T>(scalar));
 	}
 
 	template<class T>
 	SMATH_CONSTEXPR vec<4, T> operator-(T scalar, const vec<4, T> &v) {
-		return vec<4, T>(
-			scalar - v.x,
-			scalar - v.y,
-			scalar - v.z,
-			scalar - v.w
-		);
+		return detail::compute_vec4_sub<T, detail::is_simd<4, T>::value>::call(vec<4, T>(scalar), v);
 	}
 
 	template<class T>
 	SMATH_CONSTEXPR vec<4, T> operator-(const vec<4, T> &v1, const vec<4, T> &v2) {
-		return vec<4, T>(
-			v1.x - v2.x,
-			v1.y - v2.y,
-			v1.z - v2.z,
-			v1.w - v2.w
-		);
+		return detail::compute_vec4_sub<T, detail::is_simd<4, T>::value>::call(v1, v2);
 	}
 
 	template<class T>
 	SMATH_CONSTEXPR vec<4, T> operator*(const vec<4, T> &v, T scalar) {
-		return vec<4, T>(
-			v.x * scalar,
-			v.y * scalar,
-			v.z * scalar,
-			v.w * scalar
-		);
+		return detail::compute_vec4_mul<T, detail::is_simd<4, T>::value>::call(v, vec<4, T>(scalar));
 	}
 
 	template<class T>
 	SMATH_CONSTEXPR vec<4, T> operator*(T scalar, const vec<4, T> &v) {
-		return vec<4, T>(
-			scalar * v.x,
-			scalar * v.y,
-			scalar * v.z,
-			scalar * v.w
-		);
+		return detail::compute_vec4_mul<T, detail::is_simd<4, T>::value>::call(vec<4, T>(scalar), v);
 	}
 
 	template<class T>
 	SMATH_CONSTEXPR vec<4, T> operator*(const vec<4, T> &v1, const vec<4, T> &v2) {
-		return vec<4, T>(
-			v1.x * v2.x,
-			v1.y * v2.y,
-			v1.z * v2.z,
-			v1.w * v2.w
-		);
+		return detail::compute_vec4_mul<T, detail::is_simd<4, T>::value>::call(v1, v2);
 	}
 
 	template<class T>
 	SMATH_CONSTEXPR vec<4, T> operator/(const vec<4, T> &v, T scalar) {
-		return vec<4, T>(
-			v.x / scalar,
-			v.y / scalar,
-			v.z / scalar,
-			v.w / scalar
-		);
+		return detail::compute_vec4_div<T, detail::is_simd<4, T>::value>::call(v, vec<4, T>(scalar));
 	}
 
 	template<class T>
 	SMATH_CONSTEXPR vec<4, T> operator/(T scalar, const vec<4, T> &v) {
-		return vec<4, T>(
-			scalar / v.x,
-			scalar / v.y,
-			scalar / v.z,
-			scalar / v.w
-		);
+		return detail::compute_vec4_div<T, detail::is_simd<4, T>::value>::call(vec<4, T>(scalar), v);
 	}
 
 	template<class T>
 	SMATH_CONSTEXPR vec<4, T> operator/(const vec<4, T> &v1, const vec<4, T> &v2) {
-		return vec<4, T>(
-			v1.x / v2.x,
-			v1.y / v2.y,
-			v1.z / v2.z,
-			v1.w / v2.w
-		);
+		return detail::compute_vec4_div<T, detail::is_simd<4, T>::value>::call(v1, v2);
 	}
 
 	template<class T>
@@ -735,3 +689,7 @@ namespace smath {
 	}
 
 } // namespace smath
+
+#if SMATH_CONFIG_SIMD == SMATH_ENABLE
+#	include "type_vec4_simd.inl"
+#endif
@@ -0,0 +1,132 @@
+/**
+ * SIMD implementation of the type_vec4.hpp arithmetic operators for vec<4, float>
+ * and vec<4, double>, enabled by defining SMATH_FORCE_INTRINSICS.
+ */
+
+#include "../simd/simd.hpp"
+
+namespace smath {
+
+	namespace detail {
+
+		// -- Loads and stores --
+
+		template<class T>
+		SMATH_INLINE simd::batch<T, 4> vec4_load(const vec<4, T> &v) {
+			return simd::batch<T, 4>::load(&v.x);
+		}
+
+		template<class T>
+		SMATH_INLINE vec<4, T> vec4_store(const simd::batch<T, 4> &r) {
+			vec<4, T> result;
+			r.store(&result.x);
+			return result;
+		}
+
+		// -- Single-precision --
+
+		template<>
+		struct compute_vec4_add<float, true> {
+			SMATH_CONSTEXPR static vec<4, float> call(const vec<4, float> &a, const vec<4, float> &b) {
+				if (SMATH_IS_CONSTANT_EVALUATED()) {
+					return compute_vec4_add<float, false>::call(a, b);
+				}
+				return vec4_store(vec4_load(a) + vec4_load(b));
+			}
+		};
+
+		template<>
+		struct compute_vec4_sub<float, true> {
+			SMATH_CONSTEXPR static vec<4, float> call(const vec<4, float> &a, const vec<4, float> &b) {
+				if (SMATH_IS_CONSTANT_EVALUATED()) {
+					return compute_vec4_sub<float, false>::call(a, b);
+				}
+				return vec4_store(vec4_load(a) - vec4_load(b));
+			}
+		};
+
+		template<>
+		struct compute_vec4_mul<float, true> {
+			SMATH_CONSTEXPR static vec<4, float> call(const vec<4, float> &a, const vec<4, float> &b) {
+				if (SMATH_IS_CONSTANT_EVALUATED()) {
+					return compute_vec4_mul<float, false>::call(a, b);
+				}
+				return vec4_store(vec4_load(a) * vec4_load(b));
+			}
+		};
+
+		template<>
+		struct compute_vec4_div<float, true> {
+			SMATH_CONSTEXPR static vec<4, float> call(const vec<4, float> &a, const vec<4, float> &b) {
+				if (SMATH_IS_CONSTANT_EVALUATED()) {
+					return compute_vec4_div<float, false>::call(a, b);
+				}
+				return vec4_store(vec4_load(a) / vec4_load(b));
+			}
+		};
+
+		template<>
+		struct compute_vec4_neg<float, true> {
+			SMATH_CONSTEXPR static vec<4, float> call(const vec<4, float> &v) {
+				if (SMATH_IS_CONSTANT_EVALUATED()) {
+					return compute_vec4_neg<float, false>::call(v);
+				}
+				return vec4_store(-vec4_load(v));
+			}
+		};
+
+		// -- Double-precision --
+
+		template<>
+		struct compute_vec4_add<double, true> {
+			SMATH_CONSTEXPR static vec<4, double> call(const vec<4, double> &a, const vec<4, double> &b) {
+				if (SMATH_IS_CONSTANT_EVALUATED()) {
+					return compute_vec4_add<double, false>::call(a, b);
+				}
+				return vec4_store(vec4_load(a) + vec4_load(b));
+			}
+		};
+
+		template<>
+		struct compute_vec4_sub<double, true> {
+			SMATH_CONSTEXPR static vec<4, double> call(const vec<4, double> &a, const vec<4, double> &b) {
+				if (SMATH_IS_CONSTANT_EVALUATED()) {
+					return compute_vec4_sub<double, false>::call(a, b);
+				}
+				return vec4_store(vec4_load(a) - vec4_load(b));
+			}
+		};
+
+		template<>
+		struct compute_vec4_mul<double, true> {
+			SMATH_CONSTEXPR static vec<4, double> call(const vec<4, double> &a, const vec<4, double> &b) {
+				if (SMATH_IS_CONSTANT_EVALUATED()) {
+					return compute_vec4_mul<double, false>::call(a, b);
+				}
+				return vec4_store(vec4_load(a) * vec4_load(b));
+			}
+		};
+
+		template<>
+		struct compute_vec4_div<double, true> {
+			SMATH_CONSTEXPR static vec<4, double> call(const vec<4, double> &a, const vec<4, double> &b) {
+				if (SMATH_IS_CONSTANT_EVALUATED()) {
+					return compute_vec4_div<double, false>::call(a, b);
+				}
+				return vec4_store(vec4_load(a) / vec4_load(b));
+			}
+		};
+
+		template<>
+		struct compute_vec4_neg<double, true> {
+			SMATH_CONSTEXPR static vec<4, double> call(const vec<4, double> &v) {
+				if (SMATH_IS_CONSTANT_EVALUATED()) {
+					return compute_vec4_neg<double, false>::call(v);
+				}
+				return vec4_store(-vec4_load(v));
+			}
+		};
+
+	} // namespace detail
+
+} // namespace smath
@@ -0,0 +1,162 @@
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+// the configuration every user gets: no SMATH_FORCE_INTRINSICS, so vec4 is
+// stored and operated on like the other vectors. It changes the layout of
+// vec4, which is why these tests are a separate executable from test/main.cpp
+#include "smath/smath.hpp"
+
+/**
+ * Test the vec4 operators of the default configuration
+ */
+void test_vec4_default() {
+	std::cout << "\033[32m-- smath::vec4 (default) --\033[0m\n";
+	using v4 = smath::vec4;
+	using v4d = smath::vec4d;
+
+	SMATH_STATIC_ASSERT(!(smath::detail::is_simd<4, float>::value) && !(smath::detail::is_simd<4, double>::value), "Failed default vec4 storage");
+	SMATH_STATIC_ASSERT((v4{ 1.5f, 2.5f, -3.f, 4.f } * 2.f - v4{ 1.f } == v4{ 2.f, 4.f, -7.f, 7.f }), "Failed constexpr vec4f arithmetic");
+
+	v4 a{ 1.5f, 2.5f, -3.f, 4.f };
+	const v4 b{ 2.f, 0.5f, 1.f, -8.f };
+	assert((a + b == v4{ 3.5f, 3.f, -2.f, -4.f }) && "Failed vec4f addition with vec4f");
+	assert((a / b == v4{ 0.75f, 5.f, -3.f, -0.5f }) && "Failed vec4f division with vec4f");
+	assert((1.f / b == v4{ 0.5f, 2.f, 1.f, -0.125f }) && "Failed scalar division with vec4f");
+	assert((-a == v4{ -1.5f, -2.5f, 3.f, -4.f }) && "Failed vec4f negation");
+	a += b;
+	a *= 2.f;
+	assert((a == v4{ 7.f, 6.f, -4.f, -8.f }) && "Failed vec4f compound assignment");
+
+	v4d c{ 1.5, 2.5, -3.0, 4.0 };
+	c -= 1.0;
+	c /= v4d{ 2.0, 0.5, 1.0, -8.0 };
+	assert((c == v4d{ 0.25, 3.0, -4.0, -0.375 }) && "Failed vec4d compound assignment");
+
+	std::cout << "Passed\n\n";
+}
+
+/**
+ * Test the geometric functions of the default configuration
+ */
+void test_geometric_default() {
+	std::cout << "\033[32m-- smath::geometric (default) --\033[0m\n";
+	using v3 = smath::vec3;
+	using v4 = smath::vec4;
+
+	SMATH_STATIC_ASSERT(smath::dot(v4{ 1.f, 2.f, 3.f, 4.f }, v4{ 5.f, 6.f, 7.f, 8.f }) == 70.f, "Failed vec4f dot");
+	SMATH_STATIC_ASSERT((smath::cross(v3{ 1.f, 2.f, 3.f }, v3{ 4.f, 5.f, 6.f }) == v3{ -3.f, 6.f, -3.f }), "Failed vec3f cross");
+
+	// the same summation order as the SIMD vectors
+	const v4 a{ 1e8f, 1.f, -1e8f, 3.f };
+	const v4 b{ 1.f, 0.1f, 1.f, 0.7f };
+	assert(smath::dot(a, b) == (a.x * b.x + a.z * b.z) + (a.y * b.y + a.w * b.w) && "Failed vec4f dot summation order");
+
+	assert(smath::length(v4{ 2.f, 4.f, 4.f, 0.f }) == 6.f && "Failed vec4f length");
+	assert(smath::distance(v3{ 1.f, 1.f, 1.f }, v3{ 3.f, 5.f, 5.f }) == 6.f && "Failed vec3f distance");
+	const v4 n{ smath::normalize(v4{ 2.f, 4.f, 4.f, 0.f }) };
+	assert(std::fabs(smath::length(n) - 1.f) < 1e-5f && std::fabs(n.y - 4.f / 6.f) < 1e-5f && "Failed vec4f normalize");
+	const smath::vec4d m{ smath::normalize(smath::vec4d{ 0.0, 3.0, 4.0, 0.0 }, smath::accuracy::fast) };
+	assert(std::fabs(m.z - 0.8) < 0.8 * smath::fast_t::max_error<double>() && "Failed vec4d normalize");
+
+	std::cout << "Passed\n\n";
+}
+
+/**
+ * Test the common math functions of the default configuration, which must
+ * give the same results as the scalar functions for each component
+ */
+void test_math_default() {
+	std::cout << "\033[32m-- smath::math (default) --\033[0m\n";
+	using v4 = smath::vec4;
+
+	const float nan{ std::numeric_limits<float>::quiet_NaN() };
+	const v4 x{ -1.5f, 0.25f, 2.5f, -0.f };
+	assert((smath::abs(x) == v4{ 1.5f, 0.25f, 2.5f, 0.f }) && "Failed abs vec4");
+	assert((smath::floor(x) == v4{ -2.f, 0.f, 2.f, -0.f }) && (smath::ceil(x) == v4{ -1.f, 1.f, 3.f, 0.f }) && "Failed floor/ceil vec4");
+	assert((smath::round(x) == v4{ -2.f, 0.f, 3.f, 0.f }) && (smath::trunc(x) == v4{ -1.f, 0.f, 2.f, 0.f }) && "Failed round/trunc vec4");
+	assert(smath::fract(v4{ -1e-9f })[0] < 1.f && (smath::fract(x) == v4{ 0.5f, 0.25f, 0.5f, 0.f }) && "Failed fract vec4");
+	assert(smath::min_component(x) == -1.5f && smath::max_component(x) == 2.5f && "Failed min/max_component vec4");
+	assert((smath::fma(x, v4{ 2.f }, v4{ 1.f }) == v4{ -2.f, 1.5f, 6.f, 1.f }) && "Failed fma vec4");
+	assert((smath::mix(v4{ 0.f }, v4{ 4.f }, 0.25f) == v4{ 1.f }) && "Failed mix vec4");
+
+	// NaN and -0 are clamped like the scalar clamp
+	const v4 c{ smath::clamp(v4{ nan, -0.f, 0.5f, 2.f }, 0.f, 1.f) };
+	assert(c.x == smath::clamp(nan, 0.f, 1.f) && std::signbit(c.y) && c.z == 0.5f && c.w == 1.f && "Failed clamp vec4 NaN and -0");
+	const v4 s{ smath::smoothstep(0.f, 2.f, v4{ -1.f, 1.f, 3.f, nan }) };
+	assert(s.x == 0.f && s.y == 0.5f && s.z == 1.f && s.w == smath::smoothstep(0.f, 2.f, nan) && "Failed smoothstep vec4");
+
+	std::cout << "Passed\n\n";
+}
+
+/**
+ * Test the exponential functions of the default configuration against the
+ * standard library, within the bound of each accuracy
+ */
+void test_exponential_default() {
+	std::cout << "\033[32m-- smath::exponential (default) --\033[0m\n";
+
+	const smath::accuracy tiers[3]{ smath::accuracy::fast, smath::accuracy::balanced, smath::accuracy::precise };
+	const double bounds[3]{ 5e-4, 2.0 * std::numeric_limits<float>::epsilon(), std::numeric_limits<float>::epsilon() };
+	const auto near = [](double a, double b, double bound) {
+		return a == b || std::fabs(a - b) <= bound * std::fabs(b);
+	};
+
+	const smath::vec4 x{ 0.3f, 1.7f, 12.f, 0.02f };
+	const smath::vec3 y{ -1.5f, 0.5f, 2.25f };
+	for (int t = 0; t < 3; ++t) {
+		const smath::vec4 e{ smath::exp(x, tiers[t]) };
+		const smath::vec4 e2{ smath::exp2(x, tiers[t]) };
+		const smath::vec4 em{ smath::expm1(x, tiers[t]) };
+		const smath::vec4 l{ smath::log(x, tiers[t]) };
+		const smath::vec4 l2{ smath::log2(x, tiers[t]) };
+		const smath::vec4 l10{ smath::log10(x, tiers[t]) };
+		const smath::vec4 l1p{ smath::log1p(x, tiers[t]) };
+		const smath::vec4 r{ smath::inv_sqrt(x, tiers[t]) };
+		const smath::vec4 q{ smath::sqrt(x, tiers[t]) };
+		for (smath::length_t i = 0; i < 4; ++i) {
+			const double v{ x[i] };
+			assert(near(e[i], std::exp(v), bounds[t]) && near(e2[i], std::exp2(v), bounds[t]) && near(em[i], std::expm1(v), bounds[t]) && "Failed exp vec4");
+			assert(near(l[i], std::log(v), bounds[t]) && near(l2[i], std::log2(v), bounds[t]) && "Failed log/log2 vec4");
+			assert(near(l10[i], std::log10(v), bounds[t]) && near(l1p[i], std::log1p(v), bounds[t]) && "Failed log10/log1p vec4");
+			assert(near(r[i], 1.0 / std::sqrt(v), bounds[t]) && near(q[i], std::sqrt(v), bounds[t]) && "Failed sqrt/inv_sqrt vec4");
+		}
+
+		const smath::vec3 p{ smath::pow(smath::vec3{ 2.f, 0.7f, 9.f }, y, tiers[t]) };
+		const smath::vec2 l3{ smath::log(smath::vec2{ 3.f, 1e-30f }, tiers[t]) };
+		const smath::vec2d e3{ smath::exp(smath::vec2d{ -3.0, 40.0 }, tiers[t]) };
+		for (smath::length_t i = 0; i < 3; ++i) {
+			assert(near(p[i], std::pow(static_cast<double>(smath::vec3{ 2.f, 0.7f, 9.f }[i]), static_cast<double>(y[i])), bounds[t]) && "Failed pow vec3");
+		}
+		assert(near(l3.x, std::log(3.0), bounds[t]) && near(l3.y, std::log(static_cast<double>(1e-30f)), bounds[t]) && "Failed log vec2");
+		// vec2d is padded into a batch of doubles, with the bounds of doubles
+		const double bound_d{ t == 0 ? 5e-4 : 2.0 * std::numeric_limits<double>::epsilon() };
+		assert(near(e3.x, std::exp(-3.0), bound_d) && near(e3.y, std::exp(40.0), bound_d) && "Failed exp vec2d");
+	}
+
+	// special values pass through like the standard library
+	const float inf{ std::numeric_limits<float>::infinity() };
+	const smath::vec4 s{ smath::log(smath::vec4{ 0.f, -1.f, inf, 1.f }) };
+	assert(s.x == -inf && std::isnan(s.y) && s.z == inf && s.w == 0.f && "Failed log vec4 special values");
+	const smath::vec3 z{ smath::exp(smath::vec3{ -inf, inf, 0.f }) };
+	assert(z.x == 0.f && z.y == inf && z.z == 1.f && "Failed exp vec3 special values");
+
+	std::cout << "Passed\n\n";
+}
+
+/**
+ * Main function for testing the default configuration
+ */
+int main() {
+
+	std::cout << '\n';
+
+	test_vec4_default();
+	test_geometric_default();
+	test_math_default();
+	test_exponential_default();
+
+	return 0;
+}
@@ -1,7 +1,21 @@
+#include <atomic>
 #include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <functional>
 #include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
 
+#define SMATH_FORCE_INTRINSICS
+#define SMATH_FORCE_EXPRESSIONS
 #include "smath/smath.hpp"
+#include "smath/simd/simd.hpp"
+
+// defined in soa_eager.cpp, which includes smath without the expressions
+void test_soa_eager();
 
 /**
  * Test the smath::max function against std::max
@@ -66,6 +80,9 @@ void test_sqrt() {
 	assert(smath::sqrt(smath::vec3(4.0, 16.0, 12.0)) == smath::vec3(std::sqrt(4.0), std::sqrt(16.0), std::sqrt(12.0)) && "Failed sqrt of vec3(4.0,16.0,12.0)");
 	assert(smath::sqrt(smath::vec3(4.0f, 16.0f, 12.0f)) == smath::vec3(std::sqrt(4.0f), std::sqrt(16.0f), std::sqrt(12.0f)) && "Failed sqrt of vec3(4.0f,16.0f,12.0f)");
 
+	assert(smath::sqrt(smath::vec4(4.0f, 16.0f, 12.0f, 1.0f)) == smath::vec4(std::sqrt(4.0f), std::sqrt(16.0f), std::sqrt(12.0f), 1.0f) && "Failed sqrt of vec4(4.0f,16.0f,12.0f,1.0f)");
+	assert(smath::log(smath::vec4d(1.0, 2.0, 4.0, 8.0)) == smath::vec4d(0.0, std::log(2.0), std::log(4.0), std::log(8.0)) && "Failed log of vec4d(1.0,2.0,4.0,8.0)");
+
 	std::cout << "Passed\n\n";
 }
 
@@ -97,6 +114,10 @@ void test_floor() {
 	assert(smath::floor(2.7) == std::floor(2.7) && "Failed floor(2.7)");
 	assert(smath::floor(3) == std::floor(3) && "Failed floor(3)");
 
+	assert(smath::floor(smath::vec4(-1.2f, 1.2f, 2.7f, 3.f)) == smath::vec4(-2.f, 1.f, 2.f, 3.f) && "Failed floor of vec4");
+	assert(smath::round(smath::vec4d(-1.5, 1.2, 2.5, 3.0)) == smath::vec4d(-2.0, 1.0, 3.0, 3.0) && "Failed round of vec4d");
+	assert(smath::abs(smath::vec4i(-1, 2, -3, 0)) == smath::vec4i(1, 2, 3, 0) && "Failed abs of vec4i");
+
 	std::cout << "Passed\n\n";
 }
 
@@ -112,6 +133,8 @@ void test_ceil() {
 	assert(smath::ceil(2.7) == std::ceil(2.7) && "Failed ceil(2.7)");
 	assert(smath::ceil(3) == std::ceil(3) && "Failed ceil(3)");
 
+	assert(smath::ceil(smath::vec4(-1.2f, 1.2f, 2.7f, 3.f)) == smath::vec4(-1.f, 2.f, 3.f, 3.f) && "Failed ceil of vec4");
+
 	std::cout << "Passed\n\n";
 }
 
@@ -129,6 +152,7 @@ void test_convert_radians_degrees() {
 
 	SMATH_STATIC_ASSERT(smath::degrees(smath::radians(smath::vec1(180.f))) == smath::vec1(smath::degrees(smath::radians(180.f))), "Failed degrees(vec1)");
 	SMATH_STATIC_ASSERT(smath::degrees(smath::radians(smath::vec1(90.f))) == smath::vec1(smath::degrees(smath::radians(90.f))), "Failed degrees(vec1)");
+	SMATH_STATIC_ASSERT(smath::degrees(smath::radians(smath::vec4(0.f, 45.f, 90.f, 180.f))) == smath::vec4(0.f, 45.f, 90.f, 180.f), "Failed degrees(vec4)");
 
 	std::cout << "Passed\n\n";
 }
@@ -345,6 +369,1576 @@ void test_vec4() {
 	std::cout << "Passed\n\n";
 }
 
+/**
+ * Test the SIMD arithmetic of 4-component vectors outside of constant expressions.
+ */
+void test_vec4_simd() {
+	std::cout << "\033[32m-- smath::vec4 (SIMD) --\033[0m\n";
+	using v4 = smath::vec4;
+	using v4d = smath::vec4d;
+
+	v4 a{ 1.5f, 2.5f, -3.f, 4.f };
+	v4 b{ 2.f, 0.5f, 1.f, -8.f };
+
+	assert((a + b == v4{ 3.5f, 3.f, -2.f, -4.f }) && "Failed vec4f addition with vec4f");
+	assert((a - b == v4{ -0.5f, 2.f, -4.f, 12.f }) && "Failed vec4f subtraction with vec4f");
+	assert((a * b == v4{ 3.f, 1.25f, -3.f, -32.f }) && "Failed vec4f multiplication with vec4f");
+	assert((a / b == v4{ 0.75f, 5.f, -3.f, -0.5f }) && "Failed vec4f division with vec4f");
+	assert((2.f * a == v4{ 3.f, 5.f, -6.f, 8.f }) && "Failed scalar multiplication with vec4f");
+	assert((1.f / b == v4{ 0.5f, 2.f, 1.f, -0.125f }) && "Failed scalar division with vec4f");
+	assert((-a == v4{ -1.5f, -2.5f, 3.f, -4.f }) && "Failed vec4f negation");
+
+	a += b;
+	a *= 2.f;
+	assert((a == v4{ 7.f, 6.f, -4.f, -8.f }) && "Failed vec4f compound assignment");
+
+	v4d c{ 1.5, 2.5, -3.0, 4.0 };
+	v4d d{ 2.0, 0.5, 1.0, -8.0 };
+
+	assert((c + d == v4d{ 3.5, 3.0, -2.0, -4.0 }) && "Failed vec4d addition with vec4d");
+	assert((c - d == v4d{ -0.5, 2.0, -4.0, 12.0 }) && "Failed vec4d subtraction with vec4d");
+	assert((c * d == v4d{ 3.0, 1.25, -3.0, -32.0 }) && "Failed vec4d multiplication with vec4d");
+	assert((c / d == v4d{ 0.75, 5.0, -3.0, -0.5 }) && "Failed vec4d division with vec4d");
+	assert((-c == v4d{ -1.5, -2.5, 3.0, -4.0 }) && "Failed vec4d negation");
+
+	c -= 1.0;
+	c /= d;
+	assert((c == v4d{ 0.25, 3.0, -4.0, -0.375 }) && "Failed vec4d compound assignment");
+
+	std::cout << "Passed\n\n";
+}
+
+/**
+ * Check a SIMD batch lane by lane against the equivalent scalar operations.
+ */
+template<class B>
+void check_batch() {
+	using T = typename B::value_type;
+	const smath::length_t n{ B::size() };
+
+	alignas(64) T in_a[16];
+	alignas(64) T in_b[16];
+	alignas(64) T out[16];
+	for (smath::length_t i = 0; i < n; ++i) {
+		in_a[i] = static_cast<T>(3 * i - 7);
+		in_b[i] = static_cast<T>((i % 3) + 1);
+	}
+
+	const B a{ B::load(in_a) };
+	const B b{ B::loadu(in_b) };
+
+	(a + b).store(out);
+	for (smath::length_t i = 0; i < n; ++i) assert(out[i] == in_a[i] + in_b[i] && "Failed batch addition");
+	(a - b).store(out);
+	for (smath::length_t i = 0; i < n; ++i) assert(out[i] == in_a[i] - in_b[i] && "Failed batch subtraction");
+	(a * b).storeu(out);
+	for (smath::length_t i = 0; i < n; ++i) assert(out[i] == in_a[i] * in_b[i] && "Failed batch multiplication");
+	(-a).store(out);
+	for (smath::length_t i = 0; i < n; ++i) assert(out[i] == -in_a[i] && "Failed batch negation");
+	abs(a).store(out);
+	for (smath::length_t i = 0; i < n; ++i) assert(out[i] == (in_a[i] < 0 ? -in_a[i] : in_a[i]) && "Failed batch abs");
+	min(a, b).store(out);
+	for (smath::length_t i = 0; i < n; ++i) assert(out[i] == (in_a[i] < in_b[i] ? in_a[i] : in_b[i]) && "Failed batch min");
+	max(a, b).store(out);
+	for (smath::length_t i = 0; i < n; ++i) assert(out[i] == (in_a[i] > in_b[i] ? in_a[i] : in_b[i]) && "Failed batch max");
+
+	const typename B::mask_type lt{ a < b };
+	select(lt, a, B(T(0))).store(out);
+	int expected{ 0 };
+	for (smath::length_t i = 0; i < n; ++i) {
+		assert(lt[i] == (in_a[i] < in_b[i]) && "Failed batch comparison");
+		assert(out[i] == (in_a[i] < in_b[i] ? in_a[i] : T(0)) && "Failed batch select");
+		expected |= (in_a[i] < in_b[i]) ? (1 << i) : 0;
+	}
+	assert(bits(lt) == expected && any(lt) == (expected != 0) && "Failed batch mask bits");
+	assert(all(a == a) && none(a != a) && "Failed batch mask equality");
+	assert(bits(B::mask_type::from_bits(expected)) == expected && "Failed batch mask from_bits");
+
+	T sum{ 0 };
+	for (smath::length_t i = 0; i < n; ++i) sum += in_a[i];
+	assert(reduce_add(a) == sum && "Failed batch reduce_add");
+	assert(reduce_min(a) == in_a[0] && "Failed batch reduce_min");
+	assert(reduce_max(a) == in_a[n - 1] && "Failed batch reduce_max");
+}
+
+/**
+ * Check the floating-point only operations of a SIMD batch.
+ */
+template<class B>
+void check_batch_float() {
+	using T = typename B::value_type;
+	const smath::length_t n{ B::size() };
+
+	alignas(64) T in[16];
+	alignas(64) T out[16];
+	for (smath::length_t i = 0; i < n; ++i) {
+		in[i] = static_cast<T>(i * i + 1);
+	}
+
+	const B a{ B::load(in) };
+
+	(a / B(T(2))).store(out);
+	for (smath::length_t i = 0; i < n; ++i) assert(out[i] == in[i] / T(2) && "Failed batch division");
+	sqrt(a * a).store(out);
+	for (smath::length_t i = 0; i < n; ++i) assert(out[i] == in[i] && "Failed batch sqrt");
+	fma(a, a, B(T(-1))).store(out);
+	for (smath::length_t i = 0; i < n; ++i) assert(out[i] == std::fma(in[i], in[i], T(-1)) && "Failed batch fma");
+	assert(a[n - 1] == in[n - 1] && "Failed batch access");
+}
+
+/**
+ * Test every width of the internal SIMD layer against scalar results.
+ */
+void test_simd() {
+	std::cout << "\033[32m-- smath::simd --\033[0m\n";
+	using namespace smath::simd;
+
+	check_batch<f32x4>();
+	check_batch<f32x8>();
+	check_batch<f32x16>();
+	check_batch<f64x2>();
+	check_batch<f64x4>();
+	check_batch<f64x8>();
+	check_batch<i32x4>();
+	check_batch<i32x8>();
+	check_batch<i32x16>();
+
+	check_batch_float<f32x4>();
+	check_batch_float<f32x8>();
+	check_batch_float<f32x16>();
+	check_batch_float<f64x2>();
+	check_batch_float<f64x4>();
+	check_batch_float<f64x8>();
+
+	assert(((i32x4(1) << 4)[0] == 16 && (i32x4(-16) >> 2)[3] == -4) && "Failed batch shifts");
+	assert((native<float>::size() >= 4 && native<double>::size() >= 2) && "Failed native batch width");
+
+	std::cout << "Passed\n\n";
+}
+
+/**
+ * Test the runtime CPU detection and every batch kernel the host supports.
+ */
+void test_batch() {
+	std::cout << "\033[32m-- smath::batch --\033[0m\n";
+	namespace detail = smath::batch::detail;
+
+	const smath::cpu_info &cpu{ smath::cpu_features() };
+	assert(&cpu == &smath::cpu_features() && "Failed cached cpu_features");
+	assert((!cpu.avx2 || cpu.avx) && (!cpu.fma || cpu.avx) && "Failed cpu_features implications");
+
+	float a[37];
+	float b[37];
+	float out[37];
+	for (int i = 0; i < 37; ++i) {
+		a[i] = static_cast<float>(i) * 0.5f;
+		b[i] = static_cast<float>(i % 5 + 1);
+	}
+
+	smath::batch::add(a, b, out, 37);
+	for (int i = 0; i < 37; ++i) assert(out[i] == a[i] + b[i] && "Failed batch::add");
+	smath::batch::sub(a, b, out, 37);
+	for (int i = 0; i < 37; ++i) assert(out[i] == a[i] - b[i] && "Failed batch::sub");
+	smath::batch::mul(a, b, out, 37);
+	for (int i = 0; i < 37; ++i) assert(out[i] == a[i] * b[i] && "Failed batch::mul");
+	smath::batch::div(a, b, out, 37);
+	for (int i = 0; i < 37; ++i) assert(out[i] == a[i] / b[i] && "Failed batch::div");
+
+	double c[19];
+	double d[19];
+	double outd[19];
+	for (int i = 0; i < 19; ++i) {
+		c[i] = static_cast<double>(i) * 1.25;
+		d[i] = static_cast<double>(i % 3 + 1);
+	}
+
+	smath::batch::div(c, d, outd, 19);
+	for (int i = 0; i < 19; ++i) assert(outd[i] == c[i] / d[i] && "Failed batch::div (double)");
+
+	std::vector<detail::binary_kernel<double>> kernels{ &detail::kernel_scalar<detail::op_mul, double> };
+#if SMATH_HAS_CPU_DISPATCH
+	if (cpu.sse2) kernels.insert(kernels.end(), { &detail::kernel_sse2<detail::op_mul, false>, &detail::kernel_sse2<detail::op_mul, true> });
+	if (cpu.avx2) kernels.insert(kernels.end(), { &detail::kernel_avx2<detail::op_mul, false>, &detail::kernel_avx2<detail::op_mul, true> });
+	if (cpu.avx512f) kernels.insert(kernels.end(), { &detail::kernel_avx512<detail::op_mul, false>, &detail::kernel_avx512<detail::op_mul, true> });
+#endif
+	for (const auto &kernel : kernels) {
+		kernel(c, d, outd, 19);
+		for (int i = 0; i < 19; ++i) assert(outd[i] == c[i] * d[i] && "Failed batch kernel");
+	}
+
+	// streaming stores into an output that is not aligned to the register
+	float stream_out[38];
+	smath::batch::add(a, b, stream_out + 1, 37, smath::batch::store_mode::streaming);
+	for (int i = 0; i < 37; ++i) assert(stream_out[i + 1] == a[i] + b[i] && "Failed batch::add (streaming)");
+
+	std::vector<smath::vec4> va(9, smath::vec4{ 1.f, 2.f, 3.f, 4.f });
+	std::vector<smath::vec4> vb(9, smath::vec4{ 0.5f });
+	std::vector<smath::vec4> vout(9);
+	smath::batch::mul(va.data(), vb.data(), vout.data(), va.size(), smath::batch::store_mode::streaming);
+	assert((vout[8] == smath::vec4{ 0.5f, 1.f, 1.5f, 2.f }) && "Failed batch::mul (vec4)");
+
+	std::cout << "Passed\n\n";
+}
+
+/**
+ * Test the component-wise comparisons and selection of vectors.
+ */
+void test_relational() {
+	std::cout << "\033[32m-- smath::relational --\033[0m\n";
+	using v3i = smath::vec3i;
+	using v4 = smath::vec4;
+	using v4d = smath::vec4d;
+	using v4b = smath::vec4b;
+
+	SMATH_STATIC_ASSERT((smath::less_than(v3i{ 1, 5, 3 }, v3i{ 2, 2, 3 }) == smath::vec3b{ true, false, false }), "Failed vec3i less_than");
+	SMATH_STATIC_ASSERT((smath::greater_than_equal(v3i{ 1, 5, 3 }, v3i{ 2, 2, 3 }) == smath::vec3b{ false, true, true }), "Failed vec3i greater_than_equal");
+	SMATH_STATIC_ASSERT((smath::not_equal(smath::vec2i{ 1, 5 }, smath::vec2i{ 1, 2 }) == smath::vec2b{ false, true }), "Failed vec2i not_equal");
+	SMATH_STATIC_ASSERT((smath::select(v4b{ true, false, true, false }, v4{ 1.f }, v4{ 2.f }) == v4{ 1.f, 2.f, 1.f, 2.f }), "Failed vec4f select");
+	SMATH_STATIC_ASSERT(smath::any(smath::vec2b{ false, true }) && !smath::all(smath::vec2b{ false, true }), "Failed vec2b any/all");
+	SMATH_STATIC_ASSERT(smath::none(smath::vec1b{ false }) && smath::all(smath::vec1b{ true }), "Failed vec1b none/all");
+
+	const v4 a{ 1.f, 5.f, -3.f, 2.f };
+	const v4 b{ 2.f, 2.f, -3.f, 8.f };
+
+	assert((smath::less_than(a, b) == v4b{ true, false, false, true }) && "Failed vec4f less_than");
+	assert((smath::less_than_equal(a, b) == v4b{ true, false, true, true }) && "Failed vec4f less_than_equal");
+	assert((smath::greater_than(a, b) == v4b{ false, true, false, false }) && "Failed vec4f greater_than");
+	assert((smath::greater_than_equal(a, b) == v4b{ false, true, true, false }) && "Failed vec4f greater_than_equal");
+	assert((smath::equal(a, b) == v4b{ false, false, true, false }) && "Failed vec4f equal");
+	assert((smath::not_equal(a, b) == v4b{ true, true, false, true }) && "Failed vec4f not_equal");
+	assert((smath::select(smath::less_than(a, b), a, b) == v4{ 1.f, 2.f, -3.f, 2.f }) && "Failed vec4f select");
+
+	const v4d c{ 1.0, 5.0, -3.0, 2.0 };
+	const v4d d{ 2.0, 2.0, -3.0, 8.0 };
+
+	assert((smath::greater_than(c, d) == v4b{ false, true, false, false }) && "Failed vec4d greater_than");
+	assert((smath::select(smath::greater_than(c, d), c, d) == v4d{ 2.0, 5.0, -3.0, 8.0 }) && "Failed vec4d select");
+	assert(smath::any(smath::equal(c, d)) && !smath::all(smath::equal(c, d)) && "Failed vec4d any/all");
+
+	std::cout << "Passed\n\n";
+}
+
+/**
+ * Test the dot product, length, distance, normalization and cross product.
+ */
+void test_geometric() {
+	std::cout << "\033[32m-- smath::geometric --\033[0m\n";
+	using v3 = smath::vec3;
+	using v4 = smath::vec4;
+	using v4d = smath::vec4d;
+
+	SMATH_STATIC_ASSERT(smath::dot(smath::vec2i{ 1, 2 }, smath::vec2i{ 3, 4 }) == 11, "Failed vec2i dot");
+	SMATH_STATIC_ASSERT(smath::dot(v4{ 1.f, 2.f, 3.f, 4.f }, v4{ 5.f, 6.f, 7.f, 8.f }) == 70.f, "Failed vec4f dot");
+	SMATH_STATIC_ASSERT((smath::cross(smath::vec3i{ 1, 0, 0 }, smath::vec3i{ 0, 1, 0 }) == smath::vec3i{ 0, 0, 1 }), "Failed vec3i cross");
+	SMATH_STATIC_ASSERT((smath::cross(v3{ 1.f, 2.f, 3.f }, v3{ 4.f, 5.f, 6.f }) == v3{ -3.f, 6.f, -3.f }), "Failed vec3f cross");
+
+	// the SIMD reduction must match the scalar summation order exactly
+	v4 a{ 1e8f, 1.f, -1e8f, 3.f };
+	v4 b{ 1.f, 0.1f, 1.f, 0.7f };
+	const float scalar{ (a.x * b.x + a.z * b.z) + (a.y * b.y + a.w * b.w) };
+	assert(smath::dot(a, b) == scalar && "Failed vec4f dot summation order");
+
+	v4d c{ 1e17, 1.0, -1e17, 3.0 };
+	v4d d{ 1.0, 0.1, 1.0, 0.7 };
+	const double scalard{ (c.x * d.x + c.z * d.z) + (c.y * d.y + c.w * d.w) };
+	assert(smath::dot(c, d) == scalard && "Failed vec4d dot summation order");
+
+	assert(smath::length(v4{ 2.f, 4.f, 4.f, 0.f }) == 6.f && "Failed vec4f length");
+	assert(smath::length(smath::vec2d{ 3.0, 4.0 }) == 5.0 && "Failed vec2d length");
+	assert(smath::distance(v3{ 1.f, 1.f, 1.f }, v3{ 3.f, 5.f, 5.f }) == 6.f && "Failed vec3f distance");
+
+	const v4 n{ smath::normalize(v4{ 2.f, 4.f, 4.f, 0.f }) };
+	assert(std::fabs(smath::length(n) - 1.f) < 1e-5f && "Failed vec4f normalize length");
+	assert(std::fabs(n.y - 4.f / 6.f) < 1e-5f && "Failed vec4f normalize direction");
+	const smath::vec3d m{ smath::normalize(smath::vec3d{ 0.0, 3.0, 4.0 }) };
+	assert(std::fabs(m.z - 0.8) < 1e-5 && "Failed vec3d normalize");
+
+	std::cout << "Passed\n\n";
+}
+
+/**
+ * Test the precomputed integer division against operator/ and operator%
+ */
+void test_divider() {
+	std::cout << "\033[32m-- smath::divider --\033[0m\n";
+
+	const int divisors[]{ 1, -1, 2, -2, 3, -3, 5, 7, -7, 10, 16, 64, 641, -1000, 65536, 2147483647, -2147483647, -2147483647 - 1 };
+	const int dividends[]{ 0, 1, -1, 2, 3, -3, 7, 100, -100, 12345, -65537, 1 << 30, 2147483647, -2147483647, -2147483647 - 1 };
+
+	for (const int d : divisors) {
+		const smath::divider<int> div{ d };
+		for (const int n : dividends) {
+			if (d == -1 && n == -2147483647 - 1) {
+				continue;
+			}
+			assert(n / div == n / d && "Failed divider quotient");
+			assert(n % div == n % d && "Failed divider remainder");
+		}
+
+		const smath::vec3i v{ 1000, -999, 2147483647 };
+		assert((v / div == smath::vec3i{ 1000 / d, -999 / d, 2147483647 / d }) && "Failed vec3i divider quotient");
+		assert((v % div == smath::vec3i{ 1000 % d, -999 % d, 2147483647 % d }) && "Failed vec3i divider remainder");
+
+		const smath::simd::i32x16 b{ 123456789 };
+		assert((b / div)[15] == 123456789 / d && (b % div)[7] == 123456789 % d && "Failed batch divider");
+	}
+
+	const smath::divider<int> grid{ 48 };
+	for (int n = -5000; n < 5000; ++n) {
+		assert(n / grid == n / 48 && n % grid == n % 48 && "Failed divider range");
+	}
+
+	const smath::vec4i tile{ smath::vec4i{ 480, 95, -49, 4800 } / grid };
+	assert((tile == smath::vec4i{ 10, 1, -1, 100 }) && "Failed vec4i divider quotient");
+
+	std::cout << "Passed\n\n";
+}
+
+/**
+ * Test the structure-of-arrays container and its element proxies.
+ */
+void test_soa_array() {
+	std::cout << "\033[32m-- smath::soa_array --\033[0m\n";
+	using v3 = smath::vec3;
+
+	smath::soa_array<3, float> positions;
+	for (int i = 0; i < 37; ++i) {
+		positions.push_back(v3{ static_cast<float>(i), static_cast<float>(2 * i), -static_cast<float>(i) });
+	}
+
+	assert(positions.size() == 37 && positions.capacity() % 16 == 0 && "Failed soa_array size");
+	for (smath::length_t c = 0; c < 3; ++c) {
+		assert(reinterpret_cast<std::uintptr_t>(positions.data(c)) % 64 == 0 && "Failed soa_array alignment");
+	}
+
+	const smath::soa_array<3, float> velocity(37, v3{ 0.5f, 1.f, 2.f });
+	positions += velocity;
+	positions *= 2.f;
+	positions -= v3{ 1.f, 0.f, 0.f };
+	assert((positions[10] == v3{ 20.f, 42.f, -16.f }) && "Failed soa_array arithmetic");
+
+	const smath::soa_array<3, float> halved{ positions / 2.f };
+	assert((halved[36] == v3{ 36.f, 73.f, -34.f }) && "Failed soa_array division");
+
+	// element proxies read and write the streams like a vector
+	positions[3] = v3{ 9.f, 16.f, -25.f };
+	positions[3].y += 9.f;
+	positions[4] = positions[3];
+	positions[4] *= 2.f;
+	const v3 sum{ positions[3] + positions[4] };
+	assert((positions[3] == v3{ 9.f, 25.f, -25.f }) && "Failed soa_array proxy assignment");
+	assert((sum == v3{ 27.f, 75.f, -75.f }) && positions.data(1)[4] == 50.f && "Failed soa_array proxy arithmetic");
+
+	const smath::soa_array<3, float> roots{ smath::sqrt(smath::abs(positions)) };
+	assert((roots[3] == v3{ 3.f, 5.f, 5.f }) && "Failed soa_array sqrt/abs");
+
+	smath::soa_array<2, double> values(5, smath::vec2d{ -1.5, 2.5 });
+	assert((smath::floor(values)[0] == smath::vec2d{ -2.0, 2.0 }) && "Failed soa_array floor");
+	assert((smath::ceil(values)[1] == smath::vec2d{ -1.0, 3.0 }) && "Failed soa_array ceil");
+	assert((smath::round(values)[2] == smath::vec2d{ -2.0, 3.0 }) && "Failed soa_array round");
+	assert(std::fabs(smath::log(values * 4.0)[4].y - std::log(10.0)) < 1e-12 && "Failed soa_array log");
+
+	smath::soa_array<4, int> cells(9, smath::vec4i{ 10, -20, 30, 7 });
+	cells /= smath::vec4i{ 3, 3, 4, 7 };
+	const smath::soa_array<4, int> copy{ cells };
+	assert((copy[8] == smath::vec4i{ 3, -6, 7, 1 }) && "Failed soa_array<int> division");
+
+	std::cout << "Passed\n\n";
+}
+
+/**
+ * Test the array-of-structure-of-arrays container and its block access.
+ */
+void test_aosoa_array() {
+	std::cout << "\033[32m-- smath::aosoa_array --\033[0m\n";
+	using v3 = smath::vec3;
+
+	smath::aosoa_array<3, float, 8> points;
+	for (int i = 0; i < 21; ++i) {
+		points.push_back(v3{ static_cast<float>(i), static_cast<float>(-i), 1.f });
+	}
+
+	assert(points.size() == 21 && points.block_count() == 3 && "Failed aosoa_array size");
+	assert(reinterpret_cast<std::uintptr_t>(points.block(1).data(2)) % 32 == 0 && "Failed aosoa_array alignment");
+	assert((points[13] == v3{ 13.f, -13.f, 1.f }) && "Failed aosoa_array element access");
+
+	// each block feeds one batch per component straight into the kernel
+	using batch = smath::aosoa_array<3, float, 8>::batch_type;
+	for (auto it = points.block_begin(); it != points.block_end(); ++it) {
+		const batch x{ it->load(0) };
+		it->store(0, x * x + it->load(2));
+		it->store(1, it->load(1) * batch(2.f));
+	}
+	assert((points[5] == v3{ 26.f, -10.f, 1.f }) && "Failed aosoa_array block kernel");
+	assert((points[20] == v3{ 401.f, -40.f, 1.f }) && "Failed aosoa_array tail block");
+
+	points.set(7, v3{ 1.f, 2.f, 3.f });
+	assert((points.block(0).get(7) == v3{ 1.f, 2.f, 3.f }) && "Failed aosoa_array set");
+
+	// shrinking clears the padding of the last block
+	points.resize(17);
+	assert(points.block_count() == 3 && points.block(2).data(0)[1] == 0.f && "Failed aosoa_array resize");
+
+	const smath::aosoa_array<4, double> dirs(6, smath::vec4d{ 1.0, 2.0, 3.0, 4.0 });
+	assert(decltype(dirs)::block_size() >= 4 && (dirs[5] == smath::vec4d{ 1.0, 2.0, 3.0, 4.0 }) && "Failed aosoa_array<double>");
+
+	std::cout << "Passed\n\n";
+}
+
+/**
+ * Test the batch overloads of the exponential functions over spans.
+ */
+void test_exponential_span() {
+	std::cout << "\033[32m-- smath::sqrt/inv_sqrt/log (span) --\033[0m\n";
+
+	// an odd size exercises both the full batches and the scalar tail
+	std::vector<float> in(37);
+	for (std::size_t i = 0; i < in.size(); ++i) {
+		in[i] = static_cast<float>(i * i);
+	}
+	std::vector<float> out(in.size());
+
+	smath::sqrt(in, out);
+	for (std::size_t i = 0; i < out.size(); ++i) {
+		assert(out[i] == static_cast<float>(i) && "Failed sqrt span");
+	}
+
+	smath::sqrt(smath::span<float>(in));
+	assert(in == out && "Failed sqrt span in place");
+
+	std::vector<double> d{ 1.0, 4.0, 16.0, 64.0, 0.25 };
+	smath::inv_sqrt(smath::span<double>(d), smath::accuracy::precise);
+	assert(d[2] == 0.25 && d[4] == 2.0 && "Failed inv_sqrt span");
+
+	float e[5]{ 1.f, 2.f, 3.f, 4.f, 5.f };
+	smath::log(e, e);
+	assert(e[0] == 0.f && e[4] == std::log(5.f) && "Failed log span");
+
+	std::vector<smath::vec3> points(11, smath::vec3{ 4.f, 9.f, 16.f });
+	std::vector<smath::vec3> roots(points.size());
+	smath::sqrt(points, smath::span(roots));
+	assert((roots[10] == smath::vec3{ 2.f, 3.f, 4.f }) && "Failed sqrt vec span");
+
+	smath::inv_sqrt(smath::span<smath::vec3>(points), smath::accuracy::precise);
+	assert((points[0] == smath::vec3{ 0.5f, 1.f / 3.f, 0.25f }) && "Failed inv_sqrt vec span");
+
+	const std::vector<smath::vec2d> grid(3, smath::vec2d{ 1.0, M_E });
+	std::vector<smath::vec2d> logs(grid.size());
+	smath::log(smath::span<const smath::vec2d>(grid), smath::span<smath::vec2d>(logs));
+	assert((logs[2] == smath::vec2d{ 0.0, 1.0 }) && "Failed log vec span");
+
+	std::cout << "Passed\n\n";
+}
+
+/**
+ * Test the in-register transposes between interleaved vectors and one batch
+ * per component.
+ */
+void test_layout() {
+	std::cout << "\033[32m-- smath::load_soa/store_aos --\033[0m\n";
+	using namespace smath::simd;
+
+	float m[16];
+	for (int i = 0; i < 16; ++i) {
+		m[i] = static_cast<float>(i);
+	}
+	f32x4 r0{ f32x4::loadu(m) }, r1{ f32x4::loadu(m + 4) }, r2{ f32x4::loadu(m + 8) }, r3{ f32x4::loadu(m + 12) };
+	transpose(r0, r1, r2, r3);
+	assert(r0[1] == 4.f && r1[0] == 1.f && r2[3] == 14.f && r3[2] == 11.f && "Failed transpose f32x4");
+
+	f64x4 d0{ 0.0 }, d1{ 1.0 }, d2{ 2.0 }, d3{ 3.0 };
+	transpose(d0, d1, d2, d3);
+	assert(d0[3] == 3.0 && d2[1] == 1.0 && "Failed transpose f64x4");
+
+	// 8 interleaved 3-component vectors, where component c of vector i is 10 * i + c
+	float xyz[24];
+	for (int i = 0; i < 8; ++i) {
+		for (int c = 0; c < 3; ++c) {
+			xyz[3 * i + c] = static_cast<float>(10 * i + c);
+		}
+	}
+	f32x8 x, y, z;
+	deinterleave3(f32x8::loadu(xyz), f32x8::loadu(xyz + 8), f32x8::loadu(xyz + 16), x, y, z);
+	for (smath::length_t i = 0; i < 8; ++i) {
+		assert(x[i] == static_cast<float>(10 * i) && y[i] == x[i] + 1.f && z[i] == x[i] + 2.f && "Failed deinterleave3 f32x8");
+	}
+	f32x4 x4, y4, z4;
+	deinterleave3(f32x4::loadu(xyz), f32x4::loadu(xyz + 4), f32x4::loadu(xyz + 8), x4, y4, z4);
+	assert(x4[3] == 30.f && y4[2] == 21.f && z4[1] == 12.f && "Failed deinterleave3 f32x4");
+
+	f32x8 s0, s1, s2;
+	interleave3(x, y, z, s0, s1, s2);
+	float back[24];
+	s0.storeu(back);
+	s1.storeu(back + 8);
+	s2.storeu(back + 16);
+	for (int i = 0; i < 24; ++i) {
+		assert(back[i] == xyz[i] && "Failed interleave3 f32x8");
+	}
+
+	// 8 interleaved 4-component vectors, and 4 interleaved 3-component doubles
+	float xyzw[32];
+	for (int i = 0; i < 32; ++i) {
+		xyzw[i] = static_cast<float>(10 * (i / 4) + i % 4);
+	}
+	f32x8 w0{ f32x8::loadu(xyzw) }, w1{ f32x8::loadu(xyzw + 8) }, w2{ f32x8::loadu(xyzw + 16) }, w3{ f32x8::loadu(xyzw + 24) };
+	deinterleave4(w0, w1, w2, w3);
+	for (smath::length_t i = 0; i < 8; ++i) {
+		assert(w0[i] == static_cast<float>(10 * i) && w1[i] == w0[i] + 1.f && w2[i] == w0[i] + 2.f && w3[i] == w0[i] + 3.f && "Failed deinterleave4 f32x8");
+	}
+	interleave4(w0, w1, w2, w3);
+	float back4[32];
+	w0.storeu(back4);
+	w1.storeu(back4 + 8);
+	w2.storeu(back4 + 16);
+	w3.storeu(back4 + 24);
+	for (int i = 0; i < 32; ++i) {
+		assert(back4[i] == xyzw[i] && "Failed interleave4 f32x8");
+	}
+
+	double dxyz[12];
+	for (int i = 0; i < 12; ++i) {
+		dxyz[i] = static_cast<double>(10 * (i / 3) + i % 3);
+	}
+	f64x4 dx, dy, dz;
+	deinterleave3(f64x4::loadu(dxyz), f64x4::loadu(dxyz + 4), f64x4::loadu(dxyz + 8), dx, dy, dz);
+	for (smath::length_t i = 0; i < 4; ++i) {
+		assert(dx[i] == static_cast<double>(10 * i) && dy[i] == dx[i] + 1.0 && dz[i] == dx[i] + 2.0 && "Failed deinterleave3 f64x4");
+	}
+	f64x4 e0, e1, e2;
+	interleave3(dx, dy, dz, e0, e1, e2);
+	double dback[12];
+	e0.storeu(dback);
+	e1.storeu(dback + 4);
+	e2.storeu(dback + 8);
+	for (int i = 0; i < 12; ++i) {
+		assert(dback[i] == dxyz[i] && "Failed interleave3 f64x4");
+	}
+
+	// whole vectors
+	std::vector<smath::vec3> points(13);
+	for (std::size_t i = 0; i < points.size(); ++i) {
+		const float f{ static_cast<float>(i) };
+		points[i] = smath::vec3{ f, -f, 2.f * f };
+	}
+
+	f32x4 soa[3];
+	smath::load_soa(points.data() + 1, soa);
+	assert(soa[0][0] == 1.f && soa[1][3] == -4.f && soa[2][2] == 6.f && "Failed load_soa vec3");
+
+	std::vector<smath::vec4d> quads(4, smath::vec4d{ 1.0, 2.0, 3.0, 4.0 });
+	f64x4 q[4];
+	smath::load_soa(quads.data(), q);
+	q[3] = q[3] * f64x4(2.0);
+	smath::store_aos(q, quads.data());
+	assert((quads[2] == smath::vec4d{ 1.0, 2.0, 3.0, 8.0 }) && "Failed store_aos vec4d");
+
+	smath::transform_aos(smath::span(points), [](auto &c) {
+		c[0] = c[0] * c[0];
+		c[1] = c[1] + c[2];
+	});
+	for (std::size_t i = 0; i < points.size(); ++i) {
+		const float f{ static_cast<float>(i) };
+		assert((points[i] == smath::vec3{ f * f, f, 2.f * f }) && "Failed transform_aos vec3");
+	}
+
+	const std::vector<smath::vec2i> cells(5, smath::vec2i{ 3, 4 });
+	std::vector<smath::vec2i> sums(cells.size());
+	smath::transform_aos(cells, smath::span(sums), [](auto &c) {
+		c[0] = c[0] + c[1];
+	});
+	assert((sums[4] == smath::vec2i{ 7, 4 }) && "Failed transform_aos vec2i");
+
+	std::vector<smath::vec4> colors(19);
+	std::vector<smath::vec3d> normals(11);
+	for (std::size_t i = 0; i < colors.size(); ++i) {
+		const float f{ static_cast<float>(i) };
+		colors[i] = smath::vec4{ f, 2.f * f, 3.f * f, 1.f };
+	}
+	for (std::size_t i = 0; i < normals.size(); ++i) {
+		normals[i] = smath::vec3d{ static_cast<double>(i), 1.0, -1.0 };
+	}
+	smath::transform_aos(smath::span(colors), [](auto &c) {
+		c[3] = c[0] + c[2];
+	});
+	smath::transform_aos(smath::span(normals), [](auto &c) {
+		c[1] = c[0] * c[2];
+	});
+	for (std::size_t i = 0; i < colors.size(); ++i) {
+		const float f{ static_cast<float>(i) };
+		assert((colors[i] == smath::vec4{ f, 2.f * f, 3.f * f, 4.f * f }) && "Failed transform_aos vec4");
+	}
+	for (std::size_t i = 0; i < normals.size(); ++i) {
+		assert((normals[i] == smath::vec3d{ static_cast<double>(i), -static_cast<double>(i), -1.0 }) && "Failed transform_aos vec3d");
+	}
+
+	std::cout << "Passed\n\n";
+}
+
+/**
+ * Test the work-stealing pool and the parallel algorithms.
+ */
+void test_parallel() {
+	std::cout << "\033[32m-- smath::parallel --\033[0m\n";
+	namespace par = smath::parallel;
+
+	par::thread_pool pool(3);
+	par::options opts;
+	opts.pool = &pool;
+
+	std::vector<int> indices(100003, -1);
+	par::parallel_for(0, indices.size(), [&indices](std::size_t b, std::size_t e) {
+		for (std::size_t i = b; i < e; ++i) {
+			indices[i] = static_cast<int>(i);
+		}
+	}, opts);
+	for (std::size_t i = 0; i < indices.size(); ++i) {
+		assert(indices[i] == static_cast<int>(i) && "Failed parallel_for");
+	}
+
+	std::vector<smath::vec3> points(50001);
+	for (std::size_t i = 0; i < points.size(); ++i) {
+		points[i] = smath::vec3{ static_cast<float>(i % 7) + 1.f, 0.f, 0.f };
+	}
+	std::vector<smath::vec3> unit(points.size());
+	par::parallel_transform(points, unit, [](const smath::vec3 &v) { return smath::normalize(v); }, opts);
+	assert(std::fabs(unit[12345].x - 1.f) < 1e-5f && unit[12345].y == 0.f && "Failed parallel_transform");
+
+	std::vector<smath::vec3> sums(points.size());
+	par::parallel_transform(points, unit, sums, std::plus<>(), opts);
+	assert(sums[6].x == 7.f + unit[6].x && "Failed parallel_transform (binary)");
+
+	const long total{ par::parallel_reduce(indices, 0L, std::plus<>(), opts) };
+	assert(total == 100002L * 100003L / 2 && "Failed parallel_reduce");
+
+	const std::size_t longest{ par::parallel_transform_reduce(points, std::size_t{ 0 },
+		[](std::size_t a, std::size_t b) { return a > b ? a : b; },
+		[](const smath::vec3 &v) { return static_cast<std::size_t>(v.x); }, opts) };
+	assert(longest == 7 && "Failed parallel_transform_reduce");
+
+	// deterministic reductions give the same bits with any number of threads
+	std::vector<float> values(77777);
+	for (std::size_t i = 0; i < values.size(); ++i) {
+		values[i] = 1.f / static_cast<float>(i + 1);
+	}
+	par::thread_pool single(0);
+	par::options det;
+	det.deterministic = true;
+	det.pool = &pool;
+	const float r0{ par::parallel_reduce(values, 0.f, std::plus<>(), det) };
+	det.pool = &single;
+	const float r1{ par::parallel_reduce(values, 0.f, std::plus<>(), det) };
+	assert(r0 == r1 && std::fabs(r0 - 11.839f) < 1e-2f && "Failed deterministic parallel_reduce");
+
+	// nested calls help run the queued tasks instead of blocking the workers
+	std::atomic<int> inner{ 0 };
+	par::parallel_for(0, 8, [&](std::size_t b, std::size_t e) {
+		for (std::size_t i = b; i < e; ++i) {
+			par::parallel_for(0, 1000, [&inner](std::size_t ib, std::size_t ie) {
+				inner += static_cast<int>(ie - ib);
+			}, opts);
+		}
+	}, par::options{ 1, false, &pool });
+	assert(inner == 8000 && "Failed nested parallel_for");
+
+	// an exception in any chunk reaches the caller once every chunk is done
+	std::atomic<int> ran{ 0 };
+	bool caught{ false };
+	try {
+		par::parallel_for(0, 64, [&ran](std::size_t b, std::size_t) {
+			++ran;
+			if (b % 3 == 0) {
+				throw std::runtime_error("chunk");
+			}
+		}, par::options{ 1, false, &pool });
+	} catch (const std::runtime_error &) {
+		caught = true;
+	}
+	assert(caught && ran == 64 && "Failed parallel_for exception");
+
+	std::vector<double> squares(1000);
+	par::parallel_for(0, squares.size(), [&squares](std::size_t b, std::size_t e) {
+		for (std::size_t i = b; i < e; ++i) {
+			squares[i] = static_cast<double>(i * i);
+		}
+	});
+	assert(squares[999] == 998001.0 && "Failed parallel_for (default pool)");
+
+	std::cout << "Passed\n\n";
+}
+
+/**
+ * Test the lazy soa_array expressions.
+ */
+void test_soa_expression() {
+	std::cout << "\033[32m-- smath::soa_array (expressions) --\033[0m\n";
+	using v3 = smath::vec3;
+
+	const smath::soa_array<3, float> a(21, v3{ 1.f, 2.f, 3.f });
+	const smath::soa_array<3, float> b(21, v3{ 4.f, 5.f, 6.f });
+	const smath::soa_array<3, float> c(21, v3{ 0.5f });
+	smath::soa_array<3, float> d(21, v3{ 2.f, 4.f, 8.f });
+
+	// the operators only build the tree, which is evaluated on construction
+	const auto expr = a * b + c * d - 1.f;
+	SMATH_STATIC_ASSERT(smath::detail::is_soa_expression<decltype(expr)>::value, "Failed lazy soa_array expression");
+	const smath::soa_array<3, float> r{ expr };
+	assert(r.size() == 21 && (r[20] == v3{ 4.f, 11.f, 21.f }) && "Failed fused soa_array expression");
+
+	// the destination may be an operand
+	d = 1.f / (d - c) + v3{ 0.f, 1.f, 2.f };
+	assert(std::fabs(d[0].x - 1.f / 1.5f) < 1e-6f && std::fabs(d[7].z - (2.f + 1.f / 7.5f)) < 1e-6f && "Failed aliased soa_array expression");
+
+	d += -a * 2.f;
+	assert(std::fabs(d[3].y - (1.f + 1.f / 3.5f - 4.f)) < 1e-6f && "Failed soa_array compound expression");
+
+	const smath::soa_array<3, float> roots{ smath::sqrt(smath::abs(a - b * 2.f)) };
+	assert((roots[0] == v3{ std::sqrt(7.f), std::sqrt(8.f), 3.f }) && "Failed soa_array sqrt/abs expression");
+
+	const smath::soa_array<2, int> n(9, smath::vec2i{ 17, -9 });
+	const smath::soa_array<2, int> q{ n / smath::vec2i{ 4, 2 } + 1 };
+	assert((q[8] == smath::vec2i{ 5, -3 }) && "Failed soa_array<int> expression");
+
+	std::cout << "Passed\n\n";
+}
+
+/**
+ * Test the fused multiply-add, mix and lerp.
+ */
+void test_fma() {
+	std::cout << "\033[32m-- smath::fma --\033[0m\n";
+
+	// 1 + 2^-27 squared needs a single rounding to keep the 2^-54 term
+	const double e{ 1.0 + std::ldexp(1.0, -27) };
+	assert(smath::fma(e, e, -1.0) == std::ldexp(1.0, -26) + std::ldexp(1.0, -54) && "Failed fma single rounding");
+	assert(smath::fma(3, 4, 5) == 17 && "Failed fma<int>");
+
+	const smath::vec4 a{ 1.f, 2.f, 3.f, 4.f };
+	const smath::vec4 b{ 0.5f, -1.f, 2.f, 0.f };
+	assert((smath::fma(a, b, smath::vec4{ 1.f }) == smath::vec4{ 1.5f, -1.f, 7.f, 1.f }) && "Failed fma vec4");
+	assert((smath::fma(smath::vec3{ 1.f, 2.f, 3.f }, 2.f, smath::vec3{ 1.f }) == smath::vec3{ 3.f, 5.f, 7.f }) && "Failed fma vec3 scalar");
+	assert((smath::fma(2, smath::vec2i{ 3, -4 }, smath::vec2i{ 1 }) == smath::vec2i{ 7, -7 }) && "Failed fma vec2i scalar");
+
+	const smath::vec4d d{ e, e, 1.0, 2.0 };
+	const smath::vec4d fd{ smath::fma(d, d, smath::vec4d{ -1.0 }) };
+	// vectors are only fused with FMA instructions, and otherwise round e * e
+#if SMATH_ARCH & SMATH_ARCH_FMA_BIT
+	const double fused{ std::ldexp(1.0, -26) + std::ldexp(1.0, -54) };
+#else
+	const double fused{ std::ldexp(1.0, -26) };
+#endif
+	assert(fd.x == fused && fd.w == 3.0 && "Failed fma dvec4 rounding");
+
+	assert(smath::mix(2.0, 4.0, 0.25) == 2.5 && smath::lerp(2.f, 4.f, 1.f) == 4.f && "Failed mix");
+	assert((smath::mix(a, b, 0.5f) == smath::vec4{ 0.75f, 0.5f, 2.5f, 2.f }) && "Failed mix vec4");
+	assert((smath::lerp(smath::vec2{ 0.f, 10.f }, smath::vec2{ 1.f, 20.f }, smath::vec2{ 0.5f, 0.1f }) == smath::vec2{ 0.5f, 11.f }) && "Failed lerp vec2");
+
+	// batch forms, with a tail after the full batches
+	std::vector<float> x(37), y(37), z(37), out(37);
+	for (std::size_t i = 0; i < x.size(); ++i) {
+		x[i] = static_cast<float>(i);
+		y[i] = 0.5f;
+		z[i] = 1.f;
+	}
+	smath::fma(x, y, z, out);
+	assert(out[0] == 1.f && out[36] == 19.f && "Failed fma span");
+	smath::fma(x, 2.f, z, out);
+	assert(out[35] == 71.f && "Failed fma span scalar");
+	smath::mix(x, z, 0.5f, x);
+	assert(x[36] == 18.5f && x[1] == 1.f && "Failed mix span");
+
+	std::vector<smath::vec3d> p(5, smath::vec3d{ 1.0, 2.0, 3.0 }), q(5, smath::vec3d{ 3.0 });
+	smath::fma<3, double>(p, q, p, q);
+	assert((q[4] == smath::vec3d{ 4.0, 8.0, 12.0 }) && "Failed fma vec span");
+	smath::mix<3, double>(p, q, 0.5, p);
+	assert((p[2] == smath::vec3d{ 2.5, 5.0, 7.5 }) && "Failed mix vec span");
+
+	std::cout << "Passed\n\n";
+}
+
+/**
+ * Test the aligned allocator and the arena.
+ */
+void test_memory() {
+	std::cout << "\033[32m-- smath::arena --\033[0m\n";
+
+	std::vector<smath::vec4, smath::aligned_allocator<smath::vec4>> aligned(13, smath::vec4{ 1.f });
+	assert(reinterpret_cast<std::uintptr_t>(aligned.data()) % 64 == 0 && "Failed aligned_allocator alignment");
+	assert(reinterpret_cast<std::uintptr_t>(std::vector<double, smath::aligned_allocator<double, 128>>(3).data()) % 128 == 0 && "Failed aligned_allocator<128>");
+
+	smath::arena frame(1024);
+	const smath::span<smath::vec3> a{ frame.allocate<smath::vec3>(5) };
+	const smath::span<float> b{ frame.allocate<float>(3) };
+	assert(a.size() == 5 && b.size() == 3 && "Failed arena span size");
+	assert(reinterpret_cast<std::uintptr_t>(a.data()) % 64 == 0 && reinterpret_cast<std::uintptr_t>(b.data()) % 64 == 0 && "Failed arena alignment");
+	assert(reinterpret_cast<std::uintptr_t>(frame.allocate(1, 256)) % 256 == 0 && "Failed arena over-alignment");
+
+	// larger than a block, so it gets a block of its own
+	frame.allocate(4096);
+	const std::size_t capacity{ frame.capacity() };
+	assert(frame.used() >= 4096 + 64 + 12 + 1 && "Failed arena used");
+
+	// after a reset the same memory is handed out again
+	frame.reset();
+	assert(frame.used() == 0 && frame.allocate<smath::vec3>(5).data() == a.data() && "Failed arena reset");
+	frame.allocate(4096);
+	assert(frame.capacity() == capacity && "Failed arena reuse");
+	frame.reset();
+
+	{
+		const smath::arena_allocator<smath::vec4> alloc(frame);
+		std::vector<smath::vec4, smath::arena_allocator<smath::vec4>> scratch(alloc);
+		scratch.resize(20, smath::vec4{ 2.f });
+		assert(scratch[19] == smath::vec4{ 2.f } && reinterpret_cast<std::uintptr_t>(scratch.data()) % 64 == 0 && "Failed arena_allocator vector");
+
+		smath::soa_array<3, float, smath::arena_allocator<float>> positions(37, smath::vec3{ 1.f, 2.f, 3.f }, frame);
+		positions *= 2.f;
+		positions += positions;
+		assert(positions.size() == 37 && (positions[36] == smath::vec3{ 4.f, 8.f, 12.f }) && "Failed arena soa_array");
+		assert(positions.get_allocator() == smath::arena_allocator<float>(frame) && "Failed arena soa_array allocator");
+
+		smath::aosoa_array<2, double, 4, smath::arena_allocator<double>> points(9, smath::vec2d{ 1.0, -1.0 }, frame);
+		assert(points.block_count() == 3 && (points[8] == smath::vec2d{ 1.0, -1.0 }) && "Failed arena aosoa_array");
+	}
+	frame.reset();
+
+	std::cout << "Passed\n\n";
+}
+
+/**
+ * Test clamp, saturate, step and smoothstep.
+ */
+void test_clamp() {
+	std::cout << "\033[32m-- smath::clamp --\033[0m\n";
+
+	SMATH_STATIC_ASSERT(smath::clamp(5, 0, 3) == 3 && smath::clamp(-1.5, -1.0, 1.0) == -1.0, "Failed clamp");
+	SMATH_STATIC_ASSERT(smath::saturate(0.25f) == 0.25f && smath::saturate(2.f) == 1.f, "Failed saturate");
+	SMATH_STATIC_ASSERT(smath::step(1.0, 0.5) == 0.0 && smath::step(1.0, 1.0) == 1.0, "Failed step");
+	SMATH_STATIC_ASSERT(smath::smoothstep(0.0, 2.0, 1.0) == 0.5 && smath::smoothstep(0.0, 2.0, 3.0) == 1.0, "Failed smoothstep");
+
+	const smath::vec4 x{ -1.f, 0.25f, 0.5f, 4.f };
+	assert((smath::clamp(x, 0.f, 1.f) == smath::vec4{ 0.f, 0.25f, 0.5f, 1.f }) && "Failed clamp vec4");
+	assert((smath::clamp(x, smath::vec4{ 0.f, 0.5f, 0.f, 0.f }, smath::vec4{ 1.f, 1.f, 0.25f, 5.f }) == smath::vec4{ 0.f, 0.5f, 0.25f, 4.f }) && "Failed clamp vec4 ranges");
+	assert((smath::saturate(x) == smath::vec4{ 0.f, 0.25f, 0.5f, 1.f }) && "Failed saturate vec4");
+	assert((smath::clamp(smath::vec3i{ -4, 2, 9 }, 0, 5) == smath::vec3i{ 0, 2, 5 }) && "Failed clamp vec3i");
+
+	// NaN and -0 are clamped alike by scalars, vectors and ranges
+	const float nan{ std::numeric_limits<float>::quiet_NaN() };
+	assert(smath::clamp(nan, 0.f, 1.f) == 1.f && std::signbit(smath::clamp(-0.f, 0.f, 1.f)) && "Failed clamp NaN and -0");
+	const smath::vec4 c{ smath::clamp(smath::vec4{ nan, -0.f, 0.f, 2.f }, 0.f, 1.f) };
+	assert(c.x == 1.f && c.y == 0.f && std::signbit(c.y) && c.w == 1.f && "Failed clamp vec4 NaN and -0");
+	std::vector<float> z(19, nan), zo(19);
+	z[1] = -0.f;
+	z[18] = -0.f;
+	smath::clamp(z, 0.f, 1.f, zo);
+	assert(zo[0] == 1.f && std::signbit(zo[1]) && zo[17] == 1.f && std::signbit(zo[18]) && "Failed clamp span NaN and -0");
+
+	assert((smath::step(0.5f, x) == smath::vec4{ 0.f, 0.f, 1.f, 1.f }) && "Failed step vec4");
+	assert((smath::step(smath::vec2d{ 0.0, 1.0 }, smath::vec2d{ 0.5 }) == smath::vec2d{ 1.0, 0.0 }) && "Failed step vec2d");
+
+	const smath::vec4d s{ smath::smoothstep(0.0, 2.0, smath::vec4d{ -1.0, 0.5, 1.0, 3.0 }) };
+	assert(s.x == 0.0 && s.y == 0.15625 && s.z == 0.5 && s.w == 1.0 && "Failed smoothstep vec4d");
+	assert((smath::smoothstep(smath::vec2{ 0.f, 1.f }, smath::vec2{ 2.f, 3.f }, smath::vec2{ 1.f }) == smath::vec2{ 0.5f, 0.f }) && "Failed smoothstep vec2");
+	// a NaN t saturates to 1 like the scalar smoothstep
+	const float sn{ smath::smoothstep(0.f, 2.f, nan) };
+	assert(sn == 1.f && smath::smoothstep(0.f, 2.f, smath::vec4{ nan }).x == sn && smath::smoothstep(0.f, 2.f, smath::vec3{ nan }).x == sn && "Failed smoothstep NaN");
+	smath::smoothstep(0.f, 2.f, z, zo);
+	assert(zo[0] == sn && zo[2] == sn && zo[17] == sn && "Failed smoothstep span NaN");
+
+	// batch forms, with a tail after the full batches
+	std::vector<float> v(35), out(35);
+	for (std::size_t i = 0; i < v.size(); ++i) {
+		v[i] = static_cast<float>(i) / 8.f - 1.f;
+	}
+	smath::clamp(v, -0.5f, 0.5f, out);
+	assert(out[0] == -0.5f && out[10] == 0.25f && out[34] == 0.5f && "Failed clamp span");
+	smath::saturate(v, out);
+	assert(out[0] == 0.f && out[12] == 0.5f && out[34] == 1.f && "Failed saturate span");
+	smath::step(0.f, v, out);
+	assert(out[7] == 0.f && out[8] == 1.f && out[34] == 1.f && "Failed step span");
+	smath::smoothstep(-1.f, 1.f, v, out);
+	assert(out[0] == 0.f && out[8] == 0.5f && out[33] == 1.f && "Failed smoothstep span");
+
+	std::vector<smath::vec2> p(5, smath::vec2{ -2.f, 0.5f });
+	smath::saturate<2, float>(p, p);
+	assert((p[4] == smath::vec2{ 0.f, 0.5f }) && "Failed saturate vec span");
+
+	std::cout << "Passed\n\n";
+}
+
+/**
+ * Test the rounding modes, fract and modf on scalars, vectors and ranges
+ */
+void test_rounding() {
+	std::cout << "\033[32m-- smath::rounding --\033[0m\n";
+
+	// whole numbers and values beyond the range of int are kept
+	assert(smath::ceil(2.0f) == 2.f && smath::floor(-3.0) == -3.0 && "Failed whole numbers");
+	assert(smath::floor(5e9) == 5e9 && smath::ceil(-1e20f) == -1e20f && smath::round(3e10 + 0.5) == 3e10 + 1.0 && "Failed large values");
+	assert(std::signbit(smath::ceil(-0.5)) && std::signbit(smath::trunc(-0.7f)) && std::signbit(smath::round(-0.2)) && "Failed negative zero");
+
+	using smath::round_mode;
+	assert(smath::round(2.5, round_mode::half_away) == 3.0 && smath::round(2.5, round_mode::half_even) == 2.0 && "Failed half_even");
+	assert(smath::round(-3.5f, round_mode::half_even) == -4.f && smath::round(-2.7, round_mode::half_even) == -3.0 && "Failed half_even negative");
+	assert(smath::round(-2.5, round_mode::toward_zero) == -2.0 && smath::trunc(7) == 7 && "Failed toward_zero");
+
+	assert(smath::fract(-1.25) == 0.75 && smath::fract(2.5f) == 0.5f && "Failed fract");
+	// -1e-30 + 1 rounds to 1, which fract keeps below
+	const float below_one{ std::nextafter(1.f, 0.f) };
+	assert(smath::fract(-1e-30f) == below_one && smath::fract(-1e-300) == std::nextafter(1.0, 0.0) && std::isnan(smath::fract(std::nan(""))) && "Failed fract range");
+	double whole{ 0.0 };
+	assert(smath::modf(-3.25, whole) == -0.25 && whole == -3.0 && "Failed modf");
+
+	// vec4 is stored in SIMD registers, so this takes the batch path
+	const smath::vec4 h{ -2.5f, -0.5f, 0.5f, 1.5f };
+	assert((smath::round(h) == smath::vec4{ -3.f, -1.f, 1.f, 2.f }) && "Failed round vec4");
+	assert((smath::round(h, round_mode::half_even) == smath::vec4{ -2.f, -0.f, 0.f, 2.f }) && "Failed half_even vec4");
+	assert((smath::trunc(h) == smath::vec4{ -2.f, 0.f, 0.f, 1.f }) && "Failed trunc vec4");
+	assert(std::signbit(smath::trunc(h).y) && std::signbit(smath::ceil(h).y) && "Failed vec4 negative zero");
+	assert((smath::fract(h) == smath::vec4{ 0.5f, 0.5f, 0.5f, 0.5f }) && "Failed fract vec4");
+	const smath::vec4 fr{ smath::fract(smath::vec4{ -1e-30f, std::nanf(""), -0.f, 3.f }) };
+	assert(fr.x == below_one && std::isnan(fr.y) && fr.z == 0.f && fr.w == 0.f && "Failed fract vec4 range");
+	assert((smath::floor(smath::vec4d{ 1e17 + 2.0, -5e9 - 0.5, -0.25, 9.75 }) == smath::vec4d{ 1e17 + 2.0, -5e9 - 1.0, -1.0, 9.0 }) && "Failed floor vec4d");
+	assert((smath::round(smath::vec3i{ 1, -2, 3 }) == smath::vec3i{ 1, -2, 3 }) && "Failed round vec3i");
+
+#if SMATH_HAS_IS_CONSTANT_EVALUATED
+	SMATH_STATIC_ASSERT(smath::floor(-1.5) == -2.0 && smath::ceil(2.25f) == 3.f && smath::trunc(-7.9) == -7.0, "Failed constexpr floor/ceil/trunc");
+	SMATH_STATIC_ASSERT(smath::round(2.5f) == 3.f && smath::round(2.5, round_mode::half_even) == 2.0 && smath::fract(-1.25) == 0.75, "Failed constexpr round/fract");
+	SMATH_STATIC_ASSERT(smath::scale(5, 0, 10, 0, 3) == 2 && smath::round(1e300) == 1e300, "Failed constexpr scale");
+#endif
+	// the constant-expression rounding agrees with the standard library
+	const round_mode modes[5]{ round_mode::half_away, round_mode::half_even, round_mode::down, round_mode::up, round_mode::toward_zero };
+	const float samples[10]{ -0.5f, -0.f, 0.49999997f, 2.5f, -3.5f, -1e-30f, 8388607.5f, -16777216.f, 1e30f, std::numeric_limits<float>::infinity() };
+	for (const float f : samples) {
+		for (const round_mode m : modes) {
+			const float r{ smath::detail::round_constexpr(f, m) };
+			assert(r == smath::round(f, m) && std::signbit(r) == std::signbit(smath::round(f, m)) && "Failed constexpr rounding");
+		}
+	}
+	assert(std::isnan(smath::detail::round_constexpr(std::nan(""), round_mode::down)) && "Failed constexpr rounding NaN");
+
+	smath::vec2d ipart;
+	const smath::vec2d fpart{ smath::modf(smath::vec2d{ 2.75, -1.5 }, ipart) };
+	assert((fpart == smath::vec2d{ 0.75, -0.5 } && ipart == smath::vec2d{ 2.0, -1.0 }) && "Failed modf vec2d");
+
+	// batch forms, with a tail after the full batches
+	std::vector<float> v(37), out(37);
+	for (std::size_t i = 0; i < v.size(); ++i) {
+		v[i] = static_cast<float>(i) * 0.5f - 9.f;
+	}
+	smath::round(v, out);
+	for (std::size_t i = 0; i < v.size(); ++i) {
+		assert(out[i] == std::round(v[i]) && "Failed round span");
+	}
+	smath::round(v, out, round_mode::half_even);
+	for (std::size_t i = 0; i < v.size(); ++i) {
+		assert(out[i] == std::nearbyint(v[i]) && "Failed half_even span");
+	}
+	smath::floor(v, out);
+	assert(out[1] == -9.f && out[36] == 9.f && "Failed floor span");
+	smath::ceil(v, out);
+	assert(out[1] == -8.f && out[35] == 9.f && "Failed ceil span");
+	smath::trunc(v, out);
+	assert(out[1] == -8.f && out[35] == 8.f && "Failed trunc span");
+	smath::fract(v, out);
+	assert(out[1] == 0.5f && out[2] == 0.f && "Failed fract span");
+	std::vector<float> tiny(19, -1e-30f), tiny_out(19);
+	smath::fract(tiny, tiny_out);
+	assert(tiny_out[0] == below_one && tiny_out[18] == below_one && "Failed fract span range");
+
+	std::vector<smath::vec3d> p(3, smath::vec3d{ -1.5, 0.25, 4e15 + 0.5 });
+	smath::floor<3, double>(p, p);
+	assert((p[2] == smath::vec3d{ -2.0, 0.0, 4e15 }) && "Failed floor vec span");
+
+	smath::soa_array<2, float> a(9, smath::vec2{ -1.5f, 2.5f });
+	assert((smath::round(a, round_mode::half_even)[8] == smath::vec2{ -2.f, 2.f }) && "Failed soa_array half_even");
+	assert((smath::trunc(a)[0] == smath::vec2{ -1.f, 2.f }) && "Failed soa_array trunc");
+
+	std::cout << "Passed\n\n";
+}
+
+/**
+ * Test the precomputed range mappers against smath::scale and smath::round_nearest
+ */
+void test_range_map() {
+	std::cout << "\033[32m-- smath::range_map --\033[0m\n";
+
+	SMATH_STATIC_ASSERT(smath::range_map<double>(0.0, 10.0, -1.0, 1.0)(2.5) == -0.5, "Failed range_map");
+	SMATH_STATIC_ASSERT(smath::quantize_map<double>(5.0)(12.5) == 15.0, "Failed quantize_map");
+
+	const smath::range_map<float> m{ 0.f, 1024.f, 0.f, 1.f };
+	assert(m(256.f) == smath::scale(256.f, 0.f, 1024.f, 0.f, 1.f) && m(1024.f) == 1.f && "Failed range_map float");
+	assert(m.inverse()(0.5f) == 512.f && "Failed range_map inverse");
+	assert((m(smath::vec4{ 0.f, 256.f, 512.f, 1024.f }) == smath::vec4{ 0.f, 0.25f, 0.5f, 1.f }) && "Failed range_map vec4");
+
+	const smath::quantize_map<double> q{ 0.0, 1.0, 0.0, 255.0 };
+	assert(q(0.5) == 128.0 && q(0.1) == 26.0 && q(1.0) == 255.0 && "Failed quantize_map to bytes");
+	assert(smath::quantize_map<double>(10.0)(38.0) == smath::round_nearest(38.0, 10) && "Failed quantize_map as round_nearest");
+	assert((q(smath::vec2d{ 0.0, 0.75 }) == smath::vec2d{ 0.0, 191.0 }) && "Failed quantize_map vec2d");
+
+	// scale on integers no longer loses precision through float
+	assert(smath::scale(16777217, 0, 33554432, 0, 33554432) == 16777217 && smath::round_nearest(3000000001.0, 2) == 3000000002.0 && "Failed integer scale");
+
+	// batch forms, with a tail after the full batches
+	std::vector<float> v(37), out(37);
+	for (std::size_t i = 0; i < v.size(); ++i) {
+		v[i] = static_cast<float>(i) * 32.f;
+	}
+	m(v, out);
+	for (std::size_t i = 0; i < v.size(); ++i) {
+		assert(out[i] == m(v[i]) && "Failed range_map span");
+	}
+	// inexact mappings round the same way in the batches and the scalar form
+	const smath::range_map<float> r{ 0.f, 3.f, -1.f, 7.f };
+	std::vector<float> w(37), wo(37);
+	for (std::size_t i = 0; i < w.size(); ++i) {
+		w[i] = static_cast<float>(i) * 0.37f;
+	}
+	r(w, wo);
+	for (std::size_t i = 0; i < w.size(); ++i) {
+		assert(wo[i] == r(w[i]) && "Failed range_map span rounding");
+	}
+	const smath::quantize_map<float> steps{ 0.f, 1152.f, 0.f, 1.f, 0.25f };
+	steps(v, out);
+	assert(out[0] == 0.f && out[4] == 0.f && out[5] == 0.25f && out[36] == 1.f && "Failed quantize_map span");
+
+	std::vector<smath::vec3d> p(5, smath::vec3d{ 0.0, 512.0, 1024.0 });
+	smath::range_map<double>(0.0, 1024.0, -1.0, 1.0)(smath::span<const smath::vec3d>(p), smath::span(p));
+	assert((p[4] == smath::vec3d{ -1.0, 0.0, 1.0 }) && "Failed range_map vec span");
+
+	std::cout << "Passed\n\n";
+}
+
+/**
+ * Test the component-wise and horizontal min/max and argmin/argmax
+ */
+void test_min_max() {
+	std::cout << "\033[32m-- smath::min/max --\033[0m\n";
+
+	SMATH_STATIC_ASSERT(smath::min_component(smath::vec3i{ 4, -2, 7 }) == -2 && smath::max_component(smath::vec3i{ 4, -2, 7 }) == 7, "Failed min/max_component vec3i");
+
+	const smath::vec4 a{ 1.f, -2.f, 3.f, 8.f };
+	const smath::vec4 b{ 0.f, 5.f, 3.5f, -8.f };
+	assert((smath::min(a, b) == smath::vec4{ 0.f, -2.f, 3.f, -8.f }) && "Failed min vec4");
+	assert((smath::max(a, b) == smath::vec4{ 1.f, 5.f, 3.5f, 8.f }) && "Failed max vec4");
+	assert((smath::max(a, 2.f) == smath::vec4{ 2.f, 2.f, 3.f, 8.f }) && "Failed max vec4 scalar");
+	assert((smath::min(smath::vec2d{ 1.0, -1.0 }, 0.0) == smath::vec2d{ 0.0, -1.0 }) && "Failed min vec2d scalar");
+	assert(smath::min_component(b) == -8.f && smath::max_component(b) == 5.f && "Failed min/max_component vec4");
+	assert(smath::max_component(smath::vec4d{ -1.0, -3.0, 2.5, 0.0 }) == 2.5 && "Failed max_component vec4d");
+
+	// NaNs and signed zeros behave like the scalar smath::min and smath::max
+	const float nan{ std::numeric_limits<float>::quiet_NaN() };
+	const smath::vec4 n{ smath::min(smath::vec4{ nan, 1.f, 0.f, -0.f }, smath::vec4{ 2.f, nan, -0.f, 0.f }) };
+	assert(n.x == 2.f && std::isnan(n.y) && std::signbit(n.z) && !std::signbit(n.w) && "Failed min vec4 NaN");
+	const smath::vec4 m{ smath::max(smath::vec4{ nan, 1.f, 0.f, -0.f }, smath::vec4{ 2.f, nan, -0.f, 0.f }) };
+	assert(std::isnan(m.x) && m.y == 1.f && !std::signbit(m.z) && std::signbit(m.w) && "Failed max vec4 NaN");
+	assert(std::isnan(smath::max_component(smath::vec4{ nan, -0.f, 2.f, 0.5f })) && smath::max_component(smath::vec4{ 1.f, nan, 2.f, 0.5f }) == 2.f && "Failed max_component vec4 NaN");
+	assert(smath::min_component(smath::vec4{ nan, 3.f, -1.f, 0.5f }) == -1.f && std::isnan(smath::min_component(smath::vec4{ 1.f, 0.f, 2.f, nan })) && "Failed min_component vec4 NaN");
+	assert(std::signbit(smath::min_component(smath::vec4d{ 0.0, -0.0, 1.0, 2.0 })) && !std::signbit(smath::max_component(smath::vec4d{ 0.0, -0.0, -1.0, -2.0 })) && "Failed min/max_component vec4d signed zeros");
+
+	// first index of the extreme, with a tail after the full batches
+	std::vector<float> v(43);
+	for (std::size_t i = 0; i < v.size(); ++i) {
+		v[i] = static_cast<float>((i * 7) % 43);
+	}
+	v[3] = nan;
+	assert(smath::argmin(v) == 0 && smath::argmax(v) == 6 && "Failed argmin/argmax");
+	v[40] = -1.f;
+	v[41] = -1.f;
+	assert(smath::argmin(v) == 40 && "Failed argmin first index");
+	const std::vector<double> nans{ std::nan(""), std::nan("") }, empty;
+	assert(smath::argmin(nans) == 2 && smath::argmax(empty) == 0 && "Failed argmin without values");
+
+	std::vector<smath::vec3> p(11, smath::vec3{ 0.f });
+	p[2] = smath::vec3{ -4.f, 1.f, 9.f };
+	p[9] = smath::vec3{ 5.f, -3.f, 9.f };
+	assert((smath::argmin(smath::span(p)) == smath::vec<3, std::size_t>(2, 9, 0)) && "Failed argmin vec3");
+	assert((smath::argmax(smath::span(p)) == smath::vec<3, std::size_t>(9, 2, 2)) && "Failed argmax vec3");
+
+	std::cout << "Passed\n\n";
+}
+
+/**
+ * Test the integer bit functions on scalars, vectors and ranges
+ */
+void test_bits() {
+	std::cout << "\033[32m-- smath::bits --\033[0m\n";
+
+	SMATH_STATIC_ASSERT(smath::popcount(0xFF) == 8 && smath::popcount(-1) == 32 && smath::popcount(0) == 0, "Failed popcount");
+	SMATH_STATIC_ASSERT(smath::clz(1) == 31 && smath::clz(0) == 32 && smath::clz(-5) == 0, "Failed clz");
+	SMATH_STATIC_ASSERT(smath::ctz(8) == 3 && smath::ctz(0) == 32 && smath::ctz(-2147483647 - 1) == 31, "Failed ctz");
+	SMATH_STATIC_ASSERT(smath::ilog2(1) == 0 && smath::ilog2(1023) == 9 && smath::ilog2(1024) == 10 && smath::ilog2(0) == -1, "Failed ilog2");
+	SMATH_STATIC_ASSERT(smath::next_pow2(0) == 1 && smath::next_pow2(17) == 32 && smath::next_pow2(64) == 64, "Failed next_pow2");
+	SMATH_STATIC_ASSERT(smath::is_pow2(1) && smath::is_pow2(4096) && !smath::is_pow2(0) && !smath::is_pow2(12) && !smath::is_pow2(-2147483647 - 1), "Failed is_pow2");
+	SMATH_STATIC_ASSERT(smath::bit_reverse(1) == -2147483647 - 1 && smath::bit_reverse(0x0000F00F) == static_cast<int>(0xF00F0000u), "Failed bit_reverse");
+
+	const smath::vec4i sizes{ 1, 100, 512, 1920 };
+	assert((smath::ilog2(sizes) == smath::vec4i{ 0, 6, 9, 10 }) && "Failed ilog2 vec4i");
+	assert((smath::next_pow2(sizes) == smath::vec4i{ 1, 128, 512, 2048 }) && "Failed next_pow2 vec4i");
+	assert((smath::popcount(sizes) == smath::vec4i{ 1, 3, 1, 4 }) && "Failed popcount vec4i");
+	assert((smath::is_pow2(sizes) == smath::vec<4, bool>(true, false, true, false)) && "Failed is_pow2 vec4i");
+	assert((smath::ctz(smath::vec2i{ 12, 0 }) == smath::vec2i{ 2, 32 }) && (smath::clz(smath::vec2i{ 12, -1 }) == smath::vec2i{ 28, 0 }) && "Failed clz/ctz vec2i");
+	assert((smath::bit_reverse(smath::bit_reverse(sizes)) == sizes) && "Failed bit_reverse vec4i");
+
+	// vec4i runs the batch kernels, which must agree with the scalars
+	const smath::vec4i edges{ 0, -1, 1 << 30, -123457 };
+	for (int i = 0; i < 4; ++i) {
+		assert(smath::popcount(edges)[i] == smath::popcount(edges[i]) && smath::clz(edges)[i] == smath::clz(edges[i]) && smath::ctz(edges)[i] == smath::ctz(edges[i]) && "Failed bits vec4i edges");
+		assert(smath::ilog2(edges)[i] == smath::ilog2(edges[i]) && smath::bit_reverse(edges)[i] == smath::bit_reverse(edges[i]) && "Failed bits vec4i edges");
+	}
+
+	// Morton codes against interleaving one bit at a time
+	SMATH_STATIC_ASSERT(smath::morton_encode(smath::vec2i{ 3, 5 }) == 0x27 && smath::morton_encode(smath::vec3i{ 1, 2, 4 }) == 0x111, "Failed morton_encode");
+	SMATH_STATIC_ASSERT((smath::morton_decode<2>(0x27) == smath::vec2i{ 3, 5 }) && (smath::morton_decode<3>(0x111) == smath::vec3i{ 1, 2, 4 }), "Failed morton_decode");
+	for (unsigned i = 0; i < 1000; ++i) {
+		const smath::vec3i p{ static_cast<int>((i * 2654435761u) >> 16), static_cast<int>((i * 40503u) & 0xFFFFu), static_cast<int>((i * 97u) & 0x3FFu) };
+		unsigned code2{ 0 }, code3{ 0 };
+		for (unsigned b = 0; b < 16; ++b) {
+			code2 |= ((static_cast<unsigned>(p.x) >> b) & 1u) << (2 * b);
+			code2 |= ((static_cast<unsigned>(p.y) >> b) & 1u) << (2 * b + 1);
+		}
+		for (unsigned b = 0; b < 10; ++b) {
+			code3 |= ((static_cast<unsigned>(p.x) >> b) & 1u) << (3 * b);
+			code3 |= ((static_cast<unsigned>(p.y) >> b) & 1u) << (3 * b + 1);
+			code3 |= ((static_cast<unsigned>(p.z) >> b) & 1u) << (3 * b + 2);
+		}
+		const smath::vec2i p2{ p.x, p.y };
+		assert(smath::morton_encode(p2) == static_cast<int>(code2) && (smath::morton_decode<2>(static_cast<int>(code2)) == p2) && "Failed morton 2D");
+		const smath::vec3i p3{ p.x & 0x3FF, p.y & 0x3FF, p.z };
+		assert(smath::morton_encode(p3) == static_cast<int>(code3) && (smath::morton_decode<3>(static_cast<int>(code3)) == p3) && "Failed morton 3D");
+	}
+	assert(smath::morton_encode(smath::vec2i{ 0xFFFF, 0xFFFF }) == -1 && (smath::morton_decode<2>(-1) == smath::vec2i{ 0xFFFF, 0xFFFF }) && "Failed morton 2D full");
+	assert(smath::morton_encode(smath::vec3i{ -1, -1, -1 }) == 0x3FFFFFFF && (smath::morton_decode<3>(-1) == smath::vec3i{ 1023, 1023, 1023 }) && "Failed morton 3D full");
+
+	// batch forms against the scalar versions, with a tail after the full batches
+	std::vector<int> v(53), out(53);
+	for (std::size_t i = 0; i < v.size(); ++i) {
+		v[i] = static_cast<int>(i * 2654435761u);
+	}
+	v[0] = 0;
+	v[1] = -1;
+	v[2] = 1 << 30;
+	v[3] = (1 << 30) + 1;
+	smath::popcount(v, out);
+	for (std::size_t i = 0; i < v.size(); ++i) {
+		assert(out[i] == smath::popcount(v[i]) && "Failed popcount span");
+	}
+	smath::clz(v, out);
+	for (std::size_t i = 0; i < v.size(); ++i) {
+		assert(out[i] == smath::clz(v[i]) && "Failed clz span");
+	}
+	smath::ctz(v, out);
+	for (std::size_t i = 0; i < v.size(); ++i) {
+		assert(out[i] == smath::ctz(v[i]) && "Failed ctz span");
+	}
+	smath::ilog2(v, out);
+	for (std::size_t i = 0; i < v.size(); ++i) {
+		assert(out[i] == smath::ilog2(v[i]) && "Failed ilog2 span");
+	}
+	smath::next_pow2(v, out);
+	for (std::size_t i = 0; i < v.size(); ++i) {
+		assert((v[i] > (1 << 30) || v[i] < 0 || out[i] == smath::next_pow2(v[i])) && "Failed next_pow2 span");
+	}
+	smath::bit_reverse(v, out);
+	for (std::size_t i = 0; i < v.size(); ++i) {
+		assert(out[i] == smath::bit_reverse(v[i]) && "Failed bit_reverse span");
+	}
+
+	std::vector<smath::vec2i> tiles(5, smath::vec2i{ 300, 17 });
+	smath::next_pow2<2>(tiles, tiles);
+	assert((tiles[4] == smath::vec2i{ 512, 32 }) && "Failed next_pow2 vec span");
+
+	std::cout << "Passed\n\n";
+}
+
+/**
+ * Test the accuracy tiers of smath::inv_sqrt on scalars, vectors and ranges
+ */
+void test_inv_sqrt() {
+	std::cout << "\033[32m-- smath::inv_sqrt --\033[0m\n";
+
+#if SMATH_HAS_BUILTIN_BIT_CAST
+	SMATH_STATIC_ASSERT(smath::inv_sqrt(4.f, smath::accuracy::fast) > 0.4999f && smath::inv_sqrt(4.f, smath::accuracy::fast) < 0.5001f, "Failed constexpr inv_sqrt");
+#endif
+
+	const smath::accuracy tiers[3]{ smath::accuracy::fast, smath::accuracy::balanced, smath::accuracy::precise };
+	const double float_bounds[3]{ 5e-4, 2.0 * std::numeric_limits<float>::epsilon(), std::numeric_limits<float>::epsilon() };
+	const double double_bounds[3]{ 5e-4, 2.0 * std::numeric_limits<double>::epsilon(), std::numeric_limits<double>::epsilon() };
+
+	// the ULP distance between two finite numbers of the same sign
+	const auto ulps = [](auto a, auto b) {
+		using U = typename std::conditional<sizeof(a) == 4, std::int32_t, std::int64_t>::type;
+		U i{}, j{};
+		std::memcpy(&i, &a, sizeof(a));
+		std::memcpy(&j, &b, sizeof(b));
+		return i > j ? i - j : j - i;
+	};
+	const long long max_ulps[3]{ -1, 2, 1 };
+
+	// denormals up to large values, with an odd size for both the full batches
+	// and the padded tail
+	std::vector<float> f;
+	std::vector<double> d;
+	for (double x = 1e-45; x < 1e38; x *= 1.37) {
+		f.push_back(static_cast<float>(x));
+		d.push_back(x * 1e-278);
+		d.push_back(x * 1e270);
+	}
+	std::vector<float> fo(f.size());
+	std::vector<double> dout(d.size());
+
+	for (int t = 0; t < 3; ++t) {
+		smath::inv_sqrt(f, fo, tiers[t]);
+		for (std::size_t i = 0; i < f.size(); ++i) {
+			const double rf{ 1.0 / std::sqrt(static_cast<double>(f[i])) };
+			const float sf{ smath::inv_sqrt(f[i], tiers[t]) };
+			assert(std::fabs(fo[i] - rf) <= float_bounds[t] * rf && "Failed inv_sqrt float span");
+			assert(std::fabs(sf - rf) <= float_bounds[t] * rf && "Failed inv_sqrt float");
+			assert((t == 0 || (ulps(fo[i], static_cast<float>(rf)) <= max_ulps[t] && ulps(sf, static_cast<float>(rf)) <= max_ulps[t])) && "Failed inv_sqrt float ULP");
+		}
+
+		smath::inv_sqrt(d, dout, tiers[t]);
+		for (std::size_t i = 0; i < d.size(); ++i) {
+			const long double rd{ 1.0L / std::sqrt(static_cast<long double>(d[i])) };
+			const double sd{ smath::inv_sqrt(d[i], tiers[t]) };
+			assert(std::fabs(dout[i] - rd) <= double_bounds[t] * rd && "Failed inv_sqrt double span");
+			assert(std::fabs(sd - rd) <= double_bounds[t] * rd && "Failed inv_sqrt double");
+			assert((t == 0 || (ulps(dout[i], static_cast<double>(rd)) <= max_ulps[t] && ulps(sd, static_cast<double>(rd)) <= max_ulps[t])) && "Failed inv_sqrt double ULP");
+		}
+
+		// the tail gets the same result as a full batch
+		std::vector<float> tail(3, f[40]);
+		smath::inv_sqrt(smath::span<float>(tail), tiers[t]);
+		assert(tail[2] == fo[40] && "Failed inv_sqrt span tail");
+
+		const smath::vec4 v{ smath::inv_sqrt(smath::vec4{ 0.25f, 1.f, 2.f, 1e6f }, tiers[t]) };
+		assert(std::fabs(v.x - 2.f) <= 4.f * float_bounds[t] && std::fabs(v.w - 1e-3f) <= 1e-3f * float_bounds[t] && "Failed inv_sqrt vec4");
+		const smath::vec3d w{ smath::inv_sqrt(smath::vec3d{ 4.0, 9.0, 1e-8 }, tiers[t]) };
+		assert(std::fabs(w.y - 1.0 / 3.0) <= double_bounds[t] / 3.0 && std::fabs(w.z - 1e4) <= 1e4 * double_bounds[t] && "Failed inv_sqrt vec3d");
+	}
+
+	// zero, infinity and invalid inputs in every tier
+	const float inf{ std::numeric_limits<float>::infinity() };
+	for (int t = 0; t < 3; ++t) {
+		assert(smath::inv_sqrt(0.f, tiers[t]) == inf && smath::inv_sqrt(inf, tiers[t]) == 0.f && std::isnan(smath::inv_sqrt(-1.0, tiers[t])) && "Failed inv_sqrt special values");
+		const smath::vec4d s{ smath::inv_sqrt(smath::vec4d{ 0.0, std::numeric_limits<double>::infinity(), -4.0, std::nan("") }, tiers[t]) };
+		assert(s.x == std::numeric_limits<double>::infinity() && s.y == 0.0 && std::isnan(s.z) && std::isnan(s.w) && "Failed inv_sqrt vec4d special values");
+	}
+
+	std::cout << "Passed\n\n";
+}
+
+/**
+ * Test the accuracy tiers of smath::exp, exp2, expm1 and pow, and the exact
+ * smath::ldexp and frexp, on scalars, vectors and ranges
+ */
+void test_exp() {
+	std::cout << "\033[32m-- smath::exp --\033[0m\n";
+
+	const smath::accuracy tiers[3]{ smath::accuracy::fast, smath::accuracy::balanced, smath::accuracy::precise };
+	const double float_bounds[3]{ 5e-4, 2.0 * std::numeric_limits<float>::epsilon(), std::numeric_limits<float>::epsilon() };
+	const double double_bounds[3]{ 5e-4, 2.0 * std::numeric_limits<double>::epsilon(), std::numeric_limits<double>::epsilon() };
+
+	// an odd size exercises both the full batches and the padded tail
+	std::vector<float> f;
+	std::vector<double> d;
+	for (double x = -80.0; x < 80.0; x += 0.0731) {
+		f.push_back(static_cast<float>(x));
+		d.push_back(x);
+	}
+	std::vector<float> fo(f.size());
+	std::vector<double> dout(d.size());
+
+	for (int t = 0; t < 3; ++t) {
+		smath::exp(f, fo, tiers[t]);
+		smath::exp(d, dout, tiers[t]);
+		for (std::size_t i = 0; i < f.size(); ++i) {
+			const double rf{ std::exp(static_cast<double>(f[i])) };
+			assert(std::fabs(fo[i] - rf) <= float_bounds[t] * rf && "Failed exp float span");
+			assert(std::fabs(smath::exp(f[i], tiers[t]) - rf) <= float_bounds[t] * rf && "Failed exp float");
+
+			const long double rd{ std::exp(static_cast<long double>(d[i])) };
+			assert(std::fabs(dout[i] - rd) <= double_bounds[t] * rd && "Failed exp double span");
+			assert(std::fabs(smath::exp(d[i], tiers[t]) - rd) <= double_bounds[t] * rd && "Failed exp double");
+		}
+
+		smath::exp2(f, fo, tiers[t]);
+		smath::expm1(d, dout, tiers[t]);
+		for (std::size_t i = 0; i < f.size(); ++i) {
+			const double rf{ std::exp2(static_cast<double>(f[i])) };
+			assert(std::fabs(fo[i] - rf) <= float_bounds[t] * rf && "Failed exp2 float span");
+
+			const long double rd{ std::expm1(static_cast<long double>(d[i])) };
+			assert(std::fabs(dout[i] - rd) <= double_bounds[t] * std::fabs(rd) && "Failed expm1 double span");
+		}
+
+		// expm1 keeps its precision for tiny arguments, where exp(x) - 1 cannot
+		for (float x = -1e-3f; x < 1e-3f; x += 1.37e-5f) {
+			const double r{ std::expm1(static_cast<double>(x)) };
+			assert(std::fabs(smath::expm1(x, tiers[t]) - r) <= float_bounds[t] * std::fabs(r) && "Failed expm1 float");
+		}
+
+		// the tail gets the same result as a full batch
+		std::vector<float> tail(3, f[40]), full(17, f[40]);
+		smath::exp(smath::span<float>(tail), tiers[t]);
+		smath::exp(smath::span<float>(full), tiers[t]);
+		assert(tail[2] == full[0] && "Failed exp span tail");
+
+		const smath::vec4 v{ smath::exp(smath::vec4{ 0.f, 1.f, -2.f, 10.f }, tiers[t]) };
+		assert(v.x == 1.f && std::fabs(v.y - 2.718281828f) <= 2.72f * float_bounds[t] && std::fabs(v.w - 22026.4658f) <= 22026.5f * float_bounds[t] && "Failed exp vec4");
+		const smath::vec3d w{ smath::exp2(smath::vec3d{ 3.0, -0.5, 1000.0 }, tiers[t]) };
+		assert(w.x == 8.0 && std::fabs(w.y - 0.70710678118654752) <= 0.71 * double_bounds[t] && std::fabs(w.z / std::exp2(1000.0) - 1.0) <= double_bounds[t] && "Failed exp2 vec3d");
+	}
+
+	// pow against std::pow for the exponents each tier documents
+	std::vector<float> bases;
+	for (float x = 1e-3f; x < 1e3f; x *= 1.093f) {
+		bases.push_back(x);
+	}
+	std::vector<float> po(bases.size());
+	const float exponents[4]{ 1.f / 2.2f, 2.f, -1.f, 0.5f };
+	for (int t = 0; t < 3; ++t) {
+		for (const float e : exponents) {
+			// the balanced error grows with the exponent, see smath::pow
+			const double bound{ float_bounds[t] * (t == 1 ? std::max(1.0, std::fabs(e) * 1.5) : 1.0) };
+			smath::pow(bases, e, po, tiers[t]);
+			for (std::size_t i = 0; i < bases.size(); ++i) {
+				const double r{ std::pow(static_cast<double>(bases[i]), static_cast<double>(e)) };
+				assert(std::fabs(po[i] - r) <= bound * r && "Failed pow float span");
+				assert(std::fabs(smath::pow(bases[i], e, tiers[t]) - r) <= bound * r && "Failed pow float");
+			}
+			const long double rd{ std::pow(static_cast<long double>(3.7), static_cast<long double>(e)) };
+			assert(std::fabs(smath::pow(3.7, static_cast<double>(e), tiers[t]) - rd) <= double_bounds[t] * (t == 1 ? 3.0 : 1.0) * rd && "Failed pow double");
+		}
+		const smath::vec4d p{ smath::pow(smath::vec4d{ 2.0, 9.0, 10.0, -2.0 }, smath::vec4d{ 10.0, 0.5, -2.0, 3.0 }, tiers[t]) };
+		assert(std::fabs(p.x - 1024.0) <= 1024.0 * double_bounds[t] * 2.0 && std::fabs(p.y - 3.0) <= 3.0 * double_bounds[t] && std::fabs(p.z - 0.01) <= 0.01 * double_bounds[t] * 2.0 && std::fabs(p.w + 8.0) <= 8.0 * double_bounds[t] * 2.0 && "Failed pow vec4d");
+	}
+
+	// special values in every tier, through the SIMD kernels of the ranges as
+	// the scalars call the standard library
+	const auto exp_k = [](auto x, smath::accuracy acc) { std::vector<decltype(x)> v(1, x); smath::exp(smath::span<decltype(x)>(v), acc); return v[0]; };
+	const auto exp2_k = [](auto x, smath::accuracy acc) { std::vector<decltype(x)> v(1, x); smath::exp2(smath::span<decltype(x)>(v), acc); return v[0]; };
+	const auto expm1_k = [](auto x, smath::accuracy acc) { std::vector<decltype(x)> v(1, x); smath::expm1(smath::span<decltype(x)>(v), acc); return v[0]; };
+	const auto pow_k = [](float x, float y, smath::accuracy acc) { std::vector<float> v(1, x), e(1, y); smath::pow(v, e, v, acc); return v[0]; };
+	const float inf{ std::numeric_limits<float>::infinity() };
+	const float nan{ std::numeric_limits<float>::quiet_NaN() };
+	for (int t = 0; t < 3; ++t) {
+		assert(exp_k(inf, tiers[t]) == inf && exp_k(-inf, tiers[t]) == 0.f && std::isnan(exp_k(nan, tiers[t])) && "Failed exp special values");
+		assert(exp_k(100.f, tiers[t]) == inf && exp_k(-200.f, tiers[t]) == 0.f && exp2_k(1024.0, tiers[t]) == std::numeric_limits<double>::infinity() && "Failed exp overflow");
+		assert(exp2_k(-149.f, tiers[t]) == std::numeric_limits<float>::denorm_min() && exp2_k(-1074.0, tiers[t]) == std::numeric_limits<double>::denorm_min() && "Failed exp2 denormals");
+		assert(expm1_k(inf, tiers[t]) == inf && expm1_k(-inf, tiers[t]) == -1.f && std::signbit(expm1_k(-0.f, tiers[t])) && "Failed expm1 special values");
+
+		assert(pow_k(0.f, -1.f, tiers[t]) == inf && pow_k(-0.f, -3.f, tiers[t]) == -inf && pow_k(0.f, 2.f, tiers[t]) == 0.f && "Failed pow zero");
+		assert(pow_k(-2.f, 3.f, tiers[t]) == -8.f && std::isnan(pow_k(-2.f, 0.5f, tiers[t])) && pow_k(-inf, 3.f, tiers[t]) == -inf && "Failed pow negative base");
+		assert(pow_k(nan, 0.f, tiers[t]) == 1.f && pow_k(1.f, nan, tiers[t]) == 1.f && std::isnan(pow_k(2.f, nan, tiers[t])) && "Failed pow NaN");
+		assert(pow_k(0.5f, inf, tiers[t]) == 0.f && pow_k(0.5f, -inf, tiers[t]) == inf && pow_k(-1.f, inf, tiers[t]) == 1.f && "Failed pow infinite exponent");
+	}
+
+	// ldexp and frexp are exact, and round trip denormals
+	int e{};
+	assert(smath::ldexp(0.75f, 4) == 12.f && smath::frexp(12.f, e) == 0.75f && e == 4 && "Failed ldexp/frexp");
+	assert(smath::frexp(std::numeric_limits<double>::denorm_min(), e) == 0.5 && e == -1073 && "Failed frexp denormal");
+	smath::vec3i ev;
+	const smath::vec3 fm{ smath::frexp(smath::vec3{ 1.f, -6.f, 0.f }, ev) };
+	assert((fm == smath::vec3{ 0.5f, -0.75f, 0.f }) && (ev == smath::vec3i{ 1, 3, 0 }) && "Failed frexp vec3");
+	assert((smath::ldexp(fm, ev) == smath::vec3{ 1.f, -6.f, 0.f }) && "Failed ldexp vec3");
+
+	std::vector<double> values{ 1.0, -3.5, 1e-310, 5e-324, 1e300, 0.0, -0.0, 7.25, 1e-20 };
+	std::vector<double> mantissas(values.size());
+	std::vector<int> powers(values.size());
+	smath::frexp(values, mantissas, powers);
+	for (std::size_t i = 0; i < values.size(); ++i) {
+		int r{};
+		assert(mantissas[i] == std::frexp(values[i], &r) && powers[i] == r && "Failed frexp span");
+	}
+	smath::ldexp(mantissas, powers, mantissas);
+	assert(mantissas == values && "Failed ldexp span round trip");
+	std::vector<int> shifts{ -1080, 2000, -1, 0, 5, -1074, 10, -20, 1 };
+	smath::ldexp(values, shifts, mantissas);
+	for (std::size_t i = 0; i < values.size(); ++i) {
+		assert(mantissas[i] == std::ldexp(values[i], shifts[i]) && "Failed ldexp span");
+	}
+
+	std::cout << "Passed\n\n";
+}
+
+/**
+ * Test the accuracy tiers of smath::log, log2, log10 and log1p on scalars,
+ * vectors and ranges
+ */
+void test_log() {
+	std::cout << "\033[32m-- smath::log --\033[0m\n";
+
+	const smath::accuracy tiers[3]{ smath::accuracy::fast, smath::accuracy::balanced, smath::accuracy::precise };
+	const double float_bounds[3]{ 5e-4, std::numeric_limits<float>::epsilon(), std::numeric_limits<float>::epsilon() };
+	const double double_bounds[3]{ 5e-4, std::numeric_limits<double>::epsilon(), std::numeric_limits<double>::epsilon() };
+
+	// denormals up to large values, with an odd size for the padded tail
+	std::vector<float> f;
+	std::vector<double> d;
+	for (double x = 1e-44; x < 1e38; x *= 1.0731) {
+		f.push_back(static_cast<float>(x));
+		d.push_back(x * 1e-279);
+	}
+	std::vector<float> fo(f.size());
+	std::vector<double> dout(d.size());
+
+	for (int t = 0; t < 3; ++t) {
+		smath::log(f, fo, tiers[t]);
+		smath::log10(d, dout, tiers[t]);
+		for (std::size_t i = 0; i < f.size(); ++i) {
+			const double rf{ std::log(static_cast<double>(f[i])) };
+			assert(std::fabs(fo[i] - rf) <= float_bounds[t] * std::fabs(rf) && "Failed log float span");
+			assert(std::fabs(smath::log(f[i], tiers[t]) - rf) <= float_bounds[t] * std::fabs(rf) && "Failed log float");
+
+			const long double rd{ std::log10(static_cast<long double>(d[i])) };
+			assert(std::fabs(dout[i] - rd) <= double_bounds[t] * std::fabs(rd) && "Failed log10 double span");
+		}
+
+		smath::log2(f, fo, tiers[t]);
+		for (std::size_t i = 0; i < f.size(); ++i) {
+			const double rf{ std::log2(static_cast<double>(f[i])) };
+			assert(std::fabs(fo[i] - rf) <= float_bounds[t] * std::fabs(rf) && "Failed log2 float span");
+		}
+
+		// log1p keeps its precision where 1 + x rounds
+		std::vector<double> p;
+		for (double x = -0.99; x < 1e6; x = (x < 0.0 ? x * 0.9 + 1e-7 : x * 1.3 + 1e-7)) {
+			p.push_back(x);
+		}
+		std::vector<double> po(p.size());
+		smath::log1p(p, po, tiers[t]);
+		for (std::size_t i = 0; i < p.size(); ++i) {
+			const long double r{ std::log1p(static_cast<long double>(p[i])) };
+			assert(std::fabs(po[i] - r) <= double_bounds[t] * std::fabs(r) && "Failed log1p double span");
+			assert(std::fabs(smath::log1p(p[i], tiers[t]) - r) <= double_bounds[t] * std::fabs(r) && "Failed log1p double");
+		}
+
+		// the tail gets the same result as a full batch
+		std::vector<float> tail(3, f[40]);
+		smath::log2(smath::span<float>(tail), tiers[t]);
+		assert(tail[2] == fo[40] && "Failed log2 span tail");
+
+		const smath::vec4 v{ smath::log2(smath::vec4{ 1.f, 8.f, 0.125f, 1e-40f }, tiers[t]) };
+		assert(v.x == 0.f && v.y == 3.f && v.z == -3.f && std::fabs(v.w + 132.877124f) <= 133.f * float_bounds[t] && "Failed log2 vec4");
+		const smath::vec3d w{ smath::log10(smath::vec3d{ 1.0, 1000.0, 0.5 }, tiers[t]) };
+		assert(w.x == 0.0 && std::fabs(w.y - 3.0) <= 3.0 * double_bounds[t] && std::fabs(w.z + 0.30102999566398120) <= 0.31 * double_bounds[t] && "Failed log10 vec3d");
+		const smath::vec2 l{ smath::log1p(smath::vec2{ 1e-10f, 1.f }, tiers[t]) };
+		assert(std::fabs(l.x - 1e-10f) <= 1e-10f * float_bounds[t] && std::fabs(l.y - 0.69314718f) <= 0.7f * float_bounds[t] && "Failed log1p vec2");
+	}
+
+	// zero, negative, infinite and NaN inputs in every tier, through the SIMD
+	// kernels of the ranges
+	const auto log_k = [](auto x, smath::accuracy acc) { std::vector<decltype(x)> v(1, x); smath::log(smath::span<decltype(x)>(v), acc); return v[0]; };
+	const auto log1p_k = [](auto x, smath::accuracy acc) { std::vector<decltype(x)> v(1, x); smath::log1p(smath::span<decltype(x)>(v), acc); return v[0]; };
+	const float inf{ std::numeric_limits<float>::infinity() };
+	for (int t = 0; t < 3; ++t) {
+		assert(log_k(0.f, tiers[t]) == -inf && log_k(-0.f, tiers[t]) == -inf && log_k(inf, tiers[t]) == inf && std::isnan(log_k(-1.f, tiers[t])) && "Failed log special values");
+		const smath::vec4d s{ smath::log10(smath::vec4d{ 0.0, std::numeric_limits<double>::infinity(), -4.0, std::nan("") }, tiers[t]) };
+		assert(s.x == -std::numeric_limits<double>::infinity() && s.y == std::numeric_limits<double>::infinity() && std::isnan(s.z) && std::isnan(s.w) && "Failed log10 vec4d special values");
+		assert(log1p_k(-1.f, tiers[t]) == -inf && std::isnan(log1p_k(-2.f, tiers[t])) && log1p_k(inf, tiers[t]) == inf && "Failed log1p special values");
+		assert(log1p_k(-0.0, tiers[t]) == 0.0 && std::signbit(log1p_k(-0.0, tiers[t])) && "Failed log1p negative zero");
+	}
+
+	// integer vectors keep the std::log results
+	assert((smath::log(smath::vec3i{ 1, 8, 100 }) == smath::vec3i{ 0, 2, 4 }) && "Failed log vec3i");
+
+	std::cout << "Passed\n\n";
+}
+
+/**
+ * Test the precision policies and their error bounds, and the `fast` square root
+ */
+void test_precision() {
+	std::cout << "\033[32m-- smath::precision --\033[0m\n";
+
+	SMATH_STATIC_ASSERT(smath::default_accuracy == smath::accuracy::balanced, "Failed default precision");
+	SMATH_STATIC_ASSERT((std::is_same<decltype(smath::default_accuracy), const smath::balanced_t>::value), "Failed default precision policy");
+	SMATH_STATIC_ASSERT(smath::detail::is_precision<smath::fast_t>::value && smath::detail::is_precision<smath::accuracy>::value && !smath::detail::is_precision<float>::value, "Failed is_precision");
+	SMATH_STATIC_ASSERT(smath::detail::with_precision(smath::accuracy::precise, [](auto p) { return decltype(p)::value; }) == smath::accuracy::precise, "Failed with_precision");
+	SMATH_STATIC_ASSERT(smath::precise_t::max_ulp() == 1 && smath::balanced_t::max_ulp() == 2 && smath::fast_t::max_ulp() < 0, "Failed max_ulp");
+	SMATH_STATIC_ASSERT(smath::fast_t::max_error<double>() == 5e-4 && smath::balanced_t::max_error<float>() == 2.f * std::numeric_limits<float>::epsilon(), "Failed max_error");
+	SMATH_STATIC_ASSERT(smath::balanced_t::max_pow_ulp(4.0) == 2.0 && smath::balanced_t::max_pow_ulp(16.0) == 4.0 && smath::precise_t::max_pow_ulp(100.0) == 1.0 && smath::balanced_t::max_pow_ulp<float>(100.0) == 1.0, "Failed max_pow_ulp");
+	SMATH_STATIC_ASSERT(smath::fast_t::max_pow_error<double>(2.0) == 5e-4 && smath::fast_t::max_pow_error<double>(10.0) > 5e-4, "Failed max_pow_error");
+#if SMATH_HAS_BUILTIN_BIT_CAST
+	SMATH_STATIC_ASSERT(smath::inv_sqrt(4.f, smath::fast) > 0.4999f && smath::inv_sqrt(4.f, smath::fast) < 0.5001f, "Failed constexpr policy");
+#endif
+
+	// a policy gives the same results as its accuracy
+	assert(smath::exp(1.3, smath::fast) == smath::exp(1.3, smath::accuracy::fast) && "Failed exp policy");
+	assert(smath::log(0.7f, smath::precise) == smath::log(0.7f, smath::accuracy::precise) && "Failed log policy");
+	assert((smath::pow(smath::vec4{ 2.f }, 0.5f, smath::balanced) == smath::pow(smath::vec4{ 2.f }, 0.5f)) && "Failed pow policy");
+	const std::vector<float> pb{ 0.3f, 2.f, 7.5f, 11.f, 0.02f, 3.f, 9.f, 1.5f, 4.f };
+	std::vector<float> pf(pb.size()), pa(pb.size());
+	smath::pow(pb, pb, pf, smath::fast);
+	smath::pow(pb, pb, pa, smath::accuracy::fast);
+	assert(pf == pa && "Failed pow span policy");
+	const smath::vec3 n{ smath::normalize(smath::vec3{ 3.f, 0.f, 4.f }, smath::fast) };
+	assert(std::fabs(n.x - 0.6f) <= 0.6f * smath::fast_t::max_error<float>() && "Failed normalize policy");
+
+	// square roots within the bound of each policy, denormals included
+	std::vector<float> f;
+	std::vector<double> d;
+	for (double x = 1e-44; x < 1e38; x *= 1.37) {
+		f.push_back(static_cast<float>(x));
+		d.push_back(x * 1e-270);
+	}
+	std::vector<float> fo(f.size());
+	std::vector<double> dout(d.size());
+	smath::sqrt(f, fo, smath::fast);
+	smath::sqrt(d, dout, smath::fast);
+	for (std::size_t i = 0; i < f.size(); ++i) {
+		const double rf{ std::sqrt(static_cast<double>(f[i])) };
+		assert(std::fabs(fo[i] - rf) <= smath::fast_t::max_error<double>() * rf && "Failed fast sqrt float span");
+		const double rd{ std::sqrt(d[i]) };
+		assert(std::fabs(dout[i] - rd) <= smath::fast_t::max_error<double>() * rd && "Failed fast sqrt double span");
+	}
+	smath::sqrt(f, fo, smath::precise);
+	assert(fo[7] == std::sqrt(f[7]) && "Failed precise sqrt span");
+
+	const float inf{ std::numeric_limits<float>::infinity() };
+	const smath::vec4 s{ smath::sqrt(smath::vec4{ 0.f, inf, -4.f, 1e-40f }, smath::fast) };
+	assert(s.x == 0.f && s.y == inf && std::isnan(s.z) && std::fabs(s.w - 1e-20f) <= 1e-20f * smath::fast_t::max_error<float>() && "Failed fast sqrt vec4");
+	assert((smath::sqrt(smath::vec4d{ 4.0, 2.0, 0.0, 9.0 }, smath::balanced) == smath::vec4d{ 2.0, std::sqrt(2.0), 0.0, 3.0 }) && "Failed balanced sqrt vec4d");
+	assert(smath::sqrt(2.f, smath::fast) == std::sqrt(2.f) && "Failed scalar sqrt policy");
+
+	// pow within its own bound, which grows with the exponent, for bases around
+	// sqrt(2), whose logarithms lose the most, and for wider bases
+	std::vector<float> bases;
+	std::vector<float> exponents;
+	for (int i = 0; i < 3001; ++i) {
+		bases.push_back(std::ldexp(0.7f + static_cast<float>(i % 97) / 69.f, i % 3 == 0 ? i % 41 - 20 : 0));
+		exponents.push_back(static_cast<float>(i % 257) / 8.f - 16.f);
+	}
+	std::vector<float> po(bases.size());
+	std::vector<double> bd(bases.begin(), bases.end());
+	std::vector<double> yd(exponents.begin(), exponents.end());
+	std::vector<double> pd(bases.size());
+	const smath::accuracy pow_tiers[3]{ smath::accuracy::fast, smath::accuracy::balanced, smath::accuracy::precise };
+	for (const smath::accuracy acc : pow_tiers) {
+		smath::pow(bases, exponents, po, acc);
+		smath::pow(bd, yd, pd, acc);
+		for (std::size_t i = 0; i < bases.size(); ++i) {
+			const double y{ std::fabs(yd[i]) };
+			const double r{ std::pow(bd[i], yd[i]) };
+			if (r < std::numeric_limits<float>::min() || r > std::numeric_limits<float>::max()) {
+				continue;
+			}
+			// floats past fast are within 1 ULP for any exponent
+			const double bound{ acc == smath::accuracy::fast ? smath::fast_t::max_pow_error<double>(y) : smath::balanced_t::max_pow_error<float>(static_cast<float>(y)) };
+			assert(std::fabs(po[i] - r) <= bound * r && "Failed pow float bound");
+			if (std::numeric_limits<long double>::digits > std::numeric_limits<double>::digits) {
+				const long double rd{ std::pow(static_cast<long double>(bd[i]), static_cast<long double>(yd[i])) };
+				const double bound_d{ acc == smath::accuracy::fast ? bound :
+					(acc == smath::accuracy::balanced ? smath::balanced_t::max_pow_error<double>(y) : smath::precise_t::max_pow_error<double>(y)) };
+				assert(std::fabs(pd[i] - rd) <= bound_d * rd && "Failed pow double bound");
+			}
+		}
+	}
+
+	std::cout << "Passed\n\n";
+}
+
 /**
  * Test the differences between the constants
  */
@@ -373,10 +1967,34 @@ int main() {
 	test_ceil();
 	test_convert_radians_degrees();
 	test_scale();
+	test_fma();
+	test_clamp();
+	test_rounding();
+	test_range_map();
+	test_min_max();
+	test_bits();
+	test_inv_sqrt();
+	test_exp();
+	test_log();
+	test_precision();
 	test_vec1();
 	test_vec2();
 	test_vec3();
 	test_vec4();
+	test_vec4_simd();
+	test_relational();
+	test_geometric();
+	test_divider();
+	test_exponential_span();
+	test_layout();
+	test_soa_array();
+	test_soa_expression();
+	test_soa_eager();
+	test_aosoa_array();
+	test_memory();
+	test_simd();
+	test_batch();
+	test_parallel();
 	test_consts();
 
 	return 0;
@@ -0,0 +1,47 @@
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <type_traits>
+
+// the same smath configuration as main.cpp, without SMATH_FORCE_EXPRESSIONS
+#define SMATH_FORCE_INTRINSICS
+#include "smath/smath.hpp"
+
+/**
+ * Test the eager soa_array operators, which are only compiled when expressions
+ * are disabled, against the same expressions as test_soa_expression
+ */
+void test_soa_eager() {
+	std::cout << "\033[32m-- smath::soa_array (eager) --\033[0m\n";
+	using v3 = smath::vec3;
+
+	const smath::soa_array<3, float> a(21, v3{ 1.f, 2.f, 3.f });
+	const smath::soa_array<3, float> b(21, v3{ 4.f, 5.f, 6.f });
+	const smath::soa_array<3, float> c(21, v3{ 0.5f });
+	smath::soa_array<3, float> d(21, v3{ 2.f, 4.f, 8.f });
+
+	// every operator returns a new array
+	SMATH_STATIC_ASSERT((std::is_same<decltype(a * b + c), smath::soa_array<3, float>>::value), "Failed eager soa_array operator");
+	const smath::soa_array<3, float> r{ a * b + c * d - 1.f };
+	assert(r.size() == 21 && (r[20] == v3{ 4.f, 11.f, 21.f }) && "Failed eager soa_array arithmetic");
+
+	d = 1.f / (d - c) + v3{ 0.f, 1.f, 2.f };
+	assert(std::fabs(d[0].x - 1.f / 1.5f) < 1e-6f && std::fabs(d[7].z - (2.f + 1.f / 7.5f)) < 1e-6f && "Failed eager soa_array scalar on the left");
+
+	d += -a * 2.f;
+	assert(std::fabs(d[3].y - (1.f + 1.f / 3.5f - 4.f)) < 1e-6f && "Failed eager soa_array negation");
+
+	const smath::soa_array<3, float> e{ 2.f * a + v3{ 1.f, 0.f, 0.f } * b - v3{ 8.f } + (v3{ 6.f } - c) / 2.f };
+	assert((e[11] == v3{ 2.f + 4.f - 8.f + 2.75f, 4.f - 8.f + 2.75f, 6.f - 8.f + 2.75f }) && "Failed eager soa_array vector on the left");
+
+	const smath::soa_array<3, float> roots{ smath::sqrt(smath::abs(a - b * 2.f)) };
+	assert((roots[0] == v3{ std::sqrt(7.f), std::sqrt(8.f), 3.f }) && "Failed eager soa_array sqrt/abs");
+
+	const smath::soa_array<2, int> n(9, smath::vec2i{ 17, -9 });
+	const smath::soa_array<2, int> q{ n / smath::vec2i{ 4, 2 } + 1 };
+	assert((q[8] == smath::vec2i{ 5, -3 }) && "Failed eager soa_array<int>");
+	assert(((smath::vec2i{ 100, 7 } / (n + 3))[4] == smath::vec2i{ 5, -1 }) && "Failed eager soa_array<int> vector division");
+	assert(((10 - -n)[2] == smath::vec2i{ 27, 1 }) && "Failed eager soa_array<int> scalar subtraction");
+
+	std::cout << "Passed\n\n";
+}